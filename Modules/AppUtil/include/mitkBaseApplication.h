@@ -99,6 +99,7 @@ namespace mitk
     static const QString ARG_SEGMENTATION_LABELSET_PRESET;
     static const QString ARG_SEGMENTATION_LABEL_SUGGESTIONS;
     static const QString ARG_FULL_SCREEN_MODE;
+    static const QString ARG_ASYNCHRONOUS_LOGGING;
 
     // BlueBerry specific plugin framework properties
 
@@ -176,6 +176,7 @@ namespace mitk
   const QString BaseApplication::ARG_SEGMENTATION_LABELSET_PRESET = "Segmentation.labelSetPreset";
   const QString BaseApplication::ARG_SEGMENTATION_LABEL_SUGGESTIONS = "Segmentation.labelSuggestions";
   const QString BaseApplication::ARG_FULL_SCREEN_MODE = "MITK.fullscreen";
+  const QString BaseApplication::ARG_ASYNCHRONOUS_LOGGING = "MITK.asynchronousLogging";
 
   const QString BaseApplication::PROP_APPLICATION = "blueberry.application";
   const QString BaseApplication::PROP_FORCE_PLUGIN_INSTALL = BaseApplication::ARG_FORCE_PLUGIN_INSTALL;
@@ -938,6 +939,10 @@ namespace mitk
     fullscreenOption.callback(Poco::Util::OptionCallback<Impl>(d, &Impl::handleBooleanOption));
     options.addOption(fullscreenOption);
 
+    Poco::Util::Option asynchronousLoggingOption(ARG_ASYNCHRONOUS_LOGGING.toStdString(), "", "pass log messages to the log backends on a background thread");
+    asynchronousLoggingOption.callback(Poco::Util::OptionCallback<Impl>(d, &Impl::handleBooleanOption));
+    options.addOption(asynchronousLoggingOption);
+
 
     // Make Poco aware of QGuiApplication command-line options, even though they are only parsed by
     // Qt. Otherwise, Poco would throw exceptions for unknown options.
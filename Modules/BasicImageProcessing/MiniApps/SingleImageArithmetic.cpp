@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -95,70 +95,72 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image->Clone();
+  // the operations are evaluated in a single pass when the result is saved
+  mitk::ArithmeticExpression expression(image.GetPointer());
 
   if (ConvertToBool(parsedArgs, "tan"))
   {
     MITK_INFO << " Start Doing Operation: TAN()";
-    tmpImage = mitk::ArithmeticOperation::Tan(tmpImage, resultAsDouble);
+    expression = expression.Tan();
   }
   if (ConvertToBool(parsedArgs, "atan"))
   {
     MITK_INFO << " Start Doing Operation: ATAN()";
-    tmpImage = mitk::ArithmeticOperation::Atan(tmpImage, resultAsDouble);
+    expression = expression.Atan();
   }
   if (ConvertToBool(parsedArgs, "cos"))
   {
     MITK_INFO << " Start Doing Operation: COS()";
-    tmpImage = mitk::ArithmeticOperation::Cos(tmpImage, resultAsDouble);
+    expression = expression.Cos();
   }
   if (ConvertToBool(parsedArgs, "acos"))
   {
     MITK_INFO << " Start Doing Operation: ACOS()";
-    tmpImage = mitk::ArithmeticOperation::Acos(tmpImage, resultAsDouble);
+    expression = expression.Acos();
   }
   if (ConvertToBool(parsedArgs, "sin"))
   {
     MITK_INFO << " Start Doing Operation: SIN()";
-    tmpImage = mitk::ArithmeticOperation::Sin(tmpImage, resultAsDouble);
+    expression = expression.Sin();
   }
   if (ConvertToBool(parsedArgs, "asin"))
   {
     MITK_INFO << " Start Doing Operation: ASIN()";
-    tmpImage = mitk::ArithmeticOperation::Asin(tmpImage, resultAsDouble);
+    expression = expression.Asin();
   }
   if (ConvertToBool(parsedArgs, "square"))
   {
     MITK_INFO << " Start Doing Operation: SQUARE()";
-    tmpImage = mitk::ArithmeticOperation::Square(tmpImage, resultAsDouble);
+    expression = expression.Square();
   }
   if (ConvertToBool(parsedArgs, "sqrt"))
   {
     MITK_INFO << " Start Doing Operation: SQRT()";
-    tmpImage = mitk::ArithmeticOperation::Sqrt(tmpImage, resultAsDouble);
+    expression = expression.Sqrt();
   }
   if (ConvertToBool(parsedArgs, "abs"))
   {
     MITK_INFO << " Start Doing Operation: ABS()";
-    tmpImage = mitk::ArithmeticOperation::Abs(tmpImage, resultAsDouble);
+    expression = expression.Abs();
   }
   if (ConvertToBool(parsedArgs, "exp"))
   {
     MITK_INFO << " Start Doing Operation: EXP()";
-    tmpImage = mitk::ArithmeticOperation::Exp(tmpImage, resultAsDouble);
+    expression = expression.Exp();
   }
   if (ConvertToBool(parsedArgs, "expneg"))
   {
     MITK_INFO << " Start Doing Operation: EXPNEG()";
-    tmpImage = mitk::ArithmeticOperation::ExpNeg(tmpImage, resultAsDouble);
+    expression = expression.ExpNeg();
   }
   if (ConvertToBool(parsedArgs, "log10"))
   {
     MITK_INFO << " Start Doing Operation: LOG10()";
-    tmpImage = mitk::ArithmeticOperation::Log10(tmpImage, resultAsDouble);
+    expression = expression.Log10();
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  const auto outputPixelType = resultAsDouble ? mitk::MakeScalarPixelType<double>() : image->GetPixelType();
+  mitk::IOUtil::Save(expression.Evaluate(outputPixelType), outputFilename);
 
   return EXIT_SUCCESS;
 }
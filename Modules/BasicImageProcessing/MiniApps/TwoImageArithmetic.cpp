@@ -15,7 +15,7 @@ found in the LICENSE file.
 #include "mitkCommandLineParser.h"
 #include "mitkIOUtil.h"
 
-#include <mitkArithmeticOperation.h>
+#include <mitkArithmeticExpression.h>
 
 static bool ConvertToBool(std::map<std::string, us::Any> &data, std::string name)
 {
@@ -101,30 +101,33 @@ int main(int argc, char* argv[])
   bool resultAsDouble = ConvertToBool(parsedArgs, "as-double");
   MITK_INFO << "Output image as double: " << resultAsDouble;
 
-  mitk::Image::Pointer tmpImage = image1->Clone();
+  // the operations are evaluated in a single pass when the result is saved
+  mitk::ArithmeticExpression expression(image1.GetPointer());
+  const mitk::ArithmeticExpression rightImage(image2.GetPointer());
 
   if (ConvertToBool(parsedArgs, "add"))
   {
     MITK_INFO << " Start Doing Operation: ADD()";
-    tmpImage = mitk::ArithmeticOperation::Add(tmpImage, image2, resultAsDouble);
+    expression = expression + rightImage;
   }
   if (ConvertToBool(parsedArgs, "subtract"))
   {
     MITK_INFO << " Start Doing Operation: SUB()";
-    tmpImage = mitk::ArithmeticOperation::Subtract(tmpImage, image2, resultAsDouble);
+    expression = expression - rightImage;
   }
   if (ConvertToBool(parsedArgs, "multiply"))
   {
     MITK_INFO << " Start Doing Operation: MULT()";
-    tmpImage = mitk::ArithmeticOperation::Multiply(tmpImage, image2, resultAsDouble);
+    expression = expression * rightImage;
   }
   if (ConvertToBool(parsedArgs, "divide"))
   {
     MITK_INFO << " Start Doing Operation: DIV()";
-    tmpImage = mitk::ArithmeticOperation::Divide(tmpImage, image2, resultAsDouble);
+    expression = expression / rightImage;
   }
 
-  mitk::IOUtil::Save(tmpImage, outputFilename);
+  const auto outputPixelType = resultAsDouble ? mitk::MakeScalarPixelType<double>() : image1->GetPixelType();
+  mitk::IOUtil::Save(expression.Evaluate(outputPixelType), outputFilename);
 
   return EXIT_SUCCESS;
 }
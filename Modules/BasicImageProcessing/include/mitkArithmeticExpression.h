@@ -0,0 +1,95 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <memory>
+
+namespace mitk
+{
+  /** \brief Lazily evaluated arithmetic expression of images and values.
+  *
+  * Composing expressions only records the operations as an expression tree. Evaluate() computes
+  * the whole expression voxel-wise in a single multithreaded pass, without allocating intermediate
+  * images. Intermediate results are calculated in double precision and converted to the requested
+  * output pixel type only once. Sub-expressions that consist of values only are folded on construction.
+  *
+  * In contrast to ArithmeticOperation, chaining operations like
+  * \code
+  * auto result = ((ArithmeticExpression(image) - mean) / stdDev).Exp().Evaluate(MakeScalarPixelType<float>());
+  * \endcode
+  * does not create a temporary image per operation.
+  *
+  * All images of an expression must be scalar images of the same dimensions. The geometry of the result
+  * is taken from the first image of the expression.
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    ArithmeticExpression(const Image* image);
+    ArithmeticExpression(double value);
+
+    ArithmeticExpression operator-() const;
+
+    ArithmeticExpression Pow(const ArithmeticExpression& exponent) const;
+
+    ArithmeticExpression Tan() const;
+    ArithmeticExpression Atan() const;
+    ArithmeticExpression Cos() const;
+    ArithmeticExpression Acos() const;
+    ArithmeticExpression Sin() const;
+    ArithmeticExpression Asin() const;
+    ArithmeticExpression Square() const;
+    ArithmeticExpression Sqrt() const;
+    ArithmeticExpression Abs() const;
+    ArithmeticExpression Exp() const;
+    ArithmeticExpression ExpNeg() const;
+    ArithmeticExpression Log10() const;
+
+    /** \brief True if the expression does not contain any image.*/
+    bool IsConstant() const;
+
+    /** \brief Value of a constant expression.
+    * @throw mitk::Exception if the expression contains images.*/
+    double GetConstantValue() const;
+
+    /** \brief Computes the expression for all voxels (and time steps) of the input images.
+    *
+    * Values that do not fit into an integral output pixel type are clamped, NaN becomes 0.
+    * @throw mitk::Exception if the expression does not contain any image, the images differ in their
+    * dimensions, or a pixel type is not a scalar type.*/
+    Image::Pointer Evaluate(const PixelType& outputPixelType = MakeScalarPixelType<double>()) const;
+
+    friend MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator+(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    friend MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator-(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    friend MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator*(const ArithmeticExpression& left, const ArithmeticExpression& right);
+    friend MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator/(const ArithmeticExpression& left, const ArithmeticExpression& right);
+
+  private:
+    struct Node;
+
+    explicit ArithmeticExpression(std::shared_ptr<const Node> node);
+
+    std::shared_ptr<const Node> m_Node;
+  };
+
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator+(const ArithmeticExpression& left, const ArithmeticExpression& right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator-(const ArithmeticExpression& left, const ArithmeticExpression& right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator*(const ArithmeticExpression& left, const ArithmeticExpression& right);
+  MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression operator/(const ArithmeticExpression& left, const ArithmeticExpression& right);
+}
+
+#endif
@@ -0,0 +1,617 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  enum class OperationType
+  {
+    Image,
+    Value,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Pow,
+    Negate,
+    Tan,
+    Atan,
+    Cos,
+    Acos,
+    Sin,
+    Asin,
+    Square,
+    Sqrt,
+    Abs,
+    Exp,
+    ExpNeg,
+    Log10
+  };
+
+  template <OperationType Operation>
+  using OperationConstant = std::integral_constant<OperationType, Operation>;
+
+  constexpr bool IsBinary(OperationType operation)
+  {
+    return operation >= OperationType::Add && operation <= OperationType::Pow;
+  }
+
+  template <OperationType Operation>
+  inline double Apply(double a, double b)
+  {
+    if constexpr (Operation == OperationType::Add) return a + b;
+    else if constexpr (Operation == OperationType::Subtract) return a - b;
+    else if constexpr (Operation == OperationType::Multiply) return a * b;
+    else if constexpr (Operation == OperationType::Divide) return a / b;
+    else if constexpr (Operation == OperationType::Pow) return std::pow(a, b);
+    else if constexpr (Operation == OperationType::Negate) return -a;
+    else if constexpr (Operation == OperationType::Tan) return std::tan(a);
+    else if constexpr (Operation == OperationType::Atan) return std::atan(a);
+    else if constexpr (Operation == OperationType::Cos) return std::cos(a);
+    else if constexpr (Operation == OperationType::Acos) return std::acos(a);
+    else if constexpr (Operation == OperationType::Sin) return std::sin(a);
+    else if constexpr (Operation == OperationType::Asin) return std::asin(a);
+    else if constexpr (Operation == OperationType::Square) return a * a;
+    else if constexpr (Operation == OperationType::Sqrt) return std::sqrt(a);
+    else if constexpr (Operation == OperationType::Abs) return std::abs(a);
+    else if constexpr (Operation == OperationType::Exp) return std::exp(a);
+    else if constexpr (Operation == OperationType::ExpNeg) return std::exp(-a);
+    else return std::log10(a);
+  }
+
+  /** Calls function with an OperationConstant of the passed (non-leaf) operation, so the
+   * operation is a compile time constant in the inner loops.*/
+  template <typename TFunction>
+  void Dispatch(OperationType operation, TFunction function)
+  {
+    switch (operation)
+    {
+      case OperationType::Add: function(OperationConstant<OperationType::Add>()); break;
+      case OperationType::Subtract: function(OperationConstant<OperationType::Subtract>()); break;
+      case OperationType::Multiply: function(OperationConstant<OperationType::Multiply>()); break;
+      case OperationType::Divide: function(OperationConstant<OperationType::Divide>()); break;
+      case OperationType::Pow: function(OperationConstant<OperationType::Pow>()); break;
+      case OperationType::Negate: function(OperationConstant<OperationType::Negate>()); break;
+      case OperationType::Tan: function(OperationConstant<OperationType::Tan>()); break;
+      case OperationType::Atan: function(OperationConstant<OperationType::Atan>()); break;
+      case OperationType::Cos: function(OperationConstant<OperationType::Cos>()); break;
+      case OperationType::Acos: function(OperationConstant<OperationType::Acos>()); break;
+      case OperationType::Sin: function(OperationConstant<OperationType::Sin>()); break;
+      case OperationType::Asin: function(OperationConstant<OperationType::Asin>()); break;
+      case OperationType::Square: function(OperationConstant<OperationType::Square>()); break;
+      case OperationType::Sqrt: function(OperationConstant<OperationType::Sqrt>()); break;
+      case OperationType::Abs: function(OperationConstant<OperationType::Abs>()); break;
+      case OperationType::Exp: function(OperationConstant<OperationType::Exp>()); break;
+      case OperationType::ExpNeg: function(OperationConstant<OperationType::ExpNeg>()); break;
+      case OperationType::Log10: function(OperationConstant<OperationType::Log10>()); break;
+      default: mitkThrow() << "Invalid arithmetic operation.";
+    }
+  }
+
+  double ApplyScalar(OperationType operation, double a, double b)
+  {
+    double result = 0.0;
+    Dispatch(operation, [&](auto op) { result = Apply<decltype(op)::value>(a, b); });
+    return result;
+  }
+
+  using LoadFunction = void (*)(const void* data, std::size_t first, std::size_t count, double* target);
+  using StoreFunction = void (*)(const double* source, std::size_t first, std::size_t count, void* data);
+
+  template <typename TPixel>
+  void LoadPixels(const void* data, std::size_t first, std::size_t count, double* target)
+  {
+    const auto* pixels = static_cast<const TPixel*>(data) + first;
+
+    for (std::size_t i = 0; i < count; ++i)
+      target[i] = static_cast<double>(pixels[i]);
+  }
+
+  template <typename TPixel>
+  void StorePixels(const double* source, std::size_t first, std::size_t count, void* data)
+  {
+    auto* pixels = static_cast<TPixel*>(data) + first;
+
+    if constexpr (std::is_integral_v<TPixel>)
+    {
+      constexpr auto lowest = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+      constexpr auto max = static_cast<double>(std::numeric_limits<TPixel>::max());
+
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const double value = source[i];
+        pixels[i] = std::isnan(value)
+          ? TPixel(0)
+          : value <= lowest ? std::numeric_limits<TPixel>::lowest()
+          : value >= max ? std::numeric_limits<TPixel>::max()
+          : static_cast<TPixel>(value);
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        pixels[i] = static_cast<TPixel>(source[i]);
+    }
+  }
+
+  template <template <typename> class TFunctionTraits>
+  typename TFunctionTraits<double>::Type GetPixelFunction(const mitk::PixelType& pixelType)
+  {
+    if (pixelType.GetNumberOfComponents() != 1)
+      mitkThrow() << "Arithmetic expressions support scalar images only. Pixel type: " << pixelType.GetPixelTypeAsString();
+
+    switch (pixelType.GetComponentType())
+    {
+      case itk::IOComponentEnum::UCHAR: return TFunctionTraits<unsigned char>::Function;
+      case itk::IOComponentEnum::CHAR: return TFunctionTraits<signed char>::Function;
+      case itk::IOComponentEnum::USHORT: return TFunctionTraits<unsigned short>::Function;
+      case itk::IOComponentEnum::SHORT: return TFunctionTraits<short>::Function;
+      case itk::IOComponentEnum::UINT: return TFunctionTraits<unsigned int>::Function;
+      case itk::IOComponentEnum::INT: return TFunctionTraits<int>::Function;
+      case itk::IOComponentEnum::ULONG: return TFunctionTraits<unsigned long>::Function;
+      case itk::IOComponentEnum::LONG: return TFunctionTraits<long>::Function;
+      case itk::IOComponentEnum::ULONGLONG: return TFunctionTraits<unsigned long long>::Function;
+      case itk::IOComponentEnum::LONGLONG: return TFunctionTraits<long long>::Function;
+      case itk::IOComponentEnum::FLOAT: return TFunctionTraits<float>::Function;
+      case itk::IOComponentEnum::DOUBLE: return TFunctionTraits<double>::Function;
+      default:
+        mitkThrow() << "Arithmetic expressions do not support the component type " << pixelType.GetComponentTypeAsString() << ".";
+    }
+  }
+
+  template <typename TPixel>
+  struct LoadFunctionTraits
+  {
+    using Type = LoadFunction;
+    static constexpr LoadFunction Function = &LoadPixels<TPixel>;
+  };
+
+  template <typename TPixel>
+  struct StoreFunctionTraits
+  {
+    using Type = StoreFunction;
+    static constexpr StoreFunction Function = &StorePixels<TPixel>;
+  };
+
+  /** An instruction of the compiled expression. Instructions work on slots, buffers of
+   * ChunkSize voxels. Binary operations combine the target slot either with another slot
+   * or with a constant value on the left or right side.*/
+  struct Instruction
+  {
+    enum class OperandType
+    {
+      None,
+      Slot,
+      ValueLeft,
+      ValueRight
+    };
+
+    OperationType Operation = OperationType::Value;
+    OperandType Operand = OperandType::None;
+    std::size_t Target = 0;
+    std::size_t Source = 0;
+    std::size_t Input = 0;
+    double Value = 0.0;
+  };
+
+  constexpr std::size_t ChunkSize = 4096;
+  constexpr std::size_t ChunksPerTask = 16;
+
+  template <OperationType Operation>
+  void Execute(const Instruction& instruction, double* target, const double* source, std::size_t count)
+  {
+    const double value = instruction.Value;
+
+    if constexpr (IsBinary(Operation))
+    {
+      switch (instruction.Operand)
+      {
+        case Instruction::OperandType::Slot:
+          for (std::size_t i = 0; i < count; ++i)
+            target[i] = Apply<Operation>(target[i], source[i]);
+          break;
+
+        case Instruction::OperandType::ValueLeft:
+          for (std::size_t i = 0; i < count; ++i)
+            target[i] = Apply<Operation>(value, target[i]);
+          break;
+
+        default:
+          for (std::size_t i = 0; i < count; ++i)
+            target[i] = Apply<Operation>(target[i], value);
+          break;
+      }
+    }
+    else
+    {
+      for (std::size_t i = 0; i < count; ++i)
+        target[i] = Apply<Operation>(target[i], value);
+    }
+  }
+}
+
+struct mitk::ArithmeticExpression::Node
+{
+  OperationType Operation = OperationType::Value;
+  Image::ConstPointer InputImage;
+  double Value = 0.0;
+  std::shared_ptr<const Node> Left;
+  std::shared_ptr<const Node> Right;
+
+  bool IsConstant() const
+  {
+    return Operation == OperationType::Value;
+  }
+
+  static std::shared_ptr<const Node> MakeUnary(OperationType operation, const std::shared_ptr<const Node>& operand)
+  {
+    auto node = std::make_shared<Node>();
+
+    if (operand->IsConstant())
+    {
+      node->Value = ApplyScalar(operation, operand->Value, 0.0);
+    }
+    else
+    {
+      node->Operation = operation;
+      node->Left = operand;
+    }
+
+    return node;
+  }
+
+  static std::shared_ptr<const Node> MakeBinary(OperationType operation, const std::shared_ptr<const Node>& left, const std::shared_ptr<const Node>& right)
+  {
+    auto node = std::make_shared<Node>();
+
+    if (left->IsConstant() && right->IsConstant())
+    {
+      node->Value = ApplyScalar(operation, left->Value, right->Value);
+    }
+    else
+    {
+      node->Operation = operation;
+      node->Left = left;
+      node->Right = right;
+    }
+
+    return node;
+  }
+};
+
+namespace
+{
+  /** Flattens the expression tree into a list of instructions and collects the distinct input images.*/
+  class ExpressionCompiler
+  {
+  public:
+    template <typename TNode>
+    void Compile(const TNode& node, std::size_t slot)
+    {
+      m_NumberOfSlots = std::max(m_NumberOfSlots, slot + 1);
+
+      Instruction instruction;
+      instruction.Operation = node.Operation;
+      instruction.Target = slot;
+
+      if (node.Operation == OperationType::Image)
+      {
+        instruction.Input = this->GetInputIndex(node.InputImage);
+      }
+      else if (node.Operation == OperationType::Value)
+      {
+        instruction.Value = node.Value;
+      }
+      else if (!IsBinary(node.Operation))
+      {
+        this->Compile(*node.Left, slot);
+      }
+      else if (node.Right->IsConstant())
+      {
+        this->Compile(*node.Left, slot);
+        instruction.Operand = Instruction::OperandType::ValueRight;
+        instruction.Value = node.Right->Value;
+      }
+      else if (node.Left->IsConstant())
+      {
+        this->Compile(*node.Right, slot);
+        instruction.Operand = Instruction::OperandType::ValueLeft;
+        instruction.Value = node.Left->Value;
+      }
+      else
+      {
+        this->Compile(*node.Left, slot);
+        this->Compile(*node.Right, slot + 1);
+        instruction.Operand = Instruction::OperandType::Slot;
+        instruction.Source = slot + 1;
+      }
+
+      m_Instructions.push_back(instruction);
+    }
+
+    const std::vector<Instruction>& GetInstructions() const
+    {
+      return m_Instructions;
+    }
+
+    const std::vector<mitk::Image::ConstPointer>& GetInputs() const
+    {
+      return m_Inputs;
+    }
+
+    std::size_t GetNumberOfSlots() const
+    {
+      return m_NumberOfSlots;
+    }
+
+  private:
+    std::size_t GetInputIndex(const mitk::Image* image)
+    {
+      auto iter = std::find_if(m_Inputs.begin(), m_Inputs.end(), [image](const mitk::Image::ConstPointer& input) { return input.GetPointer() == image; });
+
+      if (iter != m_Inputs.end())
+        return static_cast<std::size_t>(iter - m_Inputs.begin());
+
+      m_Inputs.push_back(image);
+      return m_Inputs.size() - 1;
+    }
+
+    std::vector<Instruction> m_Instructions;
+    std::vector<mitk::Image::ConstPointer> m_Inputs;
+    std::size_t m_NumberOfSlots = 0;
+  };
+
+  std::size_t GetNumberOfPixels(const mitk::Image* image)
+  {
+    std::size_t numberOfPixels = 1;
+
+    for (unsigned int i = 0; i < image->GetDimension(); ++i)
+      numberOfPixels *= image->GetDimension(i);
+
+    return numberOfPixels;
+  }
+
+  void CheckInputs(const std::vector<mitk::Image::ConstPointer>& inputs)
+  {
+    if (inputs.empty())
+      mitkThrow() << "Cannot evaluate an arithmetic expression without an image.";
+
+    const auto* reference = inputs.front().GetPointer();
+
+    for (const auto& input : inputs)
+    {
+      if (input->GetDimension() != reference->GetDimension())
+        mitkThrow() << "Images of an arithmetic expression have different dimensions.";
+
+      for (unsigned int i = 0; i < reference->GetDimension(); ++i)
+      {
+        if (input->GetDimension(i) != reference->GetDimension(i))
+          mitkThrow() << "Images of an arithmetic expression have different sizes.";
+      }
+    }
+  }
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(const Image* image)
+{
+  if (nullptr == image)
+    mitkThrow() << "Invalid image in arithmetic expression.";
+
+  auto node = std::make_shared<Node>();
+  node->Operation = OperationType::Image;
+  node->InputImage = image;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(double value)
+{
+  auto node = std::make_shared<Node>();
+  node->Value = value;
+  m_Node = node;
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(std::shared_ptr<const Node> node)
+  : m_Node(std::move(node))
+{
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::operator-() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Negate, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(const ArithmeticExpression& exponent) const
+{
+  return ArithmeticExpression(Node::MakeBinary(OperationType::Pow, m_Node, exponent.m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Tan() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Tan, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Atan() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Atan, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Cos() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Cos, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Acos() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Acos, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sin() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Sin, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Asin() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Asin, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Square() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Square, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sqrt() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Sqrt, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Abs() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Abs, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Exp() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Exp, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ExpNeg() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::ExpNeg, m_Node));
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Log10() const
+{
+  return ArithmeticExpression(Node::MakeUnary(OperationType::Log10, m_Node));
+}
+
+bool mitk::ArithmeticExpression::IsConstant() const
+{
+  return m_Node->IsConstant();
+}
+
+double mitk::ArithmeticExpression::GetConstantValue() const
+{
+  if (!m_Node->IsConstant())
+    mitkThrow() << "Arithmetic expression is not constant.";
+
+  return m_Node->Value;
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(const PixelType& outputPixelType) const
+{
+  ExpressionCompiler compiler;
+  compiler.Compile(*m_Node, 0);
+
+  const auto& inputs = compiler.GetInputs();
+  CheckInputs(inputs);
+
+  const auto store = GetPixelFunction<StoreFunctionTraits>(outputPixelType);
+
+  std::vector<LoadFunction> loads;
+  std::vector<std::unique_ptr<ImageReadAccessor>> readAccessors;
+  std::vector<const void*> inputData;
+
+  for (const auto& input : inputs)
+  {
+    loads.push_back(GetPixelFunction<LoadFunctionTraits>(input->GetPixelType()));
+    readAccessors.push_back(std::make_unique<ImageReadAccessor>(input));
+    inputData.push_back(readAccessors.back()->GetData());
+  }
+
+  const auto* reference = inputs.front().GetPointer();
+
+  auto result = Image::New();
+  result->Initialize(outputPixelType, reference->GetDimension(), reference->GetDimensions());
+  result->SetTimeGeometry(reference->GetTimeGeometry()->Clone());
+
+  ImageWriteAccessor writeAccessor(result);
+  void* outputData = writeAccessor.GetData();
+
+  const auto& instructions = compiler.GetInstructions();
+  const std::size_t numberOfSlots = compiler.GetNumberOfSlots();
+  const std::size_t numberOfPixels = GetNumberOfPixels(reference);
+  const std::size_t numberOfChunks = (numberOfPixels + ChunkSize - 1) / ChunkSize;
+  const std::size_t numberOfTasks = (numberOfChunks + ChunksPerTask - 1) / ChunksPerTask;
+
+  auto evaluateTask = [&](itk::SizeValueType task)
+  {
+    std::vector<double> slots(numberOfSlots * ChunkSize);
+
+    const std::size_t firstChunk = task * ChunksPerTask;
+    const std::size_t lastChunk = std::min(firstChunk + ChunksPerTask, numberOfChunks);
+
+    for (std::size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+    {
+      const std::size_t first = chunk * ChunkSize;
+      const std::size_t count = std::min(ChunkSize, numberOfPixels - first);
+
+      for (const auto& instruction : instructions)
+      {
+        double* target = slots.data() + instruction.Target * ChunkSize;
+
+        if (instruction.Operation == OperationType::Image)
+        {
+          loads[instruction.Input](inputData[instruction.Input], first, count, target);
+        }
+        else if (instruction.Operation == OperationType::Value)
+        {
+          std::fill_n(target, count, instruction.Value);
+        }
+        else
+        {
+          const double* source = slots.data() + instruction.Source * ChunkSize;
+          Dispatch(instruction.Operation, [&](auto op) { Execute<decltype(op)::value>(instruction, target, source, count); });
+        }
+      }
+
+      store(slots.data(), first, count, outputData);
+    }
+  };
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfTasks, evaluateTask, nullptr);
+
+  return result;
+}
+
+mitk::ArithmeticExpression mitk::operator+(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return ArithmeticExpression(ArithmeticExpression::Node::MakeBinary(OperationType::Add, left.m_Node, right.m_Node));
+}
+
+mitk::ArithmeticExpression mitk::operator-(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return ArithmeticExpression(ArithmeticExpression::Node::MakeBinary(OperationType::Subtract, left.m_Node, right.m_Node));
+}
+
+mitk::ArithmeticExpression mitk::operator*(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return ArithmeticExpression(ArithmeticExpression::Node::MakeBinary(OperationType::Multiply, left.m_Node, right.m_Node));
+}
+
+mitk::ArithmeticExpression mitk::operator/(const ArithmeticExpression& left, const ArithmeticExpression& right)
+{
+  return ArithmeticExpression(ArithmeticExpression::Node::MakeBinary(OperationType::Divide, left.m_Node, right.m_Node));
+}
@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkArithmeticExpression.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cmath>
+
+class mitkArithmeticExpressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticExpressionTestSuite);
+  MITK_TEST(TestConstantFolding);
+  MITK_TEST(TestTwoImages);
+  MITK_TEST(TestChainedOperations);
+  MITK_TEST(TestIntegralOutput);
+  MITK_TEST(TestInvalidExpressions);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  // more pixels than a single chunk of the evaluation
+  static constexpr unsigned int Size = 40;
+
+  mitk::Image::Pointer m_ShortImage;
+  mitk::Image::Pointer m_FloatImage;
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateImage(TPixel (*function)(unsigned int, unsigned int, unsigned int))
+  {
+    unsigned int dimensions[3] = { Size, Size, Size };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<TPixel>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<TPixel, 3> accessor(image);
+    for (unsigned int z = 0; z < Size; ++z)
+      for (unsigned int y = 0; y < Size; ++y)
+        for (unsigned int x = 0; x < Size; ++x)
+          accessor.SetPixelByIndex({ { x, y, z } }, function(x, y, z));
+
+    return image;
+  }
+
+  template <typename TPixel>
+  static TPixel GetPixel(mitk::Image* image, unsigned int x, unsigned int y, unsigned int z)
+  {
+    mitk::ImagePixelReadAccessor<TPixel, 3> accessor(image);
+    return accessor.GetPixelByIndex({ { x, y, z } });
+  }
+
+public:
+  void setUp() override
+  {
+    m_ShortImage = CreateImage<short>([](unsigned int x, unsigned int y, unsigned int z) { return static_cast<short>(static_cast<int>(x + y) - static_cast<int>(z)); });
+    m_FloatImage = CreateImage<float>([](unsigned int x, unsigned int, unsigned int z) { return 0.5f * x + z; });
+  }
+
+  void tearDown() override
+  {
+    m_ShortImage = nullptr;
+    m_FloatImage = nullptr;
+  }
+
+  void TestConstantFolding()
+  {
+    auto expression = (mitk::ArithmeticExpression(2.0) + 3.0) * 4.0;
+    CPPUNIT_ASSERT(expression.IsConstant());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, expression.GetConstantValue(), mitk::eps);
+
+    auto imageExpression = mitk::ArithmeticExpression(m_ShortImage.GetPointer()) * expression;
+    CPPUNIT_ASSERT(!imageExpression.IsConstant());
+    CPPUNIT_ASSERT_THROW(imageExpression.GetConstantValue(), mitk::Exception);
+  }
+
+  void TestTwoImages()
+  {
+    const mitk::ArithmeticExpression shortImage(m_ShortImage.GetPointer());
+    const mitk::ArithmeticExpression floatImage(m_FloatImage.GetPointer());
+
+    auto result = (shortImage * floatImage - shortImage).Evaluate();
+    CPPUNIT_ASSERT(mitk::MakeScalarPixelType<double>() == result->GetPixelType());
+    CPPUNIT_ASSERT(mitk::Equal(*m_ShortImage->GetGeometry(), *result->GetGeometry(), mitk::eps, true));
+
+    for (unsigned int i = 0; i < Size; i += 7)
+    {
+      const double a = GetPixel<short>(m_ShortImage, i, Size - 1 - i, i / 2);
+      const double b = GetPixel<float>(m_FloatImage, i, Size - 1 - i, i / 2);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(a * b - a, GetPixel<double>(result, i, Size - 1 - i, i / 2), mitk::eps);
+    }
+  }
+
+  void TestChainedOperations()
+  {
+    // value on the left side and nested image operands
+    auto expression = (10.0 - mitk::ArithmeticExpression(m_FloatImage.GetPointer())).Abs().Sqrt()
+      + mitk::ArithmeticExpression(m_FloatImage.GetPointer()).Pow(2.0) / (mitk::ArithmeticExpression(m_ShortImage.GetPointer()).Square() + 1.0);
+    auto result = expression.Evaluate(mitk::MakeScalarPixelType<float>());
+    CPPUNIT_ASSERT(mitk::MakeScalarPixelType<float>() == result->GetPixelType());
+
+    for (unsigned int i = 0; i < Size; i += 5)
+    {
+      const double a = GetPixel<short>(m_ShortImage, i, i, Size - 1 - i);
+      const double b = GetPixel<float>(m_FloatImage, i, i, Size - 1 - i);
+      const double expected = std::sqrt(std::abs(10.0 - b)) + std::pow(b, 2.0) / (a * a + 1.0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, GetPixel<float>(result, i, i, Size - 1 - i), 1e-4);
+    }
+  }
+
+  void TestIntegralOutput()
+  {
+    auto result = (mitk::ArithmeticExpression(m_ShortImage.GetPointer()) * 10.0).Evaluate(mitk::MakeScalarPixelType<unsigned char>());
+
+    // negative values and values above 255 are clamped
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(0), GetPixel<unsigned char>(result, 0, 0, 5));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(30), GetPixel<unsigned char>(result, 1, 2, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(255), GetPixel<unsigned char>(result, 20, 20, 0));
+  }
+
+  void TestInvalidExpressions()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::ArithmeticExpression(5.0).Evaluate(), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::ArithmeticExpression(static_cast<const mitk::Image*>(nullptr)), mitk::Exception);
+
+    unsigned int dimensions[3] = { Size, Size, 1 };
+    auto smallImage = mitk::Image::New();
+    smallImage->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    auto expression = mitk::ArithmeticExpression(m_ShortImage.GetPointer()) + mitk::ArithmeticExpression(smallImage.GetPointer());
+    CPPUNIT_ASSERT_THROW(expression.Evaluate(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticExpression)
@@ -13,13 +13,19 @@ found in the LICENSE file.
 #include <mitkContourModelUtils.h>
 
 #include <mitkContourModelToSurfaceFilter.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkSurface.h>
 #include <vtkImageStencil.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataToImageStencil.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 mitk::ContourModelUtils::ContourModelUtils()
 {
 }
@@ -95,6 +101,188 @@ mitk::ContourModel::Pointer mitk::ContourModelUtils::BackProjectContourFrom2DSli
   return worldContour;
 }
 
+namespace
+{
+  struct ContourEdge
+  {
+    double X0, Y0, X1, Y1;
+  };
+
+  /** Pixels of the slice that are inside the contour, stored for the bounding box of the contour.*/
+  struct FillMask
+  {
+    int OffsetX = 0;
+    int OffsetY = 0;
+    int Width = 0;
+    int Height = 0;
+    std::vector<unsigned char> Inside;
+  };
+
+  /** Marks all sample columns of the row whose position lies within [beginX, endX] (inclusive, with tolerance).*/
+  void MarkSpan(std::vector<unsigned char>& sampleRow, double beginX, double endX, double firstSampleX, unsigned int samples)
+  {
+    const auto firstColumn = std::max(0.0, std::ceil((beginX - mitk::eps - firstSampleX) * samples));
+    const auto lastColumn = std::min(static_cast<double>(sampleRow.size()) - 1.0, std::floor((endX + mitk::eps - firstSampleX) * samples));
+
+    for (auto column = static_cast<std::size_t>(firstColumn); column <= lastColumn; ++column)
+      sampleRow[column] = 1;
+  }
+
+  /** Marks the inside of the contour on the sample row at height y. Crossings are determined once with edges
+  * including their lower and once with edges including their upper end point. The union of both results
+  * makes boundary pixels inside, like the tolerance of vtkPolyDataToImageStencil did.*/
+  void RasterizeSampleRow(const std::vector<ContourEdge>& edges, double y, mitk::ContourModelUtils::FillRule fillRule,
+    double firstSampleX, unsigned int samples, std::vector<std::pair<double, int>>& crossings, std::vector<unsigned char>& sampleRow)
+  {
+    for (const bool includeLowerEnd : { true, false })
+    {
+      crossings.clear();
+
+      for (const auto& edge : edges)
+      {
+        const bool crosses = includeLowerEnd
+          ? (edge.Y0 <= y) != (edge.Y1 <= y)
+          : (edge.Y0 < y) != (edge.Y1 < y);
+
+        if (crosses)
+        {
+          const auto x = edge.X0 + (y - edge.Y0) * (edge.X1 - edge.X0) / (edge.Y1 - edge.Y0);
+          crossings.emplace_back(x, edge.Y1 > edge.Y0 ? 1 : -1);
+        }
+      }
+
+      std::sort(crossings.begin(), crossings.end());
+
+      int winding = 0;
+      for (std::size_t i = 0; i + 1 < crossings.size(); ++i)
+      {
+        winding += crossings[i].second;
+
+        const bool inside = mitk::ContourModelUtils::FillRule::EvenOdd == fillRule
+          ? 0 == i % 2
+          : 0 != winding;
+
+        if (inside)
+          MarkSpan(sampleRow, crossings[i].first, crossings[i + 1].first, firstSampleX, samples);
+      }
+    }
+
+    // horizontal edges on the sample row are part of the contour, but have no crossings
+    for (const auto& edge : edges)
+    {
+      if (std::abs(edge.Y0 - edge.Y1) < mitk::eps && std::abs(edge.Y0 - y) < mitk::eps)
+        MarkSpan(sampleRow, std::min(edge.X0, edge.X1), std::max(edge.X0, edge.X1), firstSampleX, samples);
+    }
+  }
+
+  /** Rasterizes the closed polygon given by the contour vertices (x and y of the index coordinates).
+  * Returns an empty mask if the contour does not overlap the slice.*/
+  FillMask RasterizeContour(const mitk::ContourModel* contour, mitk::TimeStepType timeStep, const int sliceWidth, const int sliceHeight,
+    mitk::ContourModelUtils::FillRule fillRule, unsigned int samples)
+  {
+    FillMask mask;
+
+    std::vector<ContourEdge> edges;
+    edges.reserve(contour->GetNumberOfVertices(timeStep));
+
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    const mitk::ContourElement::VertexType* previous = nullptr;
+    const mitk::ContourElement::VertexType* first = nullptr;
+
+    for (auto iter = contour->Begin(timeStep); iter != contour->End(timeStep); ++iter)
+    {
+      const auto& point = (*iter)->Coordinates;
+      minX = std::min(minX, point[0]);
+      maxX = std::max(maxX, point[0]);
+      minY = std::min(minY, point[1]);
+      maxY = std::max(maxY, point[1]);
+
+      if (nullptr == first)
+        first = *iter;
+      else
+        edges.push_back({ previous->Coordinates[0], previous->Coordinates[1], point[0], point[1] });
+
+      previous = *iter;
+    }
+
+    if (nullptr == first)
+      return mask;
+
+    // filling always regards the contour as closed
+    edges.push_back({ previous->Coordinates[0], previous->Coordinates[1], first->Coordinates[0], first->Coordinates[1] });
+
+    const auto beginX = std::max(0, static_cast<int>(std::floor(minX - 0.5)));
+    const auto beginY = std::max(0, static_cast<int>(std::floor(minY - 0.5)));
+    const auto endX = std::min(sliceWidth, static_cast<int>(std::ceil(maxX + 0.5)) + 1);
+    const auto endY = std::min(sliceHeight, static_cast<int>(std::ceil(maxY + 0.5)) + 1);
+
+    if (beginX >= endX || beginY >= endY)
+      return mask;
+
+    mask.OffsetX = beginX;
+    mask.OffsetY = beginY;
+    mask.Width = endX - beginX;
+    mask.Height = endY - beginY;
+    mask.Inside.assign(static_cast<std::size_t>(mask.Width) * mask.Height, 0);
+
+    // sample positions within a pixel (pixel centers are at integer index coordinates)
+    const auto sampleOffset = 0.5 / samples - 0.5;
+    const auto firstSampleX = beginX + sampleOffset;
+    const auto requiredSamples = samples * samples;
+
+    std::vector<std::pair<double, int>> crossings;
+    std::vector<unsigned char> sampleRow(static_cast<std::size_t>(mask.Width) * samples);
+    std::vector<unsigned int> coverage(mask.Width);
+
+    for (int row = 0; row < mask.Height; ++row)
+    {
+      std::fill(coverage.begin(), coverage.end(), 0);
+
+      for (unsigned int sampleY = 0; sampleY < samples; ++sampleY)
+      {
+        const auto y = beginY + row + sampleOffset + static_cast<double>(sampleY) / samples;
+        std::fill(sampleRow.begin(), sampleRow.end(), 0);
+
+        RasterizeSampleRow(edges, y, fillRule, firstSampleX, samples, crossings, sampleRow);
+
+        for (std::size_t column = 0; column < sampleRow.size(); ++column)
+          coverage[column / samples] += sampleRow[column];
+      }
+
+      auto maskRow = mask.Inside.data() + static_cast<std::size_t>(row) * mask.Width;
+      for (int x = 0; x < mask.Width; ++x)
+        maskRow[x] = 1 == samples ? (0 != coverage[x]) : (2 * coverage[x] >= requiredSamples);
+    }
+
+    return mask;
+  }
+
+  template <typename TPixel>
+  void WriteFillMask(const mitk::PixelType&, mitk::Image* sliceImage, const FillMask& mask, int paintingPixelValue)
+  {
+    mitk::ImageWriteAccessor accessor(sliceImage, sliceImage->GetVolumeData(0));
+    auto buffer = static_cast<TPixel*>(accessor.GetData());
+    const auto value = static_cast<TPixel>(paintingPixelValue);
+    const auto sliceWidth = static_cast<std::size_t>(sliceImage->GetDimension(0));
+
+    for (int row = 0; row < mask.Height; ++row)
+    {
+      auto bufferRow = buffer + (static_cast<std::size_t>(mask.OffsetY) + row) * sliceWidth + mask.OffsetX;
+      auto maskRow = mask.Inside.data() + static_cast<std::size_t>(row) * mask.Width;
+
+      for (int x = 0; x < mask.Width; ++x)
+      {
+        if (0 != maskRow[x])
+          bufferRow[x] = value;
+      }
+    }
+  }
+}
+
 void mitk::ContourModelUtils::FillContourInSlice2(
   const ContourModel* projectedContour, Image* sliceImage, int paintingPixelValue)
 {
@@ -103,6 +291,12 @@ void mitk::ContourModelUtils::FillContourInSlice2(
 
 void mitk::ContourModelUtils::FillContourInSlice2(
   const ContourModel* projectedContour, TimeStepType contourTimeStep, Image* sliceImage, int paintingPixelValue)
+{
+  FillContourInSlice2(projectedContour, contourTimeStep, sliceImage, paintingPixelValue, FillRule::EvenOdd);
+}
+
+void mitk::ContourModelUtils::FillContourInSlice2(const ContourModel* projectedContour, TimeStepType contourTimeStep,
+  Image* sliceImage, int paintingPixelValue, FillRule fillRule, unsigned int subPixelSamples)
 {
   if (nullptr == projectedContour)
   {
@@ -114,41 +308,27 @@ void mitk::ContourModelUtils::FillContourInSlice2(
     mitkThrow() << "Cannot fill contour in slice. Passed slice is invalid";
   }
 
-  auto contourModelFilter = mitk::ContourModelToSurfaceFilter::New();
-  contourModelFilter->SetInput(projectedContour);
-  contourModelFilter->Update();
-
-  auto surface = mitk::Surface::New();
-  surface = contourModelFilter->GetOutput();
+  if (0 == subPixelSamples)
+  {
+    mitkThrow() << "Cannot fill contour in slice. Number of sub pixel samples must be at least 1";
+  }
 
-  if (nullptr == surface->GetVtkPolyData(contourTimeStep))
+  if (projectedContour->IsEmptyTimeStep(contourTimeStep))
   {
-    MITK_WARN << "Could not create surface from contour model.";
+    MITK_WARN << "Cannot fill contour in slice. Contour is empty at time step " << contourTimeStep;
     return;
   }
 
-  auto surface2D = vtkSmartPointer<vtkPolyData>::New();
-  surface2D->SetPoints(surface->GetVtkPolyData(contourTimeStep)->GetPoints());
-  surface2D->SetLines(surface->GetVtkPolyData(contourTimeStep)->GetLines());
+  const auto sliceWidth = static_cast<int>(sliceImage->GetDimension(0));
+  const auto sliceHeight = static_cast<int>(sliceImage->GetDimension() > 1 ? sliceImage->GetDimension(1) : 1);
 
-  auto polyDataToImageStencil = vtkSmartPointer<vtkPolyDataToImageStencil>::New();
+  const auto mask = RasterizeContour(projectedContour, contourTimeStep, sliceWidth, sliceHeight, fillRule, subPixelSamples);
 
-  // Set a minimal tolerance, so that clipped pixels will be added to contour as well.
-  polyDataToImageStencil->SetTolerance(mitk::eps);
-  polyDataToImageStencil->SetInputData(surface2D);
-  polyDataToImageStencil->Update();
-
-  auto imageStencil = vtkSmartPointer<vtkImageStencil>::New();
-
-  imageStencil->SetInputData(sliceImage->GetVtkImageData());
-  imageStencil->SetStencilConnection(polyDataToImageStencil->GetOutputPort());
-  imageStencil->ReverseStencilOn();
-  imageStencil->SetBackgroundValue(paintingPixelValue);
-  imageStencil->Update();
-
-  vtkSmartPointer<vtkImageData> filledImage = imageStencil->GetOutput();
+  if (mask.Inside.empty())
+    return;
 
-  sliceImage->SetVolume(filledImage->GetScalarPointer());
+  mitkPixelTypeMultiplex3(WriteFillMask, sliceImage->GetPixelType(), sliceImage, mask, paintingPixelValue);
+  sliceImage->Modified();
 }
 
 void mitk::ContourModelUtils::FillContourInSlice(
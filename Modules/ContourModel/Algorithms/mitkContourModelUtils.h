@@ -33,6 +33,13 @@ namespace mitk
   public:
     mitkClassMacroItkParent(ContourModelUtils, itk::Object);
 
+    /** Rule that decides which parts of a (self-intersecting) contour count as inside when filling.*/
+    enum class FillRule
+    {
+      EvenOdd, /**< A point is inside if a ray from it crosses the contour an odd number of times.*/
+      NonZero  /**< A point is inside if the winding number of the contour around it is not zero.*/
+    };
+
     /**
       \brief Projects a contour onto an image point by point. Converts from world to index coordinates.
 
@@ -97,6 +104,30 @@ namespace mitk
       Image* sliceImage,
       int paintingPixelValue = 1);
 
+    /**
+    \brief Fill a contour in a 2D slice with a specified pixel value.
+    The contour (in index coordinates of sliceImage, see ProjectContourTo2DSlice()) is rasterized
+    scanline by scanline directly into the slice buffer; only pixels within the bounding box of the
+    contour are visited. The contour is treated as closed.
+    \param projectedContour Pointer to the contour that should be filled.
+    \param contourTimeStep Time step of the contour that should be used.
+    \param sliceImage Pointer to the image which content should be altered.
+    \param paintingPixelValue Value that is written into all pixels inside the contour.
+    \param fillRule Rule that defines the inside of self-intersecting contours.
+    \param subPixelSamples Number of samples per pixel and axis. With 1 (default), a pixel is filled
+    if its center lies inside the contour or on its boundary. With n > 1, n x n samples are evaluated
+    and a pixel is filled if at least half of them are inside.
+    \pre sliceImage points to a valid instance
+    \pre projectedContour points to a valid instance
+    \pre subPixelSamples > 0
+    */
+    static void FillContourInSlice2(const ContourModel* projectedContour,
+      TimeStepType contourTimeStep,
+      Image* sliceImage,
+      int paintingPixelValue,
+      FillRule fillRule,
+      unsigned int subPixelSamples = 1);
+
     /**
     \brief Fills the paintingPixelValue into every pixel of resultImage as indicated by filledImage.
     If a LableSet image is specified it also by incorporating the rules of LabelSet images when filling the content.
@@ -0,0 +1,149 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkContourModelUtils.h"
+#include "mitkImagePixelReadAccessor.h"
+#include "mitkImagePixelWriteAccessor.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <itkMath.h>
+
+#include <algorithm>
+#include <cmath>
+
+class mitkContourModelUtilsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkContourModelUtilsTestSuite);
+  MITK_TEST(FillSquare);
+  MITK_TEST(FillClippedContour);
+  MITK_TEST(FillRules);
+  MITK_TEST(SubPixelSampling);
+  MITK_TEST(InvalidInput);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Slice;
+
+  static mitk::ContourModel::Pointer CreateContour(const std::vector<std::pair<double, double>>& points)
+  {
+    auto contour = mitk::ContourModel::New();
+    for (const auto& [x, y] : points)
+    {
+      mitk::Point3D point;
+      point[0] = x;
+      point[1] = y;
+      point[2] = 0.0;
+      contour->AddVertex(point);
+    }
+    contour->Close();
+    return contour;
+  }
+
+  unsigned int CountPixels(unsigned short value) const
+  {
+    mitk::ImagePixelReadAccessor<unsigned short, 3> accessor(m_Slice);
+    return static_cast<unsigned int>(std::count(accessor.GetData(), accessor.GetData() + 20 * 20, value));
+  }
+
+  unsigned short GetPixel(itk::IndexValueType x, itk::IndexValueType y) const
+  {
+    mitk::ImagePixelReadAccessor<unsigned short, 3> accessor(m_Slice);
+    return accessor.GetPixelByIndex({ { x, y, 0 } });
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 20, 20, 1 };
+    m_Slice = mitk::Image::New();
+    m_Slice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<unsigned short, 3> accessor(m_Slice);
+    std::fill_n(accessor.GetData(), 20 * 20, 0);
+  }
+
+  void tearDown() override
+  {
+    m_Slice = nullptr;
+  }
+
+  void FillSquare()
+  {
+    // contour through pixel centers, boundary pixels count as inside
+    auto contour = CreateContour({ { 2, 2 }, { 6, 2 }, { 6, 6 }, { 2, 6 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 3);
+
+    CPPUNIT_ASSERT_EQUAL(25u, CountPixels(3));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(3), GetPixel(2, 2));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(3), GetPixel(6, 6));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(0), GetPixel(7, 6));
+
+    // existing content outside of the contour is kept
+    contour = CreateContour({ { 10, 10 }, { 12, 10 }, { 11, 12 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 5);
+    CPPUNIT_ASSERT_EQUAL(25u, CountPixels(3));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(5), GetPixel(11, 11));
+  }
+
+  void FillClippedContour()
+  {
+    auto contour = CreateContour({ { -5, -5 }, { 4, -5 }, { 4, 30 }, { -5, 30 } });
+    mitk::ContourModelUtils::FillContourInSlice2(contour, m_Slice, 1);
+
+    CPPUNIT_ASSERT_EQUAL(5u * 20u, CountPixels(1));
+  }
+
+  void FillRules()
+  {
+    // pentagram around (10,10); its center is enclosed twice
+    std::vector<std::pair<double, double>> points;
+    for (int i = 0; i < 5; ++i)
+    {
+      const auto angle = -0.5 * itk::Math::pi + i * 0.8 * itk::Math::pi;
+      points.emplace_back(10.0 + 8.0 * std::cos(angle), 10.0 + 8.0 * std::sin(angle));
+    }
+    auto contour = CreateContour(points);
+
+    mitk::ContourModelUtils::FillContourInSlice2(contour, 0, m_Slice, 1, mitk::ContourModelUtils::FillRule::EvenOdd);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(0), GetPixel(10, 10));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), GetPixel(10, 4));
+
+    mitk::ContourModelUtils::FillContourInSlice2(contour, 0, m_Slice, 2, mitk::ContourModelUtils::FillRule::NonZero);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(2), GetPixel(10, 10));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(2), GetPixel(10, 4));
+  }
+
+  void SubPixelSampling()
+  {
+    // covers half of the pixel column x=3, but no pixel center
+    auto contour = CreateContour({ { 2.5, 2 }, { 2.99, 2 }, { 2.99, 6 }, { 2.5, 6 } });
+
+    mitk::ContourModelUtils::FillContourInSlice2(contour, 0, m_Slice, 1, mitk::ContourModelUtils::FillRule::EvenOdd, 1);
+    CPPUNIT_ASSERT_EQUAL(0u, CountPixels(1));
+
+    mitk::ContourModelUtils::FillContourInSlice2(contour, 0, m_Slice, 1, mitk::ContourModelUtils::FillRule::EvenOdd, 4);
+    CPPUNIT_ASSERT_EQUAL(3u, CountPixels(1));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), GetPixel(3, 4));
+  }
+
+  void InvalidInput()
+  {
+    auto contour = CreateContour({ { 2, 2 }, { 6, 2 }, { 6, 6 } });
+    CPPUNIT_ASSERT_THROW(mitk::ContourModelUtils::FillContourInSlice2(nullptr, m_Slice, 1), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::ContourModelUtils::FillContourInSlice2(contour, nullptr, 1), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::ContourModelUtils::FillContourInSlice2(contour, 0, m_Slice, 1, mitk::ContourModelUtils::FillRule::EvenOdd, 0), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkContourModelUtils)
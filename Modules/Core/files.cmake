@@ -37,6 +37,7 @@ set(CPP_FILES
   Algorithms/mitkVolumeCalculator.cpp
 
   Controllers/mitkBaseController.cpp
+  Controllers/mitkBatchUpdateScope.cpp
   Controllers/mitkCallbackFromGUIThread.cpp
   Controllers/mitkCameraController.cpp
   Controllers/mitkCameraRotationController.cpp
@@ -151,6 +152,7 @@ set(CPP_FILES
   DataManagement/mitkPropertyExtensions.cpp
   DataManagement/mitkPropertyFilter.cpp
   DataManagement/mitkPropertyFilters.cpp
+  DataManagement/mitkPropertyKey.cpp
   DataManagement/mitkPropertyKeyPath.cpp
   DataManagement/mitkPropertyList.cpp
   DataManagement/mitkPropertyListReplacedObserver.cpp
@@ -143,6 +143,9 @@ namespace mitk
     void SetReaderRanking(int ranking);
     int GetReaderRanking() const;
 
+    /** See AbstractFileReader::SetThreadSafe().*/
+    void SetReaderThreadSafe(bool threadSafe);
+
     void SetWriterRanking(int ranking);
     int GetWriterRanking() const;
 
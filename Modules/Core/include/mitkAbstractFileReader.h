@@ -97,6 +97,9 @@ namespace mitk
 
     void SetProperties(const PropertyList* properties) override;
 
+    /** The default is \c false, see SetThreadSafe().*/
+    bool IsThreadSafe() const override;
+
   protected:
     /**
      * @brief An input stream wrapper.
@@ -190,6 +193,11 @@ namespace mitk
     void SetDefaultOptions(const Options &defaultOptions);
     Options GetDefaultOptions() const;
 
+    /** Derived readers that were verified to read concurrently with readers of other files
+     * declare this in their constructor (see IFileReader::IsThreadSafe()). Readers that
+     * switch to other locales than "C" or touch other process-global state must not.*/
+    void SetThreadSafe(bool threadSafe);
+
     /**
      * \brief Set the service ranking for this file reader.
      *
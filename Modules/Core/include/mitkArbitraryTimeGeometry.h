@@ -18,6 +18,8 @@ found in the LICENSE file.
 #include <mitkCommon.h>
 #include <MitkCoreExports.h>
 
+#include <atomic>
+
 namespace mitk
 {
   /**
@@ -139,9 +141,20 @@ namespace mitk
     * step will be returned. This is also true for time points that are
     * exactly on the upper time bound (the only exception is the final
     * time step in case that HasCollapsedFinalTimeStep() is true).
+    * The time step is found by a binary search. The result of the last call
+    * is checked first, so sequential access (e.g. when playing through the
+    * time steps) is resolved in constant time.
     */
     TimeStepType TimePointToTimeStep(TimePointType timePoint) const override;
     /**
+    * \brief Converts a list of time points to the corresponding time steps
+    *
+    * Same results as TimePointToTimeStep(), but the time step of the previous
+    * time point is used as starting point for the next one. Thus mapping sorted
+    * time points (e.g. the time grid of a model fit) is done in linear time.
+    */
+    std::vector<TimeStepType> TimePointsToTimeSteps(const std::vector<TimePointType> &timePoints) const override;
+    /**
     * \brief Returns the geometry which corresponds to the given time step
     *
     * Returns a clone of the geometry which defines the given time step. If
@@ -246,6 +259,14 @@ namespace mitk
     std::vector<TimePointType> m_MinimumTimePoints;
     std::vector<TimePointType> m_MaximumTimePoints;
 
+  private:
+    /** Returns the time step of the time point. hint is checked first and only if it does not
+    cover the time point, the time step is searched.*/
+    TimeStepType LookUpTimeStep(TimePointType timePoint, TimeStepType hint) const;
+
+    /** Time step returned by the last call of TimePointToTimeStep(). Only used as hint
+    for the next call, therefore relaxed atomic access is sufficient.*/
+    mutable std::atomic<TimeStepType> m_TimeStepHint;
   }; // end class ArbitraryTimeGeometry
 
 } // end namespace MITK
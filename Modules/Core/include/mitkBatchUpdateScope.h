@@ -0,0 +1,69 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBatchUpdateScope_h
+#define mitkBatchUpdateScope_h
+
+#include <mitkDataStorage.h>
+#include <mitkRenderingManager.h>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /**
+   * @brief Defers and deduplicates node change notifications and rendering requests.
+   *
+   * Changing properties of many data nodes at once, e.g. the visibility or opacity of all
+   * selected nodes, triggers a ChangedNodeEvent of the data storage for each modified property
+   * and possibly a rendering request for each node. For the lifetime of a BatchUpdateScope,
+   * ChangedNodeEvent is invoked at most once per modified node and all rendering requests are
+   * combined into a single request, both as soon as the (outermost) scope ends:
+   *
+   * \code
+   * {
+   *   mitk::BatchUpdateScope batchUpdate(dataStorage);
+   *
+   *   for (auto node : selectedNodes)
+   *     node->SetOpacity(opacity);
+   *
+   *   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
+   * } // listeners and render windows are updated here
+   * \endcode
+   *
+   * Scopes can be nested. Only the ChangedNodeEvent of the data storage is deferred, the ITK
+   * modified events of the nodes and their properties are still invoked immediately.
+   *
+   * @sa DataStorage::DeferNodeModifiedEvents
+   * @sa RenderingManager::DeferRenderingRequests
+   */
+  class MITKCORE_EXPORT BatchUpdateScope
+  {
+  public:
+    /**
+     * @param dataStorage Data storage whose ChangedNodeEvent is deferred (may be nullptr).
+     * @param renderingManager Rendering manager whose rendering requests are deferred. If nullptr,
+     * the RenderingManager instance is used, if it has been instantiated.
+     */
+    explicit BatchUpdateScope(DataStorage *dataStorage, RenderingManager *renderingManager = nullptr);
+    ~BatchUpdateScope();
+
+    BatchUpdateScope(const BatchUpdateScope &) = delete;
+    BatchUpdateScope &operator=(const BatchUpdateScope &) = delete;
+
+  private:
+    DataStorage::Pointer m_DataStorage;
+    RenderingManager::Pointer m_RenderingManager;
+  };
+}
+
+#endif
@@ -105,11 +105,21 @@ namespace mitk
     */
     std::string GetFilenameWithoutExtension(const std::string &path) const;
 
+    /**
+    * \brief Checks if AppliesTo() can only be true for paths matching one of the extensions
+    *
+    * This holds for the base implementation of AppliesTo(). Child classes that peek into the
+    * file only after the extension matched should declare it via SetExtensionRequired(), so
+    * mitk::IMimeTypeProvider does not call AppliesTo() for paths with other extensions.
+    */
+    bool IsExtensionRequired() const;
+
     void SetName(const std::string &name);
     void SetCategory(const std::string &category);
     void SetExtension(const std::string &extension);
     void AddExtension(const std::string &extension);
     void SetComment(const std::string &comment);
+    void SetExtensionRequired(bool required);
 
     void Swap(CustomMimeType &r);
 
@@ -237,6 +237,34 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey.
+     *
+     * Same lookup order as the string based GetProperty(), but without comparing strings.
+     * Prefer this overload for properties that are queried frequently, e.g. by mappers.
+     *
+     * \sa PropertyKey
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
+    /**
+     * \brief Get several properties in one call.
+     *
+     * Returns the property of each key of \a propertyKeys in the same order (or \a nullptr if
+     * a property does not exist). The property lists of the \a renderer and of the data are
+     * resolved only once for all keys, which makes it the preferred way for mappers to fetch
+     * the properties of a render pass.
+     *
+     * \code
+     * static const std::vector<mitk::PropertyKey> keys = { mitk::PropertyKey("color"), mitk::PropertyKey("opacity") };
+     * auto properties = node->GetProperties(keys, renderer);
+     * auto colorProperty = dynamic_cast<mitk::ColorProperty*>(properties[0]);
+     * \endcode
+     *
+     * \sa GetProperty
+     */
+    std::vector<mitk::BaseProperty *> GetProperties(const std::vector<PropertyKey> &propertyKeys, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <map>
 #include <mutex>
+#include <set>
 
 namespace mitk
 {
@@ -384,6 +385,19 @@ namespace mitk
     //## react.
     void BlockNodeModifiedEvents(bool block);
 
+    //##Documentation
+    //## @brief Defers ChangedNodeEvent while modifying many nodes at once.
+    //##
+    //## While deferred, modified nodes are only collected. As soon as the
+    //## deferral ends, ChangedNodeEvent is invoked once per modified node
+    //## (in order of their first modification) instead of once per modified
+    //## property. Calls can be nested: each call with @a defer set to true must
+    //## be matched by a call with @a defer set to false.
+    //##
+    //## Prefer BatchUpdateScope, which also defers rendering requests.
+    //## @sa BatchUpdateScope
+    void DeferNodeModifiedEvents(bool defer);
+
   protected:
     //##Documentation
     //## @brief  EmitAddNodeEvent emits the AddNodeEvent
@@ -429,6 +443,16 @@ namespace mitk
     //## to suppress NodeChangedEvent to be emitted.
     bool m_BlockNodeModifiedEvents;
 
+    //##Documentation
+    //## @brief Number of active DeferNodeModifiedEvents() calls.
+    unsigned int m_NodeModifiedEventsDeferralCount;
+
+    //##Documentation
+    //## @brief Nodes modified while ChangedNodeEvent is deferred, in order of their first modification.
+    std::vector<const DataNode *> m_DeferredModifiedNodes;
+    std::set<const DataNode *> m_DeferredModifiedNodeSet;
+    std::mutex m_DeferredModifiedNodesMutex;
+
     DataStorage();
     ~DataStorage() override;
 
@@ -142,6 +142,18 @@ namespace mitk
      */
     virtual void SetProperties(const PropertyList* properties) = 0;
 
+    /**
+     * \brief Indicates if Read() may run concurrently with readers of other files.
+     *
+     * mitk::IOUtil::LoadConcurrently() reads the files of thread-safe readers on
+     * several threads. Readers that rely on global state (e.g. report progress to the application
+     * or read more than the passed file, see GetReadFiles()) must return \c false; their files are
+     * read one after another on the calling thread. Switching to the "C" locale (see mitk::LocaleSwitch)
+     * is allowed, it is already installed while files are read concurrently.
+     * Readers have to opt in explicitly, mitk::AbstractFileReader returns \c false by default.
+     */
+    virtual bool IsThreadSafe() const = 0;
+
   protected:
 
     /** \sa SetProperties().
@@ -76,6 +76,15 @@ namespace mitk
       virtual bool operator()(LoadInfo &loadInfo) const = 0;
     };
 
+    /**Struct that is the base class for callbacks of LoadConcurrently(). The callback is called on the calling
+    thread for each load info whose file was read (LoadInfo::m_Output is empty if reading failed), in the order
+    of the load infos and as soon as the file and all files of the preceding load infos were read.
+    */
+    struct MITKCORE_EXPORT LoadedFunctorBase
+    {
+      virtual void operator()(LoadInfo &loadInfo) = 0;
+    };
+
     struct MITKCORE_EXPORT SaveInfo
     {
       SaveInfo(const BaseData *baseData, const MimeType &mimeType, const std::string &path);
@@ -322,6 +331,7 @@ namespace mitk
      *
      * If an entry in \c paths cannot be loaded, this method will continue to load
      * the remaining entries into \c storage and throw an exception afterwards.
+     * Independent files are read concurrently (see LoadConcurrently()).
      *
      * @param paths A list of absolute file names including the file extension.
      * @param storage A DataStorage object to which the loaded data will be added.
@@ -337,6 +347,51 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of file paths into the given DataStorage, reading independent files concurrently.
+     *
+     * In contrast to Load(const std::vector<std::string>&, DataStorage&), the readers of all
+     * entries are selected first (calling \c optionsCallback on the calling thread). Afterwards
+     * the files are read on up to \c maximumNumberOfThreads threads. Files whose reader is not
+     * thread-safe (see IFileReader::IsThreadSafe()) are read one after another on the calling
+     * thread. The loaded nodes are added to \c storage in the order of \c paths.
+     * The "C" locale is installed while files are read concurrently (see mitk::LocaleSwitch).
+     *
+     * @param paths A list of absolute file names including the file extension.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param optionsCallback Pointer to a callback instance (see Load(const std::vector<std::string>&, DataStorage&)).
+     * @param maximumNumberOfThreads Upper bound of concurrently read files. Zero uses the number of hardware threads.
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception if an entry in \c paths could not be loaded.
+     */
+    static DataStorage::SetOfObjects::Pointer LoadConcurrently(const std::vector<std::string> &paths,
+                                                               DataStorage &storage,
+                                                               const ReaderOptionsFunctorBase *optionsCallback = nullptr,
+                                                               unsigned int maximumNumberOfThreads = 0);
+
+    static std::vector<BaseData::Pointer> LoadConcurrently(const std::vector<std::string> &paths,
+                                                           const ReaderOptionsFunctorBase *optionsCallback = nullptr,
+                                                           unsigned int maximumNumberOfThreads = 0);
+
+    /**
+     * @brief Loads the given load infos, reading independent files concurrently.
+     *
+     * In contrast to the other overloads, read-only meta data can be passed per file
+     * (LoadInfo::m_Properties) and a failing entry does not throw. The loaded data of each entry
+     * is stored in its LoadInfo::m_Output, which stays empty if the entry could not be loaded.
+     *
+     * @param loadInfos The load infos of absolute file names including the file extension.
+     * @param optionsCallback Pointer to a callback instance (see Load(const std::vector<std::string>&, DataStorage&)).
+     * @param maximumNumberOfThreads Upper bound of concurrently read files. Zero uses the number of hardware threads.
+     * @param loadedCallback Optional callback that is called for each entry as soon as it and all preceding
+     * entries were read, while the remaining files are still read (see LoadedFunctorBase).
+     * @return The error messages of all failed entries or an empty string if all entries were loaded.
+     */
+    static std::string LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                        const ReaderOptionsFunctorBase *optionsCallback = nullptr,
+                                        unsigned int maximumNumberOfThreads = 0,
+                                        LoadedFunctorBase *loadedCallback = nullptr);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -439,7 +494,9 @@ namespace mitk
     static std::string Load(std::vector<LoadInfo> &loadInfos,
                             DataStorage::SetOfObjects *nodeResult,
                             DataStorage *ds,
-                            const ReaderOptionsFunctorBase *optionsCallback);
+                            const ReaderOptionsFunctorBase *optionsCallback,
+                            unsigned int numberOfReadingThreads = 1,
+                            LoadedFunctorBase *loadedCallback = nullptr);
 
     static std::string Save(const BaseData *data,
                             const std::string &mimeType,
@@ -145,6 +145,19 @@ namespace mitk
       */
     bool IsChannelSet(int n = 0) const override;
 
+    /**
+      * @brief Releases the pixel data of all channels, volumes and slices.
+      *
+      * The image stays initialized with its geometry, pixel type and dimensions and afterwards
+      * behaves like a freshly initialized image: the next data access allocates a new, uninitialized
+      * buffer. Modified() is not called, it is the responsibility of the caller to restore or to
+      * not depend on the content.
+      * The data is not released if image accessors (including the vtkImageData of a volume,
+      * see GetVtkImageData()) are in use. The image must not be accessed concurrently meanwhile.
+      * @return \c true if the data was released.
+      */
+    bool ReleasePixelData();
+
     /**
       * @brief Set @a data as slice @a s at time @a t in channel @a n. It is in
       * the responsibility of the caller to ensure that the data vector @a data
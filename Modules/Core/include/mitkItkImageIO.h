@@ -57,8 +57,10 @@ namespace mitk
     static PropertyList::Pointer ExtractMetaDataAsPropertyList(const itk::MetaDataDictionary& dictionary, const std::string& mimeTypeName, const std::vector<std::string>& defaultMetaDataKeys);
 
     /** Helper function that can be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
-    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
-    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path);
+    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...
+    If loadPixelData is false, only the header is read and the returned image has no pixel data allocated.
+    It can be used as a template to initialize images whose content is read by other means.*/
+    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, bool loadPixelData = true);
 
     /** Helper function that can be used to prepare a mitk image being written to file using the also passed ImageIOBase instance.*/
     static void PreparImageIOToWriteImage(itk::ImageIOBase* imageIO, const Image* image);
@@ -0,0 +1,243 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkItkImageView_h
+#define mitkItkImageView_h
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageToItk.h>
+#include <mitkPixelTypeList.h>
+
+#include <sstream>
+#include <type_traits>
+
+namespace mitk
+{
+  /**
+   * @brief Checks if a MITK image can be viewed as an ITK image of the given pixel type and dimension.
+   *
+   * In contrast to CastToItkImage(), views (see ItkImageReadView and ItkImageWriteView) never convert
+   * pixel values and therefore require an exact match.
+   */
+  template <typename TPixel, unsigned int VDimension>
+  bool CanViewAsItkImage(const Image* image)
+  {
+    if (nullptr == image || image->GetDimension() != VDimension)
+      return false;
+
+    const auto& pixelType = image->GetPixelType();
+    return pixelType == MakePixelType<TPixel, VDimension>(pixelType.GetNumberOfComponents());
+  }
+
+  /**
+   * @brief Zero-copy, read-only ITK image view of a MITK image.
+   *
+   * The ITK image references the memory of the MITK image, which is locked for read access
+   * (see ImageReadAccessor) as long as the ITK image exists. Pixel values are never copied
+   * or converted, use CastToItkImage() if a conversion is needed.
+   *
+   * @throws mitk::Exception if the pixel type or dimension does not match the MITK image
+   * (see CanViewAsItkImage()).
+   *
+   * @sa ItkImageWriteView
+   * @sa AccessByItkReadView
+   *
+   * @ingroup Adaptor
+   */
+  template <typename TPixel, unsigned int VDimension>
+  class ItkImageReadView
+  {
+  public:
+    using ItkImageType = typename ImageTypeTrait<TPixel, VDimension>::ImageType;
+
+    explicit ItkImageReadView(const Image* image)
+    {
+      if (!CanViewAsItkImage<TPixel, VDimension>(image))
+        mitkThrow() << "Image cannot be viewed as ITK image of pixel type " << MakePixelType<TPixel, VDimension>(1).GetPixelTypeAsString()
+                    << " and dimension " << VDimension << ".";
+
+      auto imageToItk = ImageToItk<ItkImageType>::New();
+      imageToItk->SetInput(image);
+      imageToItk->SetCopyMemFlag(false);
+      imageToItk->Update();
+
+      // the pixel container holds the accessor, the filter is not needed anymore
+      typename ItkImageType::Pointer itkImage = imageToItk->GetOutput();
+      itkImage->DisconnectPipeline();
+      m_ItkImage = itkImage;
+    }
+
+    ItkImageReadView(const ItkImageReadView&) = delete;
+    ItkImageReadView& operator=(const ItkImageReadView&) = delete;
+
+    const ItkImageType* GetItkImage() const
+    {
+      return m_ItkImage;
+    }
+
+    const ItkImageType* operator->() const
+    {
+      return m_ItkImage;
+    }
+
+  private:
+    typename ItkImageType::ConstPointer m_ItkImage;
+  };
+
+  /**
+   * @brief Zero-copy ITK image view of a MITK image with read and write access.
+   *
+   * The ITK image references the memory of the MITK image, which is locked for write access
+   * (see ImageWriteAccessor) as long as the ITK image exists.
+   *
+   * @throws mitk::Exception if the pixel type or dimension does not match the MITK image
+   * (see CanViewAsItkImage()).
+   *
+   * @sa ItkImageReadView
+   * @sa AccessByItkWriteView
+   *
+   * @ingroup Adaptor
+   */
+  template <typename TPixel, unsigned int VDimension>
+  class ItkImageWriteView
+  {
+  public:
+    using ItkImageType = typename ImageTypeTrait<TPixel, VDimension>::ImageType;
+
+    explicit ItkImageWriteView(Image* image)
+    {
+      if (!CanViewAsItkImage<TPixel, VDimension>(image))
+        mitkThrow() << "Image cannot be viewed as ITK image of pixel type " << MakePixelType<TPixel, VDimension>(1).GetPixelTypeAsString()
+                    << " and dimension " << VDimension << ".";
+
+      auto imageToItk = ImageToItk<ItkImageType>::New();
+      imageToItk->SetInput(image);
+      imageToItk->SetCopyMemFlag(false);
+      imageToItk->Update();
+
+      m_ItkImage = imageToItk->GetOutput();
+      m_ItkImage->DisconnectPipeline();
+    }
+
+    ItkImageWriteView(const ItkImageWriteView&) = delete;
+    ItkImageWriteView& operator=(const ItkImageWriteView&) = delete;
+
+    ItkImageType* GetItkImage() const
+    {
+      return m_ItkImage;
+    }
+
+    ItkImageType* operator->() const
+    {
+      return m_ItkImage;
+    }
+
+  private:
+    typename ItkImageType::Pointer m_ItkImage;
+  };
+
+  namespace Impl
+  {
+    template <typename TPixelTypeList, unsigned int VDimension>
+    struct ItkImageViewDispatcher
+    {
+      template <typename TImage, typename TFunction>
+      static bool Dispatch(TImage* image, TFunction& function)
+      {
+        using PixelType = typename TPixelTypeList::head;
+
+        if (CanViewAsItkImage<PixelType, VDimension>(image))
+        {
+          if constexpr (std::is_const_v<TImage>)
+          {
+            ItkImageReadView<PixelType, VDimension> view(image);
+            function(view.GetItkImage());
+          }
+          else
+          {
+            ItkImageWriteView<PixelType, VDimension> view(image);
+            function(view.GetItkImage());
+          }
+
+          return true;
+        }
+
+        return ItkImageViewDispatcher<typename TPixelTypeList::tail, VDimension>::Dispatch(image, function);
+      }
+    };
+
+    template <unsigned int VDimension>
+    struct ItkImageViewDispatcher<PixelTypeList<>, VDimension>
+    {
+      template <typename TImage, typename TFunction>
+      static bool Dispatch(TImage*, TFunction&)
+      {
+        return false;
+      }
+    };
+
+    template <typename TPixelTypeList, unsigned int... VDimensions, typename TImage, typename TFunction>
+    void AccessByItkView(TImage* image, TFunction& function)
+    {
+      if (nullptr == image)
+        mitkThrow() << "Cannot access a null image by ITK.";
+
+      if (!(ItkImageViewDispatcher<TPixelTypeList, VDimensions>::Dispatch(image, function) || ...))
+      {
+        std::ostringstream message;
+        message << "Pixel type " << image->GetPixelType().GetPixelTypeAsString() << " with dimension "
+                << image->GetDimension() << " is not supported at this call site.";
+        throw AccessByItkException(message.str());
+      }
+    }
+  }
+
+  /**
+   * @brief Calls a generic function with a zero-copy, read-only ITK view of a MITK image.
+   *
+   * In contrast to the AccessByItk macros, the function is only instantiated for the pixel types and
+   * dimensions given at the call site, so call sites that know the possible pixel types (e.g. of masks)
+   * do not pay for the full MITK_ACCESSBYITK pixel type list in code size and compile time.
+   *
+   * \code
+   * mitk::AccessByItkReadView<mitk::PixelTypeList<unsigned char, unsigned short>, 2, 3>(mask, [&](auto itkMask) {
+   *   // itkMask is a const itk::Image<TPixel, VDimension>*
+   * });
+   * \endcode
+   *
+   * @tparam TPixelTypeList mitk::PixelTypeList of the supported pixel types
+   * @tparam VDimensions The supported image dimensions
+   * @throws mitk::AccessByItkException if the pixel type or dimension of the image is not supported.
+   *
+   * @ingroup Adaptor
+   */
+  template <typename TPixelTypeList, unsigned int... VDimensions, typename TFunction>
+  void AccessByItkReadView(const Image* image, TFunction&& function)
+  {
+    Impl::AccessByItkView<TPixelTypeList, VDimensions...>(image, function);
+  }
+
+  /**
+   * @brief Calls a generic function with a zero-copy ITK view of a MITK image with write access.
+   *
+   * @sa AccessByItkReadView
+   * @ingroup Adaptor
+   */
+  template <typename TPixelTypeList, unsigned int... VDimensions, typename TFunction>
+  void AccessByItkWriteView(Image* image, TFunction&& function)
+  {
+    Impl::AccessByItkView<TPixelTypeList, VDimensions...>(image, function);
+  }
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <string>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /** @brief Interned property key.
+   *
+   * The name of a property key is mapped once to a process-wide unique integer ID. PropertyList and
+   * DataNode use this ID to look up properties without hashing or comparing strings, which matters
+   * for code that queries the same properties over and over again, like mappers in every render pass.
+   * Therefore, construct such keys only once, e.g. as function-local static constants:
+   * \code
+   * static const mitk::PropertyKey opacityKey("opacity");
+   * auto opacityProperty = dynamic_cast<mitk::FloatProperty*>(node->GetProperty(opacityKey, renderer));
+   * \endcode
+   *
+   * Interning is thread-safe. IDs are only valid during the lifetime of the process and must not be persisted.
+   */
+  class MITKCORE_EXPORT PropertyKey final
+  {
+  public:
+    using IdType = unsigned int;
+
+    /** @pre name must not be empty.
+     * @throw mitk::Exception if name is empty.*/
+    explicit PropertyKey(const std::string &name);
+    explicit PropertyKey(const char *name);
+
+    IdType GetId() const { return m_Id; }
+    const std::string &GetName() const { return *m_Name; }
+
+    bool operator==(const PropertyKey &right) const { return m_Id == right.m_Id; }
+    bool operator!=(const PropertyKey &right) const { return m_Id != right.m_Id; }
+    bool operator<(const PropertyKey &right) const { return m_Id < right.m_Id; }
+
+  private:
+    IdType m_Id;
+    const std::string *m_Name;
+  };
+} // namespace mitk
+
+#endif
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <mitkIPropertyOwner.h>
 #include <mitkGenericProperty.h>
+#include <mitkPropertyKey.h>
 
 #include <nlohmann/json_fwd.hpp>
 
@@ -86,6 +87,16 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * In contrast to the string based lookup, no strings are compared.
+     * Prefer this overload for properties that are queried frequently.
+     *
+     * @sa PropertyKey
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -256,11 +267,24 @@ namespace mitk
 
     /**
      * @brief Map of properties.
+     *
+     * Only modify it by the methods of PropertyList, as they keep the index of interned keys in sync.
      */
     PropertyMap m_Properties;
 
   private:
     itk::LightObject::Pointer InternalClone() const override;
+
+    void AddToIndex(const std::string &propertyKey, BaseProperty *property);
+    void RemoveFromIndex(const std::string &propertyKey);
+    void RebuildIndex();
+
+    /**
+     * @brief Properties of m_Properties sorted by the IDs of their interned keys.
+     *
+     * Must be kept in sync with m_Properties, which owns the properties.
+     */
+    std::vector<std::pair<PropertyKey::IdType, BaseProperty *>> m_PropertyIndex;
   };
 
 } // namespace mitk
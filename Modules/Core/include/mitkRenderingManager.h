@@ -135,6 +135,15 @@ namespace mitk
      * via the parameter requestType. */
     void ForceImmediateUpdateAll(RequestType type = REQUEST_UPDATE_ALL);
 
+    /** Defers rendering requests while modifying many objects at once.
+     * While deferred, requested updates are only recorded and immediate
+     * updates are turned into requests. As soon as the deferral ends, a
+     * single rendering request is generated for all recorded updates.
+     * Calls can be nested: each call with defer set to true must be matched
+     * by a call with defer set to false.
+     * \sa BatchUpdateScope */
+    void DeferRenderingRequests(bool defer);
+
     /**
     * @brief Initialize the render windows by the aggregated geometry of all objects that are held in
     *        the data storage.
@@ -383,6 +392,8 @@ namespace mitk
 
     bool m_UpdatePending;
 
+    unsigned int m_RenderingRequestsDeferralCount;
+
     typedef std::map<BaseRenderer *, unsigned int> RendererIntMap;
     typedef std::map<BaseRenderer *, bool> RendererBoolMap;
 
@@ -147,6 +147,15 @@ namespace mitk
     * time step will be returned.
     */
     virtual TimeStepType TimePointToTimeStep(TimePointType timePoint) const = 0;
+    /**
+    * \brief Converts a list of time points to the corresponding time steps
+    *
+    * Same as calling TimePointToTimeStep() for every time point, but allows
+    * implementations to exploit the order of the time points (e.g. when mapping
+    * the time grid of a model fit or of a plot). The default implementation
+    * simply calls TimePointToTimeStep().
+    */
+    virtual std::vector<TimeStepType> TimePointsToTimeSteps(const std::vector<TimePointType> &timePoints) const;
 
     /**
     * \brief Returns the geometry of a specific time point
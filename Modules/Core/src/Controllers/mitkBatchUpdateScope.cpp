@@ -0,0 +1,37 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkBatchUpdateScope.h>
+
+mitk::BatchUpdateScope::BatchUpdateScope(DataStorage *dataStorage, RenderingManager *renderingManager)
+  : m_DataStorage(dataStorage),
+    m_RenderingManager(renderingManager)
+{
+  if (m_RenderingManager.IsNull() && RenderingManager::IsInstantiated())
+    m_RenderingManager = RenderingManager::GetInstance();
+
+  if (m_DataStorage.IsNotNull())
+    m_DataStorage->DeferNodeModifiedEvents(true);
+
+  if (m_RenderingManager.IsNotNull())
+    m_RenderingManager->DeferRenderingRequests(true);
+}
+
+mitk::BatchUpdateScope::~BatchUpdateScope()
+{
+  // notify listeners first, as they may request further rendering updates
+  if (m_DataStorage.IsNotNull())
+    m_DataStorage->DeferNodeModifiedEvents(false);
+
+  if (m_RenderingManager.IsNotNull())
+    m_RenderingManager->DeferRenderingRequests(false);
+}
@@ -38,6 +38,7 @@ namespace mitk
 
   RenderingManager::RenderingManager()
     : m_UpdatePending(false),
+      m_RenderingRequestsDeferralCount(0),
       m_MaxLOD(1),
       m_LODIncreaseBlocked(false),
       m_LODAbortMechanismEnabled(false),
@@ -204,7 +205,7 @@ namespace mitk
 
     m_RenderWindowList[renderWindow] = RENDERING_REQUESTED;
 
-    if (!m_UpdatePending)
+    if (!m_UpdatePending && 0 == m_RenderingRequestsDeferralCount)
     {
       m_UpdatePending = true;
       this->GenerateRenderingRequestEvent();
@@ -225,6 +226,12 @@ namespace mitk
       return;
     }
 
+    if (0 != m_RenderingRequestsDeferralCount)
+    {
+      this->RequestUpdate(renderWindow);
+      return;
+    }
+
     // Erase potentially pending requests for this window
     m_RenderWindowList[renderWindow] = RENDERING_INACTIVE;
 
@@ -276,6 +283,36 @@ namespace mitk
     }
   }
 
+  void RenderingManager::DeferRenderingRequests(bool defer)
+  {
+    if (defer)
+    {
+      ++m_RenderingRequestsDeferralCount;
+      return;
+    }
+
+    if (0 == m_RenderingRequestsDeferralCount)
+    {
+      MITK_WARN << "DeferRenderingRequests(false) was called without a matching DeferRenderingRequests(true).";
+      return;
+    }
+
+    if (0 != --m_RenderingRequestsDeferralCount || m_UpdatePending)
+    {
+      return;
+    }
+
+    for (const auto& renderWindow : m_RenderWindowList)
+    {
+      if (RENDERING_REQUESTED == renderWindow.second)
+      {
+        m_UpdatePending = true;
+        this->GenerateRenderingRequestEvent();
+        return;
+      }
+    }
+  }
+
   void RenderingManager::InitializeViewsByBoundingObjects(const DataStorage* dataStorage)
   {
     if (nullptr == dataStorage)
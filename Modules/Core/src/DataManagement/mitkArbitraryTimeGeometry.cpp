@@ -16,7 +16,10 @@ found in the LICENSE file.
 
 #include <mitkGeometry3D.h>
 
-mitk::ArbitraryTimeGeometry::ArbitraryTimeGeometry() = default;
+mitk::ArbitraryTimeGeometry::ArbitraryTimeGeometry()
+  : m_TimeStepHint(0)
+{
+}
 
 mitk::ArbitraryTimeGeometry::~ArbitraryTimeGeometry() = default;
 
@@ -129,29 +132,58 @@ mitk::TimePointType mitk::ArbitraryTimeGeometry::TimeStepToTimePoint( TimeStepTy
 
 mitk::TimeStepType mitk::ArbitraryTimeGeometry::TimePointToTimeStep(TimePointType timePoint) const
 {
-  mitk::TimeStepType result = 0;
+  const auto result = this->LookUpTimeStep(timePoint, m_TimeStepHint.load(std::memory_order_relaxed));
+  m_TimeStepHint.store(result, std::memory_order_relaxed);
+  return result;
+}
+
+std::vector<mitk::TimeStepType> mitk::ArbitraryTimeGeometry::TimePointsToTimeSteps(const std::vector<TimePointType> &timePoints) const
+{
+  std::vector<TimeStepType> result;
+  result.reserve(timePoints.size());
+
+  TimeStepType hint = 0;
+  for (const auto timePoint : timePoints)
+  {
+    hint = this->LookUpTimeStep(timePoint, hint);
+    result.push_back(hint);
+  }
+
+  return result;
+}
+
+mitk::TimeStepType mitk::ArbitraryTimeGeometry::LookUpTimeStep(TimePointType timePoint, TimeStepType hint) const
+{
+  if (m_MaximumTimePoints.empty() || !(timePoint >= this->GetMinimumTimePoint()))
+  {
+    return 0;
+  }
+
+  const auto count = static_cast<TimeStepType>(m_MaximumTimePoints.size());
 
-  if (timePoint >= GetMinimumTimePoint())
+  // The associated time step is the first step whose upper bound is larger than the
+  // time point. Check the hint and its successor first to serve sequential access.
+  for (auto step = hint; step < count && step <= hint + 1; ++step)
   {
-    for (auto pos = m_MaximumTimePoints.cbegin(); pos != m_MaximumTimePoints.cend(); ++pos)
+    if (timePoint < m_MaximumTimePoints[step] && (step == 0 || m_MaximumTimePoints[step - 1] <= timePoint))
     {
-      ///////////////////////////////////////
-      // Workaround T27883. See https://phabricator.mitk.org/T27883#219473 for more details.
-      // The part ("+1.") inline marked as workaround should be removed as soon as T28262 is solved!
-      if (timePoint < *pos
-          || (pos == std::prev(m_MaximumTimePoints.cend())
-              && timePoint <= *pos +1//<- +1 is the workaround
-              && this->HasCollapsedFinalTimeStep()))
-      {
-        break;
-      }
-      // End of workaround for T27883
-      //////////////////////////////////////
-
-      ++result;
+      return step;
     }
   }
 
+  auto result = static_cast<TimeStepType>(
+    std::upper_bound(m_MaximumTimePoints.begin(), m_MaximumTimePoints.end(), timePoint) - m_MaximumTimePoints.begin());
+
+  ///////////////////////////////////////
+  // Workaround T27883. See https://phabricator.mitk.org/T27883#219473 for more details.
+  // This workaround should be removed as soon as T28262 is solved!
+  if (result == count && timePoint <= m_MaximumTimePoints.back() + 1 && this->HasCollapsedFinalTimeStep())
+  {
+    result = count - 1;
+  }
+  // End of workaround for T27883
+  //////////////////////////////////////
+
   return result;
 }
 
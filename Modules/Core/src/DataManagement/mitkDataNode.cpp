@@ -247,6 +247,68 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer)
+  {
+    auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+    if (m_MapOfPropertyLists.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
+std::vector<mitk::BaseProperty *> mitk::DataNode::GetProperties(const std::vector<PropertyKey> &propertyKeys, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  const PropertyList *rendererPropertyList = nullptr;
+
+  if (nullptr != renderer)
+  {
+    auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+    if (m_MapOfPropertyLists.end() != it)
+      rendererPropertyList = it->second;
+  }
+
+  PropertyList::Pointer dataPropertyList;
+
+  if (fallBackOnDataProperties && m_Data.IsNotNull())
+    dataPropertyList = m_Data->GetPropertyList();
+
+  std::vector<BaseProperty *> properties;
+  properties.reserve(propertyKeys.size());
+
+  for (const auto &propertyKey : propertyKeys)
+  {
+    BaseProperty *property = nullptr;
+
+    if (nullptr != rendererPropertyList)
+      property = rendererPropertyList->GetProperty(propertyKey);
+
+    if (nullptr == property)
+      property = m_PropertyList->GetProperty(propertyKey);
+
+    if (nullptr == property && dataPropertyList.IsNotNull())
+      property = dataPropertyList->GetProperty(propertyKey);
+
+    properties.push_back(property);
+  }
+
+  return properties;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
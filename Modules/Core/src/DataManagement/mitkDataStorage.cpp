@@ -22,10 +22,11 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
 
+#include <algorithm>
 #include <regex>
 #include <set>
 
-mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
+mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false), m_NodeModifiedEventsDeferralCount(0)
 {
 }
 
@@ -262,6 +263,26 @@ void mitk::DataStorage::OnNodeModifiedOrDeleted(const itk::Object *caller, const
   if (_Node)
   {
     const auto *modEvent = dynamic_cast<const itk::ModifiedEvent *>(&event);
+
+    {
+      std::lock_guard<std::mutex> lock(m_DeferredModifiedNodesMutex);
+
+      if (m_NodeModifiedEventsDeferralCount > 0)
+      {
+        if (modEvent)
+        {
+          if (m_DeferredModifiedNodeSet.insert(_Node).second)
+            m_DeferredModifiedNodes.push_back(_Node);
+
+          return;
+        }
+
+        // a deleted node must not be reported as modified later on
+        if (m_DeferredModifiedNodeSet.erase(_Node) > 0)
+          m_DeferredModifiedNodes.erase(std::find(m_DeferredModifiedNodes.begin(), m_DeferredModifiedNodes.end(), _Node));
+      }
+    }
+
     if (modEvent)
       ChangedNodeEvent.Send(_Node);
     else
@@ -571,6 +592,40 @@ void mitk::DataStorage::BlockNodeModifiedEvents(bool block)
   m_BlockNodeModifiedEvents = block;
 }
 
+void mitk::DataStorage::DeferNodeModifiedEvents(bool defer)
+{
+  std::vector<const DataNode *> modifiedNodes;
+
+  {
+    std::lock_guard<std::mutex> lock(m_DeferredModifiedNodesMutex);
+
+    if (defer)
+    {
+      ++m_NodeModifiedEventsDeferralCount;
+      return;
+    }
+
+    if (0 == m_NodeModifiedEventsDeferralCount)
+    {
+      MITK_WARN << "DeferNodeModifiedEvents(false) was called without a matching DeferNodeModifiedEvents(true).";
+      return;
+    }
+
+    if (0 != --m_NodeModifiedEventsDeferralCount)
+      return;
+
+    modifiedNodes.swap(m_DeferredModifiedNodes);
+    m_DeferredModifiedNodeSet.clear();
+  }
+
+  for (const auto *node : modifiedNodes)
+  {
+    // skip nodes that have been removed from the storage in the meantime
+    if (m_NodeModifiedObserverTags.find(node) != m_NodeModifiedObserverTags.end())
+      ChangedNodeEvent.Send(node);
+  }
+}
+
 mitk::DataNode::Pointer mitk::FindTopmostVisibleNode(const DataStorage::SetOfObjects::ConstPointer nodes,
                                                      const Point3D worldPosition,
                                                      const TimePointType timePoint,
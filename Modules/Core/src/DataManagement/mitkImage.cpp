@@ -547,6 +547,28 @@ bool mitk::Image::IsChannelSet(int n) const
   return IsChannelSet_unlocked(n);
 }
 
+bool mitk::Image::ReleasePixelData()
+{
+  // accessors cannot be created meanwhile, they register under these locks
+  std::lock_guard<std::mutex> readWriteLock(m_ReadWriteLock);
+  std::lock_guard<std::mutex> vtkReadersLock(m_VtkReadersLock);
+
+  if (!m_Readers.empty() || !m_Writers.empty() || !m_VtkReaders.empty())
+    return false;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  for (auto &slice : m_Slices)
+    slice = nullptr;
+  for (auto &volume : m_Volumes)
+    volume = nullptr;
+  for (auto &channel : m_Channels)
+    channel = nullptr;
+  m_CompleteData = nullptr;
+
+  return true;
+}
+
 bool mitk::Image::IsChannelSet_unlocked(int n) const
 {
   if (IsValidChannel(n) == false)
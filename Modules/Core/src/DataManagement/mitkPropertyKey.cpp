@@ -0,0 +1,67 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKey.h>
+
+#include <mitkExceptionMacro.h>
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+  class PropertyKeyRegistry
+  {
+  public:
+    static PropertyKeyRegistry &GetInstance()
+    {
+      static PropertyKeyRegistry instance;
+      return instance;
+    }
+
+    // Keys of an unordered_map are not moved on rehashing, so the returned name stays valid.
+    const std::pair<const std::string, mitk::PropertyKey::IdType> &Intern(const std::string &name)
+    {
+      {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        auto iter = m_Ids.find(name);
+
+        if (m_Ids.end() != iter)
+          return *iter;
+      }
+
+      std::unique_lock<std::shared_mutex> lock(m_Mutex);
+      const auto id = static_cast<mitk::PropertyKey::IdType>(m_Ids.size());
+      return *m_Ids.try_emplace(name, id).first;
+    }
+
+  private:
+    std::shared_mutex m_Mutex;
+    std::unordered_map<std::string, mitk::PropertyKey::IdType> m_Ids;
+  };
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &name)
+{
+  if (name.empty())
+    mitkThrow() << "Property key is empty.";
+
+  const auto &entry = PropertyKeyRegistry::GetInstance().Intern(name);
+  m_Id = entry.second;
+  m_Name = &entry.first;
+}
+
+mitk::PropertyKey::PropertyKey(const char *name)
+  : PropertyKey(std::string(nullptr != name ? name : ""))
+{
+}
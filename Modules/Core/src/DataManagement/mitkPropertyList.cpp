@@ -16,6 +16,18 @@ found in the LICENSE file.
 #include <mitkProperties.h>
 #include <mitkStringProperty.h>
 
+#include <algorithm>
+
+namespace
+{
+  using PropertyIndexEntry = std::pair<mitk::PropertyKey::IdType, mitk::BaseProperty *>;
+
+  bool CompareIds(const PropertyIndexEntry &entry, mitk::PropertyKey::IdType id)
+  {
+    return entry.first < id;
+  }
+}
+
 mitk::BaseProperty::ConstPointer mitk::PropertyList::GetConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/) const
 {
   PropertyMap::const_iterator it;
@@ -56,6 +68,16 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  auto it = std::lower_bound(m_PropertyIndex.cbegin(), m_PropertyIndex.cend(), propertyKey.GetId(), CompareIds);
+
+  if (it != m_PropertyIndex.cend() && it->first == propertyKey.GetId())
+    return it->second;
+  else
+    return nullptr;
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +126,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->AddToIndex(propertyKey, property);
   this->Modified();
 }
 
@@ -123,6 +146,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->AddToIndex(propertyKey, property);
   Modified();
 }
 
@@ -135,6 +159,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->RemoveFromIndex(propertyKey);
     Modified();
   }
 }
@@ -149,6 +174,8 @@ mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(
   {
     m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
   }
+
+  this->RebuildIndex();
 }
 
 mitk::PropertyList::~PropertyList()
@@ -186,6 +213,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->RemoveFromIndex(propertyKey);
     Modified();
     return true;
   }
@@ -201,6 +229,7 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  m_PropertyIndex.clear();
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -419,4 +448,46 @@ void mitk::PropertyList::FromJSON(const nlohmann::json& j)
   }
 
   m_Properties = properties;
+  this->RebuildIndex();
+}
+
+void mitk::PropertyList::AddToIndex(const std::string &propertyKey, BaseProperty *property)
+{
+  // ReplaceProperty() does not reject empty keys, but they cannot be interned
+  if (propertyKey.empty())
+    return;
+
+  const auto id = PropertyKey(propertyKey).GetId();
+  auto it = std::lower_bound(m_PropertyIndex.begin(), m_PropertyIndex.end(), id, CompareIds);
+
+  if (it != m_PropertyIndex.end() && it->first == id)
+    it->second = property;
+  else
+    m_PropertyIndex.insert(it, std::make_pair(id, property));
+}
+
+void mitk::PropertyList::RemoveFromIndex(const std::string &propertyKey)
+{
+  if (propertyKey.empty())
+    return;
+
+  const auto id = PropertyKey(propertyKey).GetId();
+  auto it = std::lower_bound(m_PropertyIndex.begin(), m_PropertyIndex.end(), id, CompareIds);
+
+  if (it != m_PropertyIndex.end() && it->first == id)
+    m_PropertyIndex.erase(it);
+}
+
+void mitk::PropertyList::RebuildIndex()
+{
+  m_PropertyIndex.clear();
+  m_PropertyIndex.reserve(m_Properties.size());
+
+  for (const auto &[name, property] : m_Properties)
+  {
+    if (!name.empty())
+      m_PropertyIndex.emplace_back(PropertyKey(name).GetId(), property.GetPointer());
+  }
+
+  std::sort(m_PropertyIndex.begin(), m_PropertyIndex.end());
 }
@@ -112,6 +112,19 @@ bool mitk::TimeGeometry::IsWorldPointInside(const mitk::Point3D &p) const
   return m_BoundingBox->IsInside(p);
 }
 
+std::vector<mitk::TimeStepType> mitk::TimeGeometry::TimePointsToTimeSteps(const std::vector<TimePointType> &timePoints) const
+{
+  std::vector<TimeStepType> result;
+  result.reserve(timePoints.size());
+
+  for (const auto timePoint : timePoints)
+  {
+    result.push_back(this->TimePointToTimeStep(timePoint));
+  }
+
+  return result;
+}
+
 void mitk::TimeGeometry::UpdateBoundingBox()
 {
   assert(m_BoundingBox.IsNotNull());
@@ -132,6 +132,7 @@ namespace mitk
 
   void AbstractFileIO::SetReaderRanking(int ranking) { this->AbstractFileReader::SetRanking(ranking); }
   int AbstractFileIO::GetReaderRanking() const { return this->AbstractFileReader::GetRanking(); }
+  void AbstractFileIO::SetReaderThreadSafe(bool threadSafe) { this->AbstractFileReader::SetThreadSafe(threadSafe); }
   void AbstractFileIO::SetWriterRanking(int ranking) { this->AbstractFileWriter::SetRanking(ranking); }
   int AbstractFileIO::GetWriterRanking() const { return this->AbstractFileWriter::GetRanking(); }
   IFileReader *AbstractFileIO::ReaderClone() const { return this->IOClone(); }
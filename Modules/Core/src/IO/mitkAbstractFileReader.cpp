@@ -49,8 +49,11 @@ namespace mitk
   class AbstractFileReader::Impl : public FileReaderWriterBase
   {
   public:
-    Impl() : FileReaderWriterBase(), m_Stream(nullptr), m_PrototypeFactory(nullptr) {}
-    Impl(const Impl &other) : FileReaderWriterBase(other), m_Stream(nullptr), m_PrototypeFactory(nullptr) {}
+    Impl() : FileReaderWriterBase(), m_Stream(nullptr), m_PrototypeFactory(nullptr), m_ThreadSafe(false) {}
+    Impl(const Impl &other)
+      : FileReaderWriterBase(other), m_Stream(nullptr), m_PrototypeFactory(nullptr), m_ThreadSafe(other.m_ThreadSafe)
+    {
+    }
     std::string m_Location;
     std::string m_TmpFile;
     std::istream *m_Stream;
@@ -59,6 +62,8 @@ namespace mitk
     us::ServiceRegistration<IFileReader> m_Reg;
 
     const PropertyList* m_Properties;
+
+    bool m_ThreadSafe;
   };
 
   AbstractFileReader::AbstractFileReader() : d(new Impl) {}
@@ -300,6 +305,16 @@ namespace mitk
     return d->m_Properties;
   }
 
+  bool AbstractFileReader::IsThreadSafe() const
+  {
+    return d->m_ThreadSafe;
+  }
+
+  void AbstractFileReader::SetThreadSafe(bool threadSafe)
+  {
+    d->m_ThreadSafe = threadSafe;
+  }
+
   ////////////////// µS related Getters //////////////////
 
   const CustomMimeType *AbstractFileReader::GetMimeType() const { return d->GetMimeType(); }
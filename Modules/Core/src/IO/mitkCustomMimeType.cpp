@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkUtf8Util.h>
 
 #include <algorithm>
+#include <typeinfo>
 
 #include <itksys/SystemTools.hxx>
 
@@ -47,6 +48,7 @@ namespace mitk
     std::string m_Category;
     std::vector<std::string> m_Extensions;
     std::string m_Comment;
+    bool m_ExtensionRequired = false;
   };
 
   CustomMimeType::~CustomMimeType() { delete d; }
@@ -59,6 +61,7 @@ namespace mitk
     d->m_Category = other.GetCategory();
     d->m_Extensions = other.GetExtensions();
     d->m_Comment = other.GetComment();
+    d->m_ExtensionRequired = other.IsExtensionRequired();
   }
 
   CustomMimeType &CustomMimeType::operator=(const CustomMimeType &other)
@@ -103,6 +106,12 @@ namespace mitk
     return extension;
   }
 
+  bool CustomMimeType::IsExtensionRequired() const
+  {
+    // AppliesTo() is not overridden, so it is decided by the extension alone
+    return d->m_ExtensionRequired || typeid(*this) == typeid(CustomMimeType);
+  }
+
   std::string CustomMimeType::GetFilenameWithoutExtension(const std::string &path) const
   {
     std::string extension, filename;
@@ -151,6 +160,7 @@ namespace mitk
   }
 
   void CustomMimeType::SetComment(const std::string &comment) { d->m_Comment = comment; }
+  void CustomMimeType::SetExtensionRequired(bool required) { d->m_ExtensionRequired = required; }
   void CustomMimeType::Swap(CustomMimeType &r)
   {
     Impl *d1 = d;
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkFileReaderRegistry.h>
 #include <mitkFileWriterRegistry.h>
 #include <mitkIMimeTypeProvider.h>
+#include <mitkLocaleSwitch.h>
 #include <mitkProgressBar.h>
 #include <mitkStandaloneDataStorage.h>
 #include <usGetModuleContext.h>
@@ -36,8 +37,15 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <atomic>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
 
 static std::string GetLastErrorStr()
 {
@@ -313,6 +321,68 @@ namespace mitk
     };
 
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
+
+    /** A file of IOUtil::Load() together with its selected reader and, for concurrently
+     * read files, the result of the reader.*/
+    struct ReadTask
+    {
+      LoadInfo *m_LoadInfo = nullptr;
+      IFileReader *m_Reader = nullptr;
+      bool m_Concurrent = false;
+
+      StandaloneDataStorage::Pointer m_Storage;
+      DataStorage::SetOfObjects::Pointer m_Nodes;
+      std::exception_ptr m_Exception;
+      bool m_Read = false;
+    };
+
+    /** Reads all tasks of thread-safe readers on up to \c numberOfThreads threads, starting on
+     * construction. If \c useStorage is true, each task is read into its own data storage. The
+     * destructor waits for all threads.*/
+    class ConcurrentReading
+    {
+    public:
+      ConcurrentReading(std::vector<ReadTask> &tasks, bool useStorage, unsigned int numberOfThreads);
+      ~ConcurrentReading();
+
+      /** Blocks until the (thread-safe) task was read.*/
+      void WaitFor(const ReadTask &task);
+
+    private:
+      void ReadTasks();
+
+      std::vector<ReadTask *> m_Tasks;
+      bool m_UseStorage;
+      std::atomic<std::size_t> m_NextTask;
+      std::vector<std::thread> m_Threads;
+      std::mutex m_Mutex;
+      std::condition_variable m_TaskRead;
+    };
+
+    /** Selects the reader of the load info (re-using readers and options of previous files or
+     * calling the options callback). Returns nullptr if no reader is available; \c abort is set
+     * if the whole load operation has to be stopped.*/
+    static IFileReader *SelectReader(LoadInfo &loadInfo,
+                                     std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                     const ReaderOptionsFunctorBase *optionsCallback,
+                                     std::string &errMsg,
+                                     bool &abort);
+
+    /** Resolves the maximum number of threads passed to IOUtil::LoadConcurrently(); zero means
+     * the number of hardware threads. With a single thread the files are loaded sequentially.*/
+    static unsigned int GetNumberOfReadingThreads(unsigned int maximumNumberOfThreads);
+
+    /** Reads the data with the reader. If \c ds is not nullptr, the reader adds the nodes to it.*/
+    static DataStorage::SetOfObjects::Pointer ReadNodes(IFileReader *reader, DataStorage *ds);
+
+    /** Adds the nodes together with their sources to the target storage. Sources are added before
+     * their derivations, so the hierarchy of the source storage is preserved.*/
+    static void TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target);
+
+    static void CollectOutput(LoadInfo &loadInfo,
+                              const DataStorage::SetOfObjects *nodes,
+                              DataStorage::SetOfObjects *nodeResult,
+                              std::string &errMsg);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -325,6 +395,228 @@ namespace mitk
     return baseDataList.front();
   }
 
+  IFileReader *IOUtil::Impl::SelectReader(LoadInfo &loadInfo,
+                                          std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                          std::string &errMsg,
+                                          bool &abort)
+  {
+    std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+
+    if (readers.empty())
+    {
+      if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+      {
+        errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+      }
+      else
+      {
+        errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+      }
+      return nullptr;
+    }
+
+    bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+
+    // check if we already used a reader which should be re-used
+    std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
+    std::string selectedMimeType;
+    for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
+                                               mimeTypeIterEnd = currMimeTypes.end();
+         mimeTypeIter != mimeTypeIterEnd;
+         ++mimeTypeIter)
+    {
+      std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
+        usedReaderItems.find(mimeTypeIter->GetName());
+      if (oldSelectedItemIter != usedReaderItems.end())
+      {
+        // we found an already used item for a mime-type which is contained
+        // in the current reader set, check all current readers if there service
+        // id equals the old reader
+        for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
+                                                                   currReaderItemEnd = readers.end();
+             currReaderItem != currReaderItemEnd;
+             ++currReaderItem)
+        {
+          if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
+              currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
+              currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
+          {
+            // okay, we used the same reader already, re-use its options
+            selectedMimeType = mimeTypeIter->GetName();
+            callOptionsCallback = false;
+            loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
+            loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
+              oldSelectedItemIter->second.GetReader()->GetOptions());
+            break;
+          }
+        }
+        if (!selectedMimeType.empty())
+          break;
+      }
+    }
+
+    if (callOptionsCallback && optionsCallback)
+    {
+      callOptionsCallback = (*optionsCallback)(loadInfo);
+      if (!callOptionsCallback && !loadInfo.m_Cancel)
+      {
+        usedReaderItems.erase(selectedMimeType);
+        FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
+        usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+      }
+    }
+
+    if (loadInfo.m_Cancel)
+    {
+      errMsg += "Reading operation(s) cancelled.";
+      abort = true;
+      return nullptr;
+    }
+
+    IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      errMsg += "Unexpected nullptr reader.";
+      abort = true;
+      return nullptr;
+    }
+
+    reader->SetProperties(loadInfo.m_Properties);
+    return reader;
+  }
+
+  unsigned int IOUtil::Impl::GetNumberOfReadingThreads(unsigned int maximumNumberOfThreads)
+  {
+    if (maximumNumberOfThreads == 0)
+      maximumNumberOfThreads = std::thread::hardware_concurrency();
+
+    return std::max(1u, maximumNumberOfThreads);
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Impl::ReadNodes(IFileReader *reader, DataStorage *ds)
+  {
+    if (ds != nullptr)
+    {
+      return reader->Read(*ds);
+    }
+
+    auto nodes = DataStorage::SetOfObjects::New();
+    std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
+    for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    {
+      if (iter->IsNotNull())
+      {
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(*iter);
+        nodes->InsertElement(nodes->Size(), node);
+      }
+    }
+    return nodes;
+  }
+
+  IOUtil::Impl::ConcurrentReading::ConcurrentReading(std::vector<ReadTask> &tasks, bool useStorage, unsigned int numberOfThreads)
+    : m_UseStorage(useStorage), m_NextTask(0)
+  {
+    for (auto &task : tasks)
+    {
+      if (task.m_Concurrent)
+        m_Tasks.push_back(&task);
+    }
+
+    const auto numberOfUsedThreads = std::min<std::size_t>(numberOfThreads, m_Tasks.size());
+
+    m_Threads.reserve(numberOfUsedThreads);
+    for (std::size_t i = 0; i < numberOfUsedThreads; ++i)
+      m_Threads.emplace_back(&ConcurrentReading::ReadTasks, this);
+  }
+
+  IOUtil::Impl::ConcurrentReading::~ConcurrentReading()
+  {
+    for (auto &thread : m_Threads)
+      thread.join();
+  }
+
+  void IOUtil::Impl::ConcurrentReading::WaitFor(const ReadTask &task)
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_TaskRead.wait(lock, [&task]() { return task.m_Read; });
+  }
+
+  void IOUtil::Impl::ConcurrentReading::ReadTasks()
+  {
+    for (auto i = m_NextTask++; i < m_Tasks.size(); i = m_NextTask++)
+    {
+      auto task = m_Tasks[i];
+      try
+      {
+        if (m_UseStorage)
+          task->m_Storage = StandaloneDataStorage::New();
+
+        task->m_Nodes = ReadNodes(task->m_Reader, task->m_Storage);
+      }
+      catch (...)
+      {
+        task->m_Exception = std::current_exception();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        task->m_Read = true;
+      }
+      m_TaskRead.notify_all();
+    }
+  }
+
+  void IOUtil::Impl::TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target)
+  {
+    std::function<void(DataNode *)> transfer = [&](DataNode *node)
+    {
+      if (target.Exists(node))
+        return;
+
+      auto parents = source.GetSources(node, nullptr, true);
+      for (const auto &parent : *parents)
+        transfer(parent);
+
+      target.Add(node, parents);
+    };
+
+    for (const auto &node : *nodes)
+      transfer(node);
+  }
+
+  void IOUtil::Impl::CollectOutput(LoadInfo &loadInfo,
+                                   const DataStorage::SetOfObjects *nodes,
+                                   DataStorage::SetOfObjects *nodeResult,
+                                   std::string &errMsg)
+  {
+    for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
+         nodeIter != nodeIterEnd;
+         ++nodeIter)
+    {
+      const mitk::DataNode::Pointer &node = nodeIter->Value();
+      mitk::BaseData::Pointer data = node->GetData();
+      if (data.IsNull())
+      {
+        continue;
+      }
+
+      data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+
+      loadInfo.m_Output.push_back(data);
+      if (nodeResult)
+      {
+        nodeResult->push_back(nodeIter->Value());
+      }
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+  }
+
 #ifdef US_PLATFORM_WINDOWS
   std::string IOUtil::GetProgramPath()
   {
@@ -551,6 +843,36 @@ namespace mitk
   }
 
   DataStorage::SetOfObjects::Pointer IOUtil::Load(const std::vector<std::string> &paths, DataStorage &storage, const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    return LoadConcurrently(paths, storage, optionsCallback);
+  }
+
+  std::vector<BaseData::Pointer> IOUtil::Load(const std::vector<std::string> &paths, const ReaderOptionsFunctorBase *optionsCallback)
+  {
+    std::vector<BaseData::Pointer> result;
+    std::vector<LoadInfo> loadInfos;
+    for (const auto &loadInfo : paths)
+    {
+      loadInfos.emplace_back(loadInfo);
+    }
+    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback);
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
+
+    for (std::vector<LoadInfo>::const_iterator iter = loadInfos.begin(), iterEnd = loadInfos.end(); iter != iterEnd;
+         ++iter)
+    {
+      result.insert(result.end(), iter->m_Output.begin(), iter->m_Output.end());
+    }
+    return result;
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                               DataStorage &storage,
+                                                               const ReaderOptionsFunctorBase *optionsCallback,
+                                                               unsigned int maximumNumberOfThreads)
   {
     DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
     std::vector<LoadInfo> loadInfos;
@@ -558,7 +880,7 @@ namespace mitk
     {
       loadInfos.emplace_back(loadInfo);
     }
-    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback);
+    std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback, Impl::GetNumberOfReadingThreads(maximumNumberOfThreads));
     if (!errMsg.empty())
     {
       mitkThrow() << errMsg;
@@ -566,7 +888,9 @@ namespace mitk
     return nodeResult;
   }
 
-  std::vector<BaseData::Pointer> IOUtil::Load(const std::vector<std::string> &paths, const ReaderOptionsFunctorBase *optionsCallback)
+  std::vector<BaseData::Pointer> IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                           const ReaderOptionsFunctorBase *optionsCallback,
+                                                           unsigned int maximumNumberOfThreads)
   {
     std::vector<BaseData::Pointer> result;
     std::vector<LoadInfo> loadInfos;
@@ -574,24 +898,33 @@ namespace mitk
     {
       loadInfos.emplace_back(loadInfo);
     }
-    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback);
+    std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback, Impl::GetNumberOfReadingThreads(maximumNumberOfThreads));
     if (!errMsg.empty())
     {
       mitkThrow() << errMsg;
     }
 
-    for (std::vector<LoadInfo>::const_iterator iter = loadInfos.begin(), iterEnd = loadInfos.end(); iter != iterEnd;
-         ++iter)
+    for (const auto &loadInfo : loadInfos)
     {
-      result.insert(result.end(), iter->m_Output.begin(), iter->m_Output.end());
+      result.insert(result.end(), loadInfo.m_Output.begin(), loadInfo.m_Output.end());
     }
     return result;
   }
 
+  std::string IOUtil::LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                       const ReaderOptionsFunctorBase *optionsCallback,
+                                       unsigned int maximumNumberOfThreads,
+                                       LoadedFunctorBase *loadedCallback)
+  {
+    return Load(loadInfos, nullptr, nullptr, optionsCallback, Impl::GetNumberOfReadingThreads(maximumNumberOfThreads), loadedCallback);
+  }
+
   std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
                            DataStorage::SetOfObjects *nodeResult,
                            DataStorage *ds,
-                           const ReaderOptionsFunctorBase *optionsCallback)
+                           const ReaderOptionsFunctorBase *optionsCallback,
+                           unsigned int numberOfReadingThreads,
+                           LoadedFunctorBase *loadedCallback)
   {
     if (loadInfos.empty())
     {
@@ -606,152 +939,128 @@ namespace mitk
     std::map<std::string, FileReaderSelector::Item> usedReaderItems;
 
     std::vector< std::string > read_files;
-    for (auto &loadInfo : loadInfos)
-    {
-      if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
-        continue;
-
-      std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
 
-      if (readers.empty())
+    if (numberOfReadingThreads <= 1)
+    {
+      for (auto &loadInfo : loadInfos)
       {
-        if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+        if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
         {
-          errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+          if (loadedCallback != nullptr)
+            (*loadedCallback)(loadInfo);
+          continue;
         }
-        else
-        {
-          errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
-        }
-        continue;
-      }
 
-      bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+        bool abort = false;
+        IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, abort);
+        if (abort)
+          break;
+        if (reader == nullptr)
+          continue;
 
-      // check if we already used a reader which should be re-used
-      std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
-      std::string selectedMimeType;
-      for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
-                                                 mimeTypeIterEnd = currMimeTypes.end();
-           mimeTypeIter != mimeTypeIterEnd;
-           ++mimeTypeIter)
-      {
-        std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
-          usedReaderItems.find(mimeTypeIter->GetName());
-        if (oldSelectedItemIter != usedReaderItems.end())
+        // Do the actual reading
+        try
         {
-          // we found an already used item for a mime-type which is contained
-          // in the current reader set, check all current readers if there service
-          // id equals the old reader
-          for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
-                                                                     currReaderItemEnd = readers.end();
-               currReaderItem != currReaderItemEnd;
-               ++currReaderItem)
-          {
-            if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
-                currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
-                currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
-            {
-              // okay, we used the same reader already, re-use its options
-              selectedMimeType = mimeTypeIter->GetName();
-              callOptionsCallback = false;
-              loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
-              loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
-                oldSelectedItemIter->second.GetReader()->GetOptions());
-              break;
-            }
-          }
-          if (!selectedMimeType.empty())
-            break;
-        }
-      }
+          auto nodes = Impl::ReadNodes(reader, ds);
 
-      if (callOptionsCallback && optionsCallback)
-      {
-        callOptionsCallback = (*optionsCallback)(loadInfo);
-        if (!callOptionsCallback && !loadInfo.m_Cancel)
+          std::vector< std::string > new_files =  reader->GetReadFiles();
+          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+
+          Impl::CollectOutput(loadInfo, nodes, nodeResult, errMsg);
+        }
+        catch (const std::exception &e)
         {
-          usedReaderItems.erase(selectedMimeType);
-          FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
-          usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+          errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
         }
-      }
+        mitk::ProgressBar::GetInstance()->Progress(2);
+        --filesToRead;
 
-      if (loadInfo.m_Cancel)
-      {
-        errMsg += "Reading operation(s) cancelled.";
-        break;
+        if (loadedCallback != nullptr)
+          (*loadedCallback)(loadInfo);
       }
-
-      IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
-      if (reader == nullptr)
+    }
+    else
+    {
+      // Select all readers upfront on the calling thread, the options callback may ask the user.
+      std::vector<Impl::ReadTask> tasks;
+      std::set<std::string> selectedPaths;
+      for (auto &loadInfo : loadInfos)
       {
-        errMsg += "Unexpected nullptr reader.";
-        break;
+        if (!selectedPaths.insert(loadInfo.m_Path).second)
+          continue;
+
+        bool abort = false;
+        IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, abort);
+        if (abort)
+          break;
+        if (reader == nullptr)
+          continue;
+
+        Impl::ReadTask task;
+        task.m_LoadInfo = &loadInfo;
+        task.m_Reader = reader;
+        task.m_Concurrent = reader->IsThreadSafe();
+        tasks.push_back(task);
       }
 
-      reader->SetProperties(loadInfo.m_Properties);
+      // setlocale() affects all threads. With the "C" locale held for the whole batch, the
+      // locale switches of the readers do not change the locale anymore.
+      LocaleSwitch localeSwitch("C");
+      Impl::ConcurrentReading reading(tasks, ds != nullptr, numberOfReadingThreads);
 
-      // Do the actual reading
-      try
+      // Tasks are completed in the order of the load infos, as soon as they were read. Files of
+      // non-thread-safe readers are read here while the other files are still being read.
+      for (auto &task : tasks)
       {
-        DataStorage::SetOfObjects::Pointer nodes;
-        if (ds != nullptr)
-        {
-          nodes = reader->Read(*ds);
+        auto &loadInfo = *task.m_LoadInfo;
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
-        }
-        else
-        {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
-          {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
-          }
+        if (task.m_Concurrent)
+          reading.WaitFor(task);
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+        // The file was already read by the reader of a previous entry (e.g. a DICOM series).
+        if (std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+        {
+          if (loadedCallback != nullptr)
+            (*loadedCallback)(loadInfo);
+          continue;
         }
 
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
+        try
         {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
+          DataStorage::SetOfObjects::Pointer nodes;
+          if (task.m_Concurrent)
           {
-            continue;
-          }
-
-          data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+            if (task.m_Exception)
+              std::rethrow_exception(task.m_Exception);
 
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
+            nodes = task.m_Nodes;
+            if (ds != nullptr)
+              Impl::TransferNodes(nodes, *task.m_Storage, *ds);
+          }
+          else
           {
-            nodeResult->push_back(nodeIter->Value());
+            nodes = Impl::ReadNodes(task.m_Reader, ds);
           }
-        }
 
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+          std::vector< std::string > new_files =  task.m_Reader->GetReadFiles();
+          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+
+          Impl::CollectOutput(loadInfo, nodes, nodeResult, errMsg);
+        }
+        catch (const std::exception &e)
         {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+          errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
         }
+        catch (...)
+        {
+          errMsg += "Unknown exception occurred when reading file " + loadInfo.m_Path + "\n\n";
+        }
+        mitk::ProgressBar::GetInstance()->Progress(2);
+        --filesToRead;
+
+        if (loadedCallback != nullptr)
+          (*loadedCallback)(loadInfo);
       }
-      catch (const std::exception &e)
-      {
-        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
-      }
-      mitk::ProgressBar::GetInstance()->Progress(2);
-      --filesToRead;
     }
 
     if (!errMsg.empty())
@@ -30,6 +30,7 @@ namespace mitk
     Options defaultOptions;
     defaultOptions["Save as binary file"] = false;
     this->SetDefaultWriterOptions(defaultOptions);
+    this->SetReaderThreadSafe(true);
     this->RegisterService();
   }
 
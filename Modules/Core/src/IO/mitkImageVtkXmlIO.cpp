@@ -53,6 +53,7 @@ namespace mitk
   ImageVtkXmlIO::ImageVtkXmlIO()
     : AbstractFileIO(Image::GetStaticNameOfClass(), IOMimeTypes::VTK_IMAGE_MIMETYPE(), "VTK XML Image")
   {
+    this->SetReaderThreadSafe(true);
     this->RegisterService();
   }
 
@@ -122,6 +122,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->SetReaderThreadSafe(true);
 
     std::vector<std::string> readExtensions = m_ImageIO->GetSupportedReadExtensions();
 
@@ -207,6 +208,7 @@ namespace mitk
 
     this->AbstractFileReader::SetMimeTypePrefix(IOMimeTypes::DEFAULT_BASE_NAME() + ".image.");
     this->InitializeDefaultMetaDataKeys();
+    this->SetReaderThreadSafe(true);
 
     if (rank)
     {
@@ -237,7 +239,7 @@ namespace mitk
     return result;
   };
 
-  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path)
+  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, bool loadPixelData)
   {
     LocaleSwitch localeSwitch("C");
 
@@ -309,11 +311,15 @@ namespace mitk
 
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     imageIO->SetIORegion(ioRegion);
-    void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
-    imageIO->Read(buffer);
 
     image->Initialize(MakePixelType(imageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    if (loadPixelData)
+    {
+      void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
+      imageIO->Read(buffer);
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary& dictionary = imageIO->GetMetaDataDictionary();
 
@@ -406,7 +412,6 @@ namespace mitk
 
     image->SetTimeGeometry(timeGeometry);
 
-    buffer = nullptr;
     MITK_INFO << "number of image components: " << image->GetPixelType().GetNumberOfComponents();
     return image;
   }
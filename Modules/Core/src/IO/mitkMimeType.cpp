@@ -63,6 +63,8 @@ namespace mitk
     return m_Data->m_CustomMimeType->MatchesExtension(path);
   }
 
+  bool MimeType::IsExtensionRequired() const { return m_Data->m_CustomMimeType->IsExtensionRequired(); }
+
   bool MimeType::IsValid() const
   {
     return m_Data.Data() != nullptr && m_Data->m_CustomMimeType.get() != nullptr &&
@@ -13,20 +13,47 @@ found in the LICENSE file.
 #include "mitkMimeTypeProvider.h"
 
 #include "mitkLog.h"
+#include "mitkUtf8Util.h"
 
 #include <usGetModuleContext.h>
 #include <usModuleContext.h>
 
 #include <itksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cctype>
+
 #ifdef _MSC_VER
 #pragma warning(disable : 4503) // decorated name length exceeded, name was truncated
 #pragma warning(disable : 4355)
 #endif
 
+namespace
+{
+  // Lookups of many distinct files (e.g. browsing a DICOM directory) must not grow the cache unbounded.
+  const std::size_t MaximumNumberOfCachedLookups = 10000;
+
+  std::string ToLower(std::string value)
+  {
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    return value;
+  }
+
+  bool GetFileStatus(const std::string &filePath, long long &modifiedTime, long long &size)
+  {
+    itksys::SystemTools::Stat_t status;
+    if (0 != itksys::SystemTools::Stat(mitk::Utf8Util::Local8BitToUtf8(filePath), &status))
+      return false;
+
+    modifiedTime = static_cast<long long>(status.st_mtime);
+    size = static_cast<long long>(status.st_size);
+    return true;
+  }
+}
+
 namespace mitk
 {
-  MimeTypeProvider::MimeTypeProvider() : m_Tracker(nullptr) {}
+  MimeTypeProvider::MimeTypeProvider() : m_Tracker(nullptr), m_IndexGeneration(0) {}
   MimeTypeProvider::~MimeTypeProvider() { delete m_Tracker; }
   void MimeTypeProvider::Start()
   {
@@ -40,6 +67,7 @@ namespace mitk
   void MimeTypeProvider::Stop() { m_Tracker->Close(); }
   std::vector<MimeType> MimeTypeProvider::GetMimeTypes() const
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     std::vector<MimeType> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -50,13 +78,37 @@ namespace mitk
 
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForFile(const std::string &filePath) const
   {
+    long long modifiedTime = 0;
+    long long size = 0;
+    const bool fileExists = GetFileStatus(filePath, modifiedTime, size);
+
+    unsigned long indexGeneration = 0;
+    std::vector<MimeType> candidates;
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+
+      if (fileExists)
+      {
+        auto cacheIter = m_LookupCache.find(filePath);
+        if (cacheIter != m_LookupCache.end() && cacheIter->second.m_ModifiedTime == modifiedTime &&
+            cacheIter->second.m_Size == size)
+        {
+          return cacheIter->second.m_MimeTypes;
+        }
+      }
+
+      indexGeneration = m_IndexGeneration;
+      candidates = this->GetCandidatesForFile(filePath);
+    }
+
+    // AppliesTo() may read the file, so it is called without holding the lock
     std::vector<MimeType> result;
-    for (const auto &elem : m_NameToMimeType)
+    for (const auto &candidate : candidates)
     {
       try
       {
-        if (elem.second.AppliesTo(filePath))
-          result.push_back(elem.second);
+        if (candidate.AppliesTo(filePath))
+          result.push_back(candidate);
       }
       catch (...)
       {
@@ -64,11 +116,51 @@ namespace mitk
     }
     std::sort(result.begin(), result.end());
     std::reverse(result.begin(), result.end());
+
+    if (fileExists)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (indexGeneration == m_IndexGeneration)
+      {
+        if (m_LookupCache.size() >= MaximumNumberOfCachedLookups)
+          m_LookupCache.clear();
+
+        m_LookupCache[filePath] = CachedLookup{ modifiedTime, size, result };
+      }
+    }
+
     return result;
   }
 
+  std::vector<MimeType> MimeTypeProvider::GetCandidatesForFile(const std::string &filePath) const
+  {
+    std::vector<MimeType> candidates = m_UnindexedMimeTypes;
+    std::set<std::string> candidateNames;
+
+    for (const auto &lengthAndExtensions : m_ExtensionIndex)
+    {
+      const auto length = lengthAndExtensions.first;
+      if (length > filePath.size())
+        break;
+
+      auto extensionIter = lengthAndExtensions.second.find(ToLower(filePath.substr(filePath.size() - length)));
+      if (extensionIter == lengthAndExtensions.second.end())
+        continue;
+
+      for (const auto &mimeType : extensionIter->second)
+      {
+        // mime types may match several suffixes of the path (e.g. "gz" and "nii.gz")
+        if (candidateNames.insert(mimeType.GetName()).second)
+          candidates.push_back(mimeType);
+      }
+    }
+
+    return candidates;
+  }
+
   std::vector<MimeType> MimeTypeProvider::GetMimeTypesForCategory(const std::string &category) const
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     std::vector<MimeType> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -82,6 +174,7 @@ namespace mitk
 
   MimeType MimeTypeProvider::GetMimeTypeForName(const std::string &name) const
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     auto iter = m_NameToMimeType.find(name);
     if (iter != m_NameToMimeType.end())
       return iter->second;
@@ -90,6 +183,7 @@ namespace mitk
 
   std::vector<std::string> MimeTypeProvider::GetCategories() const
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     std::vector<std::string> result;
     for (const auto &elem : m_NameToMimeType)
     {
@@ -109,11 +203,13 @@ namespace mitk
     MimeType result = this->GetMimeType(reference);
     if (result.IsValid())
     {
+      std::lock_guard<std::mutex> lock(m_Mutex);
       std::string name = result.GetName();
       m_NameToMimeTypes[name].insert(result);
 
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(m_NameToMimeTypes[name].rbegin());
+      this->UpdateIndex();
     }
     return result;
   }
@@ -125,6 +221,7 @@ namespace mitk
 
   void MimeTypeProvider::RemovedService(const ServiceReferenceType & /*reference*/, TrackedType mimeType)
   {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     std::string name = mimeType.GetName();
     std::set<MimeType> &mimeTypes = m_NameToMimeTypes[name];
     mimeTypes.erase(mimeType);
@@ -138,6 +235,35 @@ namespace mitk
       // get the highest ranked mime-type
       m_NameToMimeType[name] = *(mimeTypes.rbegin());
     }
+    this->UpdateIndex();
+  }
+
+  void MimeTypeProvider::UpdateIndex()
+  {
+    m_ExtensionIndex.clear();
+    m_UnindexedMimeTypes.clear();
+    m_LookupCache.clear();
+    ++m_IndexGeneration;
+
+    for (const auto &elem : m_NameToMimeType)
+    {
+      const auto &mimeType = elem.second;
+      if (!mimeType.IsExtensionRequired())
+      {
+        m_UnindexedMimeTypes.push_back(mimeType);
+        continue;
+      }
+
+      std::set<std::string> extensions;
+      for (const auto &extension : mimeType.GetExtensions())
+      {
+        if (!extension.empty())
+          extensions.insert(ToLower(extension));
+      }
+
+      for (const auto &extension : extensions)
+        m_ExtensionIndex[extension.size()][extension].push_back(mimeType);
+    }
   }
 
   MimeType MimeTypeProvider::GetMimeType(const ServiceReferenceType &reference) const
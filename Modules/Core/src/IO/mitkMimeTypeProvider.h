@@ -19,6 +19,7 @@ found in the LICENSE file.
 #include "usServiceTracker.h"
 #include "usServiceTrackerCustomizer.h"
 
+#include <mutex>
 #include <set>
 
 namespace mitk
@@ -55,12 +56,42 @@ namespace mitk
 
     MimeType GetMimeType(const ServiceReferenceType &reference) const;
 
+    /** Rebuilds the extension index from m_NameToMimeType and discards all cached lookups.*/
+    void UpdateIndex();
+
+    std::vector<MimeType> GetCandidatesForFile(const std::string &filePath) const;
+
     us::ServiceTracker<CustomMimeType, MimeTypeTrackerTypeTraits> *m_Tracker;
 
     typedef std::map<std::string, std::set<MimeType>> MapType;
     MapType m_NameToMimeTypes;
 
     std::map<std::string, MimeType> m_NameToMimeType;
+
+    /** Mime types that require a matching extension (see CustomMimeType::IsExtensionRequired()),
+    * indexed by the length of the extension and the lower case extension. A path is only
+    * compared with the suffixes of the indexed lengths.*/
+    typedef std::map<std::string, std::vector<MimeType>> ExtensionMapType;
+    std::map<std::size_t, ExtensionMapType> m_ExtensionIndex;
+
+    /** Mime types whose AppliesTo() has to be called for every path.*/
+    std::vector<MimeType> m_UnindexedMimeTypes;
+
+    struct CachedLookup
+    {
+      long long m_ModifiedTime;
+      long long m_Size;
+      std::vector<MimeType> m_MimeTypes;
+    };
+
+    /** Results of GetMimeTypesForFile() for existing files. An entry is valid as long as the
+    * modification time and size of the file are unchanged.*/
+    mutable std::map<std::string, CachedLookup> m_LookupCache;
+
+    /** Incremented by UpdateIndex(), so lookups running during a registration change are not cached.*/
+    unsigned long m_IndexGeneration;
+
+    mutable std::mutex m_Mutex;
   };
 }
 
@@ -57,6 +57,8 @@ mitk::RawImageFileReaderService::RawImageFileReaderService()
 
   this->SetDefaultOptions(defaultOptions);
 
+  // binary data only, no locale dependent parsing
+  this->SetThreadSafe(true);
   this->RegisterService();
 }
 
@@ -30,6 +30,8 @@ namespace mitk
     Options defaultOptions;
     defaultOptions["Save as binary file"] = false;
     this->SetDefaultWriterOptions(defaultOptions);
+    // vtkPolyDataReader parses with C++ streams, which are not affected by setlocale()
+    this->SetReaderThreadSafe(true);
     this->RegisterService();
   }
 
@@ -51,6 +51,8 @@ namespace mitk
   SurfaceVtkXmlIO::SurfaceVtkXmlIO()
     : SurfaceVtkIO(Surface::GetStaticNameOfClass(), IOMimeTypes::VTK_POLYDATA_MIMETYPE(), "VTK XML PolyData")
   {
+    // the VTK XML parser does not depend on the C locale
+    this->SetReaderThreadSafe(true);
     this->RegisterService();
   }
 
@@ -502,43 +502,49 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
 
   float rgb[3] = {1.0f, 1.0f, 1.0f};
 
+  static const std::vector<mitk::PropertyKey> colorPropertyKeys = {
+    mitk::PropertyKey("binaryimage.ishovering"),
+    mitk::PropertyKey("selected"),
+    mitk::PropertyKey("binary"),
+    mitk::PropertyKey("binaryimage.hoveringcolor"),
+    mitk::PropertyKey("binaryimage.selectedcolor"),
+    mitk::PropertyKey("color"),
+    mitk::PropertyKey("outline binary shadow color")};
+
+  const auto properties = GetDataNode()->GetProperties(colorPropertyKeys, renderer);
+
+  auto getBool = [](const mitk::BaseProperty *property) {
+    auto boolProperty = dynamic_cast<const mitk::BoolProperty *>(property);
+    return nullptr != boolProperty && boolProperty->GetValue();
+  };
+
+  // copies the color of the first existing color property
+  auto getColor = [](float color[3], const mitk::BaseProperty *property, const mitk::BaseProperty *fallBackProperty = nullptr) {
+    auto colorProperty = dynamic_cast<const mitk::ColorProperty *>(property);
+
+    if (nullptr == colorProperty)
+      colorProperty = dynamic_cast<const mitk::ColorProperty *>(fallBackProperty);
+
+    if (nullptr != colorProperty)
+      memcpy(color, colorProperty->GetColor().GetDataPointer(), 3 * sizeof(float));
+  };
+
   // check for color prop and use it for rendering if it exists
   // binary image hovering & binary image selection
-  bool hover = false;
-  bool selected = false;
-  bool binary = false;
-  GetDataNode()->GetBoolProperty("binaryimage.ishovering", hover, renderer);
-  GetDataNode()->GetBoolProperty("selected", selected, renderer);
-  GetDataNode()->GetBoolProperty("binary", binary, renderer);
+  const bool hover = getBool(properties[0]);
+  const bool selected = getBool(properties[1]);
+  const bool binary = getBool(properties[2]);
   if (binary && hover && !selected)
   {
-    mitk::ColorProperty::Pointer colorprop =
-      dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("binaryimage.hoveringcolor", renderer));
-    if (colorprop.IsNotNull())
-    {
-      memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-    }
-    else
-    {
-      GetDataNode()->GetColor(rgb, renderer, "color");
-    }
+    getColor(rgb, properties[3], properties[5]);
   }
   if (binary && selected)
   {
-    mitk::ColorProperty::Pointer colorprop =
-      dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("binaryimage.selectedcolor", renderer));
-    if (colorprop.IsNotNull())
-    {
-      memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-    }
-    else
-    {
-      GetDataNode()->GetColor(rgb, renderer, "color");
-    }
+    getColor(rgb, properties[4], properties[5]);
   }
   if (!binary || (!hover && !selected))
   {
-    GetDataNode()->GetColor(rgb, renderer, "color");
+    getColor(rgb, properties[5]);
   }
 
   double rgbConv[3] = {(double)rgb[0], (double)rgb[1], (double)rgb[2]}; // conversion to double for VTK
@@ -546,12 +552,7 @@ void mitk::ImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer)
   localStorage->m_ImageActor->GetProperty()->SetColor(rgbConv);
 
   float shadowRGB[3] = {1.0f, 1.0f, 1.0f};
-  mitk::ColorProperty::Pointer colorprop =
-    dynamic_cast<mitk::ColorProperty *>(GetDataNode()->GetProperty("outline binary shadow color", renderer));
-  if (colorprop.IsNotNull())
-  {
-    memcpy(shadowRGB, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
-  }
+  getColor(shadowRGB, properties[6]);
   double shadowRGBConv[3] = {(double)shadowRGB[0], (double)shadowRGB[1], (double)shadowRGB[2]}; // conversion to double for VTK
   localStorage->m_ShadowOutlineActor->GetProperty()->SetColor(shadowRGBConv);
 }
@@ -36,6 +36,7 @@ set(MODULE_TESTS
   mitkGeometryDataIOTest.cpp
   mitkGeometryDataToSurfaceFilterTest.cpp
   mitkImageCastTest.cpp
+  mitkItkImageViewTest.cpp
   mitkImageDataItemTest.cpp
   mitkImageGeneratorTest.cpp
   mitkIOUtilTest.cpp
@@ -95,6 +96,8 @@ set(MODULE_TESTS
   mitkPropertyExtensionsTest.cpp
   mitkPropertyFiltersTest.cpp
   mitkPropertyKeyPathTest.cpp
+  mitkPropertyKeyTest.cpp
+  mitkBatchUpdateScopeTest.cpp
   mitkTinyXMLTest.cpp
   mitkRawImageFileReaderTest.cpp
   mitkInteractionEventTest.cpp
@@ -123,6 +126,7 @@ set(MODULE_TESTS
   mitkTemporalJoinImagesFilterTest.cpp
   mitkPreferencesTest.cpp
   mitkIOVolumeSplitReasonTest.cpp
+  mitkMimeTypeProviderTest.cpp
 )
 
 set(MODULE_RENDERING_TESTS
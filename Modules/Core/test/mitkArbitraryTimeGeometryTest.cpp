@@ -28,6 +28,7 @@ class mitkArbitraryTimeGeometryTestSuite : public mitk::TestFixture
   MITK_TEST(IsValidTimePoint);
   MITK_TEST(TimeStepToTimePoint);
   MITK_TEST(TimePointToTimeStep);
+  MITK_TEST(TimePointsToTimeSteps);
   MITK_TEST(GetGeometryCloneForTimeStep);
   MITK_TEST(GetGeometryForTimeStep);
   MITK_TEST(GetGeometryForTimePoint);
@@ -376,6 +377,28 @@ public:
 
   }
 
+  void TimePointsToTimeSteps()
+  {
+    const std::vector<mitk::TimePointType> timePoints = { 0.5, 1.0, 1.5, 1.9, 2.0, 3.5, 3.5, 5.8, 5.9, 2.5, 1.2 };
+
+    const auto timeSteps = m_12345TimeGeometry->TimePointsToTimeSteps(timePoints);
+    MITK_TEST_CONDITION_REQUIRED(timeSteps.size() == timePoints.size(),
+                                 "Testing TimePointsToTimeSteps() returns a time step per time point");
+    for (std::size_t i = 0; i < timePoints.size(); ++i)
+    {
+      MITK_TEST_CONDITION_REQUIRED(timeSteps[i] == m_12345TimeGeometry->TimePointToTimeStep(timePoints[i]),
+                                   "Testing TimePointsToTimeSteps() with m_12345TimeGeometry and time point " << timePoints[i]);
+    }
+
+    const auto collapsedTimeSteps = m_123TimeGeometryWithCollapsedEnd->TimePointsToTimeSteps({ 1.0, 2.5, 3.0, 3.5, 4.0, 4.5 });
+    const std::vector<mitk::TimeStepType> expectedCollapsedTimeSteps = { 0, 1, 2, 2, 2, 3 };
+    MITK_TEST_CONDITION_REQUIRED(collapsedTimeSteps == expectedCollapsedTimeSteps,
+                                 "Testing TimePointsToTimeSteps() with m_123TimeGeometryWithCollapsedEnd");
+
+    MITK_TEST_CONDITION_REQUIRED(m_emptyTimeGeometry->TimePointsToTimeSteps({ 0.0, 3.5 }) == std::vector<mitk::TimeStepType>(2, 0),
+                                 "Testing TimePointsToTimeSteps() with m_emptyTimeGeometry");
+  }
+
   void GetGeometryCloneForTimeStep()
   {
     MITK_TEST_CONDITION_REQUIRED(m_emptyTimeGeometry->GetGeometryCloneForTimeStep(0).IsNull(),
@@ -0,0 +1,139 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkBatchUpdateScope.h"
+#include "mitkStandaloneDataStorage.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkBatchUpdateScopeTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBatchUpdateScopeTestSuite);
+
+  MITK_TEST(WithoutScope);
+  MITK_TEST(DeferredAndDeduplicated);
+  MITK_TEST(NestedScopes);
+  MITK_TEST(RemovedNodes);
+  MITK_TEST(BlockedEvents);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+  std::vector<mitk::DataNode::Pointer> m_Nodes;
+  std::vector<const mitk::DataNode *> m_ChangedNodes;
+
+  void OnNodeChanged(const mitk::DataNode *node)
+  {
+    m_ChangedNodes.push_back(node);
+  }
+
+  void ModifyAllNodes()
+  {
+    for (auto &node : m_Nodes)
+    {
+      node->SetOpacity(0.5f);
+      node->SetVisibility(false);
+      node->SetColor(0.0f, 1.0f, 0.0f);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+
+    for (int i = 0; i < 3; ++i)
+    {
+      auto node = mitk::DataNode::New();
+      m_DataStorage->Add(node);
+      m_Nodes.push_back(node);
+    }
+
+    m_DataStorage->ChangedNodeEvent.AddListener(
+      mitk::MessageDelegate1<mitkBatchUpdateScopeTestSuite, const mitk::DataNode *>(this, &mitkBatchUpdateScopeTestSuite::OnNodeChanged));
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage->ChangedNodeEvent.RemoveListener(
+      mitk::MessageDelegate1<mitkBatchUpdateScopeTestSuite, const mitk::DataNode *>(this, &mitkBatchUpdateScopeTestSuite::OnNodeChanged));
+
+    m_ChangedNodes.clear();
+    m_Nodes.clear();
+    m_DataStorage = nullptr;
+  }
+
+  void WithoutScope()
+  {
+    this->ModifyAllNodes();
+    // each node is reported once per modified property
+    CPPUNIT_ASSERT(m_ChangedNodes.size() > m_Nodes.size());
+  }
+
+  void DeferredAndDeduplicated()
+  {
+    {
+      mitk::BatchUpdateScope batchUpdate(m_DataStorage);
+      this->ModifyAllNodes();
+      CPPUNIT_ASSERT(m_ChangedNodes.empty());
+    }
+
+    const std::vector<const mitk::DataNode *> expectedNodes = { m_Nodes[0], m_Nodes[1], m_Nodes[2] };
+    CPPUNIT_ASSERT(expectedNodes == m_ChangedNodes);
+  }
+
+  void NestedScopes()
+  {
+    {
+      mitk::BatchUpdateScope outerBatchUpdate(m_DataStorage);
+
+      {
+        mitk::BatchUpdateScope innerBatchUpdate(m_DataStorage);
+        this->ModifyAllNodes();
+      }
+
+      CPPUNIT_ASSERT(m_ChangedNodes.empty());
+      m_Nodes[1]->SetOpacity(0.25f);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(m_Nodes.size(), m_ChangedNodes.size());
+  }
+
+  void RemovedNodes()
+  {
+    {
+      mitk::BatchUpdateScope batchUpdate(m_DataStorage);
+      this->ModifyAllNodes();
+      m_DataStorage->Remove(m_Nodes[0]);
+    }
+
+    const std::vector<const mitk::DataNode *> expectedNodes = { m_Nodes[1], m_Nodes[2] };
+    CPPUNIT_ASSERT(expectedNodes == m_ChangedNodes);
+  }
+
+  void BlockedEvents()
+  {
+    m_DataStorage->BlockNodeModifiedEvents(true);
+
+    {
+      mitk::BatchUpdateScope batchUpdate(m_DataStorage);
+      this->ModifyAllNodes();
+    }
+
+    m_DataStorage->BlockNodeModifiedEvents(false);
+    CPPUNIT_ASSERT(m_ChangedNodes.empty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBatchUpdateScope)
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkUtf8Util.h>
 #include <mitkImageGenerator.h>
 #include <mitkIOMetaInformationPropertyConstants.h>
+#include <mitkStandaloneDataStorage.h>
 #include <mitkVersion.h>
 
 #include <itkMetaDataObject.h>
@@ -38,6 +39,7 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestIOMetaInformation);
   MITK_TEST(TestUtf8);
+  MITK_TEST(TestLoadConcurrently);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -307,6 +309,61 @@ public:
     CPPUNIT_ASSERT(image.IsNotNull());
   }
 
+  void TestLoadConcurrently()
+  {
+    const std::vector<std::string> paths = { m_ImagePath, m_SurfacePath, m_PointSetPath, m_ImagePath };
+
+    auto storage = mitk::StandaloneDataStorage::New();
+    auto nodes = mitk::IOUtil::LoadConcurrently(paths, *storage, nullptr, 3);
+
+    // duplicated paths are loaded once, nodes are added in the order of the paths
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), nodes->size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), storage->GetAll()->size());
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Image*>(nodes->at(0)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Surface*>(nodes->at(1)->GetData()) != nullptr);
+    CPPUNIT_ASSERT(dynamic_cast<mitk::PointSet*>(nodes->at(2)->GetData()) != nullptr);
+
+    for (std::size_t i = 0; i < nodes->size(); ++i)
+    {
+      CPPUNIT_ASSERT(storage->Exists(nodes->at(i)));
+      CPPUNIT_ASSERT_EQUAL(paths[i], nodes->at(i)->GetData()->GetProperty("path")->GetValueAsString());
+    }
+
+    auto data = mitk::IOUtil::LoadConcurrently(paths);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), data.size());
+    CPPUNIT_ASSERT(dynamic_cast<mitk::Surface*>(data[1].GetPointer()) != nullptr);
+
+    // the remaining files are loaded, the failure is reported afterwards
+    auto failureStorage = mitk::StandaloneDataStorage::New();
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::LoadConcurrently({ m_ImagePath, "doesNotExist.nrrd", m_SurfacePath }, *failureStorage), mitk::Exception);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), failureStorage->GetAll()->size());
+
+    // load infos keep the output per entry, failing entries stay empty
+    std::vector<mitk::IOUtil::LoadInfo> loadInfos = { m_SurfacePath, std::string("doesNotExist.nrrd"), m_PointSetPath };
+    CPPUNIT_ASSERT(!mitk::IOUtil::LoadConcurrently(loadInfos).empty());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), loadInfos[0].m_Output.size());
+    CPPUNIT_ASSERT(loadInfos[1].m_Output.empty());
+    CPPUNIT_ASSERT(dynamic_cast<mitk::PointSet*>(loadInfos[2].m_Output.front().GetPointer()) != nullptr);
+
+    // loaded entries are reported in order, together with their output
+    struct LoadedCallback : public mitk::IOUtil::LoadedFunctorBase
+    {
+      void operator()(mitk::IOUtil::LoadInfo &loadInfo) override
+      {
+        m_Paths.push_back(loadInfo.m_Path);
+        m_NumberOfOutputs.push_back(loadInfo.m_Output.size());
+      }
+
+      std::vector<std::string> m_Paths;
+      std::vector<std::size_t> m_NumberOfOutputs;
+    } loadedCallback;
+
+    std::vector<mitk::IOUtil::LoadInfo> reportedLoadInfos = { m_ImagePath, m_SurfacePath, m_PointSetPath };
+    CPPUNIT_ASSERT(mitk::IOUtil::LoadConcurrently(reportedLoadInfos, nullptr, 3, &loadedCallback).empty());
+    CPPUNIT_ASSERT(std::vector<std::string>({ m_ImagePath, m_SurfacePath, m_PointSetPath }) == loadedCallback.m_Paths);
+    CPPUNIT_ASSERT(std::vector<std::size_t>({ 1, 1, 1 }) == loadedCallback.m_NumberOfOutputs);
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkIOUtil)
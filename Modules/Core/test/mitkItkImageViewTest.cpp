@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkItkImageView.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkItkImageViewTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkItkImageViewTestSuite);
+  MITK_TEST(TestCanViewAsItkImage);
+  MITK_TEST(TestReadViewSharesMemory);
+  MITK_TEST(TestWriteView);
+  MITK_TEST(TestIncompatibleView);
+  MITK_TEST(TestAccessByItkReadView);
+  MITK_TEST(TestAccessByItkWriteView);
+  MITK_TEST(TestAccessByItkViewUnsupportedType);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 10, 20, 5 };
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<short>(), 3, dimensions);
+
+    mitk::ItkImageWriteView<short, 3> view(m_Image);
+    view->FillBuffer(7);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void TestCanViewAsItkImage()
+  {
+    CPPUNIT_ASSERT((mitk::CanViewAsItkImage<short, 3>(m_Image)));
+    CPPUNIT_ASSERT(!(mitk::CanViewAsItkImage<unsigned short, 3>(m_Image)));
+    CPPUNIT_ASSERT(!(mitk::CanViewAsItkImage<short, 2>(m_Image)));
+    CPPUNIT_ASSERT(!(mitk::CanViewAsItkImage<short, 3>(nullptr)));
+  }
+
+  void TestReadViewSharesMemory()
+  {
+    const mitk::Image* constImage = m_Image;
+    mitk::ItkImageReadView<short, 3> view(constImage);
+
+    mitk::ImageReadAccessor accessor(constImage);
+    CPPUNIT_ASSERT_EQUAL(accessor.GetData(), static_cast<const void*>(view->GetBufferPointer()));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(10 * 20 * 5), view->GetLargestPossibleRegion().GetNumberOfPixels());
+  }
+
+  void TestWriteView()
+  {
+    {
+      mitk::ItkImageWriteView<short, 3> view(m_Image);
+      view->SetPixel({ { 1, 2, 3 } }, 42);
+    }
+
+    mitk::ImagePixelReadAccessor<short, 3> accessor(m_Image);
+    CPPUNIT_ASSERT_EQUAL(short(42), accessor.GetPixelByIndex({ { 1, 2, 3 } }));
+    CPPUNIT_ASSERT_EQUAL(short(7), accessor.GetPixelByIndex({ { 0, 0, 0 } }));
+  }
+
+  void TestIncompatibleView()
+  {
+    const mitk::Image* constImage = m_Image;
+    CPPUNIT_ASSERT_THROW((mitk::ItkImageReadView<float, 3>(constImage)), mitk::Exception);
+    CPPUNIT_ASSERT_THROW((mitk::ItkImageWriteView<short, 2>(m_Image)), mitk::Exception);
+  }
+
+  void TestAccessByItkReadView()
+  {
+    unsigned int numberOfCalls = 0;
+    const mitk::Image* constImage = m_Image;
+
+    mitk::AccessByItkReadView<mitk::PixelTypeList<unsigned char, short>, 2, 3>(constImage, [&](auto itkImage) {
+      using ImageType = std::remove_const_t<std::remove_pointer_t<decltype(itkImage)>>;
+      CPPUNIT_ASSERT((std::is_same_v<ImageType, itk::Image<short, 3>> || std::is_same_v<ImageType, itk::Image<unsigned char, 3>> ||
+                      std::is_same_v<ImageType, itk::Image<short, 2>> || std::is_same_v<ImageType, itk::Image<unsigned char, 2>>));
+      CPPUNIT_ASSERT_EQUAL(3u, ImageType::ImageDimension);
+      CPPUNIT_ASSERT_EQUAL(7.0, static_cast<double>(itkImage->GetBufferPointer()[0]));
+      ++numberOfCalls;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(1u, numberOfCalls);
+  }
+
+  void TestAccessByItkWriteView()
+  {
+    mitk::AccessByItkWriteView<mitk::PixelTypeList<short>, 3>(m_Image, [](auto itkImage) {
+      itkImage->FillBuffer(3);
+    });
+
+    mitk::ImagePixelReadAccessor<short, 3> accessor(m_Image);
+    CPPUNIT_ASSERT_EQUAL(short(3), accessor.GetPixelByIndex({ { 9, 19, 4 } }));
+  }
+
+  void TestAccessByItkViewUnsupportedType()
+  {
+    const mitk::Image* constImage = m_Image;
+    auto function = [](auto) {};
+
+    CPPUNIT_ASSERT_THROW((mitk::AccessByItkReadView<mitk::PixelTypeList<float, double>, 3>(constImage, function)), mitk::AccessByItkException);
+    CPPUNIT_ASSERT_THROW((mitk::AccessByItkReadView<mitk::PixelTypeList<short>, 2>(constImage, function)), mitk::AccessByItkException);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkItkImageView)
@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkLogBackendCout.h>
 #include <mitkNumericTypes.h>
 #include <mitkStandardFileLocations.h>
+#include <chrono>
 #include <thread>
 #include <mitkUtf8Util.h>
 
@@ -49,6 +50,44 @@ public:
 private:
   bool m_Called;
 };
+/** Documentation
+ *
+ * @brief Counts the processed messages of a level. Optionally slows down the processing,
+ * so the asynchronous log buffer fills up.
+ */
+class TestBackendCounter : public mitk::LogBackendBase
+{
+public:
+  TestBackendCounter(mitk::LogLevel level, unsigned int delayInMilliseconds = 0)
+    : m_Level(level),
+      m_DelayInMilliseconds(delayInMilliseconds),
+      m_NumberOfMessages(0)
+  {
+  }
+
+  void ProcessMessage(const mitk::LogMessage& message) override
+  {
+    if (message.Level != m_Level)
+      return;
+
+    if (m_DelayInMilliseconds > 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(m_DelayInMilliseconds));
+
+    m_LastMessage = message.Message;
+    ++m_NumberOfMessages;
+  }
+
+  OutputType GetOutputType() const override
+  {
+    return OutputType::Other;
+  }
+
+  mitk::LogLevel m_Level;
+  unsigned int m_DelayInMilliseconds;
+  unsigned int m_NumberOfMessages;
+  std::string m_LastMessage;
+};
+
 /** Documentation
   *
   * @brief Objects of this class can start an internal thread by calling the Start() method.
@@ -275,6 +314,78 @@ public:
     mitk::UnregisterBackend(&myCoutBackend);
     MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable logging backends.")
   }
+
+  static void TestEnableDisableLogLevels()
+  {
+    TestBackendCounter counter(mitk::LogLevel::Info);
+    mitk::RegisterBackend(&counter);
+
+    mitk::DisableLogLevel(mitk::LogLevel::Info);
+    MITK_INFO << "There should be no output!";
+    bool success = !mitk::IsLogLevelEnabled(mitk::LogLevel::Info) && mitk::IsLogLevelEnabled(mitk::LogLevel::Warn);
+    success &= 0 == counter.m_NumberOfMessages;
+
+    mitk::EnableLogLevel(mitk::LogLevel::Info);
+    MITK_INFO << "Now there should be an output.";
+    success &= 1 == counter.m_NumberOfMessages;
+
+    mitk::UnregisterBackend(&counter);
+    MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable log levels.")
+  }
+
+  static void TestAsynchronousLogging()
+  {
+    TestBackendCounter counter(mitk::LogLevel::Info);
+    mitk::RegisterBackend(&counter);
+
+    mitk::EnableAsynchronousLogging();
+    MITK_TEST_CONDITION_REQUIRED(mitk::IsAsynchronousLoggingEnabled(), "Test enabling asynchronous logging.")
+
+    for (int i = 0; i < 10; ++i)
+      MITK_INFO << "Asynchronous message " << i << "\n";
+
+    mitk::FlushLog();
+    MITK_TEST_CONDITION_REQUIRED(10 == counter.m_NumberOfMessages, "Test flushing asynchronous messages.")
+    MITK_TEST_CONDITION_REQUIRED("Asynchronous message 9" == counter.m_LastMessage, "Test order and cropping of asynchronous messages.")
+
+    mitk::UnregisterBackend(&counter);
+    mitk::DisableAsynchronousLogging();
+    MITK_TEST_CONDITION_REQUIRED(!mitk::IsAsynchronousLoggingEnabled(), "Test disabling asynchronous logging.")
+  }
+
+  static void TestAsynchronousLoggingDropPolicy()
+  {
+    TestBackendCounter infoCounter(mitk::LogLevel::Info, 1);
+    TestBackendCounter errorCounter(mitk::LogLevel::Error);
+    mitk::RegisterBackend(&infoCounter);
+    mitk::RegisterBackend(&errorCounter);
+
+    const auto numberOfDroppedMessages = mitk::GetNumberOfDroppedLogMessages();
+    mitk::EnableAsynchronousLogging(4);
+
+    // the slow backend cannot keep up, info messages are dropped but errors are not
+    for (int i = 0; i < 100; ++i)
+      MITK_INFO << "Info " << i;
+
+    // errors are flushed before the emitting call returns
+    bool errorsFlushed = true;
+    for (int i = 0; i < 100; ++i)
+    {
+      MITK_ERROR << "Error " << i;
+      errorsFlushed &= static_cast<unsigned int>(i + 1) == errorCounter.m_NumberOfMessages;
+    }
+
+    mitk::DisableAsynchronousLogging();
+
+    const auto numberOfNewlyDroppedMessages = mitk::GetNumberOfDroppedLogMessages() - numberOfDroppedMessages;
+    MITK_TEST_CONDITION_REQUIRED(numberOfNewlyDroppedMessages > 0, "Test dropping messages of a full buffer.")
+    MITK_TEST_CONDITION_REQUIRED(100 == infoCounter.m_NumberOfMessages + numberOfNewlyDroppedMessages, "Test counting dropped messages.")
+    MITK_TEST_CONDITION_REQUIRED(100 == errorCounter.m_NumberOfMessages, "Test that error messages are not dropped.")
+    MITK_TEST_CONDITION_REQUIRED(errorsFlushed, "Test that error messages are flushed.")
+
+    mitk::UnregisterBackend(&errorCounter);
+    mitk::UnregisterBackend(&infoCounter);
+  }
 };
 
 int mitkLogTest(int /* argc */, char * /*argv*/ [])
@@ -292,6 +403,12 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestEnableDisableLogLevels();
+  mitkLogTestClass::TestAsynchronousLogging();
+  mitkLogTestClass::TestAsynchronousLoggingDropPolicy();
+  mitk::EnableAsynchronousLogging();
+  mitkLogTestClass::TestThreadSaveLog(false);
+  mitk::DisableAsynchronousLogging();
   // TODO actually test file somehow?
 
   // always end with this!
@@ -0,0 +1,157 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCoreServices.h>
+#include <mitkCustomMimeType.h>
+#include <mitkIMimeTypeProvider.h>
+#include <mitkIOUtil.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <usModuleContext.h>
+#include <usGetModuleContext.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+  /** Mime type that peeks into the file like e.g. the DICOM RT mime types do.*/
+  class ContentMimeType : public mitk::CustomMimeType
+  {
+  public:
+    static int NumberOfContentChecks;
+
+    ContentMimeType() : CustomMimeType("application/vnd.mitk.test.content")
+    {
+      this->AddExtension("mtpcontent");
+      this->SetExtensionRequired(true);
+    }
+
+    bool AppliesTo(const std::string &path) const override
+    {
+      if (!CustomMimeType::AppliesTo(path))
+        return false;
+
+      ++NumberOfContentChecks;
+      std::ifstream file(path);
+      std::string magic;
+      file >> magic;
+      return magic == "MTP";
+    }
+
+    ContentMimeType *Clone() const override { return new ContentMimeType(*this); }
+  };
+
+  int ContentMimeType::NumberOfContentChecks = 0;
+
+  bool Contains(const std::vector<mitk::MimeType> &mimeTypes, const std::string &name)
+  {
+    return std::find_if(mimeTypes.begin(), mimeTypes.end(), [&name](const mitk::MimeType &mimeType) {
+             return mimeType.GetName() == name;
+           }) != mimeTypes.end();
+  }
+}
+
+class mitkMimeTypeProviderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMimeTypeProviderTestSuite);
+  MITK_TEST(TestExtensionIndex);
+  MITK_TEST(TestContentCheckOnlyForMatchingExtension);
+  MITK_TEST(TestCachedLookup);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::CustomMimeType *m_ExtensionMimeType;
+  ContentMimeType *m_ContentMimeType;
+  us::ServiceRegistration<mitk::CustomMimeType> m_ExtensionRegistration;
+  us::ServiceRegistration<mitk::CustomMimeType> m_ContentRegistration;
+  std::string m_ContentFilePath;
+
+  void WriteContentFile(const std::string &content)
+  {
+    std::ofstream file(m_ContentFilePath, std::ios::trunc);
+    file << content;
+  }
+
+  static std::vector<mitk::MimeType> GetMimeTypesForFile(const std::string &path)
+  {
+    mitk::CoreServicePointer<mitk::IMimeTypeProvider> provider(mitk::CoreServices::GetMimeTypeProvider());
+    return provider->GetMimeTypesForFile(path);
+  }
+
+public:
+  void setUp() override
+  {
+    m_ExtensionMimeType = new mitk::CustomMimeType("application/vnd.mitk.test.extension");
+    m_ExtensionMimeType->AddExtension("mtp.ext");
+    m_ContentMimeType = new ContentMimeType();
+
+    auto context = us::GetModuleContext();
+    m_ExtensionRegistration = context->RegisterService(m_ExtensionMimeType, us::ServiceProperties());
+    m_ContentRegistration = context->RegisterService<mitk::CustomMimeType>(m_ContentMimeType, us::ServiceProperties());
+
+    std::ofstream tmpStream;
+    m_ContentFilePath = mitk::IOUtil::CreateTemporaryFile(tmpStream, "MimeTypeProviderTest-XXXXXX.mtpcontent");
+    tmpStream << "MTP";
+    tmpStream.close();
+
+    ContentMimeType::NumberOfContentChecks = 0;
+  }
+
+  void tearDown() override
+  {
+    if (m_ExtensionRegistration)
+      m_ExtensionRegistration.Unregister();
+    m_ContentRegistration.Unregister();
+    delete m_ExtensionMimeType;
+    delete m_ContentMimeType;
+    std::remove(m_ContentFilePath.c_str());
+  }
+
+  void TestExtensionIndex()
+  {
+    CPPUNIT_ASSERT(m_ExtensionMimeType->IsExtensionRequired());
+    CPPUNIT_ASSERT(Contains(GetMimeTypesForFile("/some/path/file.mtp.ext"), "application/vnd.mitk.test.extension"));
+    CPPUNIT_ASSERT(Contains(GetMimeTypesForFile("/some/path/FILE.MTP.EXT"), "application/vnd.mitk.test.extension"));
+    CPPUNIT_ASSERT(!Contains(GetMimeTypesForFile("/some/path/file.ext"), "application/vnd.mitk.test.extension"));
+
+    // the index is rebuilt on registration changes
+    m_ExtensionRegistration.Unregister();
+    m_ExtensionRegistration = 0;
+    CPPUNIT_ASSERT(!Contains(GetMimeTypesForFile("/some/path/file.mtp.ext"), "application/vnd.mitk.test.extension"));
+  }
+
+  void TestContentCheckOnlyForMatchingExtension()
+  {
+    GetMimeTypesForFile("/some/path/file.nrrd");
+    GetMimeTypesForFile("/some/path/file.mtp.ext");
+    CPPUNIT_ASSERT_EQUAL(0, ContentMimeType::NumberOfContentChecks);
+
+    CPPUNIT_ASSERT(Contains(GetMimeTypesForFile(m_ContentFilePath), "application/vnd.mitk.test.content"));
+    CPPUNIT_ASSERT_EQUAL(1, ContentMimeType::NumberOfContentChecks);
+  }
+
+  void TestCachedLookup()
+  {
+    CPPUNIT_ASSERT(Contains(GetMimeTypesForFile(m_ContentFilePath), "application/vnd.mitk.test.content"));
+    CPPUNIT_ASSERT(Contains(GetMimeTypesForFile(m_ContentFilePath), "application/vnd.mitk.test.content"));
+    CPPUNIT_ASSERT_EQUAL(1, ContentMimeType::NumberOfContentChecks);
+
+    // a modified file is checked again
+    this->WriteContentFile("Something else");
+    CPPUNIT_ASSERT(!Contains(GetMimeTypesForFile(m_ContentFilePath), "application/vnd.mitk.test.content"));
+    CPPUNIT_ASSERT_EQUAL(2, ContentMimeType::NumberOfContentChecks);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMimeTypeProvider)
@@ -0,0 +1,160 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKey.h"
+
+#include "mitkDataNode.h"
+#include "mitkPointSet.h"
+#include "mitkProperties.h"
+#include "mitkPropertyList.h"
+#include "mitkStringProperty.h"
+#include "mitkVtkPropRenderer.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <vtkRenderWindow.h>
+
+class mitkPropertyKeyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyTestSuite);
+
+  MITK_TEST(Interning);
+  MITK_TEST(EmptyKey);
+  MITK_TEST(PropertyListLookUp);
+  MITK_TEST(PropertyListClone);
+  MITK_TEST(DataNodeLookUp);
+  MITK_TEST(DataNodeBatchLookUp);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::PropertyList::Pointer m_PropertyList;
+
+public:
+  void setUp() override
+  {
+    m_PropertyList = mitk::PropertyList::New();
+    m_PropertyList->SetProperty("visible", mitk::BoolProperty::New(true));
+    m_PropertyList->SetProperty("name", mitk::StringProperty::New("test"));
+    m_PropertyList->SetProperty("opacity", mitk::FloatProperty::New(0.5f));
+  }
+
+  void tearDown() override
+  {
+    m_PropertyList = nullptr;
+  }
+
+  void Interning()
+  {
+    const mitk::PropertyKey key("mitkPropertyKeyTest.a");
+    const mitk::PropertyKey sameKey(std::string("mitkPropertyKeyTest.a"));
+    const mitk::PropertyKey otherKey("mitkPropertyKeyTest.b");
+
+    CPPUNIT_ASSERT(key == sameKey);
+    CPPUNIT_ASSERT_EQUAL(key.GetId(), sameKey.GetId());
+    CPPUNIT_ASSERT(key != otherKey);
+    CPPUNIT_ASSERT_EQUAL(std::string("mitkPropertyKeyTest.a"), key.GetName());
+    CPPUNIT_ASSERT_EQUAL(std::string("mitkPropertyKeyTest.b"), otherKey.GetName());
+  }
+
+  void EmptyKey()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::PropertyKey(""), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::PropertyKey(static_cast<const char *>(nullptr)), mitk::Exception);
+  }
+
+  void PropertyListLookUp()
+  {
+    const mitk::PropertyKey visibleKey("visible");
+    const mitk::PropertyKey unknownKey("mitkPropertyKeyTest.unknown");
+
+    CPPUNIT_ASSERT_EQUAL(m_PropertyList->GetProperty("visible"), m_PropertyList->GetProperty(visibleKey));
+    CPPUNIT_ASSERT(nullptr == m_PropertyList->GetProperty(unknownKey));
+
+    auto replacement = mitk::IntProperty::New(3);
+    m_PropertyList->ReplaceProperty("visible", replacement);
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::BaseProperty *>(replacement), m_PropertyList->GetProperty(visibleKey));
+
+    m_PropertyList->SetProperty("mitkPropertyKeyTest.unknown", mitk::BoolProperty::New(false));
+    CPPUNIT_ASSERT(nullptr != m_PropertyList->GetProperty(unknownKey));
+
+    m_PropertyList->DeleteProperty("visible");
+    CPPUNIT_ASSERT(nullptr == m_PropertyList->GetProperty(visibleKey));
+
+    m_PropertyList->RemoveProperty("mitkPropertyKeyTest.unknown");
+    CPPUNIT_ASSERT(nullptr == m_PropertyList->GetProperty(unknownKey));
+
+    m_PropertyList->Clear();
+    CPPUNIT_ASSERT(nullptr == m_PropertyList->GetProperty(mitk::PropertyKey("name")));
+  }
+
+  void PropertyListClone()
+  {
+    auto clone = m_PropertyList->Clone();
+    const mitk::PropertyKey opacityKey("opacity");
+
+    CPPUNIT_ASSERT(nullptr != clone->GetProperty(opacityKey));
+    CPPUNIT_ASSERT_EQUAL(clone->GetProperty("opacity"), clone->GetProperty(opacityKey));
+    CPPUNIT_ASSERT(m_PropertyList->GetProperty(opacityKey) != clone->GetProperty(opacityKey));
+  }
+
+  void DataNodeLookUp()
+  {
+    auto node = mitk::DataNode::New();
+    auto data = mitk::PointSet::New();
+    data->SetProperty("mitkPropertyKeyTest.data", mitk::BoolProperty::New(true));
+    node->SetData(data);
+    node->SetProperty("opacity", mitk::FloatProperty::New(0.5f));
+
+    auto renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+    auto renderer = mitk::VtkPropRenderer::New("mitkPropertyKeyTest renderer", renderWindow);
+    node->SetProperty("opacity", mitk::FloatProperty::New(0.25f), renderer);
+
+    const mitk::PropertyKey opacityKey("opacity");
+    const mitk::PropertyKey dataKey("mitkPropertyKeyTest.data");
+
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("opacity"), node->GetProperty(opacityKey));
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("opacity", renderer), node->GetProperty(opacityKey, renderer));
+    CPPUNIT_ASSERT(node->GetProperty(opacityKey) != node->GetProperty(opacityKey, renderer));
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("mitkPropertyKeyTest.data"), node->GetProperty(dataKey));
+    CPPUNIT_ASSERT(nullptr == node->GetProperty(dataKey, nullptr, false));
+  }
+
+  void DataNodeBatchLookUp()
+  {
+    auto node = mitk::DataNode::New();
+    auto data = mitk::PointSet::New();
+    data->SetProperty("mitkPropertyKeyTest.data", mitk::BoolProperty::New(true));
+    node->SetData(data);
+    node->SetProperty("color", mitk::ColorProperty::New(1.0f, 0.0f, 0.0f));
+
+    auto renderWindow = vtkSmartPointer<vtkRenderWindow>::New();
+    auto renderer = mitk::VtkPropRenderer::New("mitkPropertyKeyTest batch renderer", renderWindow);
+    node->SetProperty("color", mitk::ColorProperty::New(0.0f, 1.0f, 0.0f), renderer);
+
+    const std::vector<mitk::PropertyKey> keys = {
+      mitk::PropertyKey("color"), mitk::PropertyKey("mitkPropertyKeyTest.data"), mitk::PropertyKey("mitkPropertyKeyTest.unknown")};
+
+    auto properties = node->GetProperties(keys, renderer);
+    CPPUNIT_ASSERT_EQUAL(keys.size(), properties.size());
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("color", renderer), properties[0]);
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("mitkPropertyKeyTest.data"), properties[1]);
+    CPPUNIT_ASSERT(nullptr == properties[2]);
+
+    properties = node->GetProperties(keys, nullptr, false);
+    CPPUNIT_ASSERT_EQUAL(node->GetProperty("color"), properties[0]);
+    CPPUNIT_ASSERT(nullptr == properties[1]);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKey)
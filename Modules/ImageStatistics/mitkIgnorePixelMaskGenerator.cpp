@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkIgnorePixelMaskGenerator.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkItkImageView.h>
 #include <itkImageIterator.h>
 #include <itkImageConstIterator.h>
 #include <mitkITKImageImport.h>
@@ -51,8 +52,10 @@ mitk::Image::ConstPointer IgnorePixelMaskGenerator::DoGetMask(unsigned int)
 
         if (timeSliceImage.IsNull()) mitkThrow() << "Cannot generate mask. Passed time point is not supported by input image. Invalid time point: "<< m_TimePoint;
 
-        // update m_InternalMask
-        AccessByItk(timeSliceImage, InternalCalculateMask);
+        // update m_InternalMask. The mask is generated for the same (all scalar) pixel types the statistics are computed for.
+        AccessByItkReadView<PixelTypeList<MITK_ACCESSBYITK_PIXEL_TYPES>, 2, 3>(timeSliceImage, [this](auto itkImage) {
+          this->InternalCalculateMask(itkImage);
+        });
         m_InternalMask->SetGeometry(timeSliceImage->GetGeometry());
 
         this->Modified();
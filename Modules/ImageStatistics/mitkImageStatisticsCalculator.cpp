@@ -15,18 +15,27 @@ found in the LICENSE file.
 #include <mitkStatisticsImageFilter.h>
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
-#include <mitkImageCast.h>
 #include <mitkImageStatisticsConstants.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
+#include <mitkItkImageView.h>
 #include <mitkMaskUtilities.h>
 #include <mitkMinMaxImageFilterWithIndex.h>
 #include <mitkMinMaxLabelmageFilterWithIndex.h>
 #include <mitkitkMaskImageFilter.h>
 #include <mitkNodePredicateGeometry.h>
 
+#include <itkCastImageFilter.h>
+
 namespace mitk
 {
+  namespace
+  {
+    /** Statistics are supported for images of all scalar pixel types (like AccessByItk), so this list cannot
+    be restricted. The input is accessed by a zero-copy view (see AccessByItkReadView()) though.*/
+    using StatisticsPixelTypes = PixelTypeList<MITK_ACCESSBYITK_PIXEL_TYPES>;
+  }
+
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
   {
     if (image != m_Image)
@@ -153,12 +162,16 @@ namespace mitk
           if (m_MaskGenerator.IsNull() && m_SecondaryMaskGenerator.IsNull())
           {
             // 1) calculate statistics unmasked:
-            AccessByItk_1(m_ImageTimeSlice, InternalCalculateStatisticsUnmasked, timeStep)
+            AccessByItkReadView<StatisticsPixelTypes, 2, 3>(m_ImageTimeSlice, [&](auto itkImage) {
+              this->InternalCalculateStatisticsUnmasked(itkImage, timeStep);
+            });
           }
           else
           {
             // 2) calculate statistics masked
-            AccessByItk_1(m_ImageTimeSlice, InternalCalculateStatisticsMasked, timeStep)
+            AccessByItkReadView<StatisticsPixelTypes, 2, 3>(m_ImageTimeSlice, [&](auto itkImage) {
+              this->InternalCalculateStatisticsMasked(itkImage, timeStep);
+            });
           }
         }
       }
@@ -300,19 +313,23 @@ namespace mitk
     }
 
     // maskImage has to have the same dimension as image
-    typename MaskType::ConstPointer maskImage = MaskType::New();
-    try
+    typename MaskType::ConstPointer maskImage;
+    if (CanViewAsItkImage<MaskPixelType, VImageDimension>(m_InternalMask))
     {
-      // try to access the pixel values directly (no copying or casting). Only works if mask pixels are of pixelType
-      // unsigned short
+      // access the pixel values directly (no copying or casting)
       maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(m_InternalMask);
     }
-    catch (const itk::ExceptionObject &)
+    else
     {
-      typename MaskType::Pointer noneConstMaskImage; //needed to work around the fact that CastToItkImage currently does not support const itk images.
-      // if the pixel type of the mask is not short, then we have to make a copy of m_InternalMask (and cast the values)
-      CastToItkImage(m_InternalMask, noneConstMaskImage);
-      maskImage = noneConstMaskImage;
+      // if the pixel type of the mask is not unsigned short, then we have to make a copy of m_InternalMask (and cast the values)
+      AccessByItkReadView<PixelTypeList<unsigned char, char, short, unsigned int, int, float, double>, VImageDimension>(
+        m_InternalMask, [&maskImage](auto itkMask) {
+          using InputMaskType = std::remove_cv_t<std::remove_pointer_t<decltype(itkMask)>>;
+          auto castFilter = itk::CastImageFilter<InputMaskType, MaskType>::New();
+          castFilter->SetInput(itkMask);
+          castFilter->Update();
+          maskImage = castFilter->GetOutput();
+        });
     }
 
     // if we have a secondary mask (say a ignoreZeroPixelMask) we need to combine the masks (corresponds to AND)
@@ -15,6 +15,9 @@ found in the LICENSE file.
 
 #include <mitkLogBackendBase.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <sstream>
 
 #include <MitkLogExports.h>
@@ -60,6 +63,52 @@ namespace mitk
    */
   bool MITKLOG_EXPORT IsBackendEnabled(LogBackendBase::OutputType type);
 
+  /** \brief Enable messages of the given level (all levels are enabled by default).
+   */
+  void MITKLOG_EXPORT EnableLogLevel(LogLevel level);
+
+  /** \brief Disable messages of the given level.
+   *
+   * Messages of disabled levels are discarded by the PseudoLogStream before they are formatted.
+   */
+  void MITKLOG_EXPORT DisableLogLevel(LogLevel level);
+
+  /** \brief Check whether messages of this level are enabled.
+   */
+  bool MITKLOG_EXPORT IsLogLevelEnabled(LogLevel level);
+
+  /** \brief Relay log messages to the backends on a background thread.
+   *
+   * Emitting a message only moves it into a lock-free ring buffer. The messages are cropped and passed
+   * to the backends in the order of the buffer by a single logging thread, so backends are not called
+   * concurrently anymore. If the buffer is full, info, warning and debug messages are dropped (see
+   * GetNumberOfDroppedLogMessages()) and a warning about the number of dropped messages is logged
+   * afterwards. Error and fatal messages wait for free space and are flushed before the emitting
+   * call returns, so they reach the backends even if the application crashes afterwards.
+   *
+   * \param capacity Maximum number of queued messages.
+   */
+  void MITKLOG_EXPORT EnableAsynchronousLogging(std::size_t capacity = 8192);
+
+  /** \brief Stop the logging thread after all queued messages were processed.
+   *
+   * Messages are relayed synchronously afterwards. Must be called before the application shuts
+   * down, otherwise queued messages may be lost.
+   */
+  void MITKLOG_EXPORT DisableAsynchronousLogging();
+
+  bool MITKLOG_EXPORT IsAsynchronousLoggingEnabled();
+
+  /** \brief Wait until all messages emitted so far were processed by the backends.
+   *
+   * Does nothing if asynchronous logging is disabled.
+   */
+  void MITKLOG_EXPORT FlushLog();
+
+  /** \brief Number of messages dropped because the asynchronous log buffer was full.
+   */
+  std::uint64_t MITKLOG_EXPORT GetNumberOfDroppedLogMessages();
+
   /** \brief Simulates a std::cout stream.
    *
    * Should only be used by the macros defined in the file mitkLog.h.
@@ -68,10 +117,19 @@ namespace mitk
   {
   public:
     PseudoLogStream(LogLevel level, const std::string& filePath, int lineNumber, const std::string& functionName)
-      : m_Disabled(false),
-        m_Message(level, filePath, lineNumber, functionName),
-        m_Stream(std::stringstream::out)
+      : m_Disabled(!IsLogLevelEnabled(level))
+    {
+      if (!m_Disabled)
+        this->Initialize(level, filePath, lineNumber, functionName);
+    }
+
+    /** \brief Used by the macros, so no strings are created for messages of disabled levels.
+     */
+    PseudoLogStream(LogLevel level, const char* filePath, int lineNumber, const char* functionName)
+      : m_Disabled(!IsLogLevelEnabled(level))
     {
+      if (!m_Disabled)
+        this->Initialize(level, filePath, lineNumber, functionName);
     }
 
     /** \brief The encapsulated message is written to the backend.
@@ -80,9 +138,9 @@ namespace mitk
     {
       if (!m_Disabled)
       {
-        m_Message.Message = m_Stream.str();
-        m_Message.ModuleName = MITKLOG_MODULENAME;
-        DistributeToBackends(m_Message);
+        m_Message->Message = m_Stream->str();
+        m_Message->ModuleName = MITKLOG_MODULENAME;
+        DistributeToBackends(*m_Message);
       }
     }
 
@@ -90,15 +148,7 @@ namespace mitk
     PseudoLogStream& operator<<(const T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << data;
-
-        m_Stream.imbue(originalLocale);
-      }
+        *m_Stream << data;
 
       return *this;
     }
@@ -107,15 +157,7 @@ namespace mitk
     PseudoLogStream& operator<<(T& data)
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << data;
-
-        m_Stream.imbue(originalLocale);
-      }
+        *m_Stream << data;
 
       return *this;
     }
@@ -123,15 +165,7 @@ namespace mitk
     PseudoLogStream& operator<<(std::ostream& (*func)(std::ostream&))
     {
       if (!m_Disabled)
-      {
-        std::locale C("C");
-        std::locale originalLocale = m_Stream.getloc();
-        m_Stream.imbue(C);
-
-        m_Stream << func;
-
-        m_Stream.imbue(originalLocale);
-      }
+        *m_Stream << func;
 
       return *this;
     }
@@ -144,10 +178,10 @@ namespace mitk
     {
       if (!m_Disabled)
       {
-        if (m_Message.Category.length())
-          m_Message.Category += ".";
+        if (m_Message->Category.length())
+          m_Message->Category += ".";
 
-        m_Message.Category += category;
+        m_Message->Category += category;
       }
 
       return *this;
@@ -164,9 +198,18 @@ namespace mitk
     }
 
   protected:
+    void Initialize(LogLevel level, const std::string& filePath, int lineNumber, const std::string& functionName)
+    {
+      m_Message.emplace(level, filePath, lineNumber, functionName);
+      m_Stream.emplace(std::ostringstream::out);
+
+      // Messages are formatted independent of the global locale.
+      m_Stream->imbue(std::locale::classic());
+    }
+
     bool m_Disabled;
-    LogMessage m_Message;
-    std::stringstream m_Stream;
+    std::optional<LogMessage> m_Message;
+    std::optional<std::ostringstream> m_Stream;
   };
 
   /**
@@ -13,25 +13,68 @@ found in the LICENSE file.
 #include <mitkLog.h>
 #include <mitkLogBackendCout.h>
 
+#include "mitkLogMessageRingBuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 
 static std::list<mitk::LogBackendBase*> backends;
 static std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
 
-void mitk::RegisterBackend(LogBackendBase* backend)
-{
-  backends.push_back(backend);
-}
+// Guards the two containers above. Recursive, since backends may log while processing a message.
+static std::recursive_mutex backendsMutex;
 
-void mitk::UnregisterBackend(LogBackendBase* backend)
-{
-  backends.remove(backend);
-}
+static std::atomic<unsigned int> enabledLogLevels(~0u);
 
-void mitk::DistributeToBackends(LogMessage& message)
+namespace
 {
-  // Crop Message
+  unsigned int GetLogLevelBit(mitk::LogLevel level)
+  {
+    return 1u << static_cast<unsigned int>(level);
+  }
+
+  /** State of the asynchronous log pipeline. It is never destroyed, so messages emitted during
+   * static destruction do not access a destroyed object.*/
+  struct AsynchronousLogging
+  {
+    std::atomic<bool> Enabled{false};
+
+    /** Number of threads that currently push into the buffer. DisableAsynchronousLogging() waits
+     * for them before the buffer is drained.*/
+    std::atomic<unsigned int> ActiveProducers{0};
+
+    std::unique_ptr<mitk::LogMessageRingBuffer> Buffer;
+    std::thread Thread;
+    std::atomic<std::thread::id> ThreadId{std::thread::id()};
+    std::atomic<bool> Stop{false};
+
+    std::atomic<std::uint64_t> NumberOfQueuedMessages{0};
+    std::atomic<std::uint64_t> NumberOfProcessedMessages{0};
+    std::atomic<std::uint64_t> NumberOfDroppedMessages{0};
+    std::atomic<std::uint64_t> NumberOfUnreportedDroppedMessages{0};
+
+    std::mutex Mutex;
+    std::atomic<bool> Waiting{false};
+    std::condition_variable WakeUp;
+    std::condition_variable Processed;
+
+    // serializes Enable/DisableAsynchronousLogging()
+    std::mutex ControlMutex;
+  };
+
+  AsynchronousLogging& GetAsynchronousLogging()
+  {
+    static auto* asynchronousLogging = new AsynchronousLogging;
+    return *asynchronousLogging;
+  }
+
+  void CropMessage(mitk::LogMessage& message)
   {
     std::string::size_type i = message.Message.find_last_not_of(" \t\f\v\n\r");
 
@@ -40,41 +83,248 @@ void mitk::DistributeToBackends(LogMessage& message)
       : "";
   }
 
-  // create dummy backend if there is no backend registered (so we have an output anyway)
-  static LogBackendCout* dummyBackend = nullptr;
+  void ProcessMessage(mitk::LogMessage& message)
+  {
+    CropMessage(message);
+
+    std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+    // create dummy backend if there is no backend registered (so we have an output anyway)
+    static mitk::LogBackendCout* dummyBackend = nullptr;
 
-  if (backends.empty() && dummyBackend == nullptr)
+    if (backends.empty() && dummyBackend == nullptr)
+    {
+      dummyBackend = new mitk::LogBackendCout;
+      mitk::RegisterBackend(dummyBackend);
+    }
+    else if (backends.size() > 1 && dummyBackend != nullptr)
+    {
+      // if there was added another backend remove the dummy backend and delete it
+      mitk::UnregisterBackend(dummyBackend);
+      delete dummyBackend;
+      dummyBackend = nullptr;
+    }
+
+    // iterate through all registered images and call the ProcessMessage() methods of the backends
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (mitk::IsBackendEnabled((*i)->GetOutputType()))
+        (*i)->ProcessMessage(message);
+    }
+  }
+
+  void ReportDroppedMessages(AsynchronousLogging& logging)
   {
-    dummyBackend = new LogBackendCout;
-    RegisterBackend(dummyBackend);
+    const auto numberOfDroppedMessages = logging.NumberOfUnreportedDroppedMessages.exchange(0);
+    if (0 == numberOfDroppedMessages)
+      return;
+
+    mitk::LogMessage message(mitk::LogLevel::Warn, __FILE__, __LINE__, __FUNCTION__);
+    message.ModuleName = MITKLOG_MODULENAME;
+    message.Message = std::to_string(numberOfDroppedMessages) + " log message(s) dropped, the log buffer was full.";
+    ProcessMessage(message);
   }
-  else if (backends.size() > 1 && dummyBackend != nullptr)
+
+  void RunLoggingThread(AsynchronousLogging& logging)
+  {
+    std::optional<mitk::LogMessage> message;
+
+    while (true)
+    {
+      while (logging.Buffer->TryPop(message))
+      {
+        ProcessMessage(*message);
+        message.reset();
+        ++logging.NumberOfProcessedMessages;
+      }
+
+      ReportDroppedMessages(logging);
+
+      std::unique_lock<std::mutex> lock(logging.Mutex);
+      logging.Processed.notify_all();
+
+      if (logging.Stop && logging.NumberOfProcessedMessages == logging.NumberOfQueuedMessages)
+        break;
+
+      // Producers only notify if the logging thread waits. A missed notification is caught by the timeout.
+      logging.Waiting = true;
+      logging.WakeUp.wait_for(lock, std::chrono::milliseconds(100), [&logging]() {
+        return logging.Stop || logging.NumberOfProcessedMessages != logging.NumberOfQueuedMessages;
+      });
+      logging.Waiting = false;
+    }
+  }
+
+  void WakeUpLoggingThread(AsynchronousLogging& logging)
   {
-    // if there was added another backend remove the dummy backend and delete it
-    UnregisterBackend(dummyBackend);
-    delete dummyBackend;
-    dummyBackend = nullptr;
+    if (logging.Waiting)
+      logging.WakeUp.notify_one();
   }
 
-  // iterate through all registered images and call the ProcessMessage() methods of the backends
-  for (auto i = backends.begin(); i != backends.end(); ++i)
+  /** Returns false if the message has to be processed synchronously.*/
+  bool QueueMessage(AsynchronousLogging& logging, mitk::LogMessage& message)
+  {
+    const bool isLoggingThread = std::this_thread::get_id() == logging.ThreadId.load();
+
+    while (!logging.Buffer->TryPush(message))
+    {
+      if (message.Level == mitk::LogLevel::Error || message.Level == mitk::LogLevel::Fatal)
+      {
+        // The logging thread cannot wait for itself.
+        if (isLoggingThread)
+          return false;
+
+        WakeUpLoggingThread(logging);
+        std::this_thread::yield();
+        continue;
+      }
+
+      ++logging.NumberOfDroppedMessages;
+      ++logging.NumberOfUnreportedDroppedMessages;
+      return true;
+    }
+
+    ++logging.NumberOfQueuedMessages;
+    WakeUpLoggingThread(logging);
+    return true;
+  }
+}
+
+void mitk::RegisterBackend(LogBackendBase* backend)
+{
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+  backends.push_back(backend);
+}
+
+void mitk::UnregisterBackend(LogBackendBase* backend)
+{
+  // The backend is usually deleted afterwards, so queued messages are passed to it first.
+  FlushLog();
+
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+  backends.remove(backend);
+}
+
+void mitk::DistributeToBackends(LogMessage& message)
+{
+  auto& logging = GetAsynchronousLogging();
+
+  ++logging.ActiveProducers;
+  const bool queued = logging.Enabled && QueueMessage(logging, message);
+  --logging.ActiveProducers;
+
+  if (!queued)
+  {
+    ProcessMessage(message);
+  }
+  else if (message.Level == LogLevel::Error || message.Level == LogLevel::Fatal)
   {
-    if (IsBackendEnabled((*i)->GetOutputType()))
-      (*i)->ProcessMessage(message);
+    FlushLog();
   }
 }
 
 void mitk::EnableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.erase(type);
 }
 
 void mitk::DisableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.insert(type);
 }
 
 bool mitk::IsBackendEnabled(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   return disabledBackendTypes.find(type) == disabledBackendTypes.end();
 }
+
+void mitk::EnableLogLevel(LogLevel level)
+{
+  enabledLogLevels |= GetLogLevelBit(level);
+}
+
+void mitk::DisableLogLevel(LogLevel level)
+{
+  enabledLogLevels &= ~GetLogLevelBit(level);
+}
+
+bool mitk::IsLogLevelEnabled(LogLevel level)
+{
+  return 0 != (enabledLogLevels.load(std::memory_order_relaxed) & GetLogLevelBit(level));
+}
+
+void mitk::EnableAsynchronousLogging(std::size_t capacity)
+{
+  auto& logging = GetAsynchronousLogging();
+  std::lock_guard<std::mutex> lock(logging.ControlMutex);
+
+  if (logging.Enabled)
+    return;
+
+  logging.Buffer = std::make_unique<LogMessageRingBuffer>(capacity);
+  logging.NumberOfQueuedMessages = 0;
+  logging.NumberOfProcessedMessages = 0;
+  logging.Stop = false;
+  logging.Thread = std::thread(RunLoggingThread, std::ref(logging));
+  logging.ThreadId = logging.Thread.get_id();
+  logging.Enabled = true;
+}
+
+void mitk::DisableAsynchronousLogging()
+{
+  auto& logging = GetAsynchronousLogging();
+
+  // The logging thread cannot wait for itself, so backends must not call this method.
+  if (std::this_thread::get_id() == logging.ThreadId.load())
+    return;
+
+  std::lock_guard<std::mutex> lock(logging.ControlMutex);
+
+  if (!logging.Enabled)
+    return;
+
+  logging.Enabled = false;
+
+  // Messages that are pushed right now are still processed by the logging thread.
+  while (0 != logging.ActiveProducers)
+    std::this_thread::yield();
+
+  {
+    std::lock_guard<std::mutex> wakeUpLock(logging.Mutex);
+    logging.Stop = true;
+  }
+  logging.WakeUp.notify_one();
+
+  logging.Thread.join();
+  logging.ThreadId = std::thread::id();
+  logging.Buffer.reset();
+}
+
+bool mitk::IsAsynchronousLoggingEnabled()
+{
+  return GetAsynchronousLogging().Enabled;
+}
+
+void mitk::FlushLog()
+{
+  auto& logging = GetAsynchronousLogging();
+
+  if (!logging.Enabled || std::this_thread::get_id() == logging.ThreadId.load())
+    return;
+
+  const std::uint64_t numberOfQueuedMessages = logging.NumberOfQueuedMessages;
+
+  std::unique_lock<std::mutex> lock(logging.Mutex);
+  logging.WakeUp.notify_one();
+  logging.Processed.wait(lock, [&logging, numberOfQueuedMessages]() {
+    return !logging.Enabled || logging.NumberOfProcessedMessages >= numberOfQueuedMessages;
+  });
+}
+
+std::uint64_t mitk::GetNumberOfDroppedLogMessages()
+{
+  return GetAsynchronousLogging().NumberOfDroppedMessages;
+}
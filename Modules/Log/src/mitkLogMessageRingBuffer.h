@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLogMessageRingBuffer_h
+#define mitkLogMessageRingBuffer_h
+
+#include <mitkLogMessage.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace mitk
+{
+  /** \brief Bounded lock-free queue of log messages.
+   *
+   * Multiple threads may push and pop concurrently. Each cell carries a sequence number that tells
+   * whether it is free for the producer or filled for the consumer of a given position, so a
+   * position is claimed by a single compare-and-swap (bounded MPMC queue by Dmitry Vyukov).
+   */
+  class LogMessageRingBuffer
+  {
+  public:
+    /** \param capacity Maximum number of queued messages; rounded up to a power of two.
+     */
+    explicit LogMessageRingBuffer(std::size_t capacity)
+    {
+      std::size_t size = 2;
+      while (size < capacity)
+        size <<= 1;
+
+      m_Mask = size - 1;
+      m_Cells.reset(new Cell[size]);
+
+      for (std::size_t i = 0; i < size; ++i)
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+
+      m_EnqueuePosition.store(0, std::memory_order_relaxed);
+      m_DequeuePosition.store(0, std::memory_order_relaxed);
+    }
+
+    LogMessageRingBuffer(const LogMessageRingBuffer&) = delete;
+    LogMessageRingBuffer& operator=(const LogMessageRingBuffer&) = delete;
+
+    std::size_t GetCapacity() const
+    {
+      return m_Mask + 1;
+    }
+
+    /** \return False if the buffer is full. The message is left untouched in this case.
+     */
+    bool TryPush(LogMessage& message)
+    {
+      Cell* cell = nullptr;
+      auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const auto sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (0 == difference)
+        {
+          if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false;
+        }
+        else
+        {
+          position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Message.emplace(std::move(message));
+      cell->Sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    /** \return False if the buffer is empty.
+     */
+    bool TryPop(std::optional<LogMessage>& message)
+    {
+      Cell* cell = nullptr;
+      auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+
+      while (true)
+      {
+        cell = &m_Cells[position & m_Mask];
+        const auto sequence = cell->Sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+
+        if (0 == difference)
+        {
+          if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false;
+        }
+        else
+        {
+          position = m_DequeuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      message.emplace(std::move(*cell->Message));
+      cell->Message.reset();
+      cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+      return true;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      std::optional<LogMessage> Message;
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    std::size_t m_Mask;
+
+    // separate cache lines, producers and consumer must not invalidate each other's position
+    alignas(64) std::atomic<std::size_t> m_EnqueuePosition;
+    alignas(64) std::atomic<std::size_t> m_DequeuePosition;
+  };
+}
+
+#endif
@@ -1,5 +1,8 @@
 set(MODULE_TESTS
+    mitkIncrementalLabelSurfaceMesherTest.cpp
     mitkLabelTest.cpp
+    mitkLabelGroupBrickStorageTest.cpp
+    mitkLabelOccupancyIndexTest.cpp
     mitkLabelSetImageTest.cpp
     mitkLegacyLabelSetImageIOTest.cpp
     mitkMultiLabelSegmentationIOTest.cpp
@@ -0,0 +1,187 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkIncrementalLabelSurfaceMesher.h>
+#include <mitkLabelSetImage.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkPolyData.h>
+
+class mitkIncrementalLabelSurfaceMesherTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIncrementalLabelSurfaceMesherTestSuite);
+  MITK_TEST(TestFullUpdate);
+  MITK_TEST(TestStitching);
+  MITK_TEST(TestReportedModification);
+  MITK_TEST(TestUnreportedModification);
+  MITK_TEST(TestRemovedLabel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::MultiLabelSegmentation::Pointer m_Segmentation;
+
+  void SetCube(mitk::Label::PixelType value, const itk::Index<3>& lower, itk::IndexValueType edgeLength)
+  {
+    auto groupImage = m_Segmentation->GetGroupImage(0);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+      for (auto z = lower[2]; z < lower[2] + edgeLength; ++z)
+        for (auto y = lower[1]; y < lower[1] + edgeLength; ++y)
+          for (auto x = lower[0]; x < lower[0] + edgeLength; ++x)
+            accessor.SetPixelByIndex({ { x, y, z } }, value);
+    }
+    groupImage->Modified();
+  }
+
+  mitk::IncrementalLabelSurfaceMesher::Pointer CreateMesher(mitk::Label::PixelType value)
+  {
+    auto mesher = mitk::IncrementalLabelSurfaceMesher::New();
+    mesher->SetSegmentation(m_Segmentation);
+    mesher->SetLabelValue(value);
+    mesher->Update();
+    return mesher;
+  }
+
+  static void AssertEqualSurfaces(mitk::IncrementalLabelSurfaceMesher* expected, mitk::IncrementalLabelSurfaceMesher* result)
+  {
+    auto expectedPolyData = expected->GetOutput()->GetVtkPolyData();
+    auto resultPolyData = result->GetOutput()->GetVtkPolyData();
+    CPPUNIT_ASSERT_EQUAL(expectedPolyData->GetNumberOfPoints(), resultPolyData->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(expectedPolyData->GetNumberOfPolys(), resultPolyData->GetNumberOfPolys());
+  }
+
+public:
+  void setUp() override
+  {
+    // spans 3x2x2 blocks
+    unsigned int dimensions[3] = { 70, 40, 33 };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 3, dimensions);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+      std::fill_n(accessor.GetData(), 70 * 40 * 33, 0);
+    }
+
+    m_Segmentation = mitk::MultiLabelSegmentation::New();
+    m_Segmentation->Initialize(image);
+    m_Segmentation->AddLabel(mitk::Label::New(1, "Label1"), 0);
+    m_Segmentation->AddLabel(mitk::Label::New(2, "Label2"), 0);
+
+    // label 1 lies within the first block, label 2 crosses the border between the first two blocks in x.
+    this->SetCube(1, { { 2, 2, 2 } }, 6);
+    this->SetCube(2, { { 28, 2, 2 } }, 6);
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+  }
+
+  void TestFullUpdate()
+  {
+    auto mesher = this->CreateMesher(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mesher->GetNumberOfUpdatedBlocks());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mesher->GetNumberOfSurfaceBlocks());
+
+    auto polyData = mesher->GetOutput()->GetVtkPolyData();
+    CPPUNIT_ASSERT(polyData->GetNumberOfPolys() > 0);
+
+    // voxel centers are at integer world coordinates, the surface lies half way to the unlabeled neighbors.
+    double bounds[6];
+    polyData->GetBounds(bounds);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, bounds[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(7.5, bounds[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, bounds[4], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(7.5, bounds[5], mitk::eps);
+
+    // nothing changed, nothing to do
+    mesher->Update();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), mesher->GetNumberOfUpdatedBlocks());
+  }
+
+  void TestStitching()
+  {
+    auto mesher = this->CreateMesher(2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mesher->GetNumberOfSurfaceBlocks());
+
+    // both labels are cubes of the same size, the stitched surface must not contain duplicated points.
+    auto referenceMesher = this->CreateMesher(1);
+    AssertEqualSurfaces(referenceMesher, mesher);
+  }
+
+  void TestReportedModification()
+  {
+    auto mesher = this->CreateMesher(1);
+
+    auto groupImage = m_Segmentation->GetGroupImage(0);
+    const auto mTimeBeforeModification = groupImage->GetMTime();
+    this->SetCube(1, { { 60, 30, 25 } }, 1);
+
+    mitk::LabelOccupancyIndex::RegionType region;
+    region.SetIndex({ { 60, 30, 25 } });
+    region.SetSize({ { 1, 1, 1 } });
+    m_Segmentation->ReportModifiedGroupRegion(0, 0, region, mTimeBeforeModification);
+
+    mitk::LabelOccupancyIndex::RegionType modifiedRegion;
+    CPPUNIT_ASSERT(m_Segmentation->GetModifiedGroupRegion(0, 0, mTimeBeforeModification, modifiedRegion));
+    CPPUNIT_ASSERT_EQUAL(region, modifiedRegion);
+
+    mesher->Update();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mesher->GetNumberOfUpdatedBlocks());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mesher->GetNumberOfSurfaceBlocks());
+    AssertEqualSurfaces(this->CreateMesher(1), mesher);
+
+    // erasing the voxel again
+    const auto mTimeBeforeErasing = groupImage->GetMTime();
+    this->SetCube(0, { { 60, 30, 25 } }, 1);
+    m_Segmentation->ReportModifiedGroupRegion(0, 0, region, mTimeBeforeErasing);
+
+    mesher->Update();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mesher->GetNumberOfUpdatedBlocks());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), mesher->GetNumberOfSurfaceBlocks());
+    AssertEqualSurfaces(this->CreateMesher(1), mesher);
+  }
+
+  void TestUnreportedModification()
+  {
+    auto mesher = this->CreateMesher(1);
+
+    const auto mTimeBeforeModification = m_Segmentation->GetGroupImage(0)->GetMTime();
+    this->SetCube(1, { { 60, 30, 25 } }, 1);
+
+    mitk::LabelOccupancyIndex::RegionType modifiedRegion;
+    CPPUNIT_ASSERT(!m_Segmentation->GetModifiedGroupRegion(0, 0, mTimeBeforeModification, modifiedRegion));
+
+    // the whole bounding region of the label is meshed again
+    mesher->Update();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), mesher->GetNumberOfUpdatedBlocks());
+    AssertEqualSurfaces(this->CreateMesher(1), mesher);
+  }
+
+  void TestRemovedLabel()
+  {
+    auto mesher = this->CreateMesher(1);
+    CPPUNIT_ASSERT(mesher->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() > 0);
+
+    m_Segmentation->RemoveLabel(1);
+    mesher->Update();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), mesher->GetNumberOfSurfaceBlocks());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), mesher->GetOutput()->GetVtkPolyData()->GetNumberOfPolys());
+
+    auto emptyMesher = mitk::IncrementalLabelSurfaceMesher::New();
+    CPPUNIT_ASSERT_THROW(emptyMesher->Update(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIncrementalLabelSurfaceMesher)
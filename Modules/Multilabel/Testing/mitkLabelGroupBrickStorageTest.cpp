@@ -0,0 +1,208 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelGroupBrickStorage.h>
+#include <mitkLabelSetImage.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkLabelGroupBrickStorageTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelGroupBrickStorageTestSuite);
+  MITK_TEST(TestInitialize);
+  MITK_TEST(TestWriteToImage);
+  MITK_TEST(TestExtractSlice);
+  MITK_TEST(TestSetPixel);
+  MITK_TEST(TestCompressGroup);
+  MITK_TEST(TestCompressIdleGroups);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::LabelGroupBrickStorage::Pointer m_Storage;
+
+  static mitk::Image::Pointer CreateEmptyImage()
+  {
+    // spans 3x2x2 bricks, the last bricks are only partially covered by the image.
+    unsigned int dimensions[3] = { 70, 40, 33 };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(image);
+    std::fill_n(accessor.GetData(), 70 * 40 * 33, 0);
+    return image;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = CreateEmptyImage();
+
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_Image);
+    accessor.SetPixelByIndex({ { 1, 2, 3 } }, 1);
+    accessor.SetPixelByIndex({ { 69, 39, 32 } }, 2);
+    accessor.SetPixelByIndex({ { 65, 5, 3 } }, 3);
+
+    m_Storage = mitk::LabelGroupBrickStorage::New();
+    m_Storage->Initialize(m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Storage = nullptr;
+  }
+
+  void TestInitialize()
+  {
+    CPPUNIT_ASSERT(m_Storage->IsInitialized());
+    CPPUNIT_ASSERT_EQUAL(1u, m_Storage->GetNumberOfTimeSteps());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Storage->GetNumberOfAllocatedBricks());
+
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(1), m_Storage->GetPixel({ { 1, 2, 3 } }, 0));
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(2), m_Storage->GetPixel({ { 69, 39, 32 } }, 0));
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(0), m_Storage->GetPixel({ { 40, 20, 10 } }, 0));
+
+    CPPUNIT_ASSERT_THROW(m_Storage->GetPixel({ { 70, 0, 0 } }, 0), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(m_Storage->GetPixel({ { 0, 0, 0 } }, 1), mitk::Exception);
+
+    m_Storage->Clear();
+    CPPUNIT_ASSERT(!m_Storage->IsInitialized());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Storage->GetNumberOfAllocatedBricks());
+  }
+
+  void TestWriteToImage()
+  {
+    auto image = mitk::Image::New();
+    image->Initialize(m_Image);
+    m_Storage->WriteToImage(image);
+
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> expected(m_Image);
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> result(image);
+    CPPUNIT_ASSERT(std::equal(expected.GetData(), expected.GetData() + 70 * 40 * 33, result.GetData()));
+
+    unsigned int wrongDimensions[3] = { 70, 40, 32 };
+    auto wrongImage = mitk::Image::New();
+    wrongImage->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 3, wrongDimensions);
+    CPPUNIT_ASSERT_THROW(m_Storage->WriteToImage(wrongImage), mitk::Exception);
+  }
+
+  void TestExtractSlice()
+  {
+    // slice orthogonal to z: x runs fastest, then y
+    std::vector<mitk::Label::PixelType> slice(70 * 40, 99);
+    m_Storage->ExtractSlice(2, 3, 0, slice.data());
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(1), slice[2 * 70 + 1]);
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(3), slice[5 * 70 + 65]);
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(2), std::count_if(slice.begin(), slice.end(), [](mitk::Label::PixelType value) { return value != 0; }));
+
+    // slice orthogonal to x: y runs fastest, then z
+    slice.assign(40 * 33, 99);
+    m_Storage->ExtractSlice(0, 69, 0, slice.data());
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(2), slice[32 * 40 + 39]);
+    CPPUNIT_ASSERT_EQUAL(std::ptrdiff_t(1), std::count_if(slice.begin(), slice.end(), [](mitk::Label::PixelType value) { return value != 0; }));
+
+    CPPUNIT_ASSERT_THROW(m_Storage->ExtractSlice(1, 40, 0, slice.data()), mitk::Exception);
+  }
+
+  void TestSetPixel()
+  {
+    m_Storage->SetPixel({ { 40, 20, 10 } }, 0, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Storage->GetNumberOfAllocatedBricks());
+
+    m_Storage->SetPixel({ { 40, 20, 10 } }, 0, 4);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_Storage->GetNumberOfAllocatedBricks());
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(4), m_Storage->GetPixel({ { 40, 20, 10 } }, 0));
+    CPPUNIT_ASSERT_EQUAL(m_Storage->GetNumberOfAllocatedBricks() * 32 * 32 * 32 * sizeof(mitk::Label::PixelType), m_Storage->GetAllocatedMemorySize());
+  }
+
+  void TestCompressGroup()
+  {
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(CreateEmptyImage());
+    segmentation->UpdateGroupImage(0, m_Image, 0);
+
+    CPPUNIT_ASSERT(!segmentation->IsGroupCompressed(0));
+
+    // the group image is kept in place while its data is accessed, the group stays dense
+    const auto denseGroupImage = segmentation->GetGroupImage(0);
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(denseGroupImage);
+      segmentation->CompressGroup(0);
+      CPPUNIT_ASSERT(!segmentation->IsGroupCompressed(0));
+    }
+
+    // compressing keeps the group image instance and does not modify the segmentation
+    const auto segmentationMTime = segmentation->GetMTime();
+    const auto groupImageMTime = denseGroupImage->GetMTime();
+    segmentation->CompressGroup(0);
+    CPPUNIT_ASSERT(segmentation->IsGroupCompressed(0));
+    CPPUNIT_ASSERT(nullptr != segmentation->GetGroupBrickStorage(0));
+    CPPUNIT_ASSERT_EQUAL(segmentationMTime, segmentation->GetMTime());
+    CPPUNIT_ASSERT_EQUAL(groupImageMTime, denseGroupImage->GetMTime());
+    CPPUNIT_ASSERT(segmentation->GetGroupContentObject(0) == segmentation->GetGroupBrickStorage(0));
+
+    auto slab = segmentation->GetGroupSlab(0, 2, 3, 0);
+    CPPUNIT_ASSERT(segmentation->IsGroupCompressed(0));
+    CPPUNIT_ASSERT_EQUAL(1u, slab->GetDimension(2));
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> slabAccessor(slab);
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(1), slabAccessor.GetPixelByIndex({ { 1, 2, 0 } }));
+
+    auto clone = segmentation->Clone();
+    CPPUNIT_ASSERT(clone->IsGroupCompressed(0));
+    CPPUNIT_ASSERT(clone->GetGroupBrickStorage(0) != segmentation->GetGroupBrickStorage(0));
+    CPPUNIT_ASSERT_EQUAL(segmentation->GetGroupBrickStorage(0)->GetNumberOfAllocatedBricks(), clone->GetGroupBrickStorage(0)->GetNumberOfAllocatedBricks());
+
+    // reading the group does not discard its storage, an unchanged group is compressed again without a scan
+    auto storage = segmentation->GetGroupBrickStorage(0);
+    const mitk::MultiLabelSegmentation* constSegmentation = segmentation;
+    constSegmentation->GetGroupImage(0);
+    CPPUNIT_ASSERT(!segmentation->IsGroupCompressed(0));
+    segmentation->CompressGroup(0);
+    CPPUNIT_ASSERT(storage == segmentation->GetGroupBrickStorage(0));
+
+    auto groupImage = segmentation->GetGroupImage(0);
+    CPPUNIT_ASSERT(!segmentation->IsGroupCompressed(0));
+    CPPUNIT_ASSERT(denseGroupImage == groupImage);
+
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> expected(m_Image);
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> result(groupImage);
+    CPPUNIT_ASSERT(std::equal(expected.GetData(), expected.GetData() + 70 * 40 * 33, result.GetData()));
+
+    auto denseSlab = segmentation->GetGroupSlab(0, 2, 3, 0);
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> denseSlabAccessor(denseSlab);
+    CPPUNIT_ASSERT(std::equal(slabAccessor.GetData(), slabAccessor.GetData() + 70 * 40, denseSlabAccessor.GetData()));
+  }
+
+  void TestCompressIdleGroups()
+  {
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(CreateEmptyImage());
+    segmentation->UpdateGroupImage(0, m_Image, 0);
+    segmentation->AddGroup();
+    segmentation->AddGroup();
+
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    auto label = segmentation->AddLabel("active label", color, 1);
+    segmentation->SetActiveLabel(label->GetValue());
+
+    segmentation->CompressIdleGroups();
+    CPPUNIT_ASSERT(segmentation->IsGroupCompressed(0));
+    CPPUNIT_ASSERT(!segmentation->IsGroupCompressed(1));
+    CPPUNIT_ASSERT(segmentation->IsGroupCompressed(2));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelGroupBrickStorage)
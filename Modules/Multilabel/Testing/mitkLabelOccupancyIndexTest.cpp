@@ -0,0 +1,215 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelOccupancyIndex.h>
+#include <mitkLabelSetImage.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkLabelOccupancyIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelOccupancyIndexTestSuite);
+  MITK_TEST(TestInitialize);
+  MITK_TEST(TestBoundingRegion);
+  MITK_TEST(TestLabelValuesInSlice);
+  MITK_TEST(TestSetSliceCounts);
+  MITK_TEST(TestUpdateSlice);
+  MITK_TEST(TestUpdateRegion);
+  MITK_TEST(TestRemoveLabel);
+  MITK_TEST(TestUpToDate);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::LabelOccupancyIndex::Pointer m_Index;
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 10, 8, 6 };
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 3, dimensions);
+
+    mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(m_Image);
+    std::fill_n(accessor.GetData(), 10 * 8 * 6, 0);
+
+    // label 1: 2x2x2 cube at (1,1,1)
+    for (itk::IndexValueType z = 1; z < 3; ++z)
+      for (itk::IndexValueType y = 1; y < 3; ++y)
+        for (itk::IndexValueType x = 1; x < 3; ++x)
+          accessor.SetPixelByIndex({ { x, y, z } }, 1);
+
+    // label 5: two single voxels
+    accessor.SetPixelByIndex({ { 9, 0, 5 } }, 5);
+    accessor.SetPixelByIndex({ { 4, 7, 2 } }, 5);
+
+    m_Index = mitk::LabelOccupancyIndex::New();
+    m_Index->Initialize(m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Index = nullptr;
+  }
+
+  void TestInitialize()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8), m_Index->GetVoxelCount(1, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Index->GetVoxelCount(5, 0));
+    CPPUNIT_ASSERT(m_Index->IsEmpty(2, 0));
+    CPPUNIT_ASSERT(m_Index->IsEmpty(1, 1));
+
+    mitk::LabelOccupancyIndex::LabelValueVectorType expectedLabels = { 1, 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValues(0));
+  }
+
+  void TestBoundingRegion()
+  {
+    auto region = m_Index->GetBoundingRegion(1, 0);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(1), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(2), region.GetSize(2));
+
+    region = m_Index->GetBoundingRegion(5, 0);
+    CPPUNIT_ASSERT_EQUAL(itk::IndexValueType(4), region.GetIndex(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(6), region.GetSize(0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(8), region.GetSize(1));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(4), region.GetSize(2));
+
+    region = m_Index->GetBoundingRegion(3, 0);
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(0), region.GetNumberOfPixels());
+  }
+
+  void TestLabelValuesInSlice()
+  {
+    mitk::LabelOccupancyIndex::LabelValueVectorType expectedLabels = { 1, 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValuesInSlice(2, 2, 0));
+
+    expectedLabels = { 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValuesInSlice(2, 5, 0));
+
+    CPPUNIT_ASSERT(m_Index->GetLabelValuesInSlice(2, 4, 0).empty());
+  }
+
+  void TestSetSliceCounts()
+  {
+    auto counts = m_Index->GetSliceCounts(1, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), counts.size());
+    CPPUNIT_ASSERT_EQUAL(4u, counts[2][1]);
+
+    // remove slice z=2 of label 1
+    counts[2][2] = 0;
+    counts[0][1] -= 2;
+    counts[0][2] -= 2;
+    counts[1][1] -= 2;
+    counts[1][2] -= 2;
+    m_Index->SetSliceCounts(1, 0, counts);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_Index->GetVoxelCount(1, 0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(1), m_Index->GetBoundingRegion(1, 0).GetSize(2));
+
+    for (auto& axisCounts : counts)
+      std::fill(axisCounts.begin(), axisCounts.end(), 0);
+    m_Index->SetSliceCounts(1, 0, counts);
+
+    CPPUNIT_ASSERT(m_Index->IsEmpty(1, 0));
+    mitk::LabelOccupancyIndex::LabelValueVectorType expectedLabels = { 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValues(0));
+  }
+
+  void TestUpdateSlice()
+  {
+    // slice z=1 (x runs fastest, then y)
+    std::vector<mitk::Label::PixelType> oldSlice(10 * 8, 0);
+    oldSlice[1 * 10 + 1] = 1;
+    oldSlice[1 * 10 + 2] = 1;
+    oldSlice[2 * 10 + 1] = 1;
+    oldSlice[2 * 10 + 2] = 1;
+
+    // replace label 1 by label 3 at one voxel, erase two voxels and add label 5 in an empty region
+    auto newSlice = oldSlice;
+    newSlice[1 * 10 + 1] = 3;
+    newSlice[1 * 10 + 2] = 0;
+    newSlice[2 * 10 + 1] = 0;
+    newSlice[7 * 10 + 9] = 5;
+
+    m_Index->UpdateSlice(2, 1, 0, oldSlice.data(), newSlice.data());
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), m_Index->GetVoxelCount(1, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Index->GetVoxelCount(3, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), m_Index->GetVoxelCount(5, 0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(6), m_Index->GetBoundingRegion(5, 0).GetSize(0));
+
+    mitk::LabelOccupancyIndex::LabelValueVectorType expectedLabels = { 1, 3, 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValuesInSlice(2, 1, 0));
+
+    // revert the change, label 3 must vanish from the index
+    m_Index->UpdateSlice(2, 1, 0, newSlice.data(), oldSlice.data());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8), m_Index->GetVoxelCount(1, 0));
+    CPPUNIT_ASSERT(m_Index->IsEmpty(3, 0));
+    expectedLabels = { 1, 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValues(0));
+
+    CPPUNIT_ASSERT_THROW(m_Index->UpdateSlice(2, 6, 0, oldSlice.data(), newSlice.data()), mitk::Exception);
+  }
+
+  void TestUpdateRegion()
+  {
+    // region 3x2x2 at (1,1,1), x runs fastest, then y, then z
+    mitk::LabelOccupancyIndex::RegionType region;
+    region.SetIndex({ { 1, 1, 1 } });
+    region.SetSize({ { 3, 2, 2 } });
+
+    std::vector<mitk::Label::PixelType> oldContent = { 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0 };
+
+    // relabel the cube to label 2 and add label 2 at (3,2,2)
+    std::vector<mitk::Label::PixelType> newContent = { 2, 2, 0, 2, 2, 0, 2, 2, 0, 2, 2, 2 };
+
+    m_Index->UpdateRegion(region, 0, oldContent.data(), newContent.data());
+
+    CPPUNIT_ASSERT(m_Index->IsEmpty(1, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(9), m_Index->GetVoxelCount(2, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Index->GetVoxelCount(5, 0));
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(3), m_Index->GetBoundingRegion(2, 0).GetSize(0));
+
+    mitk::LabelOccupancyIndex::LabelValueVectorType expectedLabels = { 2, 5 };
+    CPPUNIT_ASSERT(expectedLabels == m_Index->GetLabelValues(0));
+
+    region.SetIndex({ { 8, 1, 1 } });
+    CPPUNIT_ASSERT_THROW(m_Index->UpdateRegion(region, 0, newContent.data(), oldContent.data()), mitk::Exception);
+  }
+
+  void TestRemoveLabel()
+  {
+    m_Index->RemoveLabel(1, 0);
+    CPPUNIT_ASSERT(m_Index->IsEmpty(1, 0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Index->GetVoxelCount(5, 0));
+    CPPUNIT_ASSERT_THROW(m_Index->RemoveLabel(5, 1), mitk::Exception);
+  }
+
+  void TestUpToDate()
+  {
+    CPPUNIT_ASSERT(m_Index->IsUpToDate(m_Image));
+
+    m_Image->Modified();
+    CPPUNIT_ASSERT(!m_Index->IsUpToDate(m_Image));
+
+    m_Index->MarkUpToDate(m_Image);
+    CPPUNIT_ASSERT(m_Index->IsUpToDate(m_Image));
+
+    m_Index->Clear();
+    CPPUNIT_ASSERT(!m_Index->IsUpToDate(m_Image));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelOccupancyIndex)
@@ -76,6 +76,7 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestEraseLabels);
   MITK_TEST(TestMergeLabels);
   MITK_TEST(TestCreateLabelMask);
+  MITK_TEST(TestCreateCroppedLabelMask);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -623,6 +624,35 @@ public:
     // Count all pixels with value 6 = 507
     CPPUNIT_ASSERT_MESSAGE("Label mask not correctly created", maskImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 507);
   }
+
+  void TestCreateCroppedLabelMask()
+  {
+    mitk::Image::Pointer image =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Multilabel/LabelSetTestInitializeImage.nrrd"));
+
+    m_LabelSetImage = nullptr;
+    m_LabelSetImage = mitk::MultiLabelSegmentation::New();
+    m_LabelSetImage->InitializeByLabeledImage(image);
+
+    auto maskImage = mitk::CreateCroppedLabelMask(m_LabelSetImage, 6, 2);
+    CPPUNIT_ASSERT_MESSAGE("Cropped label mask was not created", maskImage.IsNotNull());
+
+    // Count all pixels with value 6 = 507
+    CPPUNIT_ASSERT_MESSAGE("Cropped label mask not correctly created", maskImage->GetStatistics()->GetCountOfMaxValuedVoxels() == 507);
+
+    auto region = m_LabelSetImage->GetLabelBoundingRegion(6);
+    region.PadByRadius(2);
+    CPPUNIT_ASSERT_MESSAGE("Cropped label mask is larger than the padded bounding region", maskImage->GetDimension(0) <= region.GetSize(0));
+
+    // the mask must be placed at the position of the label in world coordinates
+    mitk::Point3D maskOrigin = maskImage->GetGeometry()->GetOrigin();
+    mitk::Point3D expectedOrigin;
+    mitk::Point3D regionStart;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      regionStart[dim] = std::max<itk::IndexValueType>(0, region.GetIndex(dim));
+    m_LabelSetImage->GetGeometry()->IndexToWorld(regionStart, expectedOrigin);
+    CPPUNIT_ASSERT_MESSAGE("Cropped label mask has a wrong origin", mitk::Equal(maskOrigin, expectedOrigin));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImage)
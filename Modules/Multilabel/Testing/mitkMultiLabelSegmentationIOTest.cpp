@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 
 #include <mitkTestFixture.h>
@@ -20,12 +21,16 @@ found in the LICENSE file.
 #include <mitkPropertyPersistenceInfo.h>
 #include <mitkIPropertyPersistence.h>
 
+#include <cstdio>
+
 class mitkMultiLabelSegmentationIOTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkMultiLabelSegmentationIOTestSuite);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation_withNoMetaInformation);
   MITK_TEST(TestReadEmptyMultiLabelSegmentation_withNoMetaInformation_butContent);
+  MITK_TEST(TestWriteReadMultipleGroups);
+  MITK_TEST(TestLazyGroupLoading);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -110,6 +115,84 @@ public:
       mitk::IOUtil::Load(GetTestDataFilePath("Multilabel/EmptyMultiLabelSegmentation_no_labels_meta_but_pixel_content.nrrd")),
       mitk::Exception);
   }
+
+  mitk::MultiLabelSegmentation::Pointer GenerateMultiGroupSegmentation() const
+  {
+    unsigned int dimensions[3] = { 40, 30, 20 };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 3, dimensions);
+
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(image);
+    segmentation->ReplaceGroupLabels(0, m_labelSet1);
+    segmentation->AddGroup(m_labelSet2_adapted);
+
+    for (mitk::MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < 2; ++groupID)
+    {
+      auto groupImage = segmentation->GetGroupImage(groupID);
+      {
+        mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+        for (itk::IndexValueType z = 0; z < 20; ++z)
+          for (itk::IndexValueType y = 0; y < 30; ++y)
+            for (itk::IndexValueType x = 0; x < 40; ++x)
+              accessor.SetPixelByIndex({ { x, y, z } }, static_cast<mitk::Label::PixelType>(0 == groupID ? (x + z) % 3 : 3 + (y * z) % 3));
+      }
+      groupImage->Modified();
+    }
+
+    return segmentation;
+  }
+
+  void TestWriteReadMultipleGroups()
+  {
+    auto segmentation = GenerateMultiGroupSegmentation();
+
+    // compressed groups are written without being decompressed
+    segmentation->CompressGroup(1);
+
+    const auto path = mitk::IOUtil::CreateTemporaryFile("MultiLabelSegmentationIOTest_XXXXXX.nrrd");
+    mitk::IOUtil::Save(segmentation, path);
+    CPPUNIT_ASSERT(segmentation->IsGroupCompressed(1));
+
+    auto loadedSegmentation = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(path);
+    std::remove(path.c_str());
+
+    CPPUNIT_ASSERT_EQUAL(2u, loadedSegmentation->GetNumberOfGroups());
+    CPPUNIT_ASSERT(!loadedSegmentation->IsGroupDeferred(0));
+    CPPUNIT_ASSERT_MESSAGE("Loaded segmentation differs from the written one.", mitk::Equal(*segmentation, *loadedSegmentation, mitk::eps, true));
+  }
+
+  void TestLazyGroupLoading()
+  {
+    auto segmentation = GenerateMultiGroupSegmentation();
+
+    const auto path = mitk::IOUtil::CreateTemporaryFile("MultiLabelSegmentationIOTest_XXXXXX.nrrd");
+    mitk::IOUtil::Save(segmentation, path);
+
+    mitk::IFileReader::Options options;
+    options["Lazy group loading"] = true;
+    auto loadedSegmentation = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(path, options);
+
+    // labels are available without loading the groups
+    CPPUNIT_ASSERT_EQUAL(2u, loadedSegmentation->GetNumberOfGroups());
+    CPPUNIT_ASSERT_EQUAL(5u, loadedSegmentation->GetTotalNumberOfLabels());
+    CPPUNIT_ASSERT(loadedSegmentation->IsGroupDeferred(0));
+    CPPUNIT_ASSERT(loadedSegmentation->IsGroupDeferred(1));
+
+    // the first access loads the group
+    loadedSegmentation->GetGroupImage(1);
+    CPPUNIT_ASSERT(loadedSegmentation->IsGroupDeferred(0));
+    CPPUNIT_ASSERT(!loadedSegmentation->IsGroupDeferred(1));
+
+    // clones share the loaders of groups that are not loaded yet
+    auto clonedSegmentation = loadedSegmentation->Clone();
+    CPPUNIT_ASSERT(clonedSegmentation->IsGroupDeferred(0));
+
+    CPPUNIT_ASSERT_MESSAGE("Lazily loaded segmentation differs from the written one.", mitk::Equal(*segmentation, *loadedSegmentation, mitk::eps, true));
+    CPPUNIT_ASSERT_MESSAGE("Clone of lazily loaded segmentation differs from the written one.", mitk::Equal(*segmentation, *clonedSegmentation, mitk::eps, true));
+
+    std::remove(path.c_str());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelSegmentationIO)
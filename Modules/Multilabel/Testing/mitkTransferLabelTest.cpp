@@ -11,10 +11,14 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <algorithm>
+
 class mitkTransferLabelTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkTransferLabelTestSuite);
@@ -29,6 +33,8 @@ class mitkTransferLabelTestSuite : public mitk::TestFixture
   MITK_TEST(TestTransfer_Replace_RegardLocks_AtTimeStep);
   MITK_TEST(TestTransfer_Replace_IgnoreLocks_AtTimeStep);
   MITK_TEST(TestTransfer_multipleLabels_AtTimeStep);
+  MITK_TEST(TestTransfer_withOccupancyIndex);
+  MITK_TEST(TestTransfer_Replace_SubGeometry);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -223,7 +229,74 @@ public:
       mitk::Equal(*(destinationLockedUnlabeledImage.GetPointer()), *(refLockedUnlabeledImage.GetPointer()), mitk::eps, false));
   }
 
+  void TestTransfer_withOccupancyIndex()
+  {
+    auto destinationImage = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(GetTestDataFilePath("Multilabel/LabelTransferTest_destination.nrrd"));
+    auto refmage = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(GetTestDataFilePath("Multilabel/LabelTransferTest_result_multipleLabels.nrrd"));
+
+    // up-to-date occupancy indices restrict the transfer to the bounding regions of the involved labels
+    CPPUNIT_ASSERT(nullptr != m_SourceImage->GetLabelOccupancyIndex(0));
+    CPPUNIT_ASSERT(nullptr != destinationImage->GetLabelOccupancyIndex(0));
+
+    mitk::TransferLabelContentAtTimeStep(m_SourceImage, destinationImage, 0, { {1,1}, {3,1}, {2,4}, {4,2} }, mitk::MultiLabelSegmentation::MergeStyle::Replace, mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
 
+    CPPUNIT_ASSERT_MESSAGE("Transfer multiple labels (1->1, 3->1, 2->4, 4->2) restricted by occupancy indices failed",
+      mitk::Equal(*(destinationImage.GetPointer()), *(refmage.GetPointer()), mitk::eps, false));
+
+    auto destIndex = destinationImage->GetLabelOccupancyIndex(0, false);
+    CPPUNIT_ASSERT_MESSAGE("Occupancy index of the destination was not kept up to date", nullptr != destIndex);
+
+    // the index has to match an independent scan of the transferred content
+    const auto groupImage = destinationImage->GetGroupImage(0);
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+    const auto numberOfPixels = groupImage->GetDimension(0) * groupImage->GetDimension(1) * groupImage->GetDimension(2);
+    for (const mitk::Label::PixelType value : { 1, 2, 4 })
+    {
+      const auto expectedCount = static_cast<std::size_t>(std::count(accessor.GetData(), accessor.GetData() + numberOfPixels, value));
+      CPPUNIT_ASSERT_EQUAL(expectedCount, static_cast<std::size_t>(destIndex->GetVoxelCount(value, 0)));
+    }
+  }
+
+  void TestTransfer_Replace_SubGeometry()
+  {
+    const unsigned int destinationDimensions[] = { 4, 4, 1 };
+    auto destinationImage = mitk::Image::New();
+    destinationImage->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 3, destinationDimensions);
+
+    const unsigned int sourceDimensions[] = { 2, 2, 1 };
+    auto sourceImage = mitk::Image::New();
+    sourceImage->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 3, sourceDimensions);
+    mitk::Point3D sourceOrigin;
+    mitk::FillVector3D(sourceOrigin, 1.0, 1.0, 0.0);
+    sourceImage->SetOrigin(sourceOrigin);
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> destinationAccessor(destinationImage);
+      std::fill(destinationAccessor.GetData(), destinationAccessor.GetData() + 16, mitk::Label::UNLABELED_VALUE);
+      destinationAccessor.SetPixelByIndex({ { 0, 0, 0 } }, 1); // outside of the source
+      destinationAccessor.SetPixelByIndex({ { 1, 1, 0 } }, 1); // unlabeled in the source
+      destinationAccessor.SetPixelByIndex({ { 3, 3, 0 } }, 2); // outside of the source, not mapped
+
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> sourceAccessor(sourceImage);
+      std::fill(sourceAccessor.GetData(), sourceAccessor.GetData() + 4, mitk::Label::UNLABELED_VALUE);
+      sourceAccessor.SetPixelByIndex({ { 1, 1, 0 } }, 1);
+    }
+
+    auto label1 = mitk::Label::New();
+    label1->SetValue(1);
+    auto label2 = mitk::Label::New();
+    label2->SetValue(2);
+
+    mitk::TransferLabelContentAtTimeStep(sourceImage, destinationImage, { label1.GetPointer(), label2.GetPointer() }, 0, mitk::Label::UNLABELED_VALUE,
+      mitk::Label::UNLABELED_VALUE, false, { {1,1} }, mitk::MultiLabelSegmentation::MergeStyle::Replace, mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
+
+    // replace mode removes the destination label also outside of a smaller source
+    mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> resultAccessor(destinationImage);
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::UNLABELED_VALUE, resultAccessor.GetPixelByIndex({ { 0, 0, 0 } }));
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::UNLABELED_VALUE, resultAccessor.GetPixelByIndex({ { 1, 1, 0 } }));
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(1), resultAccessor.GetPixelByIndex({ { 2, 2, 0 } }));
+    CPPUNIT_ASSERT_EQUAL(mitk::Label::PixelType(2), resultAccessor.GetPixelByIndex({ { 3, 3, 0 } }));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkTransferLabel)
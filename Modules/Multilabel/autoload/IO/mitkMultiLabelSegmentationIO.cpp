@@ -16,6 +16,9 @@ found in the LICENSE file.
 #include "mitkImageAccessByItk.h"
 #include "mitkMultiLabelIOHelper.h"
 #include "mitkLabelSetImageConverter.h"
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelGroupBrickStorage.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkIPropertyPersistence.h>
@@ -29,9 +32,23 @@ found in the LICENSE file.
 #include "itkMetaDataDictionary.h"
 #include "itkMetaDataObject.h"
 #include "itkNrrdImageIO.h"
+#include <itkByteSwapper.h>
+#include <itkMultiThreaderBase.h>
+#include <itk_zlib.h>
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+
 namespace mitk
 {
 
@@ -41,11 +58,733 @@ namespace mitk
   const constexpr int MULTILABEL_SEGMENTATION_VERSION_VALUE = 3;
   const constexpr char* const MULTILABEL_SEGMENTATION_LABELS_INFO_KEY = "org.mitk.multilabel.segmentation.labelgroups";
   const constexpr char* const MULTILABEL_SEGMENTATION_UNLABELEDLABEL_LOCK_KEY = "org.mitk.multilabel.segmentation.unlabeledlabellock";
+  /** Index of the independently compressed data blocks: "<slices per block> <compressed size of block 0> <compressed size of block 1> ..."*/
+  const constexpr char* const MULTILABEL_SEGMENTATION_BLOCKS_KEY = "org.mitk.multilabel.segmentation.blocks";
+
+  const constexpr char* const OPTION_NAME_LAZY_GROUP_LOADING = "Lazy group loading";
+
+  namespace
+  {
+    /** Uncompressed size (in bytes) the data blocks are aimed at.*/
+    constexpr std::size_t TargetBlockSize = 4 * 1024 * 1024;
+
+    /** Layout of the pixel data in a file. The groups are stored as interleaved components,
+    * i.e. the value of group g of voxel i is stored at position i * NumberOfGroups + g. Slices of
+    * all time steps follow each other, so slice s of the data is slice s % NumberOfSlices of time
+    * step s / NumberOfSlices.*/
+    struct GroupDataLayout
+    {
+      std::size_t SliceSize = 0;
+      unsigned int NumberOfSlices = 1;
+      unsigned int NumberOfTimeSteps = 1;
+      unsigned int NumberOfGroups = 1;
+
+      std::size_t GetInterleavedSliceSize() const
+      {
+        return SliceSize * NumberOfGroups;
+      }
+
+      std::size_t GetTotalNumberOfSlices() const
+      {
+        return static_cast<std::size_t>(NumberOfSlices) * NumberOfTimeSteps;
+      }
+    };
+
+    GroupDataLayout DetermineGroupDataLayout(const Image* groupImage, unsigned int numberOfGroups)
+    {
+      GroupDataLayout layout;
+      layout.SliceSize = static_cast<std::size_t>(groupImage->GetDimension(0)) * groupImage->GetDimension(1);
+      layout.NumberOfSlices = groupImage->GetDimension() > 2 ? groupImage->GetDimension(2) : 1;
+      layout.NumberOfTimeSteps = groupImage->GetDimension() > 3 ? groupImage->GetDimension(3) : 1;
+      layout.NumberOfGroups = numberOfGroups;
+      return layout;
+    }
+
+    unsigned int DetermineSlicesPerBlock(const GroupDataLayout& layout)
+    {
+      const auto sliceSizeInBytes = std::max<std::size_t>(1, layout.GetInterleavedSliceSize() * sizeof(Label::PixelType));
+      const auto slicesPerBlock = std::clamp<std::size_t>(TargetBlockSize / sliceSizeInBytes, 1, std::max<std::size_t>(1, layout.GetTotalNumberOfSlices()));
+      return static_cast<unsigned int>(slicesPerBlock);
+    }
+
+    /** Creates an image with the layout of the group images of the passed segmentation (see
+    * MultiLabelSegmentation::GenerateNewGroupImage()) without touching any group. Thus compressed
+    * groups stay compressed.*/
+    Image::Pointer GenerateGroupTemplateImage(const MultiLabelSegmentation* segmentation)
+    {
+      auto templateImage = Image::New();
+      const auto& dimensions = segmentation->GetDimensions();
+      if (dimensions.size() == 2)
+      {
+        auto volumeDimensions = std::array{ dimensions[0], dimensions[1], 1u };
+        templateImage->Initialize(MultiLabelSegmentation::GetPixelType(), 3, volumeDimensions.data());
+      }
+      else
+      {
+        templateImage->Initialize(MultiLabelSegmentation::GetPixelType(), *(segmentation->GetTimeGeometry()));
+      }
+      templateImage->SetClonedTimeGeometry(segmentation->GetTimeGeometry());
+      return templateImage;
+    }
+
+    /** Calls function for all indices in [0, numberOfBlocks) in parallel. The first exception thrown by
+    * function is rethrown after all calls have finished.*/
+    void ProcessBlocksInParallel(std::size_t numberOfBlocks, const std::function<void(std::size_t)>& function)
+    {
+      std::exception_ptr exception;
+      std::mutex exceptionMutex;
+
+      itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfBlocks, [&](itk::SizeValueType blockIndex) {
+        try
+        {
+          function(blockIndex);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(exceptionMutex);
+          if (!exception)
+            exception = std::current_exception();
+        }
+      }, nullptr);
+
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+
+    /** Compresses the passed data into a complete gzip member. Concatenated members form a valid
+    * gzip stream, so independently compressed blocks can be written one after another.*/
+    std::vector<char> CompressAsGzipMember(const void* data, std::size_t size)
+    {
+      z_stream stream{};
+      if (Z_OK != deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY))
+        mitkThrow() << "Cannot initialize gzip compression.";
+
+      std::vector<char> result(deflateBound(&stream, static_cast<uLong>(size)));
+      stream.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(data));
+      stream.avail_in = static_cast<uInt>(size);
+      stream.next_out = reinterpret_cast<Bytef*>(result.data());
+      stream.avail_out = static_cast<uInt>(result.size());
+
+      const auto status = deflate(&stream, Z_FINISH);
+      result.resize(stream.total_out);
+      deflateEnd(&stream);
+
+      if (Z_STREAM_END != status)
+        mitkThrow() << "Cannot compress data block. zlib status: " << status;
+
+      return result;
+    }
+
+    /** Decompresses a complete gzip member into buffer.
+    * @throw mitk::Exception if the member does not decompress to exactly size bytes.*/
+    void DecompressGzipMember(const char* data, std::size_t dataSize, void* buffer, std::size_t size)
+    {
+      z_stream stream{};
+      if (Z_OK != inflateInit2(&stream, 15 + 16))
+        mitkThrow() << "Cannot initialize gzip decompression.";
+
+      stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+      stream.avail_in = static_cast<uInt>(dataSize);
+      stream.next_out = static_cast<Bytef*>(buffer);
+      stream.avail_out = static_cast<uInt>(size);
+
+      const auto status = inflate(&stream, Z_FINISH);
+      const auto decompressedSize = stream.total_out;
+      inflateEnd(&stream);
+
+      if (Z_STREAM_END != status || decompressedSize != size)
+        mitkThrow() << "Data block is corrupted. zlib status: " << status;
+    }
+
+    /** Compresses the content of all groups in blocks of slicesPerBlock (interleaved) slices.
+    * Compressed groups are extracted slice by slice from their brick storage.*/
+    std::vector<std::vector<char>> CompressGroupData(const MultiLabelSegmentation* segmentation, const GroupDataLayout& layout, unsigned int slicesPerBlock)
+    {
+      std::vector<const LabelGroupBrickStorage*> brickStorages(layout.NumberOfGroups, nullptr);
+      std::vector<std::unique_ptr<ImageReadAccessor>> accessors(layout.NumberOfGroups);
+      std::vector<const Label::PixelType*> groupData(layout.NumberOfGroups, nullptr);
+
+      for (MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < layout.NumberOfGroups; ++groupID)
+      {
+        if (segmentation->IsGroupCompressed(groupID))
+        {
+          brickStorages[groupID] = segmentation->GetGroupBrickStorage(groupID);
+        }
+        else
+        {
+          accessors[groupID] = std::make_unique<ImageReadAccessor>(segmentation->GetGroupImage(groupID));
+          groupData[groupID] = static_cast<const Label::PixelType*>(accessors[groupID]->GetData());
+        }
+      }
+
+      const auto totalNumberOfSlices = layout.GetTotalNumberOfSlices();
+      const auto numberOfBlocks = (totalNumberOfSlices + slicesPerBlock - 1) / slicesPerBlock;
+      std::vector<std::vector<char>> blocks(numberOfBlocks);
+
+      ProcessBlocksInParallel(numberOfBlocks, [&](std::size_t blockIndex) {
+        const auto firstSlice = blockIndex * slicesPerBlock;
+        const auto numberOfSlices = std::min<std::size_t>(slicesPerBlock, totalNumberOfSlices - firstSlice);
+
+        std::vector<Label::PixelType> interleavedData(numberOfSlices * layout.GetInterleavedSliceSize());
+        std::vector<Label::PixelType> sliceBuffer;
+
+        for (unsigned int groupID = 0; groupID < layout.NumberOfGroups; ++groupID)
+        {
+          for (std::size_t sliceOffset = 0; sliceOffset < numberOfSlices; ++sliceOffset)
+          {
+            const auto slice = firstSlice + sliceOffset;
+            const Label::PixelType* source = nullptr;
+
+            if (nullptr != brickStorages[groupID])
+            {
+              sliceBuffer.resize(layout.SliceSize);
+              brickStorages[groupID]->ExtractSlice(2, static_cast<unsigned int>(slice % layout.NumberOfSlices), static_cast<TimeStepType>(slice / layout.NumberOfSlices), sliceBuffer.data());
+              source = sliceBuffer.data();
+            }
+            else
+            {
+              source = groupData[groupID] + slice * layout.SliceSize;
+            }
+
+            auto target = interleavedData.data() + sliceOffset * layout.GetInterleavedSliceSize() + groupID;
+            for (std::size_t i = 0; i < layout.SliceSize; ++i)
+              target[i * layout.NumberOfGroups] = source[i];
+          }
+        }
+
+        blocks[blockIndex] = CompressAsGzipMember(interleavedData.data(), interleavedData.size() * sizeof(Label::PixelType));
+      });
+
+      return blocks;
+    }
+
+    std::string EscapeNrrdKeyValue(const std::string& text)
+    {
+      std::string result;
+      result.reserve(text.size());
+
+      for (auto c : text)
+      {
+        if ('\\' == c)
+          result += "\\\\";
+        else if ('\n' == c)
+          result += "\\n";
+        else
+          result += c;
+      }
+
+      return result;
+    }
+
+    /** Generates the header of a gzip encoded NRRD file (including the terminating empty line) with the
+    * geometry and string meta data prepared in imageIO (see ItkImageIO::PreparImageIOToWriteImage()).
+    * Multiple groups are stored as vector components on the first axis, like itk::NrrdImageIO does.*/
+    std::string GenerateNrrdHeader(itk::ImageIOBase* imageIO, unsigned int numberOfGroups)
+    {
+      const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+      const bool hasComponentAxis = numberOfGroups > 1;
+
+      std::ostringstream header;
+      header.precision(17);
+
+      header << "NRRD0004\n"
+             << "# Complete NRRD file format specification at:\n"
+             << "# http://teem.sourceforge.net/nrrd/format.html\n"
+             << "type: unsigned short\n"
+             << "dimension: " << numberOfDimensions + (hasComponentAxis ? 1 : 0) << '\n';
+
+      if (3 == numberOfDimensions)
+        header << "space: left-posterior-superior\n";
+      else
+        header << "space dimension: " << numberOfDimensions << '\n';
+
+      header << "sizes:";
+      if (hasComponentAxis)
+        header << ' ' << numberOfGroups;
+      for (unsigned int axis = 0; axis < numberOfDimensions; ++axis)
+        header << ' ' << imageIO->GetDimensions(axis);
+
+      header << "\nspace directions:";
+      if (hasComponentAxis)
+        header << " none";
+      for (unsigned int axis = 0; axis < numberOfDimensions; ++axis)
+      {
+        const auto direction = imageIO->GetDirection(axis);
+        header << " (";
+        for (unsigned int i = 0; i < numberOfDimensions; ++i)
+        {
+          if (i > 0)
+            header << ',';
+          header << imageIO->GetSpacing(axis) * direction[i];
+        }
+        header << ')';
+      }
+
+      header << "\nkinds:";
+      if (hasComponentAxis)
+        header << " vector";
+      for (unsigned int axis = 0; axis < numberOfDimensions; ++axis)
+        header << " domain";
+
+      header << "\nendian: " << (itk::ByteSwapper<Label::PixelType>::SystemIsBigEndian() ? "big" : "little") << '\n'
+             << "encoding: gzip\n"
+             << "space origin: (";
+      for (unsigned int axis = 0; axis < numberOfDimensions; ++axis)
+      {
+        if (axis > 0)
+          header << ',';
+        header << imageIO->GetOrigin(axis);
+      }
+      header << ")\n";
+
+      const auto& dictionary = imageIO->GetMetaDataDictionary();
+      for (const auto& key : dictionary.GetKeys())
+      {
+        std::string value;
+        if (key.rfind("NRRD_", 0) == 0 || !itk::ExposeMetaData<std::string>(dictionary, key, value))
+          continue;
+
+        header << EscapeNrrdKeyValue(key) << ":=" << EscapeNrrdKeyValue(value) << '\n';
+      }
+
+      header << '\n';
+      return header.str();
+    }
+
+    /** Information about the data section of a NRRD file that itk::ImageIOBase does not expose.*/
+    struct NrrdDataInfo
+    {
+      std::streamoff DataOffset = 0;
+      std::string Encoding;
+      std::string Endian;
+      bool IsDetached = false;
+      bool HasSkips = false;
+      /** Kinds of the axes in the order of the file ("kinds" field), empty if the field is missing.*/
+      std::vector<std::string> Kinds;
+    };
+
+    NrrdDataInfo ReadNrrdDataInfo(const std::string& path)
+    {
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+        mitkThrow() << "Cannot open file: " << path;
+
+      NrrdDataInfo info;
+      std::string line;
+      while (std::getline(file, line))
+      {
+        if (!line.empty() && '\r' == line.back())
+          line.pop_back();
+
+        if (line.empty())
+        {
+          info.DataOffset = file.tellg();
+          return info;
+        }
+
+        const auto separator = line.find(": ");
+        if ('#' == line[0] || std::string::npos == separator || line.find(":=") < separator)
+          continue;
+
+        const auto field = line.substr(0, separator);
+        const auto value = line.substr(separator + 2);
+
+        if ("encoding" == field)
+          info.Encoding = value;
+        else if ("endian" == field)
+          info.Endian = value;
+        else if ("data file" == field || "datafile" == field)
+          info.IsDetached = true;
+        else if ("kinds" == field)
+        {
+          std::istringstream kinds(value);
+          std::string kind;
+          while (kinds >> kind)
+            info.Kinds.push_back(kind);
+        }
+        else if ("line skip" == field || "lineskip" == field || "byte skip" == field || "byteskip" == field)
+          info.HasSkips = info.HasSkips || "0" != value;
+      }
+
+      // header without data section
+      info.IsDetached = true;
+      return info;
+    }
+
+    bool IsDomainKind(const std::string& kind)
+    {
+      return "domain" == kind || "space" == kind || "time" == kind;
+    }
+
+    /** Checks if the groups of a multi-component file are interleaved per voxel, i.e. the first axis of the
+    * file is the only non-domain axis (e.g. "vector" or "list"). Otherwise ITK permutes the axes while
+    * reading, which the direct reading does not reproduce.*/
+    bool HasInterleavedComponents(const std::vector<std::string>& kinds)
+    {
+      if (kinds.empty() || IsDomainKind(kinds.front()))
+        return false;
+
+      return std::all_of(kinds.begin() + 1, kinds.end(), IsDomainKind);
+    }
+
+    /** Checks if the pixel data can be read directly into the group images, i.e. it is attached,
+    * unsigned short in host byte order, either raw or gzip encoded and either single-component or
+    * stored with the components on the first axis.*/
+    bool IsDirectlyReadable(const itk::ImageIOBase* imageIO, const NrrdDataInfo& info)
+    {
+      const std::string hostEndian = itk::ByteSwapper<Label::PixelType>::SystemIsBigEndian() ? "big" : "little";
+
+      return itk::IOComponentEnum::USHORT == imageIO->GetComponentType()
+        && imageIO->GetNumberOfDimensions() >= 2 && imageIO->GetNumberOfDimensions() <= 4
+        && (1 == imageIO->GetNumberOfComponents() || HasInterleavedComponents(info.Kinds))
+        && ("raw" == info.Encoding || "gzip" == info.Encoding || "gz" == info.Encoding)
+        && !info.IsDetached && !info.HasSkips
+        && (info.Endian.empty() || hostEndian == info.Endian);
+    }
+
+    /** Reads the block index written by MultiLabelSegmentationIO::Write().
+    * @return false if the index is missing or does not fit the layout.*/
+    bool ReadBlockIndex(const itk::MetaDataDictionary& dictionary, const GroupDataLayout& layout, unsigned int& slicesPerBlock, std::vector<std::size_t>& blockSizes)
+    {
+      std::string value;
+      if (!itk::ExposeMetaData<std::string>(dictionary, MULTILABEL_SEGMENTATION_BLOCKS_KEY, value))
+        return false;
+
+      std::istringstream stream(value);
+      if (!(stream >> slicesPerBlock) || 0 == slicesPerBlock)
+        return false;
+
+      std::size_t blockSize = 0;
+      while (stream >> blockSize)
+        blockSizes.push_back(blockSize);
+
+      const auto totalNumberOfSlices = layout.GetTotalNumberOfSlices();
+      return blockSizes.size() == (totalNumberOfSlices + slicesPerBlock - 1) / slicesPerBlock;
+    }
+
+    /** Reads the data section of a NRRD file sequentially. Gzip encoded data may consist of several
+    * concatenated members.*/
+    class NrrdDataStreamReader
+    {
+    public:
+      NrrdDataStreamReader(std::istream& stream, bool isCompressed)
+        : m_Stream(stream), m_IsCompressed(isCompressed), m_ZStream{}
+      {
+        if (m_IsCompressed)
+        {
+          // detect gzip or zlib header automatically
+          if (Z_OK != inflateInit2(&m_ZStream, 15 + 32))
+            mitkThrow() << "Cannot initialize gzip decompression.";
+          m_InputBuffer.resize(1024 * 1024);
+        }
+      }
+
+      ~NrrdDataStreamReader()
+      {
+        if (m_IsCompressed)
+          inflateEnd(&m_ZStream);
+      }
+
+      NrrdDataStreamReader(const NrrdDataStreamReader&) = delete;
+      NrrdDataStreamReader& operator=(const NrrdDataStreamReader&) = delete;
+
+      void Read(void* buffer, std::size_t size)
+      {
+        if (!m_IsCompressed)
+        {
+          m_Stream.read(static_cast<char*>(buffer), size);
+          if (m_Stream.gcount() != static_cast<std::streamsize>(size))
+            mitkThrow() << "Unexpected end of file.";
+          return;
+        }
+
+        m_ZStream.next_out = static_cast<Bytef*>(buffer);
+        auto remainingSize = size;
+
+        while (remainingSize > 0)
+        {
+          if (0 == m_ZStream.avail_in)
+          {
+            m_Stream.read(m_InputBuffer.data(), m_InputBuffer.size());
+            const auto count = m_Stream.gcount();
+            if (count <= 0)
+              mitkThrow() << "Unexpected end of compressed data.";
+
+            m_ZStream.next_in = reinterpret_cast<Bytef*>(m_InputBuffer.data());
+            m_ZStream.avail_in = static_cast<uInt>(count);
+          }
+
+          const auto availableOutput = static_cast<uInt>(std::min<std::size_t>(remainingSize, std::numeric_limits<uInt>::max()));
+          m_ZStream.avail_out = availableOutput;
+
+          const auto status = inflate(&m_ZStream, Z_NO_FLUSH);
+          remainingSize -= availableOutput - m_ZStream.avail_out;
+
+          if (Z_STREAM_END == status)
+          {
+            // the next gzip member follows
+            if (Z_OK != inflateReset(&m_ZStream))
+              mitkThrow() << "Cannot reset gzip decompression.";
+          }
+          else if (Z_OK != status && Z_BUF_ERROR != status)
+          {
+            mitkThrow() << "Compressed data is corrupted. zlib status: " << status;
+          }
+        }
+      }
+
+    private:
+      std::istream& m_Stream;
+      bool m_IsCompressed;
+      z_stream m_ZStream;
+      std::vector<char> m_InputBuffer;
+    };
+
+    /** Copies the groups out of interleaved data. Groups without target buffer (nullptr) are skipped.*/
+    void DeinterleaveGroupData(const Label::PixelType* data, std::size_t firstSlice, std::size_t numberOfSlices, const GroupDataLayout& layout, const std::vector<Label::PixelType*>& groupData)
+    {
+      const auto numberOfVoxels = numberOfSlices * layout.SliceSize;
+
+      for (unsigned int groupID = 0; groupID < layout.NumberOfGroups; ++groupID)
+      {
+        if (nullptr == groupData[groupID])
+          continue;
+
+        auto target = groupData[groupID] + firstSlice * layout.SliceSize;
+        for (std::size_t i = 0; i < numberOfVoxels; ++i)
+          target[i] = data[i * layout.NumberOfGroups + groupID];
+      }
+    }
+
+    /** Location of the pixel data of a file that is directly readable (see IsDirectlyReadable()).*/
+    struct GroupDataSource
+    {
+      std::string Path;
+      NrrdDataInfo Info;
+      GroupDataLayout Layout;
+      /** Block index (see MULTILABEL_SEGMENTATION_BLOCKS_KEY). It is empty if the data has to be read sequentially.*/
+      unsigned int SlicesPerBlock = 0;
+      std::vector<std::size_t> BlockSizes;
+    };
+
+    GroupDataSource MakeGroupDataSource(const std::string& path, const NrrdDataInfo& info, const GroupDataLayout& layout, const itk::MetaDataDictionary& dictionary)
+    {
+      GroupDataSource source;
+      source.Path = path;
+      source.Info = info;
+      source.Layout = layout;
+
+      if ("raw" == info.Encoding || !ReadBlockIndex(dictionary, layout, source.SlicesPerBlock, source.BlockSizes))
+        source.BlockSizes.clear();
+
+      return source;
+    }
+
+    /** Reads the pixel data of a file into the passed group buffers (one entry per group of the file).
+    * Groups without target buffer (nullptr) are skipped. Independently compressed blocks (see
+    * MULTILABEL_SEGMENTATION_BLOCKS_KEY) are decompressed in parallel, all other data is decompressed
+    * sequentially.*/
+    void ReadGroupData(const GroupDataSource& source, const std::vector<Label::PixelType*>& groupData)
+    {
+      const auto& layout = source.Layout;
+      const auto totalNumberOfSlices = layout.GetTotalNumberOfSlices();
+      const auto sliceSizeInBytes = layout.GetInterleavedSliceSize() * sizeof(Label::PixelType);
+
+      std::ifstream file(source.Path, std::ios::binary);
+      file.seekg(source.Info.DataOffset);
+      if (!file)
+        mitkThrow() << "Cannot read data of file: " << source.Path;
+
+      if (!source.BlockSizes.empty())
+      {
+        const auto slicesPerBlock = source.SlicesPerBlock;
+        const auto& blockSizes = source.BlockSizes;
+
+        std::vector<std::size_t> blockOffsets(blockSizes.size() + 1, 0);
+        for (std::size_t blockIndex = 0; blockIndex < blockSizes.size(); ++blockIndex)
+          blockOffsets[blockIndex + 1] = blockOffsets[blockIndex] + blockSizes[blockIndex];
+
+        std::vector<char> compressedData(blockOffsets.back());
+        file.read(compressedData.data(), compressedData.size());
+        if (file.gcount() != static_cast<std::streamsize>(compressedData.size()))
+          mitkThrow() << "Unexpected end of file: " << source.Path;
+
+        ProcessBlocksInParallel(blockSizes.size(), [&](std::size_t blockIndex) {
+          const auto firstSlice = blockIndex * slicesPerBlock;
+          const auto numberOfSlices = std::min<std::size_t>(slicesPerBlock, totalNumberOfSlices - firstSlice);
+          const auto compressedBlock = compressedData.data() + blockOffsets[blockIndex];
+
+          if (1 == layout.NumberOfGroups)
+          {
+            DecompressGzipMember(compressedBlock, blockSizes[blockIndex], groupData[0] + firstSlice * layout.SliceSize, numberOfSlices * sliceSizeInBytes);
+          }
+          else
+          {
+            std::vector<Label::PixelType> interleavedData(numberOfSlices * layout.GetInterleavedSliceSize());
+            DecompressGzipMember(compressedBlock, blockSizes[blockIndex], interleavedData.data(), numberOfSlices * sliceSizeInBytes);
+            DeinterleaveGroupData(interleavedData.data(), firstSlice, numberOfSlices, layout, groupData);
+          }
+        });
+      }
+      else
+      {
+        NrrdDataStreamReader reader(file, "raw" != source.Info.Encoding);
+
+        if (1 == layout.NumberOfGroups)
+        {
+          reader.Read(groupData[0], totalNumberOfSlices * sliceSizeInBytes);
+        }
+        else
+        {
+          const auto slicesPerChunk = DetermineSlicesPerBlock(layout);
+          std::vector<Label::PixelType> interleavedData;
+
+          for (std::size_t firstSlice = 0; firstSlice < totalNumberOfSlices; firstSlice += slicesPerChunk)
+          {
+            const auto numberOfSlices = std::min<std::size_t>(slicesPerChunk, totalNumberOfSlices - firstSlice);
+            interleavedData.resize(numberOfSlices * layout.GetInterleavedSliceSize());
+            reader.Read(interleavedData.data(), numberOfSlices * sliceSizeInBytes);
+            DeinterleaveGroupData(interleavedData.data(), firstSlice, numberOfSlices, layout, groupData);
+          }
+        }
+      }
+    }
+
+    /** Reads the pixel data of a file directly into the group images of segmentation.
+    * @pre segmentation must have the geometry and number of groups of the file.*/
+    void ReadGroupData(const GroupDataSource& source, MultiLabelSegmentation* segmentation)
+    {
+      std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+      std::vector<Label::PixelType*> groupData;
+
+      for (MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < source.Layout.NumberOfGroups; ++groupID)
+      {
+        accessors.push_back(std::make_unique<ImageWriteAccessor>(segmentation->GetGroupImage(groupID)));
+        groupData.push_back(static_cast<Label::PixelType*>(accessors.back()->GetData()));
+      }
+
+      ReadGroupData(source, groupData);
+      accessors.clear();
+
+      for (MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < source.Layout.NumberOfGroups; ++groupID)
+        segmentation->GetGroupImage(groupID)->Modified();
+    }
+
+    /** Decodes the pixel data of a file once for all deferred groups of the file. Decoding needs the data of all
+    * groups anyway, so the content of every group is kept as sparse brick storage (see LabelGroupBrickStorage)
+    * until the last loader of the file is released. Loaders of copies of a segmentation are served from it, too.*/
+    class DeferredGroupDataCache
+    {
+    public:
+      explicit DeferredGroupDataCache(const GroupDataSource& source)
+        : m_Source(source)
+      {
+      }
+
+      void WriteGroupContent(MultiLabelSegmentation::GroupIndexType groupID, Image* groupImage)
+      {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        if (m_GroupStorages.empty())
+          this->DecodeGroups(groupID, groupImage);
+        else
+          m_GroupStorages[groupID]->WriteToImage(groupImage);
+      }
+
+    private:
+      /** Reads all groups; the requested group is read directly into its group image.*/
+      void DecodeGroups(MultiLabelSegmentation::GroupIndexType groupID, Image* groupImage)
+      {
+        const auto numberOfGroups = m_Source.Layout.NumberOfGroups;
+        std::vector<Image::Pointer> images(numberOfGroups);
+
+        {
+          std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+          std::vector<Label::PixelType*> groupData;
+
+          for (MultiLabelSegmentation::GroupIndexType id = 0; id < numberOfGroups; ++id)
+          {
+            if (id == groupID)
+            {
+              images[id] = groupImage;
+            }
+            else
+            {
+              images[id] = Image::New();
+              images[id]->Initialize(groupImage);
+            }
+
+            accessors.push_back(std::make_unique<ImageWriteAccessor>(images[id]));
+            groupData.push_back(static_cast<Label::PixelType*>(accessors.back()->GetData()));
+          }
+
+          ReadGroupData(m_Source, groupData);
+        }
+
+        m_GroupStorages.resize(numberOfGroups);
+        for (MultiLabelSegmentation::GroupIndexType id = 0; id < numberOfGroups; ++id)
+        {
+          m_GroupStorages[id] = LabelGroupBrickStorage::New();
+          m_GroupStorages[id]->Initialize(images[id]);
+          images[id] = nullptr;
+        }
+      }
+
+      GroupDataSource m_Source;
+      std::vector<LabelGroupBrickStorage::Pointer> m_GroupStorages;
+      std::mutex m_Mutex;
+    };
+
+    /** Loads the content of one group of a file on first access (see MultiLabelSegmentation::AddDeferredGroup()).
+    * All loaders of a file share one DeferredGroupDataCache, so the file is decoded only once.*/
+    class DeferredGroupContentLoader : public LabelGroupContentLoader
+    {
+    public:
+      mitkClassMacro(DeferredGroupContentLoader, LabelGroupContentLoader);
+      mitkNewMacro2Param(Self, std::shared_ptr<DeferredGroupDataCache>, MultiLabelSegmentation::GroupIndexType);
+
+      void LoadContent(Image* groupImage) const override
+      {
+        m_Cache->WriteGroupContent(m_GroupID, groupImage);
+        groupImage->Modified();
+      }
+
+    protected:
+      DeferredGroupContentLoader(std::shared_ptr<DeferredGroupDataCache> cache, MultiLabelSegmentation::GroupIndexType groupID)
+        : m_Cache(cache), m_GroupID(groupID)
+      {
+      }
+
+    private:
+      std::shared_ptr<DeferredGroupDataCache> m_Cache;
+      MultiLabelSegmentation::GroupIndexType m_GroupID;
+    };
+
+    std::size_t CountLabelValuesInGroupContent(const MultiLabelSegmentation* segmentation, MultiLabelSegmentation::GroupIndexType groupID)
+    {
+      std::set<MultiLabelSegmentation::LabelValueType> labelValues;
+      auto occupancyIndex = segmentation->GetLabelOccupancyIndex(groupID);
+
+      for (TimeStepType t = 0; t < segmentation->GetTimeSteps(); ++t)
+      {
+        const auto values = occupancyIndex->GetLabelValues(t);
+        labelValues.insert(values.begin(), values.end());
+      }
+
+      return labelValues.size();
+    }
+  }
 
   MultiLabelSegmentationIO::MultiLabelSegmentationIO()
     : AbstractFileIO(MultiLabelSegmentation::GetStaticNameOfClass(), MitkMultilabelIOMimeTypes::MULTILABEL_SEGMENTATION_MIMETYPE(), "MITK Multilabel Segmentation")
   {
     this->InitializeDefaultMetaDataKeys();
+
+    IFileIO::Options readerOptions;
+    readerOptions[OPTION_NAME_LAZY_GROUP_LOADING] = false;
+    this->SetDefaultReaderOptions(readerOptions);
+    this->SetReaderThreadSafe(true);
+
     AbstractFileWriter::SetRanking(10);
     AbstractFileReader::SetRanking(10);
     this->RegisterService();
@@ -68,19 +807,20 @@ namespace mitk
 
     auto input = dynamic_cast<const MultiLabelSegmentation *>(this->GetInput());
 
-    mitk::LocaleSwitch localeSwitch("C");
-
-    mitk::Image::Pointer inputVector = mitk::ConvertLabelSetImageToImage(input);
-
-    // image write
-    if (inputVector.IsNull())
+    if (nullptr == input)
     {
       mitkThrow() << "Cannot write non-image data";
     }
 
+    mitk::LocaleSwitch localeSwitch("C");
+
+    // The header is derived from an image with the layout of the group images. The group content
+    // is read from the groups directly, so no copy of the segmentation is needed.
+    auto templateImage = GenerateGroupTemplateImage(input);
+
     itk::NrrdImageIO::Pointer nrrdImageIo = itk::NrrdImageIO::New();
 
-    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, inputVector);
+    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, templateImage);
 
     LocalFile localFile(this);
     const std::string path = localFile.GetFileName();
@@ -111,12 +851,35 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
-      // use compression if available
-      nrrdImageIo->UseCompressionOn();
-      nrrdImageIo->SetFileName(path);
+      // The pixel data is compressed in blocks of slices in parallel. Each block is a complete gzip
+      // member, so the concatenated blocks are a regular gzip encoded NRRD data section. The block
+      // index allows readers to decompress the blocks in parallel again.
+      const auto layout = DetermineGroupDataLayout(templateImage, input->GetNumberOfGroups());
+      const auto slicesPerBlock = DetermineSlicesPerBlock(layout);
+      const auto blocks = CompressGroupData(input, layout, slicesPerBlock);
+
+      std::ostringstream blockIndex;
+      blockIndex << slicesPerBlock;
+      for (const auto& block : blocks)
+        blockIndex << ' ' << block.size();
+
+      itk::EncapsulateMetaData<std::string>(
+        nrrdImageIo->GetMetaDataDictionary(), std::string(MULTILABEL_SEGMENTATION_BLOCKS_KEY), blockIndex.str());
 
-      ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      if (!file)
+      {
+        mitkThrow() << "Cannot open file for writing: " << path;
+      }
+
+      file << GenerateNrrdHeader(nrrdImageIo, layout.NumberOfGroups);
+      for (const auto& block : blocks)
+        file.write(block.data(), block.size());
+
+      if (!file)
+      {
+        mitkThrow() << "Error while writing file: " << path;
+      }
     }
     catch (const std::exception &e)
     {
@@ -150,7 +913,10 @@ namespace mitk
 
     std::vector<BaseData::Pointer> result;
 
-    auto rawimage = ItkImageIO::LoadRawMitkImageFromImageIO(nrrdImageIO, this->GetLocalFileName());
+    const auto path = this->GetLocalFileName();
+
+    // Only the header is read at first. It provides the geometry of the group images.
+    auto templateImage = ItkImageIO::LoadRawMitkImageFromImageIO(nrrdImageIO, path, false);
 
     const itk::MetaDataDictionary& dictionary = nrrdImageIO->GetMetaDataDictionary();
 
@@ -161,19 +927,56 @@ namespace mitk
       mitkThrow() << "Data to read has unsupported version. Software is to old to ensure correct reading. Please use a compatible version of MITK or store data in another format. Version of data: " << version << "; Supported versions up to: "<<MULTILABEL_SEGMENTATION_VERSION_VALUE;
     }
 
-    //generate multi label images
-    auto output = ConvertImageToLabelSetImage(rawimage);
-
     //get label groups definitions
     auto jsonStr = MultiLabelIOHelper::GetStringByKey(dictionary, MULTILABEL_SEGMENTATION_LABELS_INFO_KEY);
     nlohmann::json jlabelsets = nlohmann::json::parse(jsonStr);
     auto labelGroups = MultiLabelIOHelper::DeserializeMultiLabelGroupsFromJSON(jlabelsets);
 
+    //generate multi label images
+    MultiLabelSegmentation::Pointer output;
+    const auto dataInfo = ReadNrrdDataInfo(path);
+    const bool isDirectlyRead = IsDirectlyReadable(nrrdImageIO, dataInfo);
+
+    if (isDirectlyRead)
+    {
+      const auto numberOfGroups = nrrdImageIO->GetNumberOfComponents();
+      const auto source = MakeGroupDataSource(path, dataInfo, DetermineGroupDataLayout(templateImage, numberOfGroups), dictionary);
+
+      // Deferred groups read the file later on, so it must not be a temporary copy of an input stream.
+      // Without label information the content has to be checked for labels (see below) and is read directly.
+      const bool lazyGroupLoading = us::any_cast<bool>(this->GetReaderOption(OPTION_NAME_LAZY_GROUP_LOADING))
+        && nullptr == this->GetInputStream() && !labelGroups.empty();
+
+      output = MultiLabelSegmentation::New();
+      output->Initialize(templateImage, true, false);
+
+      std::shared_ptr<DeferredGroupDataCache> cache;
+      if (lazyGroupLoading)
+        cache = std::make_shared<DeferredGroupDataCache>(source);
+
+      for (MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < numberOfGroups; ++groupID)
+      {
+        if (lazyGroupLoading)
+          output->AddDeferredGroup(DeferredGroupContentLoader::New(cache, groupID));
+        else
+          output->AddGroup();
+      }
+
+      if (!lazyGroupLoading)
+        ReadGroupData(source, output);
+    }
+    else
+    {
+      auto rawimage = ItkImageIO::LoadRawMitkImageFromImageIO(nrrdImageIO, path);
+      output = ConvertImageToLabelSetImage(rawimage);
+    }
+
     if (labelGroups.empty() && output->GetNumberOfGroups()==1)
     {
-      if (output->GetTotalNumberOfLabels() > 0)
+      const auto numberOfDetectedLabels = isDirectlyRead ? CountLabelValuesInGroupContent(output, 0) : output->GetTotalNumberOfLabels();
+      if (numberOfDetectedLabels > 0)
       {
-        mitkThrow() << "Loaded data is in an invalid state. Data contains no meta information for labels but pixel content indicates labels. Number of detected invalid labels: " << output->GetTotalNumberOfLabels();
+        mitkThrow() << "Loaded data is in an invalid state. Data contains no meta information for labels but pixel content indicates labels. Number of detected invalid labels: " << numberOfDetectedLabels;
       }
 
       MITK_INFO << "Segmentation contains only one layer and has no label information. Assuming empty label.";
@@ -21,6 +21,9 @@ namespace mitk
   /**
   * Writes a MultiLabelSegmentation to a file.
   * mitk::Identifiable UID is supported and will be serialized.
+  * The groups are written as gzip encoded NRRD file. The pixel data is compressed in independent
+  * blocks of slices in parallel and read directly into the group images; blocks of files written by
+  * this class are decompressed in parallel as well.
   * @ingroup Process
   */
   // The export macro should be removed. Currently, the unit
@@ -21,6 +21,9 @@ MITK_REGISTER_SERIALIZER(MultiLabelSegmentationSerializer)
 
 mitk::MultiLabelSegmentationSerializer::MultiLabelSegmentationSerializer()
 {
+  // group images are only read, deferred or compressed groups are restored in place under the
+  // segmentation's locks (see MultiLabelSegmentation::DecompressGroup())
+  this->SetThreadSafe(true);
 }
 
 mitk::MultiLabelSegmentationSerializer::~MultiLabelSegmentationSerializer()
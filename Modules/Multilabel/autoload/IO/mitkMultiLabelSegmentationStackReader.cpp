@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkItkImageIO.h>
 #include <mitkUIDManipulator.h>
 #include <mitkProperties.h>
+#include <mitkImageWriteAccessor.h>
 
 // itk
 #include "itkImageFileReader.h"
@@ -31,7 +32,11 @@ namespace
   const constexpr char* const MULTILABEL_SEGMENTATION_TYPE_VALUE = "org.mitk.multilabel.segmentation.stack";
   const constexpr int MULTILABEL_SEGMENTATION_VERSION_VALUE = 3;
 
-  mitk::Image::Pointer LoadImageBasedOnFileName(const std::string& fileName, const std::string& fileBase)
+  const constexpr char* const OPTION_NAME_LAZY_GROUP_LOADING = "Lazy group loading";
+
+  /** Loads an image referenced by the meta file. If loadPixelData is false, only the
+  * geometry is loaded (see mitk::ItkImageIO::LoadRawMitkImageFromImageIO()).*/
+  mitk::Image::Pointer LoadImageBasedOnFileName(const std::string& fileName, const std::string& fileBase, bool loadPixelData = true)
   {
     const auto loadPath = itksys::SystemTools::FileIsFullPath(fileName.c_str()) ?
       fileName :
@@ -47,10 +52,10 @@ namespace
       mitkThrow() << "Cannot load image. ITK does not support the format. Unsupported file: " << loadPath;
     }
 
-    return mitk::ItkImageIO::LoadRawMitkImageFromImageIO(imageIO, loadPath);
+    return mitk::ItkImageIO::LoadRawMitkImageFromImageIO(imageIO, loadPath, loadPixelData);
   }
 
-  mitk::Image::Pointer LoadImageBasedOnFileProperty(const mitk::PropertyList* properties, const std::string& fileBase)
+  mitk::Image::Pointer LoadImageBasedOnFileProperty(const mitk::PropertyList* properties, const std::string& fileBase, bool loadPixelData = true)
   {
     std::string fileName;
     bool imageDefined = properties->GetStringProperty("_file", fileName);
@@ -58,7 +63,7 @@ namespace
     mitk::Image::Pointer image;
     if (imageDefined)
     {
-      image = LoadImageBasedOnFileName(fileName, fileBase);
+      image = LoadImageBasedOnFileName(fileName, fileBase, loadPixelData);
     }
 
     return image;
@@ -136,6 +141,71 @@ namespace
     return "";
   }
 
+  /** Transfers the content of the image files referenced by a group and its labels into the group image.*/
+  void TransferGroupContent(const mitk::MultiLabelIOHelper::LabelGroupMetaData& groupInfo,
+    const mitk::MultiLabelSegmentation::ConstLabelVectorType& groupLabels, const std::string& fileBase, mitk::Image* groupImage)
+  {
+    auto fileGroupImage = LoadImageBasedOnFileProperty(groupInfo.properties, fileBase);
+
+    if (fileGroupImage.IsNotNull())
+    {
+      //transfer content of the labels that have no dedicated defined import image
+      auto groupMapping = MakeLabelsGroupMapping(groupInfo.labels);
+      TransferLabelContent(fileGroupImage, groupImage, groupLabels,
+        mitk::MultiLabelSegmentation::UNLABELED_VALUE, mitk::MultiLabelSegmentation::UNLABELED_VALUE, false, groupMapping,
+        mitk::MultiLabelSegmentation::MergeStyle::Replace, mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
+    }
+
+    for (const auto& label : groupInfo.labels)
+    {
+      mitk::Image::Pointer labelImage = LoadImageBasedOnFileProperty(label, fileBase);
+      if (labelImage.IsNotNull())
+      {
+        //transfer content of the labels that have a dedicated defined import image
+        auto labelMapping = MakeLabelMapping(label);
+        TransferLabelContent(labelImage, groupImage, groupLabels,
+          mitk::MultiLabelSegmentation::UNLABELED_VALUE, mitk::MultiLabelSegmentation::UNLABELED_VALUE, false, { labelMapping },
+          mitk::MultiLabelSegmentation::MergeStyle::Replace, mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
+      }
+    }
+  }
+
+  /** Loads the content of a group from the image files referenced by the meta file on first access
+  * (see mitk::MultiLabelSegmentation::AddDeferredGroup()).*/
+  class DeferredStackGroupContentLoader : public mitk::LabelGroupContentLoader
+  {
+  public:
+    mitkClassMacro(DeferredStackGroupContentLoader, mitk::LabelGroupContentLoader);
+    mitkNewMacro3Param(Self, const mitk::MultiLabelIOHelper::LabelGroupMetaData&, const mitk::MultiLabelSegmentation::ConstLabelVectorType&, const std::string&);
+
+    void LoadContent(mitk::Image* groupImage) const override
+    {
+      {
+        // the group image holds no data yet
+        std::size_t numberOfPixels = 1;
+        for (unsigned int dim = 0; dim < groupImage->GetDimension(); ++dim)
+          numberOfPixels *= groupImage->GetDimension(dim);
+
+        mitk::ImageWriteAccessor accessor(groupImage);
+        std::fill_n(static_cast<mitk::Label::PixelType*>(accessor.GetData()), numberOfPixels, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+      }
+
+      TransferGroupContent(m_GroupInfo, m_GroupLabels, m_FileBase, groupImage);
+    }
+
+  protected:
+    DeferredStackGroupContentLoader(const mitk::MultiLabelIOHelper::LabelGroupMetaData& groupInfo,
+      const mitk::MultiLabelSegmentation::ConstLabelVectorType& groupLabels, const std::string& fileBase)
+      : m_GroupInfo(groupInfo), m_GroupLabels(groupLabels), m_FileBase(fileBase)
+    {
+    }
+
+  private:
+    mitk::MultiLabelIOHelper::LabelGroupMetaData m_GroupInfo;
+    mitk::MultiLabelSegmentation::ConstLabelVectorType m_GroupLabels;
+    std::string m_FileBase;
+  };
+
   void EnsurePropertyPersistance(const mitk::PropertyList* properties)
   {
     mitk::LocaleSwitch localeSwitch("C");
@@ -173,6 +243,11 @@ namespace
     : AbstractFileReader(MitkMultilabelIOMimeTypes::MULTILABELMETA_MIMETYPE(), "MITK Multilabel Segmentation Stack")
   {
     AbstractFileReader::SetRanking(10);
+
+    IFileReader::Options options;
+    options[OPTION_NAME_LAZY_GROUP_LOADING] = false;
+    this->SetDefaultOptions(options);
+
     this->RegisterService();
   }
 
@@ -248,16 +323,18 @@ namespace
     //get pixel content
     auto groupInfos = MultiLabelIOHelper::DeserializeMultiLabelGroupsFromJSON(fileContent["groups"]);
 
+    // Deferred groups read the image files later on, which are only known relative to a real meta file.
+    const bool lazyGroupLoading = us::any_cast<bool>(this->GetOption(OPTION_NAME_LAZY_GROUP_LOADING)) && nullptr == this->GetInputStream();
+
     for (const auto& groupInfo : groupInfos)
     {
-      auto groupImage = LoadImageBasedOnFileProperty(groupInfo.properties, filePathBase);
       auto cleanedLabels = CleanImportLabels(groupInfo.labels);
 
       if (!segInitialized)
       {
         //this is the first group, we need to initialize the segmentation first to ensure the
-        //correct geometry.
-        mitk::Image::Pointer initImage = groupImage;
+        //correct geometry. Only the geometry of the initialization image is needed.
+        mitk::Image::Pointer initImage = LoadImageBasedOnFileProperty(groupInfo.properties, filePathBase, false);
         if (initImage.IsNull())
         {
           //seems to be a stack only defined with label images
@@ -266,7 +343,7 @@ namespace
           auto firstFileName = FindFirstFileInJson(fileContent["groups"]);
           if (!firstFileName.empty())
           {
-            initImage = LoadImageBasedOnFileName(firstFileName, filePathBase);
+            initImage = LoadImageBasedOnFileName(firstFileName, filePathBase, false);
           }
         }
 
@@ -279,39 +356,15 @@ namespace
         segInitialized = true;
       }
 
-      auto groupIndex = segmentation->AddGroup(cleanedLabels);
-
-      if (groupImage.IsNotNull())
+      if (lazyGroupLoading)
       {
-        //transfer content of the labels that have no dedicated defined import image
-        auto groupMapping = MakeLabelsGroupMapping(groupInfo.labels);
-        TransferLabelContent(groupImage, segmentation->GetGroupImage(groupIndex),
-          segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupIndex)),
-          MultiLabelSegmentation::UNLABELED_VALUE, MultiLabelSegmentation::UNLABELED_VALUE, false, groupMapping,
-          MultiLabelSegmentation::MergeStyle::Replace, MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
+        segmentation->AddDeferredGroup(DeferredStackGroupContentLoader::New(groupInfo, cleanedLabels, filePathBase), cleanedLabels);
       }
-
-      for (const auto& label : groupInfo.labels)
+      else
       {
-        mitk::Image::Pointer labelImage = LoadImageBasedOnFileProperty(label, filePathBase);
-        if (labelImage.IsNotNull())
-        {
-          if (!segInitialized)
-          {
-            //this is the first group, we need to initialize the segmentation first to ensure the
-            //correct geometry.
-            segmentation->Initialize(labelImage, false);
-            segInitialized = true;
-          }
-
-          //transfer content of the labels that have no dedicated defined import image
-          auto labelMapping = MakeLabelMapping(label);
-          TransferLabelContent(labelImage, segmentation->GetGroupImage(groupIndex),
-            segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupIndex)),
-            MultiLabelSegmentation::UNLABELED_VALUE, MultiLabelSegmentation::UNLABELED_VALUE, false, { labelMapping },
-            MultiLabelSegmentation::MergeStyle::Replace, MultiLabelSegmentation::OverwriteStyle::IgnoreLocks);
-        }
-
+        auto groupIndex = segmentation->AddGroup(cleanedLabels);
+        TransferGroupContent(groupInfo, segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupIndex)),
+          filePathBase, segmentation->GetGroupImage(groupIndex));
       }
     }
 
@@ -27,6 +27,7 @@ mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType::LegacyLabelSetMimeType(
   this->AddExtension("nrrd");
   this->SetCategory("MITK LabelSetImage");
   this->SetComment("MITK LabelSetImage (legacy format)");
+  this->SetExtensionRequired(true);
 }
 
 bool mitk::MitkMultilabelIOMimeTypes::LegacyLabelSetMimeType::AppliesTo(const std::string& path) const
@@ -95,6 +96,7 @@ mitk::MitkMultilabelIOMimeTypes::MultiLabelSegmentationMimeType::MultiLabelSegme
   this->AddExtension("NRRD");
   this->SetCategory("MITK MultiLabel");
   this->SetComment("MITK Segmentation");
+  this->SetExtensionRequired(true);
 }
 
 bool mitk::MitkMultilabelIOMimeTypes::MultiLabelSegmentationMimeType::AppliesTo(const std::string& path) const
@@ -164,6 +166,7 @@ mitk::MitkMultilabelIOMimeTypes::MultiLabelMetaMimeType::MultiLabelMetaMimeType(
 
   this->SetCategory("MITK MultiLabel");
   this->SetComment("MITK MultiLabel meta data");
+  this->SetExtensionRequired(true);
 }
 
 mitk::MitkMultilabelIOMimeTypes::MultiLabelMetaMimeType* mitk::MitkMultilabelIOMimeTypes::MultiLabelMetaMimeType::Clone() const
@@ -196,6 +199,7 @@ mitk::MitkMultilabelIOMimeTypes::MultiLabelNiftiStackMimeType::MultiLabelNiftiSt
   this->AddExtension("NII.GZ");
   this->SetCategory("MITK MultiLabel");
   this->SetComment("MITK Segmentation NIFTI Stack");
+  this->SetExtensionRequired(true);
 }
 
 bool mitk::MitkMultilabelIOMimeTypes::MultiLabelNiftiStackMimeType::AppliesTo(const std::string& path) const
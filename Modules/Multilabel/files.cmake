@@ -1,8 +1,11 @@
 set(CPP_FILES
   mitkDICOMSegmentationConstants.cpp
   mitkDICOMSegmentationPropertyHelper.cpp
+  mitkIncrementalLabelSurfaceMesher.cpp
   mitkLabel.cpp
+  mitkLabelGroupBrickStorage.cpp
   mitkLabelHighlightGuard.cpp
+  mitkLabelOccupancyIndex.cpp
   mitkLabelSetImage.cpp
   mitkLabelSetImageConverter.cpp
   mitkLabelSetImageHelper.cpp
@@ -0,0 +1,388 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkIncrementalLabelSurfaceMesher.h"
+
+#include <mitkImageReadAccessor.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <vtkCellArray.h>
+#include <vtkImageData.h>
+#include <vtkMarchingCubes.h>
+#include <vtkMatrix4x4.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <vector>
+
+const unsigned int mitk::IncrementalLabelSurfaceMesher::BlockEdgeLength = 32;
+
+namespace
+{
+  using DimensionsType = std::array<itk::IndexValueType, 3>;
+  using MatrixElementsType = std::array<double, 16>;
+
+  /** Marching cubes cells are identified by the index of their lower corner voxel. To close the surface at the
+  * image border, the cells range from -1 to dimension-1 along each axis (voxels outside the image are unlabeled).
+  * Block b contains the cells b*BlockEdgeLength-1 to (b+1)*BlockEdgeLength-2.*/
+  itk::IndexValueType GetFirstCellOfBlock(unsigned int block)
+  {
+    return static_cast<itk::IndexValueType>(block) * mitk::IncrementalLabelSurfaceMesher::BlockEdgeLength - 1;
+  }
+
+  itk::IndexValueType GetLastCellOfBlock(unsigned int block, itk::IndexValueType dimension)
+  {
+    return std::min(GetFirstCellOfBlock(block) + mitk::IncrementalLabelSurfaceMesher::BlockEdgeLength - 1, dimension - 1);
+  }
+
+  unsigned int GetNumberOfBlocks(itk::IndexValueType dimension)
+  {
+    const auto edgeLength = static_cast<itk::IndexValueType>(mitk::IncrementalLabelSurfaceMesher::BlockEdgeLength);
+    return static_cast<unsigned int>((dimension + edgeLength) / edgeLength);
+  }
+
+  /** Block of the cell with the passed lower corner (-1 <= cell < dimension).*/
+  unsigned int GetBlockOfCell(itk::IndexValueType cell)
+  {
+    return static_cast<unsigned int>((cell + 1) / mitk::IncrementalLabelSurfaceMesher::BlockEdgeLength);
+  }
+
+  using FacePointFlagsType = std::vector<bool>;
+
+  vtkSmartPointer<vtkPolyData> GenerateBlockSurface(const mitk::Label::PixelType* data, const DimensionsType& dimensions,
+    mitk::Label::PixelType labelValue, const std::array<unsigned int, 3>& block, const MatrixElementsType& indexToWorld,
+    FacePointFlagsType& isFacePoint)
+  {
+    int extent[6];
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      extent[2 * dim] = static_cast<int>(GetFirstCellOfBlock(block[dim]));
+      extent[2 * dim + 1] = static_cast<int>(GetLastCellOfBlock(block[dim], dimensions[dim]) + 1);
+    }
+
+    auto mask = vtkSmartPointer<vtkImageData>::New();
+    mask->SetExtent(extent);
+    mask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto maskData = static_cast<unsigned char*>(mask->GetScalarPointer());
+
+    bool hasLabel = false;
+    for (int z = extent[4]; z <= extent[5]; ++z)
+    {
+      const bool zInside = z >= 0 && z < dimensions[2];
+      for (int y = extent[2]; y <= extent[3]; ++y)
+      {
+        const bool yInside = zInside && y >= 0 && y < dimensions[1];
+        const auto rowOffset = (static_cast<std::size_t>(z) * dimensions[1] + y) * dimensions[0];
+        for (int x = extent[0]; x <= extent[1]; ++x, ++maskData)
+        {
+          *maskData = yInside && x >= 0 && x < dimensions[0] && labelValue == data[rowOffset + x] ? 1 : 0;
+          hasLabel |= 0 != *maskData;
+        }
+      }
+    }
+
+    if (!hasLabel)
+      return nullptr;
+
+    auto marching = vtkSmartPointer<vtkMarchingCubes>::New();
+    marching->SetInputData(mask);
+    marching->SetValue(0, 0.5);
+    marching->ComputeNormalsOff();
+    marching->ComputeGradientsOff();
+    marching->ComputeScalarsOff();
+    marching->Update();
+
+    vtkSmartPointer<vtkPolyData> surface = marching->GetOutput();
+    if (0 == surface->GetNumberOfPoints())
+      return nullptr;
+
+    // The points are transformed with the same matrix in all blocks, so points on shared block faces
+    // stay identical and can be merged exactly when the blocks are stitched.
+    auto points = surface->GetPoints();
+    const auto numberOfPoints = points->GetNumberOfPoints();
+    isFacePoint.assign(numberOfPoints, false);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      double index[3];
+      points->GetPoint(i, index);
+
+      // points on a face have exactly the integer coordinate of the face plane
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        if (index[dim] == extent[2 * dim] || index[dim] == extent[2 * dim + 1])
+          isFacePoint[i] = true;
+      }
+
+      double world[3];
+      for (unsigned int row = 0; row < 3; ++row)
+      {
+        world[row] = indexToWorld[row * 4] * index[0] + indexToWorld[row * 4 + 1] * index[1] +
+          indexToWorld[row * 4 + 2] * index[2] + indexToWorld[row * 4 + 3];
+      }
+      points->SetPoint(i, world);
+    }
+
+    return surface;
+  }
+}
+
+mitk::IncrementalLabelSurfaceMesher::IncrementalLabelSurfaceMesher()
+  : m_LabelValue(0),
+    m_TimeStep(0),
+    m_Output(Surface::New()),
+    m_NumberOfUpdatedBlocks(0),
+    m_IsMeshed(false),
+    m_GroupImage(nullptr),
+    m_GroupID(0),
+    m_GroupImageMTime(0),
+    m_GeometryMTime(0)
+{
+  m_Output->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New());
+}
+
+void mitk::IncrementalLabelSurfaceMesher::SetSegmentation(const MultiLabelSegmentation* segmentation)
+{
+  if (m_Segmentation == segmentation)
+    return;
+
+  m_Segmentation = segmentation;
+  this->Reset();
+  this->Modified();
+}
+
+const mitk::MultiLabelSegmentation* mitk::IncrementalLabelSurfaceMesher::GetSegmentation() const
+{
+  return m_Segmentation;
+}
+
+void mitk::IncrementalLabelSurfaceMesher::SetLabelValue(LabelValueType labelValue)
+{
+  if (m_LabelValue == labelValue)
+    return;
+
+  m_LabelValue = labelValue;
+  this->Reset();
+  this->Modified();
+}
+
+void mitk::IncrementalLabelSurfaceMesher::SetTimeStep(TimeStepType timeStep)
+{
+  if (m_TimeStep == timeStep)
+    return;
+
+  m_TimeStep = timeStep;
+  this->Reset();
+  this->Modified();
+}
+
+mitk::Surface* mitk::IncrementalLabelSurfaceMesher::GetOutput()
+{
+  return m_Output;
+}
+
+std::size_t mitk::IncrementalLabelSurfaceMesher::GetNumberOfSurfaceBlocks() const
+{
+  return m_Blocks.size();
+}
+
+void mitk::IncrementalLabelSurfaceMesher::Reset()
+{
+  m_IsMeshed = false;
+  m_GroupImage = nullptr;
+
+  if (!m_Blocks.empty())
+  {
+    m_Blocks.clear();
+    this->StitchBlocks();
+  }
+}
+
+void mitk::IncrementalLabelSurfaceMesher::Update()
+{
+  if (m_Segmentation.IsNull())
+    mitkThrow() << "Cannot update label surface. No segmentation is set.";
+
+  m_NumberOfUpdatedBlocks = 0;
+
+  if (!m_Segmentation->ExistLabel(m_LabelValue))
+  {
+    this->Reset();
+    return;
+  }
+
+  const auto groupID = m_Segmentation->GetGroupIndexOfLabel(m_LabelValue);
+  const auto groupImage = m_Segmentation->GetGroupImage(groupID);
+
+  if (m_TimeStep >= groupImage->GetTimeSteps())
+    mitkThrow() << "Cannot update label surface. Invalid time step: " << m_TimeStep;
+
+  const auto geometryMTime = groupImage->GetGeometry(m_TimeStep)->GetMTime();
+  bool fullUpdate = !m_IsMeshed || m_GroupImage != groupImage || m_GroupID != groupID || m_GeometryMTime != geometryMTime;
+
+  RegionType modifiedRegion;
+  if (!fullUpdate)
+  {
+    if (groupImage->GetMTime() == m_GroupImageMTime)
+      return;
+
+    fullUpdate = !m_Segmentation->GetModifiedGroupRegion(groupID, m_TimeStep, m_GroupImageMTime, modifiedRegion);
+  }
+
+  if (fullUpdate)
+  {
+    m_Blocks.clear();
+    modifiedRegion = m_Segmentation->GetLabelBoundingRegion(m_LabelValue, m_TimeStep);
+  }
+
+  if (modifiedRegion.GetNumberOfPixels() > 0)
+    this->UpdateBlocks(groupImage, modifiedRegion);
+
+  if (fullUpdate || m_NumberOfUpdatedBlocks > 0)
+    this->StitchBlocks();
+
+  m_IsMeshed = true;
+  m_GroupImage = groupImage;
+  m_GroupID = groupID;
+  m_GroupImageMTime = groupImage->GetMTime();
+  m_GeometryMTime = geometryMTime;
+}
+
+void mitk::IncrementalLabelSurfaceMesher::UpdateBlocks(const Image* groupImage, const RegionType& voxelRegion)
+{
+  DimensionsType dimensions;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    dimensions[dim] = dim < groupImage->GetDimension() ? groupImage->GetDimension(dim) : 1;
+
+  // a voxel v is a corner of the cells v-1 and v.
+  std::array<unsigned int, 3> firstBlock, lastBlock;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto lower = std::max<itk::IndexValueType>(voxelRegion.GetIndex(dim), 0);
+    const auto upper = std::min<itk::IndexValueType>(voxelRegion.GetUpperIndex()[dim], dimensions[dim] - 1);
+    if (lower > upper)
+      return;
+
+    firstBlock[dim] = GetBlockOfCell(lower - 1);
+    lastBlock[dim] = std::min(GetBlockOfCell(upper), GetNumberOfBlocks(dimensions[dim]) - 1);
+  }
+
+  std::vector<BlockIndexType> blocks;
+  for (auto z = firstBlock[2]; z <= lastBlock[2]; ++z)
+    for (auto y = firstBlock[1]; y <= lastBlock[1]; ++y)
+      for (auto x = firstBlock[0]; x <= lastBlock[0]; ++x)
+        blocks.push_back({ x, y, z });
+
+  MatrixElementsType indexToWorld;
+  const auto matrix = groupImage->GetGeometry(m_TimeStep)->GetVtkMatrix();
+  for (unsigned int row = 0; row < 4; ++row)
+    for (unsigned int column = 0; column < 4; ++column)
+      indexToWorld[row * 4 + column] = matrix->GetElement(row, column);
+
+  ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(m_TimeStep));
+  const auto data = static_cast<const Label::PixelType*>(accessor.GetData());
+
+  std::vector<BlockSurface> surfaces(blocks.size());
+  const auto labelValue = m_LabelValue;
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, blocks.size(), [&](itk::SizeValueType i)
+  {
+    surfaces[i].Surface = GenerateBlockSurface(data, dimensions, labelValue, blocks[i], indexToWorld, surfaces[i].IsFacePoint);
+  }, nullptr);
+
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    if (nullptr == surfaces[i].Surface.GetPointer())
+    {
+      m_Blocks.erase(blocks[i]);
+    }
+    else
+    {
+      m_Blocks[blocks[i]] = std::move(surfaces[i]);
+    }
+  }
+
+  m_NumberOfUpdatedBlocks = blocks.size();
+}
+
+void mitk::IncrementalLabelSurfaceMesher::StitchBlocks()
+{
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+
+  if (m_Blocks.empty())
+  {
+    m_Output->SetVtkPolyData(output);
+    return;
+  }
+
+  vtkIdType numberOfPoints = 0;
+  vtkIdType numberOfPolys = 0;
+  for (const auto& [block, blockSurface] : m_Blocks)
+  {
+    (void)block; // Prevent unused variable error in older compilers
+    numberOfPoints += blockSurface.Surface->GetNumberOfPoints();
+    numberOfPolys += blockSurface.Surface->GetNumberOfPolys();
+  }
+
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->Allocate(numberOfPoints);
+  auto polys = vtkSmartPointer<vtkCellArray>::New();
+  polys->AllocateEstimate(numberOfPolys, 3);
+
+  // Neighboring blocks share only the points on their common faces. Merging is restricted to these points,
+  // instead of cleaning the whole surface again whenever a single block changed.
+  std::map<std::array<double, 3>, vtkIdType> facePointIds;
+  std::vector<vtkIdType> pointIds;
+  std::vector<vtkIdType> cellPointIds;
+
+  for (const auto& [block, blockSurface] : m_Blocks)
+  {
+    (void)block; // Prevent unused variable error in older compilers
+    const auto blockPoints = blockSurface.Surface->GetPoints();
+    const auto numberOfBlockPoints = blockPoints->GetNumberOfPoints();
+
+    pointIds.resize(numberOfBlockPoints);
+    for (vtkIdType i = 0; i < numberOfBlockPoints; ++i)
+    {
+      std::array<double, 3> point;
+      blockPoints->GetPoint(i, point.data());
+
+      if (blockSurface.IsFacePoint[i])
+      {
+        auto [finding, inserted] = facePointIds.emplace(point, points->GetNumberOfPoints());
+        if (inserted)
+          points->InsertNextPoint(point.data());
+        pointIds[i] = finding->second;
+      }
+      else
+      {
+        pointIds[i] = points->InsertNextPoint(point.data());
+      }
+    }
+
+    auto blockPolys = blockSurface.Surface->GetPolys();
+    vtkIdType numberOfCellPoints = 0;
+    const vtkIdType* blockCellPointIds = nullptr;
+    for (blockPolys->InitTraversal(); blockPolys->GetNextCell(numberOfCellPoints, blockCellPointIds);)
+    {
+      cellPointIds.resize(numberOfCellPoints);
+      for (vtkIdType i = 0; i < numberOfCellPoints; ++i)
+        cellPointIds[i] = pointIds[blockCellPointIds[i]];
+      polys->InsertNextCell(numberOfCellPoints, cellPointIds.data());
+    }
+  }
+
+  output->SetPoints(points);
+  output->SetPolys(polys);
+  m_Output->SetVtkPolyData(output);
+}
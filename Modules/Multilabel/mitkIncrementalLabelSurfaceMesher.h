@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIncrementalLabelSurfaceMesher_h
+#define mitkIncrementalLabelSurfaceMesher_h
+
+#include <mitkLabelSetImage.h>
+#include <mitkSurface.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <map>
+#include <vector>
+
+class vtkPolyData;
+
+namespace mitk
+{
+  /** @brief Generates the surface of a label and keeps it up to date by re-meshing only modified parts.
+  *
+  * The group image is partitioned into cubic blocks of marching cubes cells with an edge length of
+  * BlockEdgeLength cells. The surface of each block is extracted separately (marching cubes on the binary
+  * mask of the label) and the block surfaces are stitched into the output. Only the points on the faces of
+  * the blocks are merged while stitching; within a block the points are already merged by marching cubes.
+  * The image border is padded with unlabeled voxels, so the output is closed.
+  *
+  * On Update() only blocks that contain cells touched by a modification of the group image are extracted
+  * again. The modified region is taken from the segmentation (see MultiLabelSegmentation::GetModifiedGroupRegion()),
+  * which is e.g. reported by the write-back of mitk::SegTool2D. If the modification is unknown (or the geometry,
+  * the label or the group changed), the whole bounding region of the label is meshed again.
+  *
+  * In contrast to mitk::LabelSetImageToSurfaceFilter the surface is not smoothed. It is meant for fast visual
+  * feedback while a label is edited. The points of the output are in world coordinates.
+  */
+  class MITKMULTILABEL_EXPORT IncrementalLabelSurfaceMesher : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(IncrementalLabelSurfaceMesher, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using LabelValueType = MultiLabelSegmentation::LabelValueType;
+    using RegionType = LabelOccupancyIndex::RegionType;
+
+    /** Edge length (in marching cubes cells) of the blocks.*/
+    static const unsigned int BlockEdgeLength;
+
+    /** Changing the segmentation, the label value or the time step discards the current surface.*/
+    void SetSegmentation(const MultiLabelSegmentation* segmentation);
+    const MultiLabelSegmentation* GetSegmentation() const;
+
+    void SetLabelValue(LabelValueType labelValue);
+    itkGetConstMacro(LabelValue, LabelValueType);
+
+    void SetTimeStep(TimeStepType timeStep);
+    itkGetConstMacro(TimeStep, TimeStepType);
+
+    /** @brief Brings the output up to date with the current content of the label.
+    * If the label does not exist (anymore), the output is empty.
+    * @pre A segmentation must be set and the time step must be valid for it.*/
+    void Update();
+
+    /** Discards all extracted blocks. The next Update() meshes the whole label again.*/
+    void Reset();
+
+    /** The output surface. It is the same instance for the whole life time of the mesher;
+    * its poly data is replaced by Update().*/
+    Surface* GetOutput();
+
+    /** Number of blocks that were extracted by the last Update().*/
+    itkGetConstMacro(NumberOfUpdatedBlocks, std::size_t);
+
+    /** Number of blocks that currently contribute to the output.*/
+    std::size_t GetNumberOfSurfaceBlocks() const;
+
+  protected:
+    IncrementalLabelSurfaceMesher();
+    ~IncrementalLabelSurfaceMesher() override = default;
+
+    using BlockIndexType = std::array<unsigned int, 3>;
+
+    struct BlockSurface
+    {
+      vtkSmartPointer<vtkPolyData> Surface;
+      /** Indicates for each point of Surface if it lies on a face of the block and may be shared with a neighbor.*/
+      std::vector<bool> IsFacePoint;
+    };
+
+    using BlockMapType = std::map<BlockIndexType, BlockSurface>;
+
+    /** Extracts the surface of all blocks that contain cells touching the passed voxel region.*/
+    void UpdateBlocks(const Image* groupImage, const RegionType& voxelRegion);
+    /** Merges the surfaces of all blocks into the output. Only points on block faces are looked up for merging.*/
+    void StitchBlocks();
+
+    MultiLabelSegmentation::ConstPointer m_Segmentation;
+    LabelValueType m_LabelValue;
+    TimeStepType m_TimeStep;
+
+    Surface::Pointer m_Output;
+    BlockMapType m_Blocks;
+    std::size_t m_NumberOfUpdatedBlocks;
+
+    /** State of the segmentation that is reflected by m_Blocks.*/
+    bool m_IsMeshed;
+    const Image* m_GroupImage;
+    MultiLabelSegmentation::GroupIndexType m_GroupID;
+    itk::ModifiedTimeType m_GroupImageMTime;
+    itk::ModifiedTimeType m_GeometryMTime;
+  };
+}
+
+#endif
@@ -0,0 +1,324 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelGroupBrickStorage.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+  // Same value as mitk::MultiLabelSegmentation::UNLABELED_VALUE.
+  constexpr mitk::LabelGroupBrickStorage::PixelType UNLABELED_VALUE = 0;
+}
+
+const unsigned int mitk::LabelGroupBrickStorage::BrickEdgeLength = 32;
+
+mitk::LabelGroupBrickStorage::LabelGroupBrickStorage()
+  : m_Dimensions({0, 0, 0}),
+    m_BrickCounts({0, 0, 0})
+{
+}
+
+mitk::LabelGroupBrickStorage::LabelGroupBrickStorage(const Self& other)
+  : itk::Object()
+{
+  std::shared_lock<std::shared_mutex> guard(other.m_Mutex);
+  m_Dimensions = other.m_Dimensions;
+  m_BrickCounts = other.m_BrickCounts;
+  m_TimeSteps = other.m_TimeSteps;
+}
+
+void mitk::LabelGroupBrickStorage::Initialize(const Image* image)
+{
+  if (nullptr == image || !image->IsInitialized())
+    mitkThrow() << "Cannot initialize label brick storage. Passed image is invalid.";
+
+  if (image->GetDimension() < 2 || image->GetDimension() > 4)
+    mitkThrow() << "Cannot initialize label brick storage. Image must be 2D, 3D or 3D+t. Dimension: " << image->GetDimension();
+
+  if (!(image->GetPixelType() == MakeScalarPixelType<PixelType>()))
+    mitkThrow() << "Cannot initialize label brick storage. Image has an unsupported pixel type: " << image->GetPixelType().GetTypeAsString();
+
+  std::vector<BrickVectorType> timeSteps(image->GetTimeSteps());
+
+  {
+    // Dimensions must be known by StoreTimeStep()
+    std::lock_guard<std::shared_mutex> guard(m_Mutex);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      m_Dimensions[dim] = dim < image->GetDimension() ? image->GetDimension(dim) : 1;
+      m_BrickCounts[dim] = (m_Dimensions[dim] + BrickEdgeLength - 1) / BrickEdgeLength;
+    }
+  }
+
+  for (TimeStepType timeStep = 0; timeStep < timeSteps.size(); ++timeStep)
+    this->StoreTimeStep(image, timeStep, timeSteps[timeStep]);
+
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  m_TimeSteps = std::move(timeSteps);
+  this->Modified();
+}
+
+void mitk::LabelGroupBrickStorage::StoreTimeStep(const Image* image, TimeStepType timeStep, BrickVectorType& bricks) const
+{
+  const auto dimX = m_Dimensions[0];
+  const auto dimY = m_Dimensions[1];
+  const auto dimZ = m_Dimensions[2];
+
+  bricks.resize(m_BrickCounts[0] * m_BrickCounts[1] * m_BrickCounts[2]);
+
+  ImageReadAccessor readAccess(image, image->GetVolumeData(timeStep));
+  const auto* pixels = static_cast<const PixelType*>(readAccess.GetData());
+
+  // Walk the image row by row (memory order) and copy each row segment that contains labels
+  // into its brick. Bricks are only allocated when the first labeled segment is found.
+  for (unsigned int z = 0; z < dimZ; ++z)
+  {
+    for (unsigned int y = 0; y < dimY; ++y, pixels += dimX)
+    {
+      for (unsigned int brickX = 0; brickX < m_BrickCounts[0]; ++brickX)
+      {
+        const auto segmentBegin = pixels + brickX * BrickEdgeLength;
+        const auto segmentEnd = pixels + std::min(dimX, (brickX + 1) * BrickEdgeLength);
+
+        if (std::all_of(segmentBegin, segmentEnd, [](PixelType value) { return UNLABELED_VALUE == value; }))
+          continue;
+
+        auto& brick = bricks[this->GetBrickID(brickX, y / BrickEdgeLength, z / BrickEdgeLength)];
+        if (brick.empty())
+          brick.resize(BrickEdgeLength * BrickEdgeLength * BrickEdgeLength, UNLABELED_VALUE);
+
+        const auto brickOffset = ((z % BrickEdgeLength) * BrickEdgeLength + (y % BrickEdgeLength)) * BrickEdgeLength;
+        std::copy(segmentBegin, segmentEnd, brick.begin() + brickOffset);
+      }
+    }
+  }
+}
+
+void mitk::LabelGroupBrickStorage::Clear()
+{
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  m_TimeSteps.clear();
+  m_Dimensions = { 0, 0, 0 };
+  m_BrickCounts = { 0, 0, 0 };
+  this->Modified();
+}
+
+bool mitk::LabelGroupBrickStorage::IsInitialized() const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+  return !m_TimeSteps.empty();
+}
+
+mitk::LabelGroupBrickStorage::DimensionsType mitk::LabelGroupBrickStorage::GetDimensions() const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+  return m_Dimensions;
+}
+
+unsigned int mitk::LabelGroupBrickStorage::GetNumberOfTimeSteps() const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+  return m_TimeSteps.size();
+}
+
+void mitk::LabelGroupBrickStorage::WriteToImage(Image* image) const
+{
+  if (nullptr == image || !image->IsInitialized())
+    mitkThrow() << "Cannot write label brick storage to image. Passed image is invalid.";
+
+  if (!(image->GetPixelType() == MakeScalarPixelType<PixelType>()))
+    mitkThrow() << "Cannot write label brick storage to image. Image has an unsupported pixel type: " << image->GetPixelType().GetTypeAsString();
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  if (image->GetTimeSteps() != m_TimeSteps.size())
+    mitkThrow() << "Cannot write label brick storage to image. Number of time steps does not match. Image: " << image->GetTimeSteps() << "; storage: " << m_TimeSteps.size();
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto imageDimension = dim < image->GetDimension() ? image->GetDimension(dim) : 1;
+    if (imageDimension != m_Dimensions[dim])
+      mitkThrow() << "Cannot write label brick storage to image. Image size does not match in dimension " << dim;
+  }
+
+  const auto dimX = m_Dimensions[0];
+  const auto dimY = m_Dimensions[1];
+  const auto dimZ = m_Dimensions[2];
+
+  for (TimeStepType timeStep = 0; timeStep < m_TimeSteps.size(); ++timeStep)
+  {
+    ImageWriteAccessor writeAccess(image, image->GetVolumeData(timeStep));
+    auto* pixels = static_cast<PixelType*>(writeAccess.GetData());
+    std::fill_n(pixels, static_cast<std::size_t>(dimX) * dimY * dimZ, UNLABELED_VALUE);
+
+    const auto& bricks = m_TimeSteps[timeStep];
+
+    for (unsigned int brickZ = 0; brickZ < m_BrickCounts[2]; ++brickZ)
+    {
+      for (unsigned int brickY = 0; brickY < m_BrickCounts[1]; ++brickY)
+      {
+        for (unsigned int brickX = 0; brickX < m_BrickCounts[0]; ++brickX)
+        {
+          const auto& brick = bricks[this->GetBrickID(brickX, brickY, brickZ)];
+          if (brick.empty())
+            continue;
+
+          const auto beginX = brickX * BrickEdgeLength;
+          const auto rowLength = std::min(dimX, beginX + BrickEdgeLength) - beginX;
+          const auto endY = std::min(dimY, (brickY + 1) * BrickEdgeLength);
+          const auto endZ = std::min(dimZ, (brickZ + 1) * BrickEdgeLength);
+
+          for (auto z = brickZ * BrickEdgeLength; z < endZ; ++z)
+          {
+            for (auto y = brickY * BrickEdgeLength; y < endY; ++y)
+            {
+              const auto brickOffset = ((z % BrickEdgeLength) * BrickEdgeLength + (y % BrickEdgeLength)) * BrickEdgeLength;
+              std::copy_n(brick.begin() + brickOffset, rowLength, pixels + (static_cast<std::size_t>(z) * dimY + y) * dimX + beginX);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  image->Modified();
+}
+
+void mitk::LabelGroupBrickStorage::ExtractSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep, PixelType* buffer) const
+{
+  if (sliceDimension > 2)
+    mitkThrow() << "Cannot extract slice from label brick storage. Invalid slice dimension: " << sliceDimension;
+
+  if (nullptr == buffer)
+    mitkThrow() << "Cannot extract slice from label brick storage. Passed buffer is nullptr.";
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep >= m_TimeSteps.size() || sliceIndex >= m_Dimensions[sliceDimension])
+    mitkThrow() << "Cannot extract slice from label brick storage. Invalid time step or slice index. Time step: " << timeStep << "; slice index: " << sliceIndex;
+
+  // in-plane axes of the slice; axisU runs fastest in the buffer
+  const unsigned int axisU = 0 == sliceDimension ? 1 : 0;
+  const unsigned int axisV = 2 == sliceDimension ? 1 : 2;
+  const auto sizeU = m_Dimensions[axisU];
+  const auto sizeV = m_Dimensions[axisV];
+
+  std::fill_n(buffer, static_cast<std::size_t>(sizeU) * sizeV, UNLABELED_VALUE);
+
+  const auto& bricks = m_TimeSteps[timeStep];
+  const std::array<unsigned int, 3> strides = { 1, BrickEdgeLength, BrickEdgeLength * BrickEdgeLength };
+
+  std::array<unsigned int, 3> brickCoords;
+  brickCoords[sliceDimension] = sliceIndex / BrickEdgeLength;
+  const auto sliceOffset = (sliceIndex % BrickEdgeLength) * strides[sliceDimension];
+
+  for (brickCoords[axisV] = 0; brickCoords[axisV] < m_BrickCounts[axisV]; ++brickCoords[axisV])
+  {
+    for (brickCoords[axisU] = 0; brickCoords[axisU] < m_BrickCounts[axisU]; ++brickCoords[axisU])
+    {
+      const auto& brick = bricks[this->GetBrickID(brickCoords[0], brickCoords[1], brickCoords[2])];
+      if (brick.empty())
+        continue;
+
+      const auto beginU = brickCoords[axisU] * BrickEdgeLength;
+      const auto endU = std::min(sizeU, beginU + BrickEdgeLength);
+      const auto beginV = brickCoords[axisV] * BrickEdgeLength;
+      const auto endV = std::min(sizeV, beginV + BrickEdgeLength);
+
+      for (auto v = beginV; v < endV; ++v)
+      {
+        const auto rowOffset = sliceOffset + (v - beginV) * strides[axisV];
+        auto* target = buffer + static_cast<std::size_t>(v) * sizeU;
+
+        for (auto u = beginU; u < endU; ++u)
+          target[u] = brick[rowOffset + (u - beginU) * strides[axisU]];
+      }
+    }
+  }
+}
+
+bool mitk::LabelGroupBrickStorage::IsInside(const IndexType& index, TimeStepType timeStep) const
+{
+  if (timeStep >= m_TimeSteps.size())
+    return false;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (index[dim] < 0 || index[dim] >= static_cast<IndexType::IndexValueType>(m_Dimensions[dim]))
+      return false;
+  }
+
+  return true;
+}
+
+std::size_t mitk::LabelGroupBrickStorage::GetBrickID(unsigned int brickX, unsigned int brickY, unsigned int brickZ) const
+{
+  return (static_cast<std::size_t>(brickZ) * m_BrickCounts[1] + brickY) * m_BrickCounts[0] + brickX;
+}
+
+mitk::LabelGroupBrickStorage::PixelType mitk::LabelGroupBrickStorage::GetPixel(const IndexType& index, TimeStepType timeStep) const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  if (!this->IsInside(index, timeStep))
+    mitkThrow() << "Cannot get pixel of label brick storage. Index or time step is invalid. Index: " << index << "; time step: " << timeStep;
+
+  const auto& brick = m_TimeSteps[timeStep][this->GetBrickID(index[0] / BrickEdgeLength, index[1] / BrickEdgeLength, index[2] / BrickEdgeLength)];
+  if (brick.empty())
+    return UNLABELED_VALUE;
+
+  return brick[((index[2] % BrickEdgeLength) * BrickEdgeLength + (index[1] % BrickEdgeLength)) * BrickEdgeLength + (index[0] % BrickEdgeLength)];
+}
+
+void mitk::LabelGroupBrickStorage::SetPixel(const IndexType& index, TimeStepType timeStep, PixelType value)
+{
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+
+  if (!this->IsInside(index, timeStep))
+    mitkThrow() << "Cannot set pixel of label brick storage. Index or time step is invalid. Index: " << index << "; time step: " << timeStep;
+
+  auto& brick = m_TimeSteps[timeStep][this->GetBrickID(index[0] / BrickEdgeLength, index[1] / BrickEdgeLength, index[2] / BrickEdgeLength)];
+  if (brick.empty())
+  {
+    if (UNLABELED_VALUE == value)
+      return;
+
+    brick.resize(BrickEdgeLength * BrickEdgeLength * BrickEdgeLength, UNLABELED_VALUE);
+  }
+
+  brick[((index[2] % BrickEdgeLength) * BrickEdgeLength + (index[1] % BrickEdgeLength)) * BrickEdgeLength + (index[0] % BrickEdgeLength)] = value;
+  this->Modified();
+}
+
+std::size_t mitk::LabelGroupBrickStorage::GetNumberOfAllocatedBricks() const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  std::size_t result = 0;
+  for (const auto& bricks : m_TimeSteps)
+  {
+    result += std::count_if(bricks.begin(), bricks.end(), [](const BrickType& brick) { return !brick.empty(); });
+  }
+
+  return result;
+}
+
+std::size_t mitk::LabelGroupBrickStorage::GetAllocatedMemorySize() const
+{
+  return this->GetNumberOfAllocatedBricks() * BrickEdgeLength * BrickEdgeLength * BrickEdgeLength * sizeof(PixelType);
+}
@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelGroupBrickStorage_h
+#define mitkLabelGroupBrickStorage_h
+
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <array>
+#include <shared_mutex>
+#include <vector>
+
+namespace mitk
+{
+  /** @brief Sparse storage for the label content of a group image.
+  *
+  * The image is partitioned into cubic bricks with an edge length of BrickEdgeLength voxels.
+  * Only bricks that contain at least one labeled voxel are allocated; all other bricks are
+  * implicitly unlabeled. For typical segmentations, where labels cover only a small part of the
+  * image, this needs a fraction of the memory of the dense group image.
+  *
+  * The storage is used by mitk::MultiLabelSegmentation to park groups that are not edited
+  * (see MultiLabelSegmentation::CompressGroup()). Dense data can be regained for the whole
+  * image (WriteToImage()) or for single slices (ExtractSlice()), e.g. for rendering.
+  *
+  * All methods are thread-safe.
+  */
+  class MITKMULTILABEL_EXPORT LabelGroupBrickStorage : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LabelGroupBrickStorage, itk::Object);
+    itkFactorylessNewMacro(Self);
+    itkCloneMacro(Self);
+
+    using PixelType = Label::PixelType;
+    using IndexType = itk::Index<3>;
+    using DimensionsType = std::array<unsigned int, 3>;
+
+    /** Edge length (in voxels) of the bricks.*/
+    static const unsigned int BrickEdgeLength;
+
+    /** @brief Stores the content of all time steps of the passed label image.
+    * @pre image must be a valid 3D or 3D+t image with pixel type Label::PixelType.*/
+    void Initialize(const Image* image);
+
+    /** Removes all content and releases the bricks.*/
+    void Clear();
+
+    bool IsInitialized() const;
+
+    DimensionsType GetDimensions() const;
+    unsigned int GetNumberOfTimeSteps() const;
+
+    /** @brief Writes the content of all time steps into the passed image. Voxels outside of
+    * allocated bricks are set to unlabeled.
+    * @pre image must have the dimensions, time steps and pixel type of the image the storage
+    * was initialized with.*/
+    void WriteToImage(Image* image) const;
+
+    /** @brief Writes the content of a slice into the passed buffer.
+    * The slice is orthogonal to the axis sliceDimension. The buffer is filled in the order of the
+    * two remaining axes, the lower axis running fastest (e.g. x then z for sliceDimension 1). This is
+    * the memory layout of an image with size 1 in sliceDimension.
+    * @pre buffer must have space for the number of voxels of the slice.*/
+    void ExtractSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep, PixelType* buffer) const;
+
+    PixelType GetPixel(const IndexType& index, TimeStepType timeStep) const;
+
+    /** Sets the value of a voxel. Bricks are allocated on demand; setting unlabeled voxels outside
+    * of allocated bricks allocates nothing.*/
+    void SetPixel(const IndexType& index, TimeStepType timeStep, PixelType value);
+
+    /** Number of allocated bricks over all time steps.*/
+    std::size_t GetNumberOfAllocatedBricks() const;
+
+    /** Memory (in bytes) occupied by the voxel data of all allocated bricks.*/
+    std::size_t GetAllocatedMemorySize() const;
+
+  protected:
+    LabelGroupBrickStorage();
+    /** Deep copy; the allocated bricks of other are copied.*/
+    LabelGroupBrickStorage(const Self& other);
+    ~LabelGroupBrickStorage() override = default;
+
+    mitkCloneMacro(Self);
+
+    /** A brick is either empty (not allocated) or holds BrickEdgeLength^3 voxels.*/
+    using BrickType = std::vector<PixelType>;
+    using BrickVectorType = std::vector<BrickType>;
+
+    std::size_t GetBrickID(unsigned int brickX, unsigned int brickY, unsigned int brickZ) const;
+    bool IsInside(const IndexType& index, TimeStepType timeStep) const;
+    void StoreTimeStep(const Image* image, TimeStepType timeStep, BrickVectorType& bricks) const;
+
+    DimensionsType m_Dimensions;
+    DimensionsType m_BrickCounts;
+    std::vector<BrickVectorType> m_TimeSteps;
+
+    mutable std::shared_mutex m_Mutex;
+  };
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelGroupContentLoader_h
+#define mitkLabelGroupContentLoader_h
+
+#include <mitkImage.h>
+
+#include <MitkMultilabelExports.h>
+
+namespace mitk
+{
+  /** @brief Interface of objects that provide the pixel content of a group on demand.
+  *
+  * Readers can add groups with a loader (see MultiLabelSegmentation::AddDeferredGroup()) instead of
+  * reading their content upfront. The loader is called on the first access of the group image.
+  * Copies of a segmentation share the loaders of groups that were not loaded yet, so LoadContent()
+  * may be called more than once and from different threads.
+  */
+  class MITKMULTILABEL_EXPORT LabelGroupContentLoader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LabelGroupContentLoader, itk::Object);
+
+    /** Fills the passed group image with the content of the group. The group image has
+    * the layout of all group images of the segmentation the group belongs to.
+    * @throw mitk::Exception if the content cannot be loaded.*/
+    virtual void LoadContent(Image* groupImage) const = 0;
+
+  protected:
+    LabelGroupContentLoader() = default;
+    ~LabelGroupContentLoader() override = default;
+  };
+}
+
+#endif
@@ -0,0 +1,400 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelOccupancyIndex.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+  // Same value as mitk::MultiLabelSegmentation::UNLABELED_VALUE. Unlabeled voxels are not indexed.
+  constexpr mitk::LabelOccupancyIndex::LabelValueType UNLABELED_VALUE = 0;
+}
+
+mitk::LabelOccupancyIndex::LabelOccupancyIndex()
+  : m_Dimensions({0, 0, 0}),
+    m_IndexedMTime(0)
+{
+}
+
+void mitk::LabelOccupancyIndex::Initialize(const Image* image)
+{
+  if (nullptr == image || !image->IsInitialized())
+    mitkThrow() << "Cannot initialize label occupancy index. Passed image is invalid.";
+
+  if (image->GetDimension() < 2 || image->GetDimension() > 4)
+    mitkThrow() << "Cannot initialize label occupancy index. Image must be 2D, 3D or 3D+t. Dimension: " << image->GetDimension();
+
+  if (!(image->GetPixelType() == MakeScalarPixelType<LabelValueType>()))
+    mitkThrow() << "Cannot initialize label occupancy index. Image has an unsupported pixel type: " << image->GetPixelType().GetTypeAsString();
+
+  const auto indexedMTime = image->GetMTime();
+  std::vector<LabelOccupancyMapType> timeSteps(image->GetTimeSteps());
+
+  std::array<unsigned int, 3> dimensions;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    dimensions[dim] = dim < image->GetDimension() ? image->GetDimension(dim) : 1;
+
+  // The image is scanned without holding the lock, readers see the previous state until it is replaced as a whole.
+  for (TimeStepType timeStep = 0; timeStep < timeSteps.size(); ++timeStep)
+    ScanTimeStep(image, timeStep, dimensions, timeSteps[timeStep]);
+
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  m_Dimensions = dimensions;
+  m_TimeSteps = std::move(timeSteps);
+  m_IndexedMTime = indexedMTime;
+  this->Modified();
+}
+
+void mitk::LabelOccupancyIndex::InitializeTimeStep(const Image* image, TimeStepType timeStep)
+{
+  if (nullptr == image || timeStep >= image->GetTimeSteps())
+    mitkThrow() << "Cannot initialize time step of label occupancy index. Passed image or time step is invalid.";
+
+  std::array<unsigned int, 3> dimensions;
+
+  {
+    std::shared_lock<std::shared_mutex> guard(m_Mutex);
+    if (m_TimeSteps.size() != image->GetTimeSteps())
+      mitkThrow() << "Cannot initialize time step of label occupancy index. Index was not initialized with an image of the same geometry.";
+    dimensions = m_Dimensions;
+  }
+
+  LabelOccupancyMapType occupancies;
+  ScanTimeStep(image, timeStep, dimensions, occupancies);
+
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  if (m_TimeSteps.size() != image->GetTimeSteps() || m_Dimensions != dimensions)
+    mitkThrow() << "Cannot initialize time step of label occupancy index. Index was reinitialized concurrently.";
+  m_TimeSteps[timeStep] = std::move(occupancies);
+  this->Modified();
+}
+
+void mitk::LabelOccupancyIndex::ScanTimeStep(const Image* image, TimeStepType timeStep, const std::array<unsigned int, 3>& dimensions, LabelOccupancyMapType& occupancies)
+{
+  const auto dimX = dimensions[0];
+  const auto dimY = dimensions[1];
+  const auto dimZ = dimensions[2];
+
+  ImageReadAccessor readAccess(image, image->GetVolumeData(timeStep));
+  const auto* pixels = static_cast<const LabelValueType*>(readAccess.GetData());
+
+  // Label values usually occur in runs, so remembering the last occupancy avoids most map lookups.
+  LabelValueType lastValue = UNLABELED_VALUE;
+  LabelOccupancy* lastOccupancy = nullptr;
+
+  for (unsigned int z = 0; z < dimZ; ++z)
+  {
+    for (unsigned int y = 0; y < dimY; ++y)
+    {
+      for (unsigned int x = 0; x < dimX; ++x, ++pixels)
+      {
+        const auto value = *pixels;
+
+        if (UNLABELED_VALUE == value)
+          continue;
+
+        if (nullptr == lastOccupancy || value != lastValue)
+        {
+          auto& occupancy = occupancies[value];
+
+          if (occupancy.SliceCounts.empty())
+          {
+            occupancy.SliceCounts = { SliceCountVectorType(dimX, 0), SliceCountVectorType(dimY, 0), SliceCountVectorType(dimZ, 0) };
+          }
+
+          lastValue = value;
+          lastOccupancy = &occupancy;
+        }
+
+        ++lastOccupancy->SliceCounts[0][x];
+        ++lastOccupancy->SliceCounts[1][y];
+        ++lastOccupancy->SliceCounts[2][z];
+        ++lastOccupancy->VoxelCount;
+      }
+    }
+  }
+}
+
+void mitk::LabelOccupancyIndex::Clear()
+{
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  m_TimeSteps.clear();
+  m_Dimensions = { 0, 0, 0 };
+  m_IndexedMTime = 0;
+  this->Modified();
+}
+
+bool mitk::LabelOccupancyIndex::IsUpToDate(const Image* image) const
+{
+  if (nullptr == image)
+    return false;
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+  return !m_TimeSteps.empty() && m_IndexedMTime >= image->GetMTime();
+}
+
+void mitk::LabelOccupancyIndex::MarkUpToDate(const Image* image)
+{
+  if (nullptr == image)
+    return;
+
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+  m_IndexedMTime = image->GetMTime();
+}
+
+const mitk::LabelOccupancyIndex::LabelOccupancy* mitk::LabelOccupancyIndex::FindOccupancy(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  if (timeStep >= m_TimeSteps.size())
+    return nullptr;
+
+  auto finding = m_TimeSteps[timeStep].find(labelValue);
+  return finding == m_TimeSteps[timeStep].end() ? nullptr : &(finding->second);
+}
+
+mitk::LabelOccupancyIndex::AxisSliceCountsType mitk::LabelOccupancyIndex::GetSliceCounts(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  const auto occupancy = this->FindOccupancy(labelValue, timeStep);
+
+  if (nullptr != occupancy)
+    return occupancy->SliceCounts;
+
+  return { SliceCountVectorType(m_Dimensions[0], 0), SliceCountVectorType(m_Dimensions[1], 0), SliceCountVectorType(m_Dimensions[2], 0) };
+}
+
+void mitk::LabelOccupancyIndex::SetSliceCounts(LabelValueType labelValue, TimeStepType timeStep, const AxisSliceCountsType& sliceCounts)
+{
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep >= m_TimeSteps.size())
+    mitkThrow() << "Cannot set slice counts of label occupancy index. Invalid time step: " << timeStep;
+
+  if (3 != sliceCounts.size())
+    mitkThrow() << "Cannot set slice counts of label occupancy index. Slice counts for all three axes are needed.";
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (sliceCounts[dim].size() != m_Dimensions[dim])
+      mitkThrow() << "Cannot set slice counts of label occupancy index. Slice counts do not match the image size in dimension " << dim;
+  }
+
+  // Each voxel is counted once per axis, so any axis can be used to determine the voxel count.
+  std::size_t voxelCount = 0;
+  for (const auto count : sliceCounts[2])
+    voxelCount += count;
+
+  if (0 == voxelCount)
+  {
+    m_TimeSteps[timeStep].erase(labelValue);
+  }
+  else
+  {
+    auto& occupancy = m_TimeSteps[timeStep][labelValue];
+    occupancy.SliceCounts = sliceCounts;
+    occupancy.VoxelCount = voxelCount;
+  }
+
+  this->Modified();
+}
+
+void mitk::LabelOccupancyIndex::UpdateSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep, const LabelValueType* oldSlice, const LabelValueType* newSlice)
+{
+  if (sliceDimension > 2)
+    mitkThrow() << "Cannot update slice of label occupancy index. Invalid slice dimension: " << sliceDimension;
+
+  RegionType sliceRegion;
+  {
+    std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+    if (sliceIndex >= m_Dimensions[sliceDimension])
+      mitkThrow() << "Cannot update slice of label occupancy index. Invalid slice index: " << sliceIndex;
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      sliceRegion.SetIndex(dim, dim == sliceDimension ? sliceIndex : 0);
+      sliceRegion.SetSize(dim, dim == sliceDimension ? 1 : m_Dimensions[dim]);
+    }
+  }
+
+  // a slice is a region of thickness 1; the remaining axes keep their order, the lower one running fastest.
+  this->UpdateRegion(sliceRegion, timeStep, oldSlice, newSlice);
+}
+
+void mitk::LabelOccupancyIndex::UpdateRegion(const RegionType& region, TimeStepType timeStep, const LabelValueType* oldContent, const LabelValueType* newContent)
+{
+  if (nullptr == oldContent || nullptr == newContent)
+    mitkThrow() << "Cannot update region of label occupancy index. Content buffers must not be nullptr.";
+
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep >= m_TimeSteps.size())
+    mitkThrow() << "Cannot update region of label occupancy index. Invalid time step: " << timeStep;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    if (region.GetIndex(dim) < 0 || region.GetIndex(dim) + region.GetSize(dim) > m_Dimensions[dim])
+      mitkThrow() << "Cannot update region of label occupancy index. Region is not inside the image in dimension " << dim;
+  }
+
+  auto& occupancies = m_TimeSteps[timeStep];
+  bool labelsRemoved = false;
+
+  std::array<unsigned int, 3> lower;
+  std::array<unsigned int, 3> upper;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    lower[dim] = static_cast<unsigned int>(region.GetIndex(dim));
+    upper[dim] = lower[dim] + static_cast<unsigned int>(region.GetSize(dim));
+  }
+
+  std::array<unsigned int, 3> coords;
+
+  for (coords[2] = lower[2]; coords[2] < upper[2]; ++coords[2])
+  {
+    for (coords[1] = lower[1]; coords[1] < upper[1]; ++coords[1])
+    {
+      for (coords[0] = lower[0]; coords[0] < upper[0]; ++coords[0], ++oldContent, ++newContent)
+      {
+        if (*oldContent == *newContent)
+          continue;
+
+        if (UNLABELED_VALUE != *oldContent)
+        {
+          auto finding = occupancies.find(*oldContent);
+          if (occupancies.end() == finding || 0 == finding->second.VoxelCount)
+            mitkThrow() << "Cannot update region of label occupancy index. Index is inconsistent with the old content. Unknown label: " << *oldContent;
+
+          auto& occupancy = finding->second;
+          for (unsigned int dim = 0; dim < 3; ++dim)
+            --occupancy.SliceCounts[dim][coords[dim]];
+          labelsRemoved |= 0 == --occupancy.VoxelCount;
+        }
+
+        if (UNLABELED_VALUE != *newContent)
+        {
+          auto& occupancy = occupancies[*newContent];
+          if (occupancy.SliceCounts.empty())
+            occupancy.SliceCounts = { SliceCountVectorType(m_Dimensions[0], 0), SliceCountVectorType(m_Dimensions[1], 0), SliceCountVectorType(m_Dimensions[2], 0) };
+
+          for (unsigned int dim = 0; dim < 3; ++dim)
+            ++occupancy.SliceCounts[dim][coords[dim]];
+          ++occupancy.VoxelCount;
+        }
+      }
+    }
+  }
+
+  if (labelsRemoved)
+  {
+    for (auto iter = occupancies.begin(); iter != occupancies.end();)
+      iter = 0 == iter->second.VoxelCount ? occupancies.erase(iter) : std::next(iter);
+  }
+
+  this->Modified();
+}
+
+void mitk::LabelOccupancyIndex::RemoveLabel(LabelValueType labelValue, TimeStepType timeStep)
+{
+  std::lock_guard<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep >= m_TimeSteps.size())
+    mitkThrow() << "Cannot remove label from label occupancy index. Invalid time step: " << timeStep;
+
+  if (m_TimeSteps[timeStep].erase(labelValue) > 0)
+    this->Modified();
+}
+
+std::size_t mitk::LabelOccupancyIndex::GetVoxelCount(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  const auto occupancy = this->FindOccupancy(labelValue, timeStep);
+  return nullptr != occupancy ? occupancy->VoxelCount : 0;
+}
+
+bool mitk::LabelOccupancyIndex::IsEmpty(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  return 0 == this->GetVoxelCount(labelValue, timeStep);
+}
+
+mitk::LabelOccupancyIndex::RegionType mitk::LabelOccupancyIndex::GetBoundingRegion(LabelValueType labelValue, TimeStepType timeStep) const
+{
+  RegionType region;
+  region.GetModifiableSize().Fill(0);
+  region.GetModifiableIndex().Fill(0);
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  const auto occupancy = this->FindOccupancy(labelValue, timeStep);
+
+  if (nullptr == occupancy || 0 == occupancy->VoxelCount)
+    return region;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto& counts = occupancy->SliceCounts[dim];
+    auto isOccupied = [](unsigned int count) { return count > 0; };
+
+    const auto first = std::find_if(counts.begin(), counts.end(), isOccupied);
+    const auto last = std::find_if(counts.rbegin(), counts.rend(), isOccupied);
+
+    region.SetIndex(dim, std::distance(counts.begin(), first));
+    region.SetSize(dim, std::distance(first, last.base()));
+  }
+
+  return region;
+}
+
+mitk::LabelOccupancyIndex::LabelValueVectorType mitk::LabelOccupancyIndex::GetLabelValues(TimeStepType timeStep) const
+{
+  LabelValueVectorType result;
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep < m_TimeSteps.size())
+  {
+    for (const auto& [value, occupancy] : m_TimeSteps[timeStep])
+    {
+      (void)occupancy; // Prevent unused variable error in older compilers
+      result.push_back(value);
+    }
+  }
+
+  return result;
+}
+
+mitk::LabelOccupancyIndex::LabelValueVectorType mitk::LabelOccupancyIndex::GetLabelValuesInSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep) const
+{
+  LabelValueVectorType result;
+
+  if (sliceDimension > 2)
+    return result;
+
+  std::shared_lock<std::shared_mutex> guard(m_Mutex);
+
+  if (timeStep < m_TimeSteps.size() && sliceIndex < m_Dimensions[sliceDimension])
+  {
+    for (const auto& [value, occupancy] : m_TimeSteps[timeStep])
+    {
+      if (occupancy.SliceCounts[sliceDimension][sliceIndex] > 0)
+        result.push_back(value);
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelOccupancyIndex_h
+#define mitkLabelOccupancyIndex_h
+
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <itkImageRegion.h>
+
+#include <MitkMultilabelExports.h>
+
+#include <array>
+#include <map>
+#include <shared_mutex>
+#include <vector>
+
+namespace mitk
+{
+  /** @brief Index that keeps track of which labels occur in which slices of a label image.
+  *
+  * For every label value and time step the index stores the number of voxels of the label in each
+  * slice along each of the three image axes. From these counts the voxel count and the bounding
+  * region (in index coordinates) of a label can be derived without touching the image again.
+  *
+  * The index is built by a single pass over the image with Initialize(). Afterwards it can be
+  * kept in sync incrementally by clients that know which parts of the image they changed
+  * (e.g. mitk::SegmentationInterpolationController) via SetSliceCounts(), UpdateSlice(), UpdateRegion()
+  * or RemoveLabel(). Clients that update the
+  * index have to call MarkUpToDate() after the indexed image was modified, otherwise the index is
+  * regarded as outdated (see IsUpToDate()).
+  *
+  * Each method is thread-safe on its own: Initialize() and InitializeTimeStep() scan the image without
+  * holding the internal lock and replace the indexed state afterwards in one step, so concurrent readers
+  * either see the previous or the new state. Sequences of calls are not atomic, though. An incremental
+  * update that runs concurrently to a (re)initialization may be overwritten by the scan result, and
+  * IsUpToDate() followed by a query may see different states. Clients that modify the indexed image and
+  * update the index (e.g. mitk::MultiLabelSegmentation) have to synchronize these sequences themselves.
+  */
+  class MITKMULTILABEL_EXPORT LabelOccupancyIndex : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(LabelOccupancyIndex, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using LabelValueType = Label::PixelType;
+    using LabelValueVectorType = std::vector<LabelValueType>;
+    using SliceCountVectorType = std::vector<unsigned int>;
+    /** Slice counts of one label for all three axes (index 0: slices orthogonal to x, ...).*/
+    using AxisSliceCountsType = std::vector<SliceCountVectorType>;
+    using RegionType = itk::ImageRegion<3>;
+
+    /** @brief Builds the index for all time steps of the passed label image.
+    * @pre image must be a valid 2D, 3D or 3D+t image with pixel type Label::PixelType.*/
+    void Initialize(const Image* image);
+
+    /** @brief Rebuilds the index of one time step of the passed label image.
+    * @pre image must be the image the index was initialized with (or an image of the same geometry).*/
+    void InitializeTimeStep(const Image* image, TimeStepType timeStep);
+
+    /** Removes all information from the index.*/
+    void Clear();
+
+    /** Indicates if the index reflects the current state of the passed image, i.e. the index was
+    * initialized or marked up to date after the last modification of the image.*/
+    bool IsUpToDate(const Image* image) const;
+
+    /** Declares the index to reflect the current state of the passed image.
+    * Call it after an incremental update of the index that followed a modification of the image.*/
+    void MarkUpToDate(const Image* image);
+
+    /** Returns the slice counts of a label along all three axes. If the label does not occur in the
+    * time step, vectors of the image size filled with 0 are returned.*/
+    AxisSliceCountsType GetSliceCounts(LabelValueType labelValue, TimeStepType timeStep) const;
+
+    /** Replaces the slice counts of a label by the passed counts. Labels whose counts are all 0 are
+    * removed from the index.
+    * @pre sliceCounts must contain three vectors that match the image size.*/
+    void SetSliceCounts(LabelValueType labelValue, TimeStepType timeStep, const AxisSliceCountsType& sliceCounts);
+
+    /** @brief Updates the index after the content of one slice of the image was replaced.
+    * The slice is orthogonal to the axis sliceDimension. Both buffers contain the slice in the order of
+    * the two remaining axes, the lower axis running fastest (see MultiLabelSegmentation::GetGroupSlab()).
+    * @pre oldSlice and newSlice must contain all voxels of the slice.*/
+    void UpdateSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep, const LabelValueType* oldSlice, const LabelValueType* newSlice);
+
+    /** @brief Updates the index after the content of a region of the image was replaced.
+    * Both buffers contain the voxels of the region in image order (x running fastest).
+    * @pre region must be inside the image and oldContent and newContent must contain all voxels of the region.*/
+    void UpdateRegion(const RegionType& region, TimeStepType timeStep, const LabelValueType* oldContent, const LabelValueType* newContent);
+
+    /** Removes a label from the given time step, e.g. after all its voxels were erased.*/
+    void RemoveLabel(LabelValueType labelValue, TimeStepType timeStep);
+
+    /** Returns the number of voxels of the label in the given time step.*/
+    std::size_t GetVoxelCount(LabelValueType labelValue, TimeStepType timeStep) const;
+
+    /** Indicates if the label has no voxels in the given time step.*/
+    bool IsEmpty(LabelValueType labelValue, TimeStepType timeStep) const;
+
+    /** Returns the smallest region (index coordinates) that contains all voxels of the label in the
+    * given time step. If the label is empty, a region of size 0 is returned.*/
+    RegionType GetBoundingRegion(LabelValueType labelValue, TimeStepType timeStep) const;
+
+    /** Returns all label values that occur in the given time step (sorted ascending).*/
+    LabelValueVectorType GetLabelValues(TimeStepType timeStep) const;
+
+    /** Returns all label values that occur in the indicated slice (sorted ascending).*/
+    LabelValueVectorType GetLabelValuesInSlice(unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep) const;
+
+  protected:
+    LabelOccupancyIndex();
+    ~LabelOccupancyIndex() override = default;
+
+    struct LabelOccupancy
+    {
+      AxisSliceCountsType SliceCounts;
+      std::size_t VoxelCount = 0;
+    };
+
+    using LabelOccupancyMapType = std::map<LabelValueType, LabelOccupancy>;
+
+    static void ScanTimeStep(const Image* image, TimeStepType timeStep, const std::array<unsigned int, 3>& dimensions, LabelOccupancyMapType& occupancies);
+    const LabelOccupancy* FindOccupancy(LabelValueType labelValue, TimeStepType timeStep) const;
+
+    std::vector<LabelOccupancyMapType> m_TimeSteps;
+    std::array<unsigned int, 3> m_Dimensions;
+    itk::ModifiedTimeType m_IndexedMTime;
+
+    mutable std::shared_mutex m_Mutex;
+  };
+}
+
+#endif
@@ -16,15 +16,20 @@ found in the LICENSE file.
 #include <mitkImageCast.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
-#include <mitkPadImageFilter.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkDICOMSegmentationPropertyHelper.h>
 #include <mitkDICOMQIPropertyHelper.h>
 #include <mitkNodePredicateGeometry.h>
 #include <mitkLabelSetImageHelper.h>
 #include <mitkImageTimeSelector.h>
-#include <itkLabelGeometryImageFilter.h>
 #include <itkCommand.h>
-#include <itkBinaryFunctorImageFilter.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 
 namespace mitk
@@ -49,6 +54,22 @@ namespace mitk
       AccessByItk(image, ClearBufferProcessing);
     }
   }
+
+  /** Removes all labels of the time steps [firstTimeStep, endTimeStep) from the occupancy index of a cleared
+    group image and declares the index up to date again. Nothing happens if index is nullptr.*/
+  void ClearOccupancyIndex(LabelOccupancyIndex* index, const Image* groupImage, TimeStepType firstTimeStep, TimeStepType endTimeStep)
+  {
+    if (nullptr == index)
+      return;
+
+    for (auto timeStep = firstTimeStep; timeStep < endTimeStep; ++timeStep)
+    {
+      for (const auto labelValue : index->GetLabelValues(timeStep))
+        index->RemoveLabel(labelValue, timeStep);
+    }
+
+    index->MarkUpToDate(groupImage);
+  }
 }
 
 const mitk::MultiLabelSegmentation::LabelValueType mitk::MultiLabelSegmentation::UNLABELED_VALUE = 0;
@@ -61,27 +82,39 @@ mitk::PixelType mitk::MultiLabelSegmentation::GetPixelType()
 
 bool mitk::MultiLabelSegmentation::IsSliceSet(int s, int t, int n) const
 {
+  std::shared_lock<std::shared_mutex> containerGuard(m_GroupContainerMutex);
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
   for (const auto& image : m_GroupContainer)
   {
-    if (!image->IsSliceSet(s, t, n)) return false;
+    // the content of compressed and deferred groups is set, even if the group image holds no data.
+    if (m_CompressedGroups.end() == m_CompressedGroups.find(image) && m_DeferredGroups.end() == m_DeferredGroups.find(image)
+        && !image->IsSliceSet(s, t, n)) return false;
   }
   return true;
 }
 
 bool mitk::MultiLabelSegmentation::IsVolumeSet(int t, int n) const
 {
+  std::shared_lock<std::shared_mutex> containerGuard(m_GroupContainerMutex);
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
   for (const auto& image : m_GroupContainer)
   {
-    if (!image->IsVolumeSet(t, n)) return false;
+    // the content of compressed and deferred groups is set, even if the group image holds no data.
+    if (m_CompressedGroups.end() == m_CompressedGroups.find(image) && m_DeferredGroups.end() == m_DeferredGroups.find(image)
+        && !image->IsVolumeSet(t, n)) return false;
   }
   return true;
 }
 
 bool mitk::MultiLabelSegmentation::IsChannelSet(int n) const
 {
+  std::shared_lock<std::shared_mutex> containerGuard(m_GroupContainerMutex);
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
   for (const auto& image : m_GroupContainer)
   {
-    if (!image->IsChannelSet(n)) return false;
+    // the content of compressed and deferred groups is set, even if the group image holds no data.
+    if (m_CompressedGroups.end() == m_CompressedGroups.find(image) && m_DeferredGroups.end() == m_DeferredGroups.find(image)
+        && !image->IsChannelSet(n)) return false;
   }
   return true;
 }
@@ -113,11 +146,37 @@ mitk::MultiLabelSegmentation::MultiLabelSegmentation(const mitk::MultiLabelSegme
     m_UnlabeledLabelLock(other.m_UnlabeledLabelLock),
     m_GroupImageDimensions(other.m_GroupImageDimensions)
 {
-  GroupIndexType i = 0;
-  for (auto groupImage : other.m_GroupContainer)
+  for (GroupIndexType i = 0; i < other.GetNumberOfGroups(); ++i)
   {
-    this->AddGroup(groupImage->Clone(), other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
-    i++;
+    auto groupImage = other.GetGroupImageInstance(i);
+    auto storage = other.GetGroupBrickStorage(i);
+    LabelGroupContentLoader::ConstPointer contentLoader;
+    {
+      std::lock_guard<std::mutex> guard(other.m_CompressedGroupsMutex);
+      auto finding = other.m_DeferredGroups.find(groupImage);
+      if (other.m_DeferredGroups.end() != finding)
+        contentLoader = finding->second;
+    }
+
+    if (contentLoader.IsNotNull())
+    {
+      // the content is not loaded yet, the clone loads it on its own when needed.
+      this->AddDeferredGroup(contentLoader, other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
+    }
+    else if (nullptr != storage)
+    {
+      // the clone gets its own copy of the allocated bricks, which is still much smaller than the dense group.
+      auto placeholderImage = this->GenerateNewGroupImage();
+      {
+        std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+        m_CompressedGroups[placeholderImage] = storage->Clone();
+      }
+      this->AddGroup(placeholderImage, other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
+    }
+    else
+    {
+      this->AddGroup(groupImage->Clone(), other.GetConstLabelsByValue(other.GetLabelValuesByGroup(i)));
+    }
   }
   m_Groups = other.m_Groups;
 
@@ -173,6 +232,22 @@ void mitk::MultiLabelSegmentation::Initialize(const mitk::Image * templateImage,
   }
   else
   {
+    {
+      std::lock_guard<std::mutex> guard(m_OccupancyIndicesMutex);
+      m_OccupancyIndices.clear();
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+      m_CompressedGroups.clear();
+      m_DecompressedGroups.clear();
+      m_DeferredGroups.clear();
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_GroupModificationLogsMutex);
+      m_GroupModificationLogs.clear();
+    }
+
+    std::lock_guard<std::shared_mutex> containerGuard(m_GroupContainerMutex);
     for (auto& imagePtr : m_GroupContainer)
     {
       imagePtr = this->GenerateNewGroupImage();
@@ -221,6 +296,22 @@ void mitk::MultiLabelSegmentation::Initialize(const mitk::TimeGeometry* geometry
   }
   else
   {
+    {
+      std::lock_guard<std::mutex> guard(m_OccupancyIndicesMutex);
+      m_OccupancyIndices.clear();
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+      m_CompressedGroups.clear();
+      m_DecompressedGroups.clear();
+      m_DeferredGroups.clear();
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_GroupModificationLogsMutex);
+      m_GroupModificationLogs.clear();
+    }
+
+    std::lock_guard<std::shared_mutex> containerGuard(m_GroupContainerMutex);
     for (auto& imagePtr : m_GroupContainer)
     {
       imagePtr = this->GenerateNewGroupImage();
@@ -248,7 +339,7 @@ mitk::MultiLabelSegmentation::~MultiLabelSegmentation()
 
 unsigned int mitk::MultiLabelSegmentation::GetActiveLayer() const
 {
-  if (m_GroupContainer.empty()) mitkThrow() << "Cannot return active group index. No group is available.";
+  if (0 == this->GetNumberOfGroups()) mitkThrow() << "Cannot return active group index. No group is available.";
   if (m_ActiveLabelValue == UNLABELED_VALUE) return 0;
 
   return this->GetGroupIndexOfLabel(m_ActiveLabelValue);
@@ -256,6 +347,7 @@ unsigned int mitk::MultiLabelSegmentation::GetActiveLayer() const
 
 unsigned int mitk::MultiLabelSegmentation::GetNumberOfGroups() const
 {
+  std::shared_lock<std::shared_mutex> guard(m_GroupContainerMutex);
   return m_GroupContainer.size();
 }
 
@@ -280,7 +372,24 @@ void mitk::MultiLabelSegmentation::RemoveGroup(GroupIndexType indexToDelete)
     // remove the group entries in the maps and the image.
     m_Groups.erase(m_Groups.begin() + indexToDelete);
     m_GroupToLabelMap.erase(m_GroupToLabelMap.begin() + indexToDelete);
-    m_GroupContainer.erase(m_GroupContainer.begin() + indexToDelete);
+    {
+      std::lock_guard<std::mutex> indexGuard(m_OccupancyIndicesMutex);
+      m_OccupancyIndices.erase(m_GroupContainer[indexToDelete]);
+    }
+    {
+      std::lock_guard<std::mutex> compressedGuard(m_CompressedGroupsMutex);
+      m_CompressedGroups.erase(m_GroupContainer[indexToDelete]);
+      m_DecompressedGroups.erase(m_GroupContainer[indexToDelete]);
+      m_DeferredGroups.erase(m_GroupContainer[indexToDelete]);
+    }
+    {
+      std::lock_guard<std::mutex> logGuard(m_GroupModificationLogsMutex);
+      m_GroupModificationLogs.erase(m_GroupContainer[indexToDelete]);
+    }
+    {
+      std::lock_guard<std::shared_mutex> containerGuard(m_GroupContainerMutex);
+      m_GroupContainer.erase(m_GroupContainer.begin() + indexToDelete);
+    }
 
     //update old indexes in m_LabelToGroupMap to new group indexes
     for (auto& element : m_LabelToGroupMap)
@@ -375,6 +484,22 @@ mitk::MultiLabelSegmentation::GroupIndexType mitk::MultiLabelSegmentation::AddGr
   return newID;
 }
 
+mitk::MultiLabelSegmentation::GroupIndexType mitk::MultiLabelSegmentation::AddDeferredGroup(const LabelGroupContentLoader* contentLoader, ConstLabelVector labels)
+{
+  if (nullptr == contentLoader)
+    mitkThrow() << "Cannot add deferred group. Passed content loader is nullptr.";
+
+  // The placeholder does not allocate data as long as nobody accesses it.
+  // Its content is loaded by DecompressGroup().
+  auto placeholderImage = this->GenerateNewGroupImage();
+  {
+    std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+    m_DeferredGroups[placeholderImage] = contentLoader;
+  }
+
+  return this->AddGroup(placeholderImage, labels);
+}
+
 void mitk::MultiLabelSegmentation::InsertGroup(GroupIndexType groupID, ConstLabelVector labels, std::string name)
 {
   auto newImage = this->GenerateNewGroupImage();
@@ -408,7 +533,10 @@ void mitk::MultiLabelSegmentation::InsertGroup(GroupIndexType groupID, mitk::Ima
     std::lock_guard<std::shared_mutex> guard(m_LabelNGroupMapsMutex);
 
     // push a new working image for the new group
-    m_GroupContainer.insert(m_GroupContainer.begin()+groupID, groupImage);
+    {
+      std::lock_guard<std::shared_mutex> containerGuard(m_GroupContainerMutex);
+      m_GroupContainer.insert(m_GroupContainer.begin()+groupID, groupImage);
+    }
 
     m_Groups.insert(m_Groups.begin() + groupID, name);
     m_GroupToLabelMap.insert(m_GroupToLabelMap.begin() + groupID, LabelValueVectorType());
@@ -445,7 +573,7 @@ void mitk::MultiLabelSegmentation::InsertGroup(GroupIndexType groupID, mitk::Ima
 
 void mitk::MultiLabelSegmentation::ReplaceGroupLabels(const GroupIndexType groupID, const ConstLabelVectorType& labelSet)
 {
-  if (m_GroupContainer.size() <= groupID)
+  if (!this->ExistGroup(groupID))
   {
     mitkThrow() << "Trying to replace labels of non-existing group. Invalid group id: "<<groupID;
   }
@@ -566,7 +694,16 @@ mitk::Image* mitk::MultiLabelSegmentation::GetGroupImage(GroupIndexType groupID)
 {
   if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot return group image. Group ID is invalid. Invalid ID: " << groupID;
 
-  return m_GroupContainer[groupID];
+  this->DecompressGroup(groupID);
+  auto groupImage = this->GetGroupImageInstance(groupID);
+
+  {
+    // the caller may write into the image, so a retained brick storage cannot be reused for recompression.
+    std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+    m_DecompressedGroups.erase(groupImage);
+  }
+
+  return groupImage;
 }
 
 
@@ -574,9 +711,231 @@ const mitk::Image* mitk::MultiLabelSegmentation::GetGroupImage(GroupIndexType gr
 {
   if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot return group image. Group ID is invalid. Invalid ID: " << groupID;
 
+  this->DecompressGroup(groupID);
+  return this->GetGroupImageInstance(groupID);
+}
+
+void mitk::MultiLabelSegmentation::CompressGroup(GroupIndexType groupID)
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot compress group. Group ID is invalid. Invalid ID: " << groupID;
+
+  // deferred content has to be loaded before it can be compressed
+  if (this->IsGroupDeferred(groupID))
+    this->DecompressGroup(groupID);
+
+  auto groupImage = this->GetGroupImageInstance(groupID);
+
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+
+  if (m_CompressedGroups.end() != m_CompressedGroups.find(groupImage))
+    return;
+
+  // a group that was only read since its decompression is still represented by its former storage
+  LabelGroupBrickStorage::Pointer storage;
+  auto retainedFinding = m_DecompressedGroups.find(groupImage);
+  if (m_DecompressedGroups.end() != retainedFinding && retainedFinding->second.MTime == groupImage->GetMTime())
+    storage = retainedFinding->second.Storage;
+
+  if (storage.IsNull())
+  {
+    storage = LabelGroupBrickStorage::New();
+    storage->Initialize(groupImage);
+  }
+
+  // The group image instance stays in place, only its pixel data is released. The content does not
+  // change, so Modified() is not called and an up-to-date occupancy index stays valid.
+  if (!groupImage->ReleasePixelData())
+  {
+    // the group image data is in use, the group stays dense but can be compressed later without a scan
+    m_DecompressedGroups[groupImage] = { storage, groupImage->GetMTime() };
+    return;
+  }
+
+  m_DecompressedGroups.erase(groupImage);
+  m_CompressedGroups[groupImage] = storage;
+}
+
+void mitk::MultiLabelSegmentation::DecompressGroup(GroupIndexType groupID) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot decompress group. Group ID is invalid. Invalid ID: " << groupID;
+
+  auto groupImage = this->GetGroupImageInstance(groupID);
+
+  if (this->IsGroupDeferred(groupID))
+  {
+    // The content is read without holding m_CompressedGroupsMutex, so other groups stay accessible meanwhile.
+    // Concurrent requests of the deferred group wait for the loading thread and find the group loaded.
+    std::lock_guard<std::mutex> loadingGuard(m_DeferredGroupLoadingMutex);
+
+    LabelGroupContentLoader::ConstPointer loader;
+    {
+      std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+      auto deferredFinding = m_DeferredGroups.find(groupImage);
+      if (m_DeferredGroups.end() != deferredFinding)
+        loader = deferredFinding->second;
+    }
+
+    if (loader.IsNotNull())
+    {
+      // the content is loaded into the group image, so the group image instance stays the same.
+      loader->LoadContent(groupImage);
+
+      std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+      m_DeferredGroups.erase(groupImage);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+
+  auto finding = m_CompressedGroups.find(groupImage);
+  if (m_CompressedGroups.end() == finding)
+    return;
+
+  LabelOccupancyIndex* index = nullptr;
+  {
+    std::lock_guard<std::mutex> indexGuard(m_OccupancyIndicesMutex);
+    auto indexFinding = m_OccupancyIndices.find(groupImage);
+    if (m_OccupancyIndices.end() != indexFinding && indexFinding->second->IsUpToDate(groupImage))
+      index = indexFinding->second;
+  }
+
+  // the released pixel data of the group image is allocated again and filled from the storage
+  finding->second->WriteToImage(groupImage);
+
+  // the storage is kept, so that the group can be compressed again without a scan as long as it is unchanged
+  m_DecompressedGroups[groupImage] = { finding->second, groupImage->GetMTime() };
+  m_CompressedGroups.erase(finding);
+
+  if (nullptr != index)
+    index->MarkUpToDate(groupImage);
+}
+
+void mitk::MultiLabelSegmentation::CompressIdleGroups()
+{
+  if (0 == this->GetNumberOfGroups())
+    return;
+
+  const auto activeGroupID = this->GetActiveLayer();
+
+  for (GroupIndexType groupID = 0; groupID < this->GetNumberOfGroups(); ++groupID)
+  {
+    if (activeGroupID == groupID || this->IsGroupDeferred(groupID) || this->IsGroupCompressed(groupID))
+      continue;
+
+    this->CompressGroup(groupID);
+  }
+}
+
+bool mitk::MultiLabelSegmentation::IsGroupCompressed(GroupIndexType groupID) const
+{
+  return nullptr != this->GetGroupBrickStorage(groupID);
+}
+
+bool mitk::MultiLabelSegmentation::IsGroupDeferred(GroupIndexType groupID) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot check group content. Group ID is invalid. Invalid ID: " << groupID;
+
+  auto groupImage = this->GetGroupImageInstance(groupID);
+
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+  return m_DeferredGroups.end() != m_DeferredGroups.find(groupImage);
+}
+
+const mitk::LabelGroupBrickStorage* mitk::MultiLabelSegmentation::GetGroupBrickStorage(GroupIndexType groupID) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot return group brick storage. Group ID is invalid. Invalid ID: " << groupID;
+
+  auto groupImage = this->GetGroupImageInstance(groupID);
+
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+
+  auto finding = m_CompressedGroups.find(groupImage);
+  return m_CompressedGroups.end() == finding ? nullptr : finding->second.GetPointer();
+}
+
+const itk::Object* mitk::MultiLabelSegmentation::GetGroupContentObject(GroupIndexType groupID) const
+{
+  auto storage = this->GetGroupBrickStorage(groupID);
+  if (nullptr != storage)
+    return storage;
+
+  return this->GetGroupImageInstance(groupID);
+}
+
+mitk::Image* mitk::MultiLabelSegmentation::GetGroupImageInstance(GroupIndexType groupID) const
+{
+  std::shared_lock<std::shared_mutex> guard(m_GroupContainerMutex);
   return m_GroupContainer.at(groupID).GetPointer();
 }
 
+mitk::Image::Pointer mitk::MultiLabelSegmentation::GetGroupSlab(GroupIndexType groupID, unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot return group slab. Group ID is invalid. Invalid ID: " << groupID;
+  if (sliceDimension > 2) mitkThrow() << "Error, cannot return group slab. Invalid slice dimension: " << sliceDimension;
+
+  if (this->IsGroupDeferred(groupID))
+    this->DecompressGroup(groupID);
+
+  const auto groupImage = this->GetGroupImageInstance(groupID);
+
+  std::lock_guard<std::mutex> guard(m_CompressedGroupsMutex);
+
+  if (timeStep >= groupImage->GetTimeSteps()) mitkThrow() << "Error, cannot return group slab. Invalid time step: " << timeStep;
+
+  std::array<unsigned int, 3> dimensions;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    dimensions[dim] = dim < groupImage->GetDimension() ? groupImage->GetDimension(dim) : 1;
+
+  if (sliceIndex >= dimensions[sliceDimension]) mitkThrow() << "Error, cannot return group slab. Invalid slice index: " << sliceIndex;
+
+  // the slab geometry is the group geometry shifted to the slice and with an extent of 1 in sliceDimension.
+  const auto groupGeometry = groupImage->GetGeometry(timeStep);
+  auto slabGeometry = groupGeometry->Clone();
+
+  Point3D indexOrigin;
+  indexOrigin.Fill(0);
+  indexOrigin[sliceDimension] = sliceIndex;
+  Point3D slabOrigin;
+  groupGeometry->IndexToWorld(indexOrigin, slabOrigin);
+  slabGeometry->SetOrigin(slabOrigin);
+
+  auto bounds = slabGeometry->GetBounds();
+  bounds[2 * sliceDimension + 1] = bounds[2 * sliceDimension] + 1;
+  slabGeometry->SetBounds(bounds);
+
+  auto slab = Image::New();
+  slab->Initialize(GetPixelType(), *slabGeometry);
+
+  ImageWriteAccessor slabAccess(slab);
+  auto* slabPixels = static_cast<LabelValueType*>(slabAccess.GetData());
+
+  auto finding = m_CompressedGroups.find(groupImage);
+  if (m_CompressedGroups.end() != finding)
+  {
+    finding->second->ExtractSlice(sliceDimension, sliceIndex, timeStep, slabPixels);
+  }
+  else
+  {
+    ImageReadAccessor groupAccess(groupImage, groupImage->GetVolumeData(timeStep));
+    const auto* groupPixels = static_cast<const LabelValueType*>(groupAccess.GetData());
+
+    // in-plane axes of the slab; axisU runs fastest in memory
+    const unsigned int axisU = 0 == sliceDimension ? 1 : 0;
+    const unsigned int axisV = 2 == sliceDimension ? 1 : 2;
+    const std::array<std::size_t, 3> strides = { 1, dimensions[0], static_cast<std::size_t>(dimensions[0]) * dimensions[1] };
+
+    for (unsigned int v = 0; v < dimensions[axisV]; ++v)
+    {
+      const auto* source = groupPixels + sliceIndex * strides[sliceDimension] + v * strides[axisV];
+      for (unsigned int u = 0; u < dimensions[axisU]; ++u, ++slabPixels)
+        *slabPixels = source[u * strides[axisU]];
+    }
+  }
+
+  return slab;
+}
+
 void mitk::MultiLabelSegmentation::UpdateGroupImage(GroupIndexType groupID, const mitk::Image* sourceImage, TimeStepType timestep, TimeStepType sourceTimestep)
 {
   if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot update group image. Group ID is invalid. Invalid ID: " << groupID;
@@ -584,12 +943,22 @@ void mitk::MultiLabelSegmentation::UpdateGroupImage(GroupIndexType groupID, cons
   if (this->GetTimeSteps()<=timestep) mitkThrow() << "Error, cannot update group image. Assigned time step is not valid for segmentation. Invalid time step: " << timestep;
   if (sourceImage->GetTimeSteps() <= sourceTimestep) mitkThrow() << "Error, cannot update group image. Requested time step of source image is not valid. Invalid source time step: " << sourceTimestep;
 
-  if (!mitk::Equal(*(m_GroupContainer[groupID]->GetGeometry(timestep)), *(sourceImage->GetGeometry(sourceTimestep)), mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION))
+  if (!mitk::Equal(*(this->GetGroupImageInstance(groupID)->GetGeometry(timestep)), *(sourceImage->GetGeometry(sourceTimestep)), mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION))
     mitkThrow() << "Error, cannot update group image. Passed sourceImage has not the same geometry then the MultiLabelSegmentationInstance.";
 
+  auto index = this->GetLabelOccupancyIndex(groupID, false);
+  auto groupImage = this->GetGroupImage(groupID);
+
   auto imageTimeStep = SelectImageByTimeStep(sourceImage, sourceTimestep);
   mitk::ImageReadAccessor sourceImageAcc(imageTimeStep);
-  m_GroupContainer[groupID]->SetVolume(sourceImageAcc.GetData(), timestep);
+  groupImage->SetVolume(sourceImageAcc.GetData(), timestep);
+
+  if (nullptr != index)
+  {
+    // only the updated time step has to be indexed again
+    index->InitializeTimeStep(groupImage, timestep);
+    index->MarkUpToDate(groupImage);
+  }
 }
 
 
@@ -642,9 +1011,11 @@ void mitk::MultiLabelSegmentation::ClearGroupImage(GroupIndexType groupID)
 
   try
   {
+    auto index = this->GetLabelOccupancyIndex(groupID, false);
     auto groupImage = this->GetGroupImage(groupID);
     ClearImageBuffer(groupImage);
     groupImage->Modified();
+    ClearOccupancyIndex(index, groupImage, 0, groupImage->GetTimeSteps());
     this->InvokeEvent(LabelsChangedEvent(this->GetLabelValuesByGroup(groupID)));
     this->InvokeEvent(GroupModifiedEvent(groupID));
   }
@@ -665,10 +1036,12 @@ void mitk::MultiLabelSegmentation::ClearGroupImage(GroupIndexType groupID, TimeS
 
   try
   {
+    auto index = this->GetLabelOccupancyIndex(groupID, false);
     auto groupImage = this->GetGroupImage(groupID);
     auto tsImage = SelectImageByTimeStep(groupImage, timestep);
     ClearImageBuffer(tsImage);
     groupImage->Modified();
+    ClearOccupancyIndex(index, groupImage, timestep, timestep + 1);
     this->InvokeEvent(LabelsChangedEvent(this->GetLabelValuesByGroup(groupID)));
     this->InvokeEvent(GroupModifiedEvent(groupID));
   }
@@ -681,13 +1054,15 @@ void mitk::MultiLabelSegmentation::ClearGroupImage(GroupIndexType groupID, TimeS
 
 void mitk::MultiLabelSegmentation::ClearGroupImages()
 {
-  for (GroupIndexType groupID = 0; groupID < m_GroupContainer.size(); ++groupID)
+  for (GroupIndexType groupID = 0; groupID < this->GetNumberOfGroups(); ++groupID)
   {
     try
     {
+      auto index = this->GetLabelOccupancyIndex(groupID, false);
       auto groupImage = this->GetGroupImage(groupID);
       ClearImageBuffer(groupImage);
       groupImage->Modified();
+      ClearOccupancyIndex(index, groupImage, 0, groupImage->GetTimeSteps());
       this->InvokeEvent(LabelsChangedEvent(this->GetLabelValuesByGroup(groupID)));
       this->InvokeEvent(GroupModifiedEvent(groupID));
     }
@@ -704,14 +1079,16 @@ void mitk::MultiLabelSegmentation::ClearGroupImages(TimeStepType timestep)
   if (timestep >= this->GetTimeSteps())
     mitkThrow() << "Error, cannot clear group image time step. Time step " << timestep << " is invalid. Number of time steps: " << this->GetTimeSteps();
 
-  for (GroupIndexType groupID = 0; groupID < m_GroupContainer.size(); ++groupID)
+  for (GroupIndexType groupID = 0; groupID < this->GetNumberOfGroups(); ++groupID)
   {
     try
     {
+      auto index = this->GetLabelOccupancyIndex(groupID, false);
       auto groupImage = this->GetGroupImage(groupID);
       auto tsImage = SelectImageByTimeStep(groupImage, timestep);
       ClearImageBuffer(tsImage);
       groupImage->Modified();
+      ClearOccupancyIndex(index, groupImage, timestep, timestep + 1);
       this->InvokeEvent(LabelsChangedEvent(this->GetLabelValuesByGroup(groupID)));
       this->InvokeEvent(GroupModifiedEvent(groupID));
     }
@@ -846,17 +1223,36 @@ void mitk::MultiLabelSegmentation::EraseLabel(LabelValueType pixelValue)
   {
     auto groupID = this->GetGroupIndexOfLabel(pixelValue);
 
+    auto index = this->GetLabelOccupancyIndex(groupID);
     mitk::Image* groupImage = this->GetGroupImage(groupID);
 
-    if (4 == this->GetDimension())
-    {
-      AccessFixedDimensionByItk_1(groupImage, EraseLabelProcessing, 4, pixelValue);
-    }
-    else
+    const auto dimX = static_cast<std::size_t>(groupImage->GetDimension(0));
+    const auto dimY = static_cast<std::size_t>(groupImage->GetDimension(1));
+
+    for (TimeStepType t = 0; t < groupImage->GetTimeSteps(); ++t)
     {
-      AccessByItk_1(groupImage, EraseLabelProcessing, pixelValue);
+      // only the bounding region of the label can contain its voxels
+      const auto region = index->GetBoundingRegion(pixelValue, t);
+      if (0 == region.GetNumberOfPixels())
+        continue;
+
+      ImageWriteAccessor accessor(groupImage, groupImage->GetVolumeData(t));
+      auto* pixels = static_cast<LabelValueType*>(accessor.GetData());
+
+      for (auto z = region.GetIndex(2); z < region.GetIndex(2) + static_cast<itk::IndexValueType>(region.GetSize(2)); ++z)
+      {
+        for (auto y = region.GetIndex(1); y < region.GetIndex(1) + static_cast<itk::IndexValueType>(region.GetSize(1)); ++y)
+        {
+          auto* rowBegin = pixels + (z * dimY + y) * dimX + region.GetIndex(0);
+          std::replace(rowBegin, rowBegin + region.GetSize(0), pixelValue, UNLABELED_VALUE);
+        }
+      }
+
+      index->RemoveLabel(pixelValue, t);
     }
+
     groupImage->Modified();
+    index->MarkUpToDate(groupImage);
   }
   catch (const itk::ExceptionObject& e)
   {
@@ -892,7 +1288,7 @@ mitk::Label* mitk::MultiLabelSegmentation::AddLabel(mitk::Label* label, GroupInd
     std::lock_guard<std::shared_mutex> guard(m_LabelNGroupMapsMutex);
 
     unsigned int max_size = mitk::Label::MAX_LABEL_VALUE + 1;
-    if (m_GroupContainer.size() >= max_size)
+    if (this->GetNumberOfGroups() >= max_size)
       return nullptr;
 
     if (addAsClone) newLabel = label->Clone();
@@ -987,44 +1383,187 @@ const mitk::Label* mitk::MultiLabelSegmentation::GetActiveLabel() const
 
 void mitk::MultiLabelSegmentation::UpdateCenterOfMass(LabelValueType pixelValue)
 {
-  if (4 == this->GetDimension())
-  {
-    AccessFixedDimensionByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, 4, pixelValue);
-  }
-  else
+  auto label = this->GetLabel(pixelValue);
+  if (label.IsNull())
+    return;
+
+  const auto groupID = this->GetGroupIndexOfLabel(pixelValue);
+  const auto region = this->GetLabelBoundingRegion(pixelValue);
+  const Image* groupImage = this->GetGroupImage(groupID);
+
+  if (3 != groupImage->GetDimension())
+    return;
+
+  const auto dimX = static_cast<std::size_t>(groupImage->GetDimension(0));
+  const auto dimY = static_cast<std::size_t>(groupImage->GetDimension(1));
+
+  ImageReadAccessor accessor(groupImage, groupImage->GetVolumeData(0));
+  const auto* pixels = static_cast<const LabelValueType*>(accessor.GetData());
+
+  std::array<double, 3> sum = { 0.0, 0.0, 0.0 };
+  std::size_t count = 0;
+
+  for (auto z = region.GetIndex(2); z < region.GetIndex(2) + static_cast<itk::IndexValueType>(region.GetSize(2)); ++z)
   {
-    AccessByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, pixelValue);
+    for (auto y = region.GetIndex(1); y < region.GetIndex(1) + static_cast<itk::IndexValueType>(region.GetSize(1)); ++y)
+    {
+      const auto* row = pixels + (z * dimY + y) * dimX;
+      for (auto x = region.GetIndex(0); x < region.GetIndex(0) + static_cast<itk::IndexValueType>(region.GetSize(0)); ++x)
+      {
+        if (pixelValue == row[x])
+        {
+          sum[0] += x;
+          sum[1] += y;
+          sum[2] += z;
+          ++count;
+        }
+      }
+    }
   }
+
+  mitk::Point3D pos;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    pos[dim] = count > 0 ? sum[dim] / count : 0.0;
+
+  label->SetCenterOfMassIndex(pos);
+  this->GetSlicedGeometry()->IndexToWorld(pos, pos);
+  label->SetCenterOfMassCoordinates(pos);
 }
 
 bool mitk::MultiLabelSegmentation::IsEmpty(LabelValueType pixelValue, TimeStepType t) const
 {
-  Image::ConstPointer image = this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue));
-  image = SelectImageByTimeStep(image, t);
+  return 0 == this->GetLabelVoxelCount(pixelValue, t);
+}
 
-  size_t numPixels = 1;
+std::size_t mitk::MultiLabelSegmentation::GetLabelVoxelCount(LabelValueType pixelValue, TimeStepType t) const
+{
+  return this->GetLabelOccupancyIndex(this->GetGroupIndexOfLabel(pixelValue))->GetVoxelCount(pixelValue, t);
+}
 
-  for (int i = 0; i < 3; ++i)
-    numPixels *= static_cast<size_t>(image->GetDimension(i));
+mitk::LabelOccupancyIndex::RegionType mitk::MultiLabelSegmentation::GetLabelBoundingRegion(LabelValueType pixelValue, TimeStepType t) const
+{
+  return this->GetLabelOccupancyIndex(this->GetGroupIndexOfLabel(pixelValue))->GetBoundingRegion(pixelValue, t);
+}
+
+bool mitk::MultiLabelSegmentation::IsEmpty(const Label* label, TimeStepType t) const
+{
+  if (label == nullptr)
+    mitkThrow() << "Cannot check if label is empty. Label is null.";
+
+  return this->IsEmpty(label->GetValue(), t);
+}
 
-  ImagePixelReadAccessor<LabelValueType, 3> accessor(image);
-  auto pixels = accessor.GetData();
+mitk::LabelOccupancyIndex* mitk::MultiLabelSegmentation::GetLabelOccupancyIndex(GroupIndexType groupID, bool rebuildIfOutdated) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot return label occupancy index. Group ID is invalid. Invalid ID: " << groupID;
 
-  for (size_t i = 0; i < numPixels; ++i)
   {
-    if (pixels[i] == pixelValue)
-      return false;
+    // an up-to-date index of a compressed group can be used without decompressing the group.
+    const auto groupImage = this->GetGroupImageInstance(groupID);
+    std::lock_guard<std::mutex> guard(m_OccupancyIndicesMutex);
+    auto finding = m_OccupancyIndices.find(groupImage);
+    if (m_OccupancyIndices.end() != finding && finding->second->IsUpToDate(groupImage))
+      return finding->second;
   }
 
-  return true;
+  if (!rebuildIfOutdated)
+    return nullptr;
+
+  const auto groupImage = this->GetGroupImage(groupID);
+
+  std::lock_guard<std::mutex> guard(m_OccupancyIndicesMutex);
+
+  auto& index = m_OccupancyIndices[groupImage];
+  if (index.IsNull())
+    index = LabelOccupancyIndex::New();
+
+  if (!index->IsUpToDate(groupImage))
+    index->Initialize(groupImage);
+
+  return index;
 }
 
-bool mitk::MultiLabelSegmentation::IsEmpty(const Label* label, TimeStepType t) const
+namespace
 {
-  if (label == nullptr)
-    mitkThrow() << "Cannot check if label is empty. Label is null.";
+  /** Only the most recent modifications are kept. Consumers that lag further behind update everything.*/
+  constexpr std::size_t MaximumGroupModificationLogSize = 256;
+}
 
-  return this->IsEmpty(label->GetValue(), t);
+void mitk::MultiLabelSegmentation::ReportModifiedGroupRegion(GroupIndexType groupID, TimeStepType t, const LabelOccupancyIndex::RegionType& region, itk::ModifiedTimeType mTimeBeforeModification)
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot report modified group region. Group ID is invalid. Invalid ID: " << groupID;
+
+  const auto groupImage = this->GetGroupImageInstance(groupID);
+  if (t >= groupImage->GetTimeSteps()) mitkThrow() << "Error, cannot report modified group region. Invalid time step: " << t;
+
+  std::lock_guard<std::mutex> guard(m_GroupModificationLogsMutex);
+
+  auto& log = m_GroupModificationLogs[groupImage];
+  log.push_back({ t, region, mTimeBeforeModification, groupImage->GetMTime() });
+  if (log.size() > MaximumGroupModificationLogSize)
+    log.pop_front();
+}
+
+bool mitk::MultiLabelSegmentation::GetModifiedGroupRegion(GroupIndexType groupID, TimeStepType t, itk::ModifiedTimeType since, LabelOccupancyIndex::RegionType& region) const
+{
+  if (!this->ExistGroup(groupID)) mitkThrow() << "Error, cannot determine modified group region. Group ID is invalid. Invalid ID: " << groupID;
+
+  const auto groupImage = this->GetGroupImageInstance(groupID);
+  const auto currentMTime = groupImage->GetMTime();
+
+  region = LabelOccupancyIndex::RegionType();
+  if (currentMTime == since)
+    return true;
+
+  std::lock_guard<std::mutex> guard(m_GroupModificationLogsMutex);
+
+  auto finding = m_GroupModificationLogs.find(groupImage);
+  if (m_GroupModificationLogs.end() == finding)
+    return false;
+
+  const auto& log = finding->second;
+  auto pos = std::find_if(log.begin(), log.end(), [since](const GroupModification& modification) { return modification.MTimeBefore == since; });
+
+  // The reported modifications have to form a gapless chain from "since" to the current state,
+  // otherwise the group image was also modified in an unreported way.
+  auto lastMTime = since;
+  bool hasRegion = false;
+  for (; log.end() != pos; ++pos)
+  {
+    if (pos->MTimeBefore != lastMTime)
+      return false;
+
+    lastMTime = pos->MTimeAfter;
+
+    if (pos->TimeStep != t || 0 == pos->Region.GetNumberOfPixels())
+      continue;
+
+    if (!hasRegion)
+    {
+      region = pos->Region;
+      hasRegion = true;
+      continue;
+    }
+
+    LabelOccupancyIndex::RegionType::IndexType lower;
+    LabelOccupancyIndex::RegionType::SizeType size;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      lower[dim] = std::min(region.GetIndex(dim), pos->Region.GetIndex(dim));
+      const auto upper = std::max(region.GetUpperIndex()[dim], pos->Region.GetUpperIndex()[dim]);
+      size[dim] = upper - lower[dim] + 1;
+    }
+    region.SetIndex(lower);
+    region.SetSize(size);
+  }
+
+  if (lastMTime != currentMTime)
+  {
+    region = LabelOccupancyIndex::RegionType();
+    return false;
+  }
+
+  return true;
 }
 
 void mitk::MultiLabelSegmentation::SetLookupTable(mitk::LookupTable* lut)
@@ -1163,6 +1702,7 @@ itk::ModifiedTimeType mitk::MultiLabelSegmentation::GetMTime() const
 {
   itk::ModifiedTimeType result = Superclass::GetMTime();
 
+  std::shared_lock<std::shared_mutex> guard(m_GroupContainerMutex);
   for (const auto& groupImage : m_GroupContainer)
   {
     result = std::max(result, groupImage->GetMTime());
@@ -1171,53 +1711,6 @@ itk::ModifiedTimeType mitk::MultiLabelSegmentation::GetMTime() const
   return result;
 }
 
-template <typename ImageType>
-void mitk::MultiLabelSegmentation::CalculateCenterOfMassProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  if (ImageType::GetImageDimension() != 3)
-  {
-    return;
-  }
-
-  auto labelGeometryFilter = itk::LabelGeometryImageFilter<ImageType>::New();
-  labelGeometryFilter->SetInput(itkImage);
-  labelGeometryFilter->Update();
-  auto centroid = labelGeometryFilter->GetCentroid(pixelValue);
-
-  mitk::Point3D pos;
-  pos[0] = centroid[0];
-  pos[1] = centroid[1];
-  pos[2] = centroid[2];
-
-  auto label = this->GetLabel(pixelValue);
-  if (label.IsNotNull())
-  {
-    label->SetCenterOfMassIndex(pos);
-    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
-    label->SetCenterOfMassCoordinates(pos);
-  }
-}
-
-template <typename ImageType>
-void mitk::MultiLabelSegmentation::EraseLabelProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    LabelValueType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
 void mitk::MultiLabelSegmentation::AddLabelToMap(LabelValueType labelValue, mitk::Label* label, GroupIndexType groupID)
 {
   if (m_LabelMap.find(labelValue)!=m_LabelMap.end())
@@ -1295,6 +1788,7 @@ bool mitk::MultiLabelSegmentation::ExistLabel(LabelValueType value, GroupIndexTy
 
 bool mitk::MultiLabelSegmentation::ExistGroup(GroupIndexType index) const
 {
+  std::shared_lock<std::shared_mutex> guard(m_GroupContainerMutex);
   return index < m_GroupContainer.size();
 }
 
@@ -1649,210 +2143,385 @@ ConstLabelMapType ConvertLabelVectorToMap(const mitk::ConstLabelVector& labelV)
 }
 
 
-/** Functor class that implements the label transfer and is used in conjunction with the itk::BinaryFunctorImageFilter.
-* For details regarding the usage of the filter and the functor patterns, please see info of itk::BinaryFunctorImageFilter.
-*/
-template <class TDestinationPixel, class TSourcePixel, class TOutputpixel>
-class LabelTransferFunctor
+namespace
 {
+  using LabelLookupTableType = std::vector<unsigned char>;
+  using TransferRegionType = itk::ImageRegion<3>;
 
-public:
-  LabelTransferFunctor() {};
-
-  LabelTransferFunctor(const ConstLabelMapType& destinationLabels, mitk::Label::PixelType sourceBackground,
-    mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked,
-    mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle,
-    mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle) :
-    m_DestinationLabels(destinationLabels), m_SourceBackground(sourceBackground),
-    m_DestinationBackground(destinationBackground), m_DestinationBackgroundLocked(destinationBackgroundLocked),
-    m_SourceLabel(sourceLabel), m_NewDestinationLabel(newDestinationLabel), m_MergeStyle(mergeStyle), m_OverwriteStyle(overwriteStyle)
+  /** Settings of the label transfer that are shared by all voxels.*/
+  struct LabelTransferSettings
   {
+    mitk::LabelValueMappingVector LabelMapping;
+    /** Indicates for every label value, if the label is a locked destination label.*/
+    LabelLookupTableType LockedDestinationLabels;
+    /** Indicates for every source value, if it can change a destination voxel at all.*/
+    LabelLookupTableType RelevantSourceValues;
+    mitk::Label::PixelType SourceBackground = 0;
+    mitk::Label::PixelType DestinationBackground = 0;
+    bool DestinationBackgroundLocked = false;
+    mitk::MultiLabelSegmentation::MergeStyle MergeStyle = mitk::MultiLabelSegmentation::MergeStyle::Replace;
+    mitk::MultiLabelSegmentation::OverwriteStyle OverwriteStyle = mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks;
   };
 
-  ~LabelTransferFunctor() {};
-
-  bool operator!=(const LabelTransferFunctor& other)const
+  LabelTransferSettings CreateLabelTransferSettings(const mitk::ConstLabelVector& destinationLabels, mitk::Label::PixelType sourceBackground,
+    mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked, const mitk::LabelValueMappingVector& labelMapping,
+    mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
   {
-    return !(*this == other);
-  }
-  bool operator==(const LabelTransferFunctor& other) const
-  {
-    return this->m_SourceBackground == other.m_SourceBackground &&
-      this->m_DestinationBackground == other.m_DestinationBackground &&
-      this->m_DestinationBackgroundLocked == other.m_DestinationBackgroundLocked &&
-      this->m_SourceLabel == other.m_SourceLabel &&
-      this->m_NewDestinationLabel == other.m_NewDestinationLabel &&
-      this->m_MergeStyle == other.m_MergeStyle &&
-      this->m_OverwriteStyle == other.m_OverwriteStyle &&
-      this->m_DestinationLabels == other.m_DestinationLabels;
-  }
+    constexpr std::size_t numberOfLabelValues = std::numeric_limits<mitk::Label::PixelType>::max() + std::size_t(1);
 
-  LabelTransferFunctor& operator=(const LabelTransferFunctor& other)
-  {
-    this->m_DestinationLabels = other.m_DestinationLabels;
-    this->m_SourceBackground = other.m_SourceBackground;
-    this->m_DestinationBackground = other.m_DestinationBackground;
-    this->m_DestinationBackgroundLocked = other.m_DestinationBackgroundLocked;
-    this->m_SourceLabel = other.m_SourceLabel;
-    this->m_NewDestinationLabel = other.m_NewDestinationLabel;
-    this->m_MergeStyle = other.m_MergeStyle;
-    this->m_OverwriteStyle = other.m_OverwriteStyle;
+    LabelTransferSettings settings;
+    settings.LabelMapping = labelMapping;
+    settings.SourceBackground = sourceBackground;
+    settings.DestinationBackground = destinationBackground;
+    settings.DestinationBackgroundLocked = destinationBackgroundLocked;
+    settings.MergeStyle = mergeStyle;
+    settings.OverwriteStyle = overwriteStyle;
 
-    return *this;
+    settings.LockedDestinationLabels.assign(numberOfLabelValues, 0);
+    for (const auto& [value, label] : ConvertLabelVectorToMap(destinationLabels))
+      settings.LockedDestinationLabels[value] = label->GetLocked() ? 1 : 0;
+
+    settings.RelevantSourceValues.assign(numberOfLabelValues, 0);
+    for (const auto& [sourceLabel, newDestinationLabel] : labelMapping)
+    {
+      (void)newDestinationLabel; // Prevent unused variable error in older compilers
+      settings.RelevantSourceValues[sourceLabel] = 1;
+    }
+
+    // In replace mode source background removes destination content of the mapped labels.
+    if (mitk::MultiLabelSegmentation::MergeStyle::Replace == mergeStyle)
+      settings.RelevantSourceValues[sourceBackground] = 1;
+
+    return settings;
   }
 
-  inline TOutputpixel operator()(const TDestinationPixel& existingDestinationValue, const TSourcePixel& existingSourceValue)
+  /** Determines the new destination value of one voxel for one entry of the label mapping.*/
+  inline mitk::Label::PixelType TransferVoxel(const LabelTransferSettings& settings, mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel,
+    mitk::Label::PixelType existingDestinationValue, mitk::Label::PixelType existingSourceValue)
   {
-    if (existingSourceValue == this->m_SourceLabel)
+    const bool ignoreLocks = mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == settings.OverwriteStyle;
+
+    if (existingSourceValue == sourceLabel)
     {
-      if (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle)
+      if (ignoreLocks)
+        return newDestinationLabel;
+
+      if (existingDestinationValue == settings.DestinationBackground)
       {
-        return this->m_NewDestinationLabel;
+        if (!settings.DestinationBackgroundLocked)
+          return newDestinationLabel;
       }
-      else
+      else if (0 == settings.LockedDestinationLabels[existingDestinationValue])
       {
-        if (existingDestinationValue == m_DestinationBackground)
-        {
-          if (!m_DestinationBackgroundLocked)
-          {
-            return this->m_NewDestinationLabel;
-          }
-        }
-        else
-        {
-          auto labelFinding = this->m_DestinationLabels.find(existingDestinationValue);
-          if (labelFinding==this->m_DestinationLabels.end() || !labelFinding->second->GetLocked())
-          {
-            return this->m_NewDestinationLabel;
-          }
-        }
+        return newDestinationLabel;
       }
     }
-    else if (mitk::MultiLabelSegmentation::MergeStyle::Replace == this->m_MergeStyle
-      && existingSourceValue == this->m_SourceBackground
-      && existingDestinationValue == this->m_NewDestinationLabel
-      && (mitk::MultiLabelSegmentation::OverwriteStyle::IgnoreLocks == this->m_OverwriteStyle
-          || !this->m_DestinationBackgroundLocked))
+    else if (mitk::MultiLabelSegmentation::MergeStyle::Replace == settings.MergeStyle
+      && existingSourceValue == settings.SourceBackground
+      && existingDestinationValue == newDestinationLabel
+      && (ignoreLocks || !settings.DestinationBackgroundLocked))
     {
-      return this->m_DestinationBackground;
+      return settings.DestinationBackground;
     }
 
     return existingDestinationValue;
   }
 
-private:
-  ConstLabelMapType m_DestinationLabels;
-  mitk::Label::PixelType m_SourceBackground = 0;
-  mitk::Label::PixelType m_DestinationBackground = 0;
-  bool m_DestinationBackgroundLocked = false;
-  mitk::Label::PixelType m_SourceLabel = 1;
-  mitk::Label::PixelType m_NewDestinationLabel = 1;
-  mitk::MultiLabelSegmentation::MergeStyle m_MergeStyle = mitk::MultiLabelSegmentation::MergeStyle::Replace;
-  mitk::MultiLabelSegmentation::OverwriteStyle m_OverwriteStyle = mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks;
-};
+  /** Transfers the label content of the source buffer into the destination buffer within the passed region.
+  * region and sourceRegion are given in destination index coordinates, sourceRegion is the part of the destination
+  * that is covered by the source buffer. Outside of it the source counts as unlabeled (like a source that is padded
+  * to the destination). All mapping entries are applied one after another to each voxel, which gives the same result
+  * as transferring one mapping entry after the other over the whole image. If inPlace is true, source and destination
+  * are the same buffer and each mapping entry sees the result of the previous ones. The z slices of the region are
+  * processed in parallel.*/
+  void TransferLabelContentInRegion(const mitk::Label::PixelType* sourcePixels, const TransferRegionType& sourceRegion,
+    mitk::Label::PixelType* destinationPixels, const std::array<unsigned int, 3>& destinationDimensions,
+    const TransferRegionType& region, const LabelTransferSettings& settings, bool inPlace)
+  {
+    auto transferValue = [&settings, inPlace](mitk::Label::PixelType sourceValue, mitk::Label::PixelType& destinationValue)
+    {
+      if (0 == settings.RelevantSourceValues[sourceValue])
+        return;
 
-/**Helper function used by TransferLabelContentAtTimeStep to allow the templating over different image dimensions in conjunction of AccessFixedPixelTypeByItk_n.*/
-template<unsigned int VImageDimension>
-void TransferLabelContentAtTimeStepHelper(const itk::Image<mitk::Label::PixelType, VImageDimension>* itkSourceImage, mitk::Image* destinationImage,
-  const mitk::ConstLabelVector& destinationLabels, mitk::Label::PixelType sourceBackground, mitk::Label::PixelType destinationBackground,
-  bool destinationBackgroundLocked, mitk::Label::PixelType sourceLabel, mitk::Label::PixelType newDestinationLabel, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStyle)
-{
-  typedef itk::Image<mitk::Label::PixelType, VImageDimension> ContentImageType;
-  typename ContentImageType::Pointer itkDestinationImage;
-  mitk::CastToItkImage(destinationImage, itkDestinationImage);
+      auto value = destinationValue;
+      for (const auto& [sourceLabel, newDestinationLabel] : settings.LabelMapping)
+        value = TransferVoxel(settings, sourceLabel, newDestinationLabel, value, inPlace ? value : sourceValue);
 
-  auto sourceRegion = itkSourceImage->GetLargestPossibleRegion();
-  auto relevantRegion = itkDestinationImage->GetLargestPossibleRegion();
-  bool overlapping = relevantRegion.Crop(sourceRegion);
+      destinationValue = value;
+    };
 
-  if (!overlapping)
-  {
-    mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage and destinationImage seem to have no overlapping image region.";
-  }
+    const auto beginX = region.GetIndex(0);
+    const auto endX = beginX + static_cast<itk::IndexValueType>(region.GetSize(0));
+    const auto beginZ = region.GetIndex(2);
+    const auto endZ = beginZ + static_cast<itk::IndexValueType>(region.GetSize(2));
 
-  typedef LabelTransferFunctor <mitk::Label::PixelType, mitk::Label::PixelType, mitk::Label::PixelType> LabelTransferFunctorType;
-  typedef itk::BinaryFunctorImageFilter<ContentImageType, ContentImageType, ContentImageType, LabelTransferFunctorType> FilterType;
+    const auto sourceBeginX = sourceRegion.GetIndex(0);
+    const auto sourceEndX = sourceBeginX + static_cast<itk::IndexValueType>(sourceRegion.GetSize(0));
 
-  LabelTransferFunctorType transferFunctor(ConvertLabelVectorToMap(destinationLabels), sourceBackground, destinationBackground,
-    destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStyle);
+    auto transferSlice = [&](itk::SizeValueType sliceIndex)
+    {
+      const auto z = static_cast<itk::IndexValueType>(sliceIndex);
 
-  auto transferFilter = FilterType::New();
+      for (itk::SizeValueType rowIndex = 0; rowIndex < region.GetSize(1); ++rowIndex)
+      {
+        const auto y = region.GetIndex(1) + static_cast<itk::IndexValueType>(rowIndex);
+        auto* destinationRow = destinationPixels + (static_cast<std::size_t>(z) * destinationDimensions[1] + y) * destinationDimensions[0];
+
+        // the part of the row that is covered by the source
+        auto coveredBeginX = endX;
+        auto coveredEndX = endX;
+        itk::Index<3> rowIndexInSource = { { sourceBeginX, y, z } };
+        if (sourceRegion.IsInside(rowIndexInSource))
+        {
+          coveredBeginX = std::min(std::max(beginX, sourceBeginX), endX);
+          coveredEndX = std::max(coveredBeginX, std::min(endX, sourceEndX));
+        }
 
-  transferFilter->SetFunctor(transferFunctor);
-  transferFilter->InPlaceOn();
-  transferFilter->SetInput1(itkDestinationImage);
-  transferFilter->SetInput2(itkSourceImage);
-  transferFilter->GetOutput()->SetRequestedRegion(relevantRegion);
+        for (auto x = beginX; x < coveredBeginX; ++x)
+          transferValue(mitk::Label::UNLABELED_VALUE, destinationRow[x]);
 
-  transferFilter->Update();
-}
+        if (coveredBeginX < coveredEndX)
+        {
+          const auto* sourceRow = sourcePixels + ((static_cast<std::size_t>(z - sourceRegion.GetIndex(2)) * sourceRegion.GetSize(1) + (y - sourceRegion.GetIndex(1))) * sourceRegion.GetSize(0));
+          for (auto x = coveredBeginX; x < coveredEndX; ++x)
+            transferValue(sourceRow[x - sourceBeginX], destinationRow[x]);
+        }
 
-void mitk::TransferLabelContentAtTimeStep(
-  const Image* sourceImage, Image* destinationImage, const mitk::ConstLabelVector& destinationLabels, const TimeStepType timeStep, mitk::Label::PixelType sourceBackground,
-  mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked, LabelValueMappingVector labelMapping,
-  MultiLabelSegmentation::MergeStyle mergeStyle, MultiLabelSegmentation::OverwriteStyle overwriteStlye)
-{
-  if (nullptr == sourceImage)
-  {
-    mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage must not be null.";
+        for (auto x = coveredEndX; x < endX; ++x)
+          transferValue(mitk::Label::UNLABELED_VALUE, destinationRow[x]);
+      }
+    };
+
+    if (endZ - beginZ > 1)
+    {
+      auto multiThreader = itk::MultiThreaderBase::New();
+      multiThreader->ParallelizeArray(static_cast<itk::SizeValueType>(beginZ), static_cast<itk::SizeValueType>(endZ), transferSlice, nullptr);
+    }
+    else if (endZ > beginZ)
+    {
+      transferSlice(static_cast<itk::SizeValueType>(beginZ));
+    }
   }
-  if (nullptr == destinationImage)
+
+  std::array<unsigned int, 3> GetVolumeDimensions(const mitk::Image* image)
   {
-    mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; destinationImage must not be null.";
+    std::array<unsigned int, 3> dimensions;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      dimensions[dim] = dim < image->GetDimension() ? image->GetDimension(dim) : 1;
+    return dimensions;
   }
 
-  if (sourceImage == destinationImage && labelMapping.size() > 1)
+  /** Implementation of mitk::TransferLabelContentAtTimeStep for images. If restriction is not nullptr, only voxels
+  * within this region (destination index coordinates) are transferred. The caller must ensure that the restriction
+  * covers all voxels that the transfer can change.*/
+  void TransferLabelContentAtTimeStepImpl(const mitk::Image* sourceImage, mitk::Image* destinationImage, const mitk::ConstLabelVector& destinationLabels,
+    const mitk::TimeStepType timeStep, mitk::Label::PixelType sourceBackground, mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked,
+    const mitk::LabelValueMappingVector& labelMapping, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, mitk::MultiLabelSegmentation::OverwriteStyle overwriteStlye,
+    const TransferRegionType* restriction)
   {
-    MITK_DEBUG << "Warning. Using TransferLabelContentAtTimeStep or TransferLabelContent with equal source and destination and more then on label to transfer, can lead to wrong results. Please see documentation and verify that the usage is OK.";
-  }
+    if (nullptr == sourceImage)
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage must not be null.";
+    }
+    if (nullptr == destinationImage)
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; destinationImage must not be null.";
+    }
 
-  Image::ConstPointer sourceImageAtTimeStep = SelectImageByTimeStep(sourceImage, timeStep);
-  Image::Pointer destinationImageAtTimeStep = SelectImageByTimeStep(destinationImage, timeStep);
+    if (sourceImage == destinationImage && labelMapping.size() > 1)
+    {
+      MITK_DEBUG << "Warning. Using TransferLabelContentAtTimeStep or TransferLabelContent with equal source and destination and more then on label to transfer, can lead to wrong results. Please see documentation and verify that the usage is OK.";
+    }
 
-  if (nullptr == sourceImageAtTimeStep)
-  {
-    mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage does not have the requested time step: " << timeStep;
-  }
+    if (!sourceImage->GetTimeGeometry()->IsValidTimeStep(timeStep))
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage does not have the requested time step: " << timeStep;
+    }
 
-  if (nullptr == destinationImageAtTimeStep)
-  {
-    mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; destinationImage does not have the requested time step: " << timeStep;
+    if (!destinationImage->GetTimeGeometry()->IsValidTimeStep(timeStep))
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; destinationImage does not have the requested time step: " << timeStep;
+    }
+
+    if (!(sourceImage->GetPixelType() == mitk::MakeScalarPixelType<mitk::Label::PixelType>()) || !(destinationImage->GetPixelType() == mitk::MakeScalarPixelType<mitk::Label::PixelType>()))
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage and destinationImage must have the pixel type of labels. Source pixel type: "
+        << sourceImage->GetPixelType().GetTypeAsString() << "; destination pixel type: " << destinationImage->GetPixelType().GetTypeAsString();
+    }
+
+    const auto sourceGeometry = sourceImage->GetGeometry(timeStep);
+    const auto destinationGeometry = destinationImage->GetGeometry(timeStep);
+    const auto sourceDimensions = GetVolumeDimensions(sourceImage);
+    const auto destinationDimensions = GetVolumeDimensions(destinationImage);
+
+    itk::Offset<3> sourceOffset;
+    sourceOffset.Fill(0);
+
+    if (!Equal(*sourceGeometry, *destinationGeometry, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION))
+    {
+      if (IsSubGeometry(*sourceGeometry, *destinationGeometry, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION, true))
+      {
+        // the source grid is aligned with the destination grid, so the origin of the source
+        // determines the position of the source voxels in the destination.
+        mitk::Point3D sourceOriginIndex;
+        destinationGeometry->WorldToIndex(sourceGeometry->GetOrigin(), sourceOriginIndex);
+        for (unsigned int dim = 0; dim < 3; ++dim)
+          sourceOffset[dim] = static_cast<itk::OffsetValueType>(std::round(sourceOriginIndex[dim]));
+      }
+      else
+      {
+        mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; source image has neither the same geometry than destination image nor has the source image a sub geometry.";
+      }
+    }
+
+    auto destLabelMap = ConvertLabelVectorToMap(destinationLabels);
+    for (const auto& [sourceLabel, newDestinationLabel] : labelMapping)
+    {
+      (void)sourceLabel; // Prevent unused variable error in older compilers
+      if (mitk::MultiLabelSegmentation::UNLABELED_VALUE != newDestinationLabel && destLabelMap.end() == destLabelMap.find(newDestinationLabel))
+      {
+        mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep. Defined destination label does not exist in destinationImage. newDestinationLabel: " << newDestinationLabel;
+      }
+    }
+
+    // the part of the destination that is covered by the source
+    TransferRegionType sourceRegion;
+    TransferRegionType destinationRegion;
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      sourceRegion.SetIndex(dim, sourceOffset[dim]);
+      sourceRegion.SetSize(dim, sourceDimensions[dim]);
+      destinationRegion.SetIndex(dim, 0);
+      destinationRegion.SetSize(dim, destinationDimensions[dim]);
+    }
+
+    auto coveredRegion = destinationRegion;
+    if (!coveredRegion.Crop(sourceRegion))
+    {
+      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; sourceImage and destinationImage seem to have no overlapping image region.";
+    }
+
+    if (labelMapping.empty())
+      return;
+
+    const auto settings = CreateLabelTransferSettings(destinationLabels, sourceBackground, destinationBackground, destinationBackgroundLocked,
+      labelMapping, mergeStyle, overwriteStlye);
+
+    // Outside of a smaller source the source counts as unlabeled. If unlabeled source voxels can change the
+    // destination (e.g. replace mode clears mapped labels there), the whole destination is relevant.
+    auto relevantRegion = 0 != settings.RelevantSourceValues[mitk::Label::UNLABELED_VALUE] ? destinationRegion : coveredRegion;
+
+    if (nullptr != restriction && !relevantRegion.Crop(*restriction))
+    {
+      // nothing within the restriction can change
+      return;
+    }
+
+    if (sourceImage == destinationImage)
+    {
+      // a read and a write accessor on the same image would block each other
+      mitk::ImageWriteAccessor access(destinationImage, destinationImage->GetVolumeData(timeStep));
+      auto pixels = static_cast<mitk::Label::PixelType*>(access.GetData());
+      TransferLabelContentInRegion(pixels, sourceRegion, pixels, destinationDimensions, relevantRegion, settings, true);
+    }
+    else
+    {
+      mitk::ImageReadAccessor sourceAccess(sourceImage, sourceImage->GetVolumeData(timeStep));
+      mitk::ImageWriteAccessor destinationAccess(destinationImage, destinationImage->GetVolumeData(timeStep));
+
+      TransferLabelContentInRegion(static_cast<const mitk::Label::PixelType*>(sourceAccess.GetData()), sourceRegion,
+        static_cast<mitk::Label::PixelType*>(destinationAccess.GetData()), destinationDimensions, relevantRegion, settings, false);
+    }
+
+    destinationImage->Modified();
   }
 
-  if (!Equal(*(sourceImageAtTimeStep->GetGeometry()), *(destinationImageAtTimeStep->GetGeometry()), mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION))
+  /** Copies the voxels of a region (index coordinates of image) of one time step into a buffer (x running fastest).*/
+  std::vector<mitk::Label::PixelType> CopyRegionContent(const mitk::Image* image, mitk::TimeStepType timeStep, const TransferRegionType& region)
   {
-    if (IsSubGeometry(*(sourceImageAtTimeStep->GetGeometry()), *(destinationImageAtTimeStep->GetGeometry()), mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION, true))
+    const auto dimensions = GetVolumeDimensions(image);
+    std::vector<mitk::Label::PixelType> content(region.GetNumberOfPixels());
+
+    mitk::ImageReadAccessor access(image, image->GetVolumeData(timeStep));
+    const auto pixels = static_cast<const mitk::Label::PixelType*>(access.GetData());
+
+    const auto rowLength = region.GetSize(0);
+    auto target = content.data();
+    for (itk::IndexValueType z = region.GetIndex(2); z < region.GetIndex(2) + static_cast<itk::IndexValueType>(region.GetSize(2)); ++z)
     {
-      //we have to pad the source image
-      //because ImageToImageFilters always check for origin matching even if
-      //the requested output region is fitting :(
-      auto padFilter = mitk::PadImageFilter::New();
-      padFilter->SetInput(0, sourceImageAtTimeStep);
-      padFilter->SetInput(1, destinationImageAtTimeStep);
-      padFilter->SetPadConstant(Label::UNLABELED_VALUE);
-      padFilter->SetBinaryFilter(false);
+      for (itk::IndexValueType y = region.GetIndex(1); y < region.GetIndex(1) + static_cast<itk::IndexValueType>(region.GetSize(1)); ++y)
+      {
+        const auto rowStart = pixels + (static_cast<std::size_t>(z) * dimensions[1] + y) * dimensions[0] + region.GetIndex(0);
+        target = std::copy(rowStart, rowStart + rowLength, target);
+      }
+    }
 
-      padFilter->Update();
+    return content;
+  }
 
-      sourceImageAtTimeStep = padFilter->GetOutput();
+  /** Extends target, so that it also covers region.*/
+  void UniteRegions(TransferRegionType& target, const TransferRegionType& region)
+  {
+    if (0 == region.GetNumberOfPixels())
+      return;
+
+    if (0 == target.GetNumberOfPixels())
+    {
+      target = region;
+      return;
     }
-    else
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
     {
-      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep; source image has neither the same geometry than destination image nor has the source image a sub geometry.";
+      const auto lower = std::min(target.GetIndex(dim), region.GetIndex(dim));
+      const auto upper = std::max(target.GetIndex(dim) + static_cast<itk::IndexValueType>(target.GetSize(dim)),
+        region.GetIndex(dim) + static_cast<itk::IndexValueType>(region.GetSize(dim)));
+      target.SetIndex(dim, lower);
+      target.SetSize(dim, upper - lower);
     }
   }
 
-  auto destLabelMap = ConvertLabelVectorToMap(destinationLabels);
-  for (const auto& [sourceLabel, newDestinationLabel] : labelMapping)
+  /** Determines the region of the destination group that a transfer between two segmentations with equal geometry
+  * can change: the bounding regions of the mapped source labels and, in replace mode, of the mapped destination labels.
+  * Returns false if the region cannot be determined without scanning the group images.*/
+  bool DetermineTransferRegion(const mitk::MultiLabelSegmentation* sourceSeg, mitk::MultiLabelSegmentation::GroupIndexType sourceGroupID,
+    const mitk::MultiLabelSegmentation* destinationSeg, mitk::MultiLabelSegmentation::GroupIndexType destinationGroupID, mitk::TimeStepType timeStep,
+    const mitk::LabelValueMappingVector& labelMapping, mitk::MultiLabelSegmentation::MergeStyle mergeStyle, TransferRegionType& region)
   {
-    if (MultiLabelSegmentation::UNLABELED_VALUE!=newDestinationLabel && destLabelMap.end() == destLabelMap.find(newDestinationLabel))
+    if (!mitk::Equal(*(sourceSeg->GetGeometry(timeStep)), *(destinationSeg->GetGeometry(timeStep)), mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION, mitk::NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION, false))
+      return false;
+
+    auto sourceIndex = sourceSeg->GetLabelOccupancyIndex(sourceGroupID, false);
+    if (nullptr == sourceIndex)
+      return false;
+
+    mitk::LabelOccupancyIndex* destinationIndex = nullptr;
+    if (mitk::MultiLabelSegmentation::MergeStyle::Replace == mergeStyle)
+    {
+      destinationIndex = destinationSeg->GetLabelOccupancyIndex(destinationGroupID, false);
+      if (nullptr == destinationIndex)
+        return false;
+    }
+
+    region = TransferRegionType();
+    for (const auto& [sourceLabel, newDestinationLabel] : labelMapping)
     {
-      mitkThrow() << "Invalid call of TransferLabelContentAtTimeStep. Defined destination label does not exist in destinationImage. newDestinationLabel: " << newDestinationLabel;
+      UniteRegions(region, sourceIndex->GetBoundingRegion(sourceLabel, timeStep));
+      if (nullptr != destinationIndex)
+        UniteRegions(region, destinationIndex->GetBoundingRegion(newDestinationLabel, timeStep));
     }
 
-    AccessFixedPixelTypeByItk_n(sourceImageAtTimeStep, TransferLabelContentAtTimeStepHelper, (Label::PixelType), (destinationImageAtTimeStep, destinationLabels, sourceBackground, destinationBackground, destinationBackgroundLocked, sourceLabel, newDestinationLabel, mergeStyle, overwriteStlye));
+    return true;
   }
-  destinationImage->Modified();
+}
+
+void mitk::TransferLabelContentAtTimeStep(
+  const Image* sourceImage, Image* destinationImage, const mitk::ConstLabelVector& destinationLabels, const TimeStepType timeStep, mitk::Label::PixelType sourceBackground,
+  mitk::Label::PixelType destinationBackground, bool destinationBackgroundLocked, LabelValueMappingVector labelMapping,
+  MultiLabelSegmentation::MergeStyle mergeStyle, MultiLabelSegmentation::OverwriteStyle overwriteStlye)
+{
+  TransferLabelContentAtTimeStepImpl(sourceImage, destinationImage, destinationLabels, timeStep, sourceBackground, destinationBackground,
+    destinationBackgroundLocked, labelMapping, mergeStyle, overwriteStlye, nullptr);
 }
 
 void mitk::TransferLabelContent(
@@ -1906,10 +2575,42 @@ void mitk::TransferLabelContentAtTimeStep(
 
     for (const auto& [destGroupID, relevantLabelMapping] : destGroupLabelMapping)
     {
+      auto destIndex = destinationImage->GetLabelOccupancyIndex(destGroupID, false);
       auto destGroupImage = destinationImage->GetGroupImage(destGroupID);
       auto destinationLabels = destinationImage->GetConstLabelsByValue(destinationImage->GetLabelValuesByGroup(destGroupID));
-      TransferLabelContentAtTimeStep(sourceGroupImage, destGroupImage, destinationLabels, timeStep, MultiLabelSegmentation::UNLABELED_VALUE, MultiLabelSegmentation::UNLABELED_VALUE, destinationImage->GetUnlabeledLabelLock(),
-        relevantLabelMapping, mergeStyle, overwriteStlye);
+
+      // if the occupancy indices are available, only the bounding regions of the involved labels have to be visited.
+      itk::ImageRegion<3> transferRegion;
+      const bool restrictTransfer = DetermineTransferRegion(sourceImage, sourceGroupID, destinationImage, destGroupID, timeStep, relevantLabelMapping, mergeStyle, transferRegion);
+
+      // an existing, up to date index of the destination group is kept up to date. For a restricted transfer only
+      // the changes within the transfer region are applied; outdated indices are rebuilt on their next request.
+      const bool updateIndex = nullptr != destIndex && destIndex->IsUpToDate(destGroupImage);
+      const bool updateIndexByRegion = updateIndex && restrictTransfer && 0 != transferRegion.GetNumberOfPixels();
+      std::vector<Label::PixelType> oldContent;
+      const auto indexMTimeBeforeTransfer = updateIndex ? destIndex->GetMTime() : 0;
+      if (updateIndexByRegion)
+        oldContent = CopyRegionContent(destGroupImage, timeStep, transferRegion);
+
+      TransferLabelContentAtTimeStepImpl(sourceGroupImage, destGroupImage, destinationLabels, timeStep, MultiLabelSegmentation::UNLABELED_VALUE, MultiLabelSegmentation::UNLABELED_VALUE, destinationImage->GetUnlabeledLabelLock(),
+        relevantLabelMapping, mergeStyle, overwriteStlye, restrictTransfer ? &transferRegion : nullptr);
+
+      // an index that was rebuilt meanwhile already reflects the transfer
+      if (updateIndex && indexMTimeBeforeTransfer == destIndex->GetMTime())
+      {
+        if (updateIndexByRegion)
+        {
+          const auto newContent = CopyRegionContent(destGroupImage, timeStep, transferRegion);
+          destIndex->UpdateRegion(transferRegion, timeStep, oldContent.data(), newContent.data());
+        }
+        else if (!restrictTransfer)
+        {
+          // the unrestricted transfer visited the whole time step anyway
+          destIndex->InitializeTimeStep(destGroupImage, timeStep);
+        }
+
+        destIndex->MarkUpToDate(destGroupImage);
+      }
     }
   }
 }
@@ -13,9 +13,14 @@ found in the LICENSE file.
 #ifndef mitkMultiLabelSegmentation_h
 #define mitkMultiLabelSegmentation_h
 
+#include <deque>
+#include <mutex>
 #include <shared_mutex>
 #include <mitkImage.h>
 #include <mitkLabel.h>
+#include <mitkLabelGroupBrickStorage.h>
+#include <mitkLabelGroupContentLoader.h>
+#include <mitkLabelOccupancyIndex.h>
 #include <mitkLookupTable.h>
 #include <mitkMultiLabelEvents.h>
 #include <mitkMessage.h>
@@ -248,6 +253,18 @@ namespace mitk
      */
     GroupIndexType AddGroup(mitk::Image* layerImage, ConstLabelVector labels = {});
 
+    /**
+     * \brief Adds a group whose pixel content is not loaded yet.
+     * The group image holds no data until it is accessed the first time (see GetGroupImage()). Then
+     * the content is provided by the passed loader. Readers use this to make the labels of a segmentation
+     * available without reading the content of all groups.
+     * \param contentLoader Loader that provides the content of the group.
+     * \param labels labels that will be cloned and added to the new group if provided
+     * \return the group ID of the new group
+     * \pre contentLoader must be valid instance
+     */
+    GroupIndexType AddDeferredGroup(const LabelGroupContentLoader* contentLoader, ConstLabelVector labels = {});
+
     /**
      * \brief Inserts a new group to the MultiLabelSegmentation. The new group will be set as the active one,
      * if also labels are added,.
@@ -457,13 +474,66 @@ namespace mitk
     void ReplaceLabels(const LabelVectorType& newLabels);
 
     /** Returns the pointer to the image that contains the labeling of the indicate group.
+     * If the group is compressed (see CompressGroup()), it is decompressed first. If the content of
+     * the group is deferred (see AddDeferredGroup()), it is loaded first.
      *@pre groupID must reference an existing group.*/
     mitk::Image* GetGroupImage(GroupIndexType groupID);
 
     /** Returns the pointer to the image that contains the labeling of the indicate group.
+     * If the group is compressed (see CompressGroup()), it is decompressed first. If the content of
+     * the group is deferred (see AddDeferredGroup()), it is loaded first.
+     * A group that is only read this way can be compressed again without scanning the group image,
+     * as long as the group image is not modified.
      *@pre groupID must reference an existing group.*/
     const mitk::Image* GetGroupImage(GroupIndexType groupID) const;
 
+    /** @brief Moves the content of a group into a sparse brick storage (see LabelGroupBrickStorage)
+    * and releases the dense group image data.
+    * Compressing is useful for groups that are kept but not edited, e.g. in segmentations with many
+    * groups. Any access to the group image (GetGroupImage()) transparently decompresses the group again.
+    * Slices of compressed groups can be retrieved without decompression via GetGroupSlab().
+    * The group image instance is kept (only its pixel data is released, see Image::ReleasePixelData())
+    * and the content is not changed, so neither the group image nor the segmentation are modified.
+    * Clients that hold the group image must use GetGroupImage() or DecompressGroup() before they access
+    * its data again. If the pixel data is in use (e.g. by accessors or VTK pipelines), the group stays dense.
+    * @pre groupID must reference an existing group.*/
+    void CompressGroup(GroupIndexType groupID);
+
+    /** @brief Compresses all groups but the active one (see GetActiveLayer() and CompressGroup()).
+    * Groups that are deferred or already compressed are left untouched. Clients call this when the
+    * segmentation or some of its groups are not edited anymore, e.g. when the active group changes.*/
+    void CompressIdleGroups();
+
+    /** Restores the dense group image of a compressed group or loads the content of a deferred group.
+    * Nothing happens if the group is neither compressed nor deferred.
+    * @pre groupID must reference an existing group.*/
+    void DecompressGroup(GroupIndexType groupID) const;
+
+    /** @pre groupID must reference an existing group.*/
+    bool IsGroupCompressed(GroupIndexType groupID) const;
+
+    /** Indicates if the content of a group was not loaded yet (see AddDeferredGroup()).
+    * @pre groupID must reference an existing group.*/
+    bool IsGroupDeferred(GroupIndexType groupID) const;
+
+    /** Returns the brick storage of a compressed group or nullptr if the group is not compressed.
+    * @pre groupID must reference an existing group.*/
+    const LabelGroupBrickStorage* GetGroupBrickStorage(GroupIndexType groupID) const;
+
+    /** Returns an image that only contains one slice of a group (orthogonal to the image axis sliceDimension)
+    * at the given time step. The slab image has one time step and its geometry places the slice at the same
+    * world position as the group image. For compressed groups the slice is generated from the brick storage
+    * without decompressing the group.
+    * @pre groupID must reference an existing group.
+    * @pre sliceDimension, sliceIndex and timeStep must be valid for the group image.*/
+    Image::Pointer GetGroupSlab(GroupIndexType groupID, unsigned int sliceDimension, unsigned int sliceIndex, TimeStepType timeStep) const;
+
+    /** Returns an identifier of the current content storage of a group (the group image or the brick storage
+    * of a compressed group) together with its modification time, without decompressing the group.
+    * Renderers can use it to detect changes of groups.
+    * @pre groupID must reference an existing group.*/
+    const itk::Object* GetGroupContentObject(GroupIndexType groupID) const;
+
     /** Updates a group image by copying a given source image content.
     * @remark the pixel content of the sourceImage will be simply copied. It won't
     * be checked if the source only contains valid label values for the group.
@@ -563,16 +633,74 @@ namespace mitk
     itk::ModifiedTimeType GetMTime() const override;
 
     /**
-      * \brief  */
+      * \brief Updates the center of mass of the label (first time step). Only the bounding region of the
+      * label (see GetLabelBoundingRegion()) is visited.*/
     void UpdateCenterOfMass(LabelValueType pixelValue);
 
     using BaseData::IsEmpty;
 
     /** \brief Checks if a label is empty at a given time step (does not contain any pixels).
+      * Like GetLabelVoxelCount() the result is taken from the label occupancy index.
       */
     bool IsEmpty(const Label* label, TimeStepType t = 0) const;
     bool IsEmpty(LabelValueType pixelValue, TimeStepType t = 0) const;
 
+    /** \brief Returns the number of voxels of a label at a given time step.
+      * The value is taken from the label occupancy index of the label's group (see GetLabelOccupancyIndex()).
+      * The index is only rebuilt if the modification time of the group image has changed. Clients that write
+      * into a group image directly (e.g. via mitk::ImageWriteAccessor or an ITK view of the group image)
+      * must call Modified() on the group image afterwards; otherwise this method, IsEmpty() and
+      * GetLabelBoundingRegion() return results for the previous content.
+      * @pre pixelValue must exist.*/
+    std::size_t GetLabelVoxelCount(LabelValueType pixelValue, TimeStepType t = 0) const;
+
+    /** \brief Returns the smallest region (index coordinates of the group image) that contains all voxels of a
+      * label at a given time step. For empty labels a region of size 0 is returned.
+      * Algorithms that only deal with one label can restrict their work to this region.
+      * The region is taken from the label occupancy index (see GetLabelVoxelCount() for the requirements
+      * on clients that modify group images).
+      * @pre pixelValue must exist.*/
+    LabelOccupancyIndex::RegionType GetLabelBoundingRegion(LabelValueType pixelValue, TimeStepType t = 0) const;
+
+    /** \brief Returns the label occupancy index of a group image.
+      *
+      * The index is created and (re)built with a single pass over the group image, if it does not reflect
+      * the current state of the group image. Whether the index is up to date is decided by the modification
+      * time of the group image only (see LabelOccupancyIndex::IsUpToDate()), so direct writes to the pixel
+      * buffer have to be followed by a call of Modified() on the group image. An up-to-date index is returned
+      * without decompressing the group image (see CompressGroup()). Clients that change the group image slice-wise can keep the
+      * index up to date incrementally (see LabelOccupancyIndex::UpdateSlice() and
+      * LabelOccupancyIndex::MarkUpToDate()) to avoid rescans. Operations of this class (e.g. EraseLabel(),
+      * UpdateGroupImage() or TransferLabelContent()) keep an existing index up to date themselves.
+      * @param groupID Index of the group.
+      * @param rebuildIfOutdated If false, no index is created or rebuilt and nullptr is returned if no up-to-date
+      * index exists. Clients that only want to update an existing index use this to avoid a rescan.
+      * @pre groupID must reference an existing group.
+      */
+    LabelOccupancyIndex* GetLabelOccupancyIndex(GroupIndexType groupID, bool rebuildIfOutdated = true) const;
+
+    /** \brief Records that the content of a group image was only modified within the passed region of a time step.
+      *
+      * Clients that write into group images (e.g. mitk::SegTool2D) report the regions they have modified, so
+      * that consumers deriving data from the group content (e.g. mitk::IncrementalLabelSurfaceMesher) can restrict
+      * their updates to these regions (see GetModifiedGroupRegion()). Call it directly after the modification.
+      * @param groupID Index of the group.
+      * @param t Modified time step.
+      * @param region Modified region (index coordinates of the group image).
+      * @param mTimeBeforeModification Modification time of the group image before the modification.
+      * @pre groupID must reference an existing group.
+      */
+    void ReportModifiedGroupRegion(GroupIndexType groupID, TimeStepType t, const LabelOccupancyIndex::RegionType& region, itk::ModifiedTimeType mTimeBeforeModification);
+
+    /** \brief Determines the region of a group image time step that was modified after the group image had the passed
+      * modification time.
+      * @return True if all modifications of the group image since then were reported (see ReportModifiedGroupRegion()).
+      * region is set to the union of the reported regions of the time step (size 0 if the time step was not modified).
+      * False if the modified region is unknown; consumers have to assume that the whole group image was modified.
+      * @pre groupID must reference an existing group.
+      */
+    bool GetModifiedGroupRegion(GroupIndexType groupID, TimeStepType t, itk::ModifiedTimeType since, LabelOccupancyIndex::RegionType& region) const;
+
     /**
      * @brief Gets the ID of the currently active group
      * @return the ID of the active group
@@ -626,12 +754,6 @@ namespace mitk
 
     LabelValueType m_ActiveLabelValue;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType* input, LabelValueType index);
-
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType* input, LabelValueType index);
-
     template <typename MultiLabelSegmentationType, typename ImageType>
     void InitializeByLabeledImageProcessing(MultiLabelSegmentationType* input, const ImageType* other);
 
@@ -644,7 +766,13 @@ namespace mitk
       @remark The pixel values are not initialized. E.g. use clear Image buffer for that.*/
     Image::Pointer GenerateNewGroupImage() const;
 
+    /** Returns the group image without decompressing or loading it.*/
+    Image* GetGroupImageInstance(GroupIndexType groupID) const;
+
     std::vector<Image::Pointer> m_GroupContainer;
+    /** Guards m_GroupContainer itself (not the group images). It is only held briefly and may be taken while
+    * m_LabelNGroupMapsMutex is held; the mutexes of the compression and occupancy maps are taken after it.*/
+    mutable std::shared_mutex m_GroupContainerMutex;
 
     using LabelMapType = std::map<LabelValueType, Label::Pointer>;
     /** Dictionary that holds all known labels (label value is the key).*/
@@ -677,6 +805,46 @@ namespace mitk
     /** This variable stores the dimensions of the multi label segmentation, in order to make it available even
     when no group image is available.*/
     GroupImageDimensionVectorType m_GroupImageDimensions;
+
+    using OccupancyIndexMapType = std::map<const Image*, LabelOccupancyIndex::Pointer>;
+    /** Lazily created label occupancy indices of the group images (key is the group image).*/
+    mutable OccupancyIndexMapType m_OccupancyIndices;
+    mutable std::mutex m_OccupancyIndicesMutex;
+
+    using BrickStorageMapType = std::map<const Image*, LabelGroupBrickStorage::Pointer>;
+    /** Brick storages of compressed groups (key is the group image whose pixel data is released while compressed).*/
+    mutable BrickStorageMapType m_CompressedGroups;
+
+    using ContentLoaderMapType = std::map<const Image*, LabelGroupContentLoader::ConstPointer>;
+    /** Loaders of deferred groups (key is the group image that holds no data until it is loaded).*/
+    mutable ContentLoaderMapType m_DeferredGroups;
+
+    struct RetainedBrickStorage
+    {
+      LabelGroupBrickStorage::Pointer Storage;
+      itk::ModifiedTimeType MTime;
+    };
+    using RetainedBrickStorageMapType = std::map<const Image*, RetainedBrickStorage>;
+    /** Brick storages of decompressed groups with the modification time of the group image after
+    * decompression (key is the group image). They are reused by CompressGroup() for unchanged groups.*/
+    mutable RetainedBrickStorageMapType m_DecompressedGroups;
+
+    /** Guards m_CompressedGroups, m_DecompressedGroups and m_DeferredGroups.*/
+    mutable std::mutex m_CompressedGroupsMutex;
+    /** Serializes the loading of deferred groups, which happens without holding m_CompressedGroupsMutex.*/
+    mutable std::mutex m_DeferredGroupLoadingMutex;
+
+    struct GroupModification
+    {
+      TimeStepType TimeStep;
+      LabelOccupancyIndex::RegionType Region;
+      itk::ModifiedTimeType MTimeBefore;
+      itk::ModifiedTimeType MTimeAfter;
+    };
+    using GroupModificationLogMapType = std::map<const Image*, std::deque<GroupModification>>;
+    /** Most recent reported modifications of the group images (key is the group image).*/
+    GroupModificationLogMapType m_GroupModificationLogs;
+    mutable std::mutex m_GroupModificationLogsMutex;
   };
 
   /**
@@ -782,6 +950,8 @@ namespace mitk
   /**Helper function that transfers pixels of the specified source label from source image to the destination image by using
   a specified destination label for a specific time step. Function processes the whole image volume of the specified time step.
   @remark the function assumes that it is only called with source and destination image of same geometry.
+  If the source image has a sub geometry of the destination image, the destination voxels outside of it are treated
+  as unlabeled source voxels (e.g. the merge style Replace removes mapped destination labels there).
   @remark CAUTION: The function is not save, if sourceImage and destinationImage are the same instance and you transfer more then one
   label, because the changes are made in-place for performance reasons but not in one pass. If a mapped value A equals a "old value"
   that is later in the mapping, one ends up with a wrong transfer, as a pixel would be first mapped to A and then latter again, because
@@ -15,6 +15,8 @@ found in the LICENSE file.
 #include <mitkITKImageImport.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImageConverter.h>
 #include <mitkLabelSetImageHelper.h>
 
@@ -360,6 +362,73 @@ mitk::Image::Pointer mitk::CreateLabelMask(const MultiLabelSegmentation* segment
   return mask;
 }
 
+mitk::Image::Pointer mitk::CreateCroppedLabelMask(const MultiLabelSegmentation* segmentation, MultiLabelSegmentation::LabelValueType labelValue, unsigned int padding, bool createBinaryMap)
+{
+  if (nullptr == segmentation)
+    mitkThrow() << "Error, cannot create cropped label mask. Passed segmentation is nullptr.";
+
+  if (!segmentation->ExistLabel(labelValue))
+    mitkThrow() << "Error, cannot create cropped label mask. Label ID is invalid. Invalid ID: " << labelValue;
+
+  if (3 != segmentation->GetDimension() || 1 != segmentation->GetTimeSteps())
+    mitkThrow() << "Error, cannot create cropped label mask. Only 3D segmentations with a single time step are supported.";
+
+  auto region = segmentation->GetLabelBoundingRegion(labelValue);
+
+  if (0 == region.GetNumberOfPixels())
+    return nullptr;
+
+  const auto groupImage = segmentation->GetGroupImage(segmentation->GetGroupIndexOfLabel(labelValue));
+
+  LabelOccupancyIndex::RegionType largestRegion;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    largestRegion.SetSize(dim, groupImage->GetDimension(dim));
+
+  region.PadByRadius(padding);
+  region.Crop(largestRegion);
+
+  // the mask geometry is the group geometry shifted to the region and with the extent of the region.
+  const auto groupGeometry = groupImage->GetGeometry();
+  auto maskGeometry = groupGeometry->Clone();
+
+  Point3D indexOrigin;
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    indexOrigin[dim] = region.GetIndex(dim);
+
+  Point3D maskOrigin;
+  groupGeometry->IndexToWorld(indexOrigin, maskOrigin);
+  maskGeometry->SetOrigin(maskOrigin);
+
+  auto bounds = maskGeometry->GetBounds();
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    bounds[2 * dim + 1] = bounds[2 * dim] + region.GetSize(dim);
+  maskGeometry->SetBounds(bounds);
+
+  auto mask = Image::New();
+  mask->Initialize(MultiLabelSegmentation::GetPixelType(), *maskGeometry);
+
+  const MultiLabelSegmentation::LabelValueType maskValue = createBinaryMap ? 1 : labelValue;
+
+  ImageReadAccessor groupAccess(groupImage, groupImage->GetVolumeData(0));
+  ImageWriteAccessor maskAccess(mask);
+
+  const auto* groupPixels = static_cast<const MultiLabelSegmentation::LabelValueType*>(groupAccess.GetData());
+  auto* maskPixels = static_cast<MultiLabelSegmentation::LabelValueType*>(maskAccess.GetData());
+
+  for (itk::SizeValueType z = 0; z < region.GetSize(2); ++z)
+  {
+    for (itk::SizeValueType y = 0; y < region.GetSize(1); ++y)
+    {
+      const auto* groupRow = groupPixels + largestRegion.ComputeOffset({ { region.GetIndex(0), region.GetIndex(1) + static_cast<itk::IndexValueType>(y), region.GetIndex(2) + static_cast<itk::IndexValueType>(z) } });
+
+      for (itk::SizeValueType x = 0; x < region.GetSize(0); ++x, ++maskPixels)
+        *maskPixels = labelValue == groupRow[x] ? maskValue : MultiLabelSegmentation::UNLABELED_VALUE;
+    }
+  }
+
+  return mask;
+}
+
 mitk::Image::Pointer mitk::CreateFilteredGroupImage(const MultiLabelSegmentation* segmentation, MultiLabelSegmentation::GroupIndexType groupID, const MultiLabelSegmentation::LabelValueVectorType& selectedLabels)
 {
   if (nullptr == segmentation) mitkThrow() << "Error, cannot create label class map. Passed segmentation is nullptr.";
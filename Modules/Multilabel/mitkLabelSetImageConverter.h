@@ -49,6 +49,18 @@ namespace mitk
   * @pre labelValue must exist in segmentation.*/
   MITKMULTILABEL_EXPORT Image::Pointer CreateLabelMask(const MultiLabelSegmentation* segmentation, MultiLabelSegmentation::LabelValueType labelValue, bool createBinaryMap = true);
 
+  /** Function creates a mask representing only the specified label, like CreateLabelMask(), but restricted to the
+  * bounding region of the label (see MultiLabelSegmentation::GetLabelBoundingRegion()) grown by padding voxels in each
+  * direction (clipped at the image border). The geometry of the mask is placed accordingly in world coordinates.
+  * @param segmentation Pointer to the segmentation that is the source for the mask.
+  * @param labelValue the label that should be extracted.
+  * @param padding number of voxels the bounding region is grown.
+  * @param createBinaryMap see CreateLabelMask().
+  * @return the mask or nullptr if the label is empty.
+  * @pre segmentation must point to a valid instance with a 3D geometry and a single time step.
+  * @pre labelValue must exist in segmentation.*/
+  MITKMULTILABEL_EXPORT Image::Pointer CreateCroppedLabelMask(const MultiLabelSegmentation* segmentation, MultiLabelSegmentation::LabelValueType labelValue, unsigned int padding, bool createBinaryMap = true);
+
   /** Function creates the group image of a segmentation that only contains the selected labels.
   * @param segmentation Pointer to the segmentation that is the source for the map.
   * @param groupID the group that should be used.
@@ -14,10 +14,12 @@ found in the LICENSE file.
 
 #include <mitkDataStorage.h>
 #include <mitkLabelSetImage.h>
+#include <mitkAbstractTransformGeometry.h>
 #include <mitkExceptionMacro.h>
 #include <mitkProperties.h>
 
 #include <array>
+#include <cmath>
 #include <regex>
 #include <vector>
 
@@ -282,3 +284,34 @@ std::string mitk::LabelSetImageHelper::CreateHTMLLabelName(const mitk::Label* la
   stream << "</font>";
   return stream.str();
 }
+
+bool mitk::LabelSetImageHelper::DetermineAxisAlignedSlice(const BaseGeometry* imageGeometry, const PlaneGeometry* plane, unsigned int& sliceDimension, unsigned int& sliceIndex)
+{
+  if (nullptr == imageGeometry || nullptr == plane || nullptr != dynamic_cast<const AbstractTransformGeometry*>(plane))
+    return false;
+
+  auto normal = plane->GetNormal();
+  normal.Normalize();
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    auto axis = imageGeometry->GetAxisVector(dim);
+    axis.Normalize();
+
+    if (std::abs(normal * axis) < 1.0 - eps)
+      continue;
+
+    Point3D indexPoint;
+    imageGeometry->WorldToIndex(plane->GetCenter(), indexPoint);
+    const auto index = std::round(indexPoint[dim]);
+
+    if (index < 0 || index >= imageGeometry->GetExtent(dim))
+      return false;
+
+    sliceDimension = dim;
+    sliceIndex = static_cast<unsigned int>(index);
+    return true;
+  }
+
+  return false;
+}
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <mitkDataNode.h>
 #include <mitkLabelSetImage.h>
+#include <mitkPlaneGeometry.h>
 
 namespace mitk
 {
@@ -93,6 +94,12 @@ namespace mitk
     /** Helper that creates a HTML string that contains the display name and a square glyph with the color of the label.
     */
     MITKMULTILABEL_EXPORT std::string CreateHTMLLabelName(const Label* label, const MultiLabelSegmentation* segmentation = nullptr);
+
+    /** Helper that determines which slice of an image is covered by a plane, if the plane is orthogonal to one of
+    * the image axes (e.g. the planes of the standard render windows).
+    * @return False if the plane is oblique or does not intersect the image. In this case sliceDimension and
+    * sliceIndex are not changed.*/
+    MITKMULTILABEL_EXPORT bool DetermineAxisAlignedSlice(const BaseGeometry* imageGeometry, const PlaneGeometry* plane, unsigned int& sliceDimension, unsigned int& sliceIndex);
   } // namespace LabelSetImageHelper
 } // namespace mitk
 
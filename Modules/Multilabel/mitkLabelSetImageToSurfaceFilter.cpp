@@ -17,13 +17,10 @@ found in the LICENSE file.
 
 // itk
 #include <itkAntiAliasBinaryImageFilter.h>
-#include <itkAutoCropLabelMapFilter.h>
 #include <itkBinaryThresholdImageFilter.h>
-#include <itkLabelImageToLabelMapFilter.h>
-#include <itkLabelMap.h>
-#include <itkLabelMapToLabelImageFilter.h>
-#include <itkLabelObject.h>
-#include <itkNumericTraits.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkMultiThreaderBase.h>
+#include <itkRegionOfInterestImageFilter.h>
 #include <itkSmoothingRecursiveGaussianImageFilter.h>
 
 // vtk
@@ -34,6 +31,8 @@ found in the LICENSE file.
 #include <vtkMarchingCubes.h>
 #include <vtkSmartPointer.h>
 
+#include <algorithm>
+
 mitk::LabelSetImageToSurfaceFilter::LabelSetImageToSurfaceFilter()
   : m_GenerateAllLabels(false), m_RequestedLabel(1), m_BackgroundLabel(0), m_UseSmoothing(0), m_Sigma(0.1)
 {
@@ -82,53 +81,166 @@ void mitk::LabelSetImageToSurfaceFilter::GenerateData()
   AccessFixedDimensionByItk_1(inputImage, InternalProcessing, 3, outputSurface);
 }
 
+namespace
+{
+  template <unsigned int VDimension>
+  struct LabelExtent
+  {
+    itk::Index<VDimension> Min;
+    itk::Index<VDimension> Max;
+    unsigned long VoxelCount = 0;
+  };
+
+  /** Determines the voxel count and the bounding box of every label (except background) in one pass over the image.*/
+  template <typename TPixel, unsigned int VDimension>
+  std::map<TPixel, LabelExtent<VDimension>> DetermineLabelExtents(const itk::Image<TPixel, VDimension> *input, TPixel background)
+  {
+    std::map<TPixel, LabelExtent<VDimension>> extents;
+
+    // cache the extent of the last label, as neighboring voxels mostly share their label
+    TPixel lastLabel = background;
+    LabelExtent<VDimension> *lastExtent = nullptr;
+
+    itk::ImageRegionConstIteratorWithIndex<itk::Image<TPixel, VDimension>> it(input, input->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const auto value = it.Get();
+      if (value == background)
+        continue;
+
+      const auto &index = it.GetIndex();
+
+      if (nullptr == lastExtent || value != lastLabel)
+      {
+        auto [finding, inserted] = extents.emplace(value, LabelExtent<VDimension>());
+        if (inserted)
+        {
+          finding->second.Min = index;
+          finding->second.Max = index;
+        }
+
+        lastLabel = value;
+        lastExtent = &(finding->second);
+      }
+
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+      {
+        lastExtent->Min[dim] = std::min(lastExtent->Min[dim], index[dim]);
+        lastExtent->Max[dim] = std::max(lastExtent->Max[dim], index[dim]);
+      }
+
+      ++(lastExtent->VoxelCount);
+    }
+
+    return extents;
+  }
+}
+
 template <typename TPixel, unsigned int VDimension>
 void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPixel, VDimension> *input,
                                                             mitk::Surface * /*surface*/)
 {
-  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef itk::ImageRegion<VDimension> RegionType;
 
-  typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
-  typedef itk::LabelObject<TPixel, VDimension> LabelObjectType;
-  typedef itk::LabelMap<LabelObjectType> LabelMapType;
-  typedef itk::LabelImageToLabelMapFilter<ImageType, LabelMapType> Image2LabelMapType;
-  typedef itk::AutoCropLabelMapFilter<LabelMapType> AutoCropType;
-  typedef itk::LabelMapToLabelImageFilter<LabelMapType, ImageType> LabelMap2ImageType;
+  auto extents = DetermineLabelExtents(input, static_cast<TPixel>(m_BackgroundLabel));
+
+  m_AvailableLabels.clear();
+  m_IndexToLabels.clear();
+
+  std::vector<std::pair<TPixel, RegionType>> labelRegions;
+
+  for (const auto &[label, extent] : extents)
+  {
+    m_AvailableLabels[label] = extent.VoxelCount;
+
+    if (m_GenerateAllLabels || static_cast<int>(label) == m_RequestedLabel)
+    {
+      RegionType region;
+      region.SetIndex(extent.Min);
+      for (unsigned int dim = 0; dim < VDimension; ++dim)
+        region.SetSize(dim, extent.Max[dim] - extent.Min[dim] + 1);
+
+      m_IndexToLabels[static_cast<unsigned int>(labelRegions.size())] = label;
+      labelRegions.emplace_back(label, region);
+    }
+  }
+
+  if (!m_GenerateAllLabels && labelRegions.empty())
+    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+
+  const auto numberOfLabels = labelRegions.size();
+
+  this->SetNumberOfIndexedOutputs(std::max<std::size_t>(1, numberOfLabels));
+  for (std::size_t i = 0; i < numberOfLabels; ++i)
+  {
+    if (nullptr == this->GetOutput(i))
+      this->SetNthOutput(i, this->MakeOutput(i));
+  }
+
+  std::vector<vtkSmartPointer<vtkPolyData>> polyDatas(numberOfLabels);
+  std::vector<std::string> errors(numberOfLabels);
+
+  auto generateSurface = [&](itk::SizeValueType i)
+  {
+    try
+    {
+      polyDatas[i] = this->GenerateLabelSurface(input, labelRegions[i].first, labelRegions[i].second);
+    }
+    catch (const std::exception &e)
+    {
+      errors[i] = e.what();
+    }
+  };
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(0, numberOfLabels, generateSurface, nullptr);
+
+  for (std::size_t i = 0; i < numberOfLabels; ++i)
+  {
+    if (!errors[i].empty())
+      MITK_WARN << "Surface generation of label " << labelRegions[i].first << " failed: " << errors[i];
+
+    if (nullptr == polyDatas[i].GetPointer())
+    {
+      if (!m_GenerateAllLabels)
+        throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
 
+      polyDatas[i] = vtkSmartPointer<vtkPolyData>::New();
+    }
+
+    this->GetOutput(i)->SetVtkPolyData(polyDatas[i], 0);
+  }
+}
+
+template <typename TPixel, unsigned int VDimension>
+vtkSmartPointer<vtkPolyData> mitk::LabelSetImageToSurfaceFilter::GenerateLabelSurface(
+  const itk::Image<TPixel, VDimension> *input, TPixel label, itk::ImageRegion<VDimension> region) const
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
   typedef itk::Image<float, VDimension> RealImageType;
 
+  typedef itk::RegionOfInterestImageFilter<ImageType, ImageType> RegionOfInterestFilterType;
+  typedef itk::BinaryThresholdImageFilter<ImageType, ImageType> BinaryThresholdFilterType;
   typedef itk::AntiAliasBinaryImageFilter<ImageType, RealImageType> AntiAliasFilterType;
   typedef itk::SmoothingRecursiveGaussianImageFilter<RealImageType, RealImageType> GaussianFilterType;
 
+  // keep a border around the label, so that the surface is closed
+  region.PadByRadius(3);
+  region.Crop(input->GetLargestPossibleRegion());
+
+  typename RegionOfInterestFilterType::Pointer roiFilter = RegionOfInterestFilterType::New();
+  roiFilter->SetInput(input);
+  roiFilter->SetRegionOfInterest(region);
+
   typename BinaryThresholdFilterType::Pointer thresholdFilter = BinaryThresholdFilterType::New();
-  thresholdFilter->SetInput(input);
-  thresholdFilter->SetLowerThreshold(m_RequestedLabel);
-  thresholdFilter->SetUpperThreshold(m_RequestedLabel);
+  thresholdFilter->SetInput(roiFilter->GetOutput());
+  thresholdFilter->SetLowerThreshold(label);
+  thresholdFilter->SetUpperThreshold(label);
   thresholdFilter->SetOutsideValue(0);
   thresholdFilter->SetInsideValue(1);
-  //  thresholdFilter->ReleaseDataFlagOn();
-  thresholdFilter->Update();
-
-  typename Image2LabelMapType::Pointer image2label = Image2LabelMapType::New();
-  image2label->SetInput(thresholdFilter->GetOutput());
-
-  typename AutoCropType::SizeType border;
-  border[0] = 3;
-  border[1] = 3;
-  border[2] = 3;
-
-  typename AutoCropType::Pointer autoCropFilter = AutoCropType::New();
-  autoCropFilter->SetInput(image2label->GetOutput());
-  autoCropFilter->SetCropBorder(border);
-  autoCropFilter->InPlaceOn();
-
-  typename LabelMap2ImageType::Pointer label2image = LabelMap2ImageType::New();
-  label2image->SetInput(autoCropFilter->GetOutput());
-
-  label2image->Update();
 
   typename AntiAliasFilterType::Pointer antiAliasFilter = AntiAliasFilterType::New();
-  antiAliasFilter->SetInput(label2image->GetOutput());
+  antiAliasFilter->SetInput(thresholdFilter->GetOutput());
   antiAliasFilter->SetMaximumRMSError(0.001);
   antiAliasFilter->SetNumberOfLayers(3);
   antiAliasFilter->SetUseImageSpacing(false);
@@ -153,21 +265,13 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
 
   result->DisconnectPipeline();
 
-  typename ImageType::RegionType cropRegion;
-  cropRegion = autoCropFilter->GetOutput()->GetLargestPossibleRegion();
-
-  const typename ImageType::IndexType &cropIndex = cropRegion.GetIndex();
-
-  m_ResultImage = mitk::Image::New();
-  mitk::CastToMitkImage(result, m_ResultImage);
+  // the region of interest filter already places the cropped image correctly in world coordinates
+  mitk::Image::Pointer resultImage = mitk::Image::New();
+  mitk::CastToMitkImage(result, resultImage);
 
-  mitk::BaseGeometry *newGeometry = m_ResultImage->GetSlicedGeometry();
-  mitk::Point3D origin;
-  vtk2itk(cropIndex, origin);
-  this->GetInput()->GetGeometry()->IndexToWorld(origin, origin);
-  newGeometry->SetOrigin(origin);
+  mitk::BaseGeometry *newGeometry = resultImage->GetSlicedGeometry();
 
-  auto *vtkimage = m_ResultImage->GetVtkImageData(0);
+  auto *vtkimage = resultImage->GetVtkImageData(0);
 
   vtkSmartPointer<vtkImageChangeInformation> indexCoordinatesImageFilter =
     vtkSmartPointer<vtkImageChangeInformation>::New();
@@ -186,7 +290,7 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   vtkPolyData *polydata = marching->GetOutput();
 
   if ((!polydata) || (!polydata->GetNumberOfPoints()))
-    throw itk::ExceptionObject(__FILE__, __LINE__, "marching cubes has failed.");
+    return nullptr;
 
   mitk::Vector3D spacing = newGeometry->GetSpacing();
 
@@ -219,6 +323,6 @@ void mitk::LabelSetImageToSurfaceFilter::InternalProcessing(const itk::Image<TPi
   cleanPolyDataFilter->PointMergingOn();
   cleanPolyDataFilter->Update();
 
-  mitk::Surface::Pointer output = this->GetOutput(0);
-  output->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), 0);
+  vtkSmartPointer<vtkPolyData> surface = cleanPolyDataFilter->GetOutput();
+  return surface;
 }
@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include <mitkSurfaceSource.h>
 
 #include <vtkMatrix4x4.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
 
 #include <itkImage.h>
 
@@ -29,7 +31,12 @@ namespace mitk
   /**
    * Generates surface meshes from a labelset image.
    * If you want to calculate a surface representation for all available labels,
-   * you may call GenerateAllLabelsOn().
+   * you may call GenerateAllLabelsOn(). In this case the filter has one output per
+   * label found in the image (see GetIndexToLabels()).
+   *
+   * The labels present in the image and their bounding regions are determined in a
+   * single pass over the image. Each label is then processed only within its bounding
+   * region, and all labels are processed concurrently.
    */
   class MITKMULTILABEL_EXPORT LabelSetImageToSurfaceFilter : public SurfaceSource
   {
@@ -105,6 +112,16 @@ namespace mitk
      */
     itkSetMacro(Sigma, float);
 
+    /**
+     * Returns the labels found by the last update and their number of voxels.
+     */
+    itkGetConstReferenceMacro(AvailableLabels, LabelMapType);
+
+    /**
+     * Returns for every output index the label that the output represents.
+     */
+    itkGetConstReferenceMacro(IndexToLabels, IndexToLabelMapType);
+
   protected:
     LabelSetImageToSurfaceFilter();
 
@@ -114,7 +131,7 @@ namespace mitk
     * Transforms a point by a 4x4 matrix
     */
     template <class T1, class T2, class T3>
-    inline void mitkVtkLinearTransformPoint(T1 matrix[4][4], T2 in[3], T3 out[3])
+    inline void mitkVtkLinearTransformPoint(T1 matrix[4][4], T2 in[3], T3 out[3]) const
     {
       T3 x = matrix[0][0] * in[0] + matrix[0][1] * in[1] + matrix[0][2] * in[2] + matrix[0][3];
       T3 y = matrix[1][0] * in[0] + matrix[1][1] * in[1] + matrix[1][2] * in[2] + matrix[1][3];
@@ -124,11 +141,18 @@ namespace mitk
       out[2] = z;
     }
 
-    mitk::Image::Pointer m_ResultImage;
-
     template <typename TPixel, unsigned int VImageDimension>
     void InternalProcessing(const itk::Image<TPixel, VImageDimension> *input, mitk::Surface *surface);
 
+    /**
+    * Generates the surface of one label within the passed region (grown by a small border).
+    * Returns nullptr if no surface could be generated.
+    */
+    template <typename TPixel, unsigned int VImageDimension>
+    vtkSmartPointer<vtkPolyData> GenerateLabelSurface(const itk::Image<TPixel, VImageDimension> *input,
+                                                      TPixel label,
+                                                      itk::ImageRegion<VImageDimension> region) const;
+
     bool m_GenerateAllLabels;
 
     int m_RequestedLabel;
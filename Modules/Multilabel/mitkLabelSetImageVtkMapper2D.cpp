@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkProperties.h>
 #include <mitkVectorProperty.h>
 #include <mitkLabelHighlightGuard.h>
+#include <mitkLabelSetImageHelper.h>
 
 #include <mitkCoreServices.h>
 #include <mitkIPreferencesService.h>
@@ -144,11 +145,13 @@ namespace
 
     for (mitk::MultiLabelSegmentation::GroupIndexType groupID = 0; groupID < nrOfGroups; ++groupID)
     {
-      const auto groupImage = seg->GetGroupImage(groupID);
-      if (groupImage->GetMTime() > ls->m_LastDataUpdateTime
-        || groupImage->GetPipelineMTime() > ls->m_LastDataUpdateTime
+      // use the content object to avoid the decompression of compressed groups
+      const auto groupContent = seg->GetGroupContentObject(groupID);
+      const auto groupImage = dynamic_cast<const mitk::Image*>(groupContent);
+      if (groupContent->GetMTime() > ls->m_LastDataUpdateTime
+        || (nullptr != groupImage && groupImage->GetPipelineMTime() > ls->m_LastDataUpdateTime)
         || ls->m_GroupImageIDs.size() <= groupID
-        || groupImage != ls->m_GroupImageIDs[groupID])
+        || groupContent != ls->m_GroupImageIDs[groupID])
       {
         result.push_back(groupID);
       }
@@ -351,16 +354,34 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
 
   for (const auto groupID : outdatedGroupIDs)
   {
-    const auto groupImage = segmentation->GetGroupImage(groupID);
-    localStorage->m_GroupImageIDs[groupID] = groupImage;
+    mitk::Image::ConstPointer groupImage;
+    auto groupTimeStep = this->GetTimestep();
+
+    if (segmentation->IsGroupCompressed(groupID))
+    {
+      // Compressed groups are resliced from a slab that only contains the displayed slice,
+      // so they stay compressed. Oblique planes need the whole volume.
+      unsigned int sliceDimension = 0;
+      unsigned int sliceIndex = 0;
+      if (LabelSetImageHelper::DetermineAxisAlignedSlice(segmentation->GetGeometry(groupTimeStep), localStorage->m_WorldPlane, sliceDimension, sliceIndex))
+      {
+        groupImage = segmentation->GetGroupSlab(groupID, sliceDimension, sliceIndex, groupTimeStep);
+        groupTimeStep = 0;
+      }
+    }
+
+    if (groupImage.IsNull())
+      groupImage = segmentation->GetGroupImage(groupID);
+
+    localStorage->m_GroupImageIDs[groupID] = segmentation->GetGroupContentObject(groupID);
 
     localStorage->m_ReslicerVector[groupID]->SetInput(groupImage);
     localStorage->m_ReslicerVector[groupID]->SetWorldGeometry(localStorage->m_WorldPlane);
-    localStorage->m_ReslicerVector[groupID]->SetTimeStep(this->GetTimestep());
+    localStorage->m_ReslicerVector[groupID]->SetTimeStep(groupTimeStep);
 
     // set the transformation of the image to adapt reslice axis
     localStorage->m_ReslicerVector[groupID]->SetResliceTransformByGeometry(
-      groupImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+      groupImage->GetTimeGeometry()->GetGeometryForTimeStep(groupTimeStep));
 
     // is the geometry of the slice based on the image image or the worldgeometry?
     bool inPlaneResampleExtentByGeometry = false;
@@ -88,11 +88,12 @@ namespace mitk
     public:
       vtkSmartPointer<vtkPropAssembly> m_Actors;
 
-      /** Vector containing the pointer of the currently used group images.
+      /** Vector containing the pointer of the currently used group content objects
+       * (group images or brick storages of compressed groups; see MultiLabelSegmentation::GetGroupContentObject()).
        * IMPORTANT: This member must not be used to access any data.
        * Its purpose is to allow checking if the order of the groups has changed
        * in order to adapt the pipe line accordingly*/
-      std::vector<const Image*> m_GroupImageIDs;
+      std::vector<const itk::Object*> m_GroupImageIDs;
 
       std::vector<vtkSmartPointer<vtkActor>> m_LayerActorVector;
       std::vector<vtkSmartPointer<vtkPolyDataMapper>> m_LayerMapperVector;
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkProperties.h>
 #include <mitkVectorProperty.h>
 #include <mitkLabelHighlightGuard.h>
+#include <mitkImageReadAccessor.h>
 
 // MITK Rendering
 
@@ -29,9 +30,19 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkPiecewiseFunction.h>
+#include <vtkFixedPointVolumeRayCastMapper.h>
+#include <vtkActor.h>
+#include <vtkPolyDataMapper.h>
 
 #include <vtkProperty.h>
 
+// ITK
+#include <itkMultiThreaderBase.h>
+
+#include <limits>
+#include <memory>
+#include <numeric>
+
 namespace
 {
   itk::ModifiedTimeType PropertyTimeStampIsNewer(const mitk::IPropertyProvider* provider, mitk::BaseRenderer* renderer, const std::string& propName, itk::ModifiedTimeType refMT)
@@ -44,6 +55,49 @@ namespace
     }
     return false;
   }
+
+  /** Computes the normalized orientation matrix of the image to ensure that the volume is shown
+  * at the right spot (same geometry like image).*/
+  vtkSmartPointer<vtkMatrix4x4> ComputeOrientationMatrix(const mitk::BaseGeometry* geometry)
+  {
+    auto spacing = geometry->GetSpacing();
+    auto orientationMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+    orientationMatrix->DeepCopy(geometry->GetVtkMatrix());
+    //normalize orientationMatrix
+    for (int i = 0; i < 3; ++i)
+    {
+      orientationMatrix->SetElement(i, 0, orientationMatrix->GetElement(i, 0) / spacing[0]);
+      orientationMatrix->SetElement(i, 1, orientationMatrix->GetElement(i, 1) / spacing[1]);
+      orientationMatrix->SetElement(i, 2, orientationMatrix->GetElement(i, 2) / spacing[2]);
+    }
+    return orientationMatrix;
+  }
+
+  /** Writes for every voxel the packed value of the label of the highest group that has a visible label
+  * at this voxel. packedValues maps label values to packed values (0 for invisible labels).*/
+  template <typename TPackedPixel>
+  void ComposeGroups(const std::vector<const mitk::Label::PixelType*>& groupData, const std::vector<unsigned short>& packedValues,
+    std::size_t sliceSize, std::size_t numberOfSlices, TPackedPixel* output)
+  {
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfSlices, [&](itk::SizeValueType slice)
+    {
+      const auto end = (slice + 1) * sliceSize;
+      for (auto i = slice * sliceSize; i < end; ++i)
+      {
+        TPackedPixel packedValue = 0;
+        for (auto data = groupData.rbegin(); data != groupData.rend(); ++data)
+        {
+          const auto value = packedValues[(*data)[i]];
+          if (0 != value)
+          {
+            packedValue = static_cast<TPackedPixel>(value);
+            break;
+          }
+        }
+        output[i] = packedValue;
+      }
+    }, nullptr);
+  }
 }
 
 mitk::MultiLabelSegmentationVtkMapper3D::MultiLabelSegmentationVtkMapper3D()
@@ -112,6 +166,13 @@ void mitk::MultiLabelSegmentationVtkMapper3D::GenerateLookupTable(mitk::BaseRend
     }
   }
 
+  if (localStorage->m_CombinedRendering || localStorage->m_SurfaceRendering)
+  {
+    // the transfer functions of the combined volume depend on the packing, see GenerateCombinedVolumeMapping();
+    // surfaces take their colors directly from the lookup table, see GenerateSurfaceMapping().
+    return;
+  }
+
   const auto nrOfGroups = image->GetNumberOfGroups();
   for (unsigned int groupID = 0; groupID < nrOfGroups; ++groupID)
   {
@@ -160,6 +221,16 @@ void mitk::MultiLabelSegmentationVtkMapper3D::GenerateDataForRenderer(mitk::Base
   auto *image = dynamic_cast<mitk::MultiLabelSegmentation *>(node->GetData());
   assert(image && image->IsInitialized());
 
+  bool surfaceRendering = false;
+  node->GetBoolProperty("multilabel.3D.surface", surfaceRendering, renderer);
+  bool combinedRendering = false;
+  node->GetBoolProperty("multilabel.3D.combined", combinedRendering, renderer);
+  combinedRendering &= !surfaceRendering;
+  if (combinedRendering != localStorage->m_CombinedRendering || surfaceRendering != localStorage->m_SurfaceRendering)
+  {
+    this->SwitchRenderingMode(renderer, combinedRendering, surfaceRendering);
+  }
+
   bool isLookupModified = localStorage->m_LabelLookupTable.IsNull() ||
     (localStorage->m_LabelLookupTable->GetMTime() < image->GetLookupTable()->GetMTime()) ||
     PropertyTimeStampIsNewer(node, renderer, "org.mitk.multilabel.labels.highlighted", localStorage->m_LabelLookupTable->GetMTime()) ||
@@ -183,6 +254,36 @@ void mitk::MultiLabelSegmentationVtkMapper3D::GenerateDataForRenderer(mitk::Base
     std::iota(outdatedGroups.begin(), outdatedGroups.end(), 0);
   }
 
+  if (localStorage->m_SurfaceRendering)
+  {
+    if (isLookupModified)
+    {
+      this->GenerateLookupTable(renderer);
+    }
+
+    // the meshers only re-mesh labels whose group changed, so all of them can be updated.
+    if (isLookupModified || !outdatedGroups.empty() || localStorage->m_Actors->GetParts()->GetNumberOfItems() == 0)
+    {
+      this->GenerateSurfaceMapping(renderer);
+    }
+    return;
+  }
+
+  if (localStorage->m_CombinedRendering)
+  {
+    if (isLookupModified)
+    {
+      this->GenerateLookupTable(renderer);
+    }
+
+    // the composition depends on the content of all groups and on the visibility of the labels.
+    if (isLookupModified || !outdatedGroups.empty() || localStorage->m_CombinedImage.GetPointer() == nullptr)
+    {
+      this->GenerateCombinedVolumeMapping(renderer);
+    }
+    return;
+  }
+
   if (!outdatedGroups.empty())
   {
     auto hasValidContent = this->GenerateVolumeMapping(renderer, outdatedGroups);
@@ -248,19 +349,7 @@ bool mitk::MultiLabelSegmentationVtkMapper3D::GenerateVolumeMapping(mitk::BaseRe
 
     localStorage->m_NumberOfGroups = numberOfGroups;
 
-    //Compute normalized orientation matrix of image to ensure that the volume is shown
-    //at the right spot (same geometry like image)
-    const auto geometry = image->GetGeometry();
-    auto spacing = geometry->GetSpacing();
-    auto orientationMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
-    orientationMatrix->DeepCopy(geometry->GetVtkMatrix());
-    //normalize orientationMatrix
-    for (int i = 0; i < 3; ++i)
-    {
-      orientationMatrix->SetElement(i, 0, orientationMatrix->GetElement(i, 0) / spacing[0]);
-      orientationMatrix->SetElement(i, 1, orientationMatrix->GetElement(i, 1) / spacing[1]);
-      orientationMatrix->SetElement(i, 2, orientationMatrix->GetElement(i, 2) / spacing[2]);
-    }
+    auto orientationMatrix = ComputeOrientationMatrix(image->GetGeometry());
 
     localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
 
@@ -300,6 +389,211 @@ bool mitk::MultiLabelSegmentationVtkMapper3D::GenerateVolumeMapping(mitk::BaseRe
   return true;
 }
 
+void mitk::MultiLabelSegmentationVtkMapper3D::GenerateCombinedVolumeMapping(mitk::BaseRenderer* renderer)
+{
+  LocalStorage* localStorage = m_LSH.GetLocalStorage(renderer);
+  mitk::DataNode* node = this->GetDataNode();
+  auto* image = dynamic_cast<mitk::MultiLabelSegmentation*>(node->GetData());
+  assert(image && image->IsInitialized());
+
+  image->Update();
+
+  const auto numberOfGroups = image->GetNumberOfGroups();
+  if (0 == numberOfGroups)
+  {
+    localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
+    localStorage->m_CombinedImage = nullptr;
+    return;
+  }
+
+  // only visible labels get a packed value, so invisible labels neither occupy table entries nor occlude lower groups.
+  auto lookUpTable = localStorage->m_LabelLookupTable->GetVtkLookupTable();
+  std::vector<unsigned short> packedValues(std::numeric_limits<Label::PixelType>::max() + 1, 0);
+  localStorage->m_PackedLabelValues.assign(1, MultiLabelSegmentation::UNLABELED_VALUE);
+  for (const auto value : image->GetAllLabelValues())
+  {
+    double rgba[4];
+    lookUpTable->GetTableValue(value, rgba);
+    if (rgba[3] > 0.)
+    {
+      packedValues[value] = static_cast<unsigned short>(localStorage->m_PackedLabelValues.size());
+      localStorage->m_PackedLabelValues.push_back(value);
+    }
+  }
+
+  const auto timeStep = this->GetTimestep();
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const Label::PixelType*> groupData;
+  localStorage->m_GroupImageIDs.resize(numberOfGroups);
+  for (unsigned int groupID = 0; groupID < numberOfGroups; ++groupID)
+  {
+    const auto groupImage = image->GetGroupImage(groupID);
+    localStorage->m_GroupImageIDs[groupID] = groupImage;
+    accessors.push_back(std::make_unique<ImageReadAccessor>(groupImage, groupImage->GetVolumeData(timeStep)));
+    groupData.push_back(static_cast<const Label::PixelType*>(accessors.back()->GetData()));
+  }
+
+  const auto referenceImage = image->GetGroupImage(0)->GetVtkImageData(timeStep);
+  auto combinedImage = vtkSmartPointer<vtkImageData>::New();
+  combinedImage->SetDimensions(referenceImage->GetDimensions());
+  combinedImage->SetSpacing(referenceImage->GetSpacing());
+  combinedImage->SetOrigin(referenceImage->GetOrigin());
+
+  const int* dimensions = combinedImage->GetDimensions();
+  const auto sliceSize = static_cast<std::size_t>(dimensions[0]) * dimensions[1];
+  const auto numberOfSlices = static_cast<std::size_t>(dimensions[2]);
+
+  if (localStorage->m_PackedLabelValues.size() <= static_cast<std::size_t>(std::numeric_limits<unsigned char>::max()) + 1)
+  {
+    combinedImage->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    ComposeGroups(groupData, packedValues, sliceSize, numberOfSlices, static_cast<unsigned char*>(combinedImage->GetScalarPointer()));
+  }
+  else
+  {
+    combinedImage->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+    ComposeGroups(groupData, packedValues, sliceSize, numberOfSlices, static_cast<unsigned short*>(combinedImage->GetScalarPointer()));
+  }
+  accessors.clear();
+
+  localStorage->m_CombinedImage = combinedImage;
+
+  // The fixed point ray cast mapper renders multithreaded on the CPU and skips empty space
+  // by means of its min/max volume. Like in GenerateVolumeMapping() the mapper is recreated
+  // to ensure that no outdated content is rendered.
+  localStorage->m_CombinedVolumeMapper = vtkSmartPointer<vtkFixedPointVolumeRayCastMapper>::New();
+  localStorage->m_CombinedVolumeMapper->LockSampleDistanceToInputSpacingOn();
+  localStorage->m_CombinedVolumeMapper->SetInputData(combinedImage);
+
+  localStorage->m_CombinedTransferFunction = vtkSmartPointer<vtkColorTransferFunction>::New();
+  localStorage->m_CombinedOpacityTransferFunction = vtkSmartPointer<vtkPiecewiseFunction>::New();
+  localStorage->m_CombinedTransferFunction->AddRGBPoint(0, 0., 0., 1.);
+  localStorage->m_CombinedOpacityTransferFunction->AddPoint(0, 0.);
+  for (std::size_t packedValue = 1; packedValue < localStorage->m_PackedLabelValues.size(); ++packedValue)
+  {
+    double* color = lookUpTable->GetTableValue(localStorage->m_PackedLabelValues[packedValue]);
+    localStorage->m_CombinedTransferFunction->AddRGBPoint(packedValue, color[0], color[1], color[2]);
+    localStorage->m_CombinedOpacityTransferFunction->AddPoint(packedValue, color[3]);
+  }
+
+  if (localStorage->m_CombinedVolume.GetPointer() == nullptr)
+  {
+    localStorage->m_CombinedVolume = vtkSmartPointer<vtkVolume>::New();
+    localStorage->m_CombinedVolume->GetProperty()->ShadeOn();
+    localStorage->m_CombinedVolume->GetProperty()->SetDiffuse(1.0);
+    localStorage->m_CombinedVolume->GetProperty()->SetAmbient(0.4);
+    localStorage->m_CombinedVolume->GetProperty()->SetSpecular(0.2);
+    localStorage->m_CombinedVolume->GetProperty()->SetInterpolationTypeToNearest();
+  }
+
+  localStorage->m_CombinedVolume->SetUserMatrix(ComputeOrientationMatrix(image->GetGeometry()));
+  localStorage->m_CombinedVolume->SetMapper(localStorage->m_CombinedVolumeMapper);
+  localStorage->m_CombinedVolume->GetProperty()->SetColor(localStorage->m_CombinedTransferFunction);
+  localStorage->m_CombinedVolume->GetProperty()->SetScalarOpacity(localStorage->m_CombinedOpacityTransferFunction);
+  localStorage->m_CombinedVolume->Update();
+
+  if (localStorage->m_Actors->GetParts()->GetNumberOfItems() == 0)
+  {
+    localStorage->m_Actors->AddPart(localStorage->m_CombinedVolume);
+  }
+
+  localStorage->m_LastDataUpdateTime.Modified();
+}
+
+void mitk::MultiLabelSegmentationVtkMapper3D::GenerateSurfaceMapping(mitk::BaseRenderer* renderer)
+{
+  LocalStorage* localStorage = m_LSH.GetLocalStorage(renderer);
+  mitk::DataNode* node = this->GetDataNode();
+  auto* image = dynamic_cast<mitk::MultiLabelSegmentation*>(node->GetData());
+  assert(image && image->IsInitialized());
+
+  image->Update();
+
+  const auto timeStep = this->GetTimestep();
+  auto lookUpTable = localStorage->m_LabelLookupTable->GetVtkLookupTable();
+
+  std::map<MultiLabelSegmentation::LabelValueType, IncrementalLabelSurfaceMesher::Pointer> meshers;
+  std::map<MultiLabelSegmentation::LabelValueType, vtkSmartPointer<vtkActor>> actors;
+  localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
+
+  for (const auto value : image->GetAllLabelValues())
+  {
+    double rgba[4];
+    lookUpTable->GetTableValue(value, rgba);
+    if (rgba[3] <= 0.)
+      continue;
+
+    // keep the meshers of known labels, so that only their modified blocks are meshed again.
+    auto mesherFinding = localStorage->m_LabelSurfaceMeshers.find(value);
+    auto mesher = localStorage->m_LabelSurfaceMeshers.end() != mesherFinding ? mesherFinding->second : IncrementalLabelSurfaceMesher::New();
+    mesher->SetSegmentation(image);
+    mesher->SetLabelValue(value);
+    mesher->SetTimeStep(timeStep);
+    mesher->Update();
+
+    auto actorFinding = localStorage->m_LabelSurfaceActors.find(value);
+    vtkSmartPointer<vtkActor> actor;
+    if (localStorage->m_LabelSurfaceActors.end() != actorFinding)
+    {
+      actor = actorFinding->second;
+    }
+    else
+    {
+      actor = vtkSmartPointer<vtkActor>::New();
+      auto polyDataMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+      polyDataMapper->ScalarVisibilityOff();
+      actor->SetMapper(polyDataMapper);
+    }
+
+    // the mesher replaces the poly data of its output with each update that changed the surface.
+    auto polyDataMapper = static_cast<vtkPolyDataMapper*>(actor->GetMapper());
+    if (polyDataMapper->GetInput() != mesher->GetOutput()->GetVtkPolyData())
+      polyDataMapper->SetInputData(mesher->GetOutput()->GetVtkPolyData());
+
+    actor->GetProperty()->SetColor(rgba[0], rgba[1], rgba[2]);
+    actor->GetProperty()->SetOpacity(rgba[3]);
+
+    localStorage->m_Actors->AddPart(actor);
+    meshers[value] = mesher;
+    actors[value] = actor;
+  }
+
+  // meshers and actors of removed or invisible labels are released.
+  localStorage->m_LabelSurfaceMeshers = std::move(meshers);
+  localStorage->m_LabelSurfaceActors = std::move(actors);
+
+  localStorage->m_LastDataUpdateTime.Modified();
+}
+
+void mitk::MultiLabelSegmentationVtkMapper3D::SwitchRenderingMode(mitk::BaseRenderer* renderer, bool combinedRendering, bool surfaceRendering)
+{
+  LocalStorage* localStorage = m_LSH.GetLocalStorage(renderer);
+
+  localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
+
+  localStorage->m_GroupImageIDs.clear();
+  localStorage->m_LayerImages.clear();
+  localStorage->m_LayerVolumeMappers.clear();
+  localStorage->m_LayerVolumes.clear();
+  localStorage->m_TransferFunctions.clear();
+  localStorage->m_OpacityTransferFunctions.clear();
+  localStorage->m_NumberOfGroups = 0;
+
+  localStorage->m_CombinedImage = nullptr;
+  localStorage->m_CombinedVolumeMapper = nullptr;
+  localStorage->m_CombinedVolume = nullptr;
+  localStorage->m_CombinedTransferFunction = nullptr;
+  localStorage->m_CombinedOpacityTransferFunction = nullptr;
+  localStorage->m_PackedLabelValues.clear();
+
+  localStorage->m_LabelSurfaceMeshers.clear();
+  localStorage->m_LabelSurfaceActors.clear();
+
+  // forces the regeneration of the lookup table and of the transfer functions.
+  localStorage->m_LabelLookupTable = nullptr;
+  localStorage->m_CombinedRendering = combinedRendering;
+  localStorage->m_SurfaceRendering = surfaceRendering;
+}
+
 void mitk::MultiLabelSegmentationVtkMapper3D::Update(mitk::BaseRenderer *renderer)
 {
   auto localStorage = m_LSH.GetLocalStorage(renderer);
@@ -361,6 +655,8 @@ void mitk::MultiLabelSegmentationVtkMapper3D::SetDefaultProperties(mitk::DataNod
 
   // add/replace the following properties
   node->SetProperty("multilabel.3D.visualize", BoolProperty::New(false), renderer);
+  node->SetProperty("multilabel.3D.combined", BoolProperty::New(false), renderer);
+  node->SetProperty("multilabel.3D.surface", BoolProperty::New(false), renderer);
 }
 
 mitk::MultiLabelSegmentationVtkMapper3D::LocalStorage::~LocalStorage()
@@ -373,4 +669,6 @@ mitk::MultiLabelSegmentationVtkMapper3D::LocalStorage::LocalStorage()
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
 
   m_NumberOfGroups = 0;
+  m_CombinedRendering = false;
+  m_SurfaceRendering = false;
 }
@@ -20,18 +20,21 @@ found in the LICENSE file.
 // MITK Rendering
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
+#include "mitkIncrementalLabelSurfaceMesher.h"
 #include "mitkLabelSetImage.h"
 #include "mitkVtkMapper.h"
 
 // VTK
 #include <vtkSmartPointer.h>
 
+class vtkActor;
 class vtkPolyDataMapper;
 class vtkImageData;
 class vtkLookupTable;
 class vtkVolumeProperty;
 class vtkVolume;
 class vtkSmartVolumeMapper;
+class vtkFixedPointVolumeRayCastMapper;
 
 namespace mitk
 {
@@ -47,6 +50,19 @@ namespace mitk
 
    *   - \b "labelset.contour.active", mitk::BoolProperty::New( true ), renderer, overwrite )
    *   - \b "labelset.contour.width", mitk::FloatProperty::New( 2.0 ), renderer, overwrite )
+   *   - \b "multilabel.3D.combined", mitk::BoolProperty::New( false ), renderer, overwrite )
+   *   - \b "multilabel.3D.surface", mitk::BoolProperty::New( false ), renderer, overwrite )
+   *
+   * If "multilabel.3D.combined" is true, all groups are composed into one label volume that is ray cast on the
+   * CPU in a single pass (multithreaded, with empty space skipping). Where groups overlap, the visible label of the
+   * highest group is shown. The label values are packed into a dense range, so the volume needs only 8 bit per voxel
+   * for up to 255 visible labels. Use it on systems without a capable GPU, where rendering each group with an own
+   * volume mapper is too slow.
+   *
+   * If "multilabel.3D.surface" is true (it takes precedence over "multilabel.3D.combined"), the surface of each
+   * visible label is rendered instead of volumes. The surfaces are generated by mitk::IncrementalLabelSurfaceMesher,
+   * so after an edit only the modified parts of the affected labels are meshed again. The surfaces are not smoothed;
+   * the mode is meant for immediate feedback while labels are edited.
 
    * \ingroup Mapper
    */
@@ -86,6 +102,21 @@ namespace mitk
       std::vector <vtkSmartPointer<vtkColorTransferFunction> > m_TransferFunctions;
       std::vector <vtkSmartPointer<vtkPiecewiseFunction> > m_OpacityTransferFunctions;
 
+      /** Members used if all groups are rendered as one combined label volume ("multilabel.3D.combined").*/
+      bool m_CombinedRendering;
+      vtkSmartPointer<vtkImageData> m_CombinedImage;
+      vtkSmartPointer<vtkFixedPointVolumeRayCastMapper> m_CombinedVolumeMapper;
+      vtkSmartPointer<vtkVolume> m_CombinedVolume;
+      vtkSmartPointer<vtkColorTransferFunction> m_CombinedTransferFunction;
+      vtkSmartPointer<vtkPiecewiseFunction> m_CombinedOpacityTransferFunction;
+      /** Label value of each packed value of the combined volume (packed value 0 is unlabeled).*/
+      std::vector<MultiLabelSegmentation::LabelValueType> m_PackedLabelValues;
+
+      /** Members used if the labels are rendered as surfaces ("multilabel.3D.surface").*/
+      bool m_SurfaceRendering;
+      std::map<MultiLabelSegmentation::LabelValueType, IncrementalLabelSurfaceMesher::Pointer> m_LabelSurfaceMeshers;
+      std::map<MultiLabelSegmentation::LabelValueType, vtkSmartPointer<vtkActor>> m_LabelSurfaceActors;
+
       /** Vector containing the pointer of the currently used group images.
        * IMPORTANT: This member must not be used to access any data.
        * Its purpose is to allow checking if the order of the groups has changed
@@ -139,6 +170,21 @@ namespace mitk
 
     bool GenerateVolumeMapping(mitk::BaseRenderer* renderer, const std::vector<mitk::MultiLabelSegmentation::GroupIndexType>& outdatedGroupIDs);
 
+    /** \brief Composes all groups into the packed label volume and (re)generates its transfer functions.
+      * Used instead of GenerateVolumeMapping() if the property "multilabel.3D.combined" is true.
+      */
+    void GenerateCombinedVolumeMapping(mitk::BaseRenderer* renderer);
+
+    /** \brief Updates the surfaces of all visible labels and their actors.
+      * Used instead of GenerateVolumeMapping() if the property "multilabel.3D.surface" is true.
+      */
+    void GenerateSurfaceMapping(mitk::BaseRenderer* renderer);
+
+    /** \brief Switches between rendering one volume per group, rendering the combined label volume and rendering label surfaces.
+      * All generated content is released, so it is regenerated with the next update.
+      */
+    void SwitchRenderingMode(mitk::BaseRenderer* renderer, bool combinedRendering, bool surfaceRendering);
+
     /** \brief Generates the look up table that should be used.
       */
     void GenerateLookupTable(mitk::BaseRenderer* renderer);
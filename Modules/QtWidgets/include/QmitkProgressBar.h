@@ -57,16 +57,19 @@ signals:
   void SignalAddStepsToDo(unsigned int steps);
   void SignalProgress(unsigned int steps);
   void SignalSetPercentageVisible(bool visible);
+  void SignalReset();
 
 protected slots:
 
   virtual void SlotAddStepsToDo(unsigned int steps);
   virtual void SlotProgress(unsigned int steps);
   virtual void SlotSetPercentageVisible(bool visible);
+  virtual void SlotReset();
 
 private:
   //##Documentation
   //## @brief Reset the progress bar. The progress bar "rewinds" and shows no progress.
+  //## Like all other calls, the reset is forwarded to the GUI thread via a signal.
   void Reset() override;
 
   unsigned int m_TotalSteps;
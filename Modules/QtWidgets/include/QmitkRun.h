@@ -79,4 +79,13 @@ T QmitkRunAsyncBlocking(const QString& title, const QString& label, std::functio
 
 MITKQTWIDGETS_EXPORT void QmitkRunAsyncBlocking(const QString& title, const QString& label, std::function<void()> task);
 
+/** \brief Like QmitkRunAsyncBlocking() but the QProgressDialog offers a cancel button.
+ *
+ * If the user cancels, the passed cancel function is called in the calling thread. It has to request
+ * the task to stop, which is not terminated otherwise. The function still blocks until the task finishes.
+ *
+ * \return False if the user canceled the task.
+ */
+MITKQTWIDGETS_EXPORT bool QmitkRunCancelableAsyncBlocking(const QString& title, const QString& label, std::function<void()> task, std::function<void()> cancel);
+
 #endif
@@ -36,6 +36,7 @@ found in the LICENSE file.
 #include <itksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <thread>
 
 struct QmitkIOUtil::Impl
 {
@@ -102,6 +103,12 @@ struct QmitkIOUtil::Impl
     return false;
   }
 
+  //! Independent files are read on up to the number of hardware threads (see mitk::IOUtil::LoadConcurrently())
+  static unsigned int GetNumberOfReadingThreads()
+  {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
 }; // Impl
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -157,7 +164,7 @@ QList<mitk::BaseData::Pointer> QmitkIOUtil::Load(const QStringList &paths, QWidg
   }
 
   Impl::ReaderOptionsDialogFunctor optionsCallback;
-  std::string errMsg = Load(loadInfos, nullptr, nullptr, &optionsCallback);
+  std::string errMsg = Load(loadInfos, nullptr, nullptr, &optionsCallback, Impl::GetNumberOfReadingThreads());
   if (!errMsg.empty())
   {
     QMessageBox::warning(parent, "Error reading files", QString::fromStdString(errMsg));
@@ -188,7 +195,7 @@ mitk::DataStorage::SetOfObjects::Pointer QmitkIOUtil::Load(const QStringList &pa
 
   mitk::DataStorage::SetOfObjects::Pointer nodeResult = mitk::DataStorage::SetOfObjects::New();
   Impl::ReaderOptionsDialogFunctor optionsCallback;
-  std::string errMsg = Load(loadInfos, nodeResult, &storage, &optionsCallback);
+  std::string errMsg = Load(loadInfos, nodeResult, &storage, &optionsCallback, Impl::GetNumberOfReadingThreads());
   if (!errMsg.empty())
   {
     QMessageBox::warning(parent, "Error reading files", QString::fromStdString(errMsg));
@@ -23,10 +23,7 @@ found in the LICENSE file.
  */
 void QmitkProgressBar::Reset()
 {
-  this->reset();
-  this->hide();
-  m_TotalSteps = 0;
-  m_Progress = 0;
+  emit SignalReset();
 }
 
 /**
@@ -67,6 +64,7 @@ QmitkProgressBar::QmitkProgressBar(QWidget *parent, const char * /*name*/)
   connect(this, SIGNAL(SignalAddStepsToDo(unsigned int)), this, SLOT(SlotAddStepsToDo(unsigned int)));
   connect(this, SIGNAL(SignalProgress(unsigned int)), this, SLOT(SlotProgress(unsigned int)));
   connect(this, SIGNAL(SignalSetPercentageVisible(bool)), this, SLOT(SlotSetPercentageVisible(bool)));
+  connect(this, SIGNAL(SignalReset()), this, SLOT(SlotReset()));
 
   mitk::ProgressBar::GetInstance()->RegisterImplementationInstance(this);
 }
@@ -82,7 +80,7 @@ void QmitkProgressBar::SlotProgress(unsigned int steps)
   this->setValue(m_Progress);
 
   if (m_Progress >= m_TotalSteps)
-    Reset();
+    this->SlotReset();
   else
   {
     this->show();
@@ -111,6 +109,14 @@ void QmitkProgressBar::SlotAddStepsToDo(unsigned int steps)
   mitk::RenderingManager::GetInstance()->ExecutePendingRequests();
 }
 
+void QmitkProgressBar::SlotReset()
+{
+  this->reset();
+  this->hide();
+  m_TotalSteps = 0;
+  m_Progress = 0;
+}
+
 void QmitkProgressBar::SlotSetPercentageVisible(bool visible)
 {
   this->setTextVisible(visible);
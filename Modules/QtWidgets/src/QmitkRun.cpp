@@ -47,3 +47,53 @@ void QmitkRunAsyncBlocking(const QString& title, const QString& label, std::func
   if (exception)
     std::rethrow_exception(exception);
 }
+
+bool QmitkRunCancelableAsyncBlocking(const QString& title, const QString& label, std::function<void()> task, std::function<void()> cancel)
+{
+  QProgressDialog dialog(label, QObject::tr("Cancel"), 0, 0);
+  dialog.setWindowModality(Qt::ApplicationModal);
+  dialog.setWindowTitle(title);
+  dialog.setMinimumDuration(250);
+  dialog.show();
+
+  bool canceled = false;
+  bool finished = false;
+  std::exception_ptr exception;
+
+  auto future = QtConcurrent::run([&]() {
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+  });
+
+  QFutureWatcher<void> watcher;
+  QEventLoop loop;
+
+  // closing the dialog emits canceled() as well
+  QObject::connect(&dialog, &QProgressDialog::canceled, [&]() {
+    if (!canceled && !finished)
+    {
+      canceled = true;
+      cancel();
+    }
+  });
+
+  QObject::connect(&watcher, &QFutureWatcher<void>::finished, [&]() {
+    finished = true;
+    dialog.close();
+    loop.quit();
+  });
+
+  watcher.setFuture(future);
+  loop.exec();
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  return !canceled;
+}
@@ -123,6 +123,8 @@ namespace
 mitk::ROIIO::ROIIO()
   : AbstractFileIO(ROI::GetStaticNameOfClass(), MitkROIIOMimeTypes::ROI_MIMETYPE(), "MITK ROI")
 {
+  // JSON parsing does not switch the locale
+  this->SetReaderThreadSafe(true);
   this->RegisterService();
 }
 
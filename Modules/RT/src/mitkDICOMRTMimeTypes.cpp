@@ -45,6 +45,7 @@ DICOMRTMimeTypes::RTDoseMimeType::RTDoseMimeType()
   this->SetComment("RTDose");
 
   this->AddExtension("dcm");
+  this->SetExtensionRequired(true);
 }
 
 bool DICOMRTMimeTypes::RTDoseMimeType::AppliesTo(const std::string &path) const
@@ -118,6 +119,7 @@ DICOMRTMimeTypes::RTStructMimeType::RTStructMimeType()
   this->SetComment("RTStruct");
 
   this->AddExtension("dcm");
+  this->SetExtensionRequired(true);
 }
 
 bool DICOMRTMimeTypes::RTStructMimeType::AppliesTo(const std::string &path) const
@@ -159,6 +161,7 @@ DICOMRTMimeTypes::RTPlanMimeType::RTPlanMimeType()
   this->SetComment("RTPLAN");
 
   this->AddExtension("dcm");
+  this->SetExtensionRequired(true);
 }
 
 bool DICOMRTMimeTypes::RTPlanMimeType::AppliesTo(const std::string &path) const
@@ -18,8 +18,11 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkNodePredicateBase.h"
 
+#include <Poco/Timestamp.h>
 #include <Poco/Zip/ZipLocalFileHeader.h>
 
+#include <set>
+
 namespace tinyxml2
 {
   class XMLDocument;
@@ -29,6 +32,7 @@ namespace tinyxml2
 namespace mitk
 {
   class BaseData;
+  class BaseDataSerializer;
   class PropertyList;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
@@ -85,6 +89,7 @@ namespace mitk
      *
      * Attempts to write a scene file, which contains the nodes of the
      * provided DataStorage, their parent/child relations, and properties.
+     * The data of nodes whose serializer is thread-safe (see BaseDataSerializer::IsThreadSafe()) is serialized concurrently.
      *
      * \param sceneNodes
      * \param storage a DataStorage containing all nodes that should be saved
@@ -115,23 +120,92 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Compress the entries of scene files written by SaveScene() (default).
+     *
+     * If disabled, all entries are stored uncompressed, which is considerably faster for
+     * large data at the cost of larger scene files. Entries of already compressed file types
+     * (like images, which are written as compressed NRRD files) are stored in any case.
+     */
+    itkSetMacro(CompressionEnabled, bool);
+    itkGetConstMacro(CompressionEnabled, bool);
+    itkBooleanMacro(CompressionEnabled);
+
+    /**
+     * \brief Reuse unchanged data of the scene file written last by this instance (disabled by default).
+     *
+     * If SaveScene() is called again for the same scene file and the file was not changed in the
+     * meantime, data that was not modified since (see itk::Object::GetMTime()) is not serialized
+     * again. Its entries are copied from the previous scene file without recompression instead.
+     * Properties are written in any case. Keep the SceneIO instance to benefit from repeated saves.
+     */
+    itkSetMacro(IncrementalSaving, bool);
+    itkGetConstMacro(IncrementalSaving, bool);
+    itkBooleanMacro(IncrementalSaving);
+
+    /**
+     * \brief Get a list of nodes whose data entries were reused during the last call to SaveScene().
+     *
+     * Only filled if incremental saving is enabled (see SetIncrementalSaving()).
+     */
+    const DataStorage::SetOfObjects *GetReusedNodes() const;
+
   protected:
     SceneIO();
     ~SceneIO() override;
 
     std::string CreateEmptyTempDirectory();
 
-    tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
+    /**
+      \brief creates the \<data\> element of data and the serializer that writes its file
+
+      The serializer is nullptr if there is none for the type of data. Since data of several
+      nodes is serialized concurrently, the caller runs the serializer and sets the file attribute.
+    */
+    tinyxml2::XMLElement *PrepareBaseData(tinyxml2::XMLDocument &doc,
+                                          BaseData *data,
+                                          const std::string &filenamehint,
+                                          itk::SmartPointer<BaseDataSerializer> &serializer);
     tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
 
+    /**
+      \brief checks if filename is the scene file written last by this instance and unchanged since
+    */
+    bool IsSavedSceneFile(const std::string &filename) const;
+
+    /**
+      \brief updates the scene file written last with the files of the working directory
+
+      Entries in reusedFiles are copied from the previous scene file, all others are replaced or removed.
+      \throws mitk::Exception if the scene file cannot be updated.
+    */
+    void UpdateSceneFile(const std::string &filename, const std::set<std::string> &reusedFiles) const;
+
     void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
     void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
 
     FailedBaseDataListType::Pointer m_FailedNodes;
     PropertyList::Pointer m_FailedProperties;
+    DataStorage::SetOfObjects::Pointer m_ReusedNodes;
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+
+    bool m_CompressionEnabled;
+    bool m_IncrementalSaving;
+
+    /** Data written to the scene file saved last, used for incremental saving. */
+    struct SavedBaseData
+    {
+      const BaseData *m_Data;
+      itk::ModifiedTimeType m_MTime;
+      std::string m_File;
+    };
+
+    std::string m_SavedSceneFilename;
+    Poco::Timestamp m_SavedSceneTimestamp;
+    Poco::UInt64 m_SavedSceneSize;
+    std::map<std::string, SavedBaseData> m_SavedBaseData; // key is the UID of the data
   };
 }
 
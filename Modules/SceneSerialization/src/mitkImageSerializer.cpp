@@ -19,6 +19,8 @@ MITK_REGISTER_SERIALIZER(ImageSerializer)
 
 mitk::ImageSerializer::ImageSerializer()
 {
+  // images are written by separate writer instances, their locale switch to "C" keeps the scene locale
+  this->SetThreadSafe(true);
 }
 
 mitk::ImageSerializer::~ImageSerializer()
@@ -11,10 +11,13 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <Poco/Delegate.h>
+#include <Poco/DirectoryIterator.h>
 #include <Poco/Path.h>
+#include <Poco/String.h>
 #include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
 #include <Poco/Zip/Decompress.h>
+#include <Poco/Zip/ZipManipulator.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
@@ -25,21 +28,139 @@ found in the LICENSE file.
 #include "mitkProgressBar.h"
 #include "mitkRenderingManager.h"
 #include "mitkStandaloneDataStorage.h"
+#include <mitkExceptionMacro.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkStandardFileLocations.h>
 #include <mitkUIDGenerator.h>
 
 #include <itkObjectFactoryBase.h>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <mitkIOUtil.h>
 #include <sstream>
+#include <thread>
 
 #include "itksys/SystemTools.hxx"
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  struct SerializationTask
+  {
+    mitk::DataNode *m_Node;
+    mitk::BaseData *m_Data;
+    itk::ModifiedTimeType m_MTime;
+    tinyxml2::XMLElement *m_Element;
+    mitk::BaseDataSerializer::Pointer m_Serializer;
+    std::string m_File;
+    std::string m_ErrorMessage;
+  };
+
+  void RunSerializer(SerializationTask &task)
+  {
+    try
+    {
+      task.m_File = task.m_Serializer->Serialize();
+    }
+    catch (const std::exception &e)
+    {
+      task.m_ErrorMessage = e.what();
+    }
+    catch (...)
+    {
+      task.m_ErrorMessage = "Unknown exception";
+    }
+
+    mitk::ProgressBar::GetInstance()->Progress();
+  }
+
+  // Runs the thread-safe serializers (see BaseDataSerializer::IsThreadSafe()) on up to the number
+  // of hardware threads and all other serializers afterwards on the calling thread. Progress is
+  // reported per finished task, errors are reported by the caller.
+  void SerializeBaseData(std::vector<SerializationTask> &tasks)
+  {
+    std::vector<SerializationTask *> concurrentTasks;
+    for (auto &task : tasks)
+    {
+      if (task.m_Serializer->IsThreadSafe())
+        concurrentTasks.push_back(&task);
+    }
+
+    if (!concurrentTasks.empty())
+    {
+      std::atomic<std::size_t> nextTask(0);
+      auto serialize = [&concurrentTasks, &nextTask]()
+      {
+        for (auto i = nextTask++; i < concurrentTasks.size(); i = nextTask++)
+          RunSerializer(*concurrentTasks[i]);
+      };
+
+      // The calling thread serializes as well.
+      const auto numberOfThreads =
+        std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), concurrentTasks.size());
+
+      std::vector<std::thread> threads;
+      threads.reserve(numberOfThreads - 1);
+      for (std::size_t i = 1; i < numberOfThreads; ++i)
+        threads.emplace_back(serialize);
+
+      serialize();
+
+      for (auto &thread : threads)
+        thread.join();
+    }
+
+    for (auto &task : tasks)
+    {
+      if (!task.m_Serializer->IsThreadSafe())
+        RunSerializer(task);
+    }
+  }
+
+  // Files of these types are already compressed (images are written as compressed NRRD files),
+  // so deflating them again costs a lot of time for hardly any gain.
+  const std::set<std::string> &GetStoreExtensions()
+  {
+    static const std::set<std::string> extensions = { "gz", "nrrd", "png" };
+    return extensions;
+  }
+
+  Poco::Zip::ZipCommon::CompressionMethod GetCompressionMethod(const std::string &fileName, bool compressionEnabled)
+  {
+    if (compressionEnabled && GetStoreExtensions().count(Poco::toLower(Poco::Path(fileName).getExtension())) == 0)
+      return Poco::Zip::ZipCommon::CM_DEFLATE;
+
+    return Poco::Zip::ZipCommon::CM_STORE;
+  }
+
+  // Collects all files below directory, mapping their path in the zip file to their local path.
+  void CollectFiles(const Poco::Path &directory, const std::string &zipDirectory, std::map<std::string, std::string> &files)
+  {
+    for (Poco::DirectoryIterator iter(directory), end; iter != end; ++iter)
+    {
+      const auto zipPath = zipDirectory + iter.name();
+
+      if (iter->isDirectory())
+      {
+        CollectFiles(iter.path(), zipPath + '/', files);
+      }
+      else
+      {
+        files[zipPath] = iter->path();
+      }
+    }
+  }
+}
+
+mitk::SceneIO::SceneIO()
+  : m_WorkingDirectory(""),
+    m_UnzipErrors(0),
+    m_CompressionEnabled(true),
+    m_IncrementalSaving(false),
+    m_SavedSceneSize(0)
 {
 }
 
@@ -243,6 +364,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
   {
     m_FailedNodes = DataStorage::SetOfObjects::New();
     m_FailedProperties = PropertyList::New();
+    m_ReusedNodes = DataStorage::SetOfObjects::New();
 
     // start XML DOM
     tinyxml2::XMLDocument document;
@@ -256,6 +378,11 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
     // DataStorage::SetOfObjects::ConstPointer sceneNodes = storage->GetSubset( predicate );
 
+    // reuse entries of unchanged data only if the scene file is still the one written last
+    const bool incremental = m_IncrementalSaving && this->IsSavedSceneFile(filename);
+    std::set<std::string> reusedFiles;
+    std::map<std::string, SavedBaseData> savedBaseData;
+
     if (sceneNodes.IsNull())
     {
       MITK_WARN << "Saving empty scene to " << filename;
@@ -318,7 +445,9 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         }
       }
 
-      // write out objects, dependencies and properties
+      // write out objects, dependencies and properties, the data of all nodes is serialized afterwards
+      std::vector<SerializationTask> serializationTasks;
+
       for (auto iter = sceneNodes->begin(); iter != sceneNodes->end(); ++iter)
       {
         DataNode *node = iter->GetPointer();
@@ -355,12 +484,41 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           // store basedata
           if (BaseData *data = node->GetData())
           {
-            // std::string filenameHint( node->GetName() );
-            bool error(false);
-            auto *dataElement = SaveBaseData(document, data, filenameHint, error); // returns a reference to a file
-            if (error)
+            tinyxml2::XMLElement *dataElement = nullptr;
+            auto savedIter = incremental ? m_SavedBaseData.find(data->GetUID()) : m_SavedBaseData.end();
+
+            if (savedIter != m_SavedBaseData.end() && savedIter->second.m_Data == data &&
+                savedIter->second.m_MTime == data->GetMTime())
+            {
+              // unchanged since the last save, the entry of the previous scene file is reused
+              dataElement = document.NewElement("data");
+              dataElement->SetAttribute("type", data->GetNameOfClass());
+              dataElement->SetAttribute("file", savedIter->second.m_File.c_str());
+              dataElement->SetAttribute("UID", data->GetUID().c_str());
+
+              reusedFiles.insert(savedIter->second.m_File);
+              savedBaseData.insert(*savedIter);
+              m_ReusedNodes->push_back(node);
+            }
+            else
             {
-              m_FailedNodes->push_back(node);
+              BaseDataSerializer::Pointer serializer;
+              dataElement = PrepareBaseData(document, data, filenameHint, serializer); // file is set after serialization
+
+              if (serializer.IsNotNull())
+              {
+                SerializationTask task;
+                task.m_Node = node;
+                task.m_Data = data;
+                task.m_MTime = data->GetMTime();
+                task.m_Element = dataElement;
+                task.m_Serializer = serializer;
+                serializationTasks.push_back(task);
+              }
+              else
+              {
+                m_FailedNodes->push_back(node);
+              }
             }
 
             // store basedata properties
@@ -403,9 +561,34 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
         {
           MITK_WARN << "Ignoring nullptr node during scene serialization.";
         }
-
-        ProgressBar::GetInstance()->Progress();
       } // end for all nodes
+
+      // nodes without data to serialize are done
+      ProgressBar::GetInstance()->Progress(sceneNodes->size() - serializationTasks.size());
+
+      // serialize the data of independent nodes concurrently
+      SerializeBaseData(serializationTasks);
+
+      for (const auto &task : serializationTasks)
+      {
+        if (!task.m_ErrorMessage.empty())
+        {
+          MITK_ERROR << "Serializer " << task.m_Serializer->GetNameOfClass() << " failed: " << task.m_ErrorMessage;
+        }
+        else
+        {
+          task.m_Element->SetAttribute("file", task.m_File.c_str());
+        }
+
+        if (task.m_File.empty())
+        {
+          m_FailedNodes->push_back(task.m_Node);
+        }
+        else
+        {
+          savedBaseData[task.m_Data->GetUID()] = { task.m_Data, task.m_MTime, task.m_File };
+        }
+      }
     }   // end if sceneNodes
 
     std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
@@ -421,25 +604,55 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     {
       try
       {
-        Poco::File deleteFile(filename.c_str());
-        if (deleteFile.exists())
+        if (incremental)
         {
-          deleteFile.remove();
-        }
+          try
+          {
+            this->UpdateSceneFile(filename, reusedFiles);
+          }
+          catch (std::exception &e)
+          {
+            MITK_WARN << "Could not update scene file " << filename << " incrementally, writing it completely. Reason: " << e.what();
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
+            try
+            {
+              Poco::File deleteDir(m_WorkingDirectory);
+              deleteDir.remove(true); // recursive
+            }
+            catch (...)
+            {
+              MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+            }
+
+            m_SavedSceneFilename.clear();
+            m_SavedBaseData.clear();
+
+            return this->SaveScene(sceneNodes, storage, filename);
+          }
         }
         else
         {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
+          Poco::File deleteFile(filename.c_str());
+          if (deleteFile.exists())
+          {
+            deleteFile.remove();
+          }
+
+          // create zip at filename
+          std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
+          if (!file.good())
+          {
+            MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
+            return false;
+          }
+          else
+          {
+            Poco::Zip::Compress zipper(file, true);
+            zipper.setStoreExtensions(GetStoreExtensions());
+            Poco::Path tmpdir(m_WorkingDirectory);
+            zipper.addRecursive(tmpdir, m_CompressionEnabled ? Poco::Zip::ZipCommon::CM_AUTO : Poco::Zip::ZipCommon::CM_STORE);
+            zipper.close();
+          }
         }
         try
         {
@@ -451,6 +664,13 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
           return false; // ok?
         }
+
+        // remember the written data for the next incremental save
+        Poco::File sceneFile(filename);
+        m_SavedSceneFilename = filename;
+        m_SavedSceneTimestamp = sceneFile.getLastModified();
+        m_SavedSceneSize = sceneFile.getSize();
+        m_SavedBaseData.swap(savedBaseData);
       }
       catch (std::exception &e)
       {
@@ -467,10 +687,13 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
   }
 }
 
-tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error)
+tinyxml2::XMLElement *mitk::SceneIO::PrepareBaseData(tinyxml2::XMLDocument &doc,
+                                                     BaseData *data,
+                                                     const std::string &filenamehint,
+                                                     BaseDataSerializer::Pointer &serializer)
 {
   assert(data);
-  error = true;
+  serializer = nullptr;
 
   // find correct serializer
   // the serializer must
@@ -495,24 +718,13 @@ tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Ba
        iter != thingsThatCanSerializeThis.end();
        ++iter)
   {
-    if (auto *serializer = dynamic_cast<BaseDataSerializer *>(iter->GetPointer()))
+    if (auto *candidate = dynamic_cast<BaseDataSerializer *>(iter->GetPointer()))
     {
-      serializer->SetData(data);
-      serializer->SetFilenameHint(filenamehint);
+      candidate->SetData(data);
+      candidate->SetFilenameHint(filenamehint);
       std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
-      serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
-      try
-      {
-        std::string writtenfilename = serializer->Serialize();
-        element->SetAttribute("file", writtenfilename.c_str());
-
-        if (!writtenfilename.empty())
-          error = false;
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
-      }
+      candidate->SetWorkingDirectory(defaultLocale_WorkingDirectory);
+      serializer = candidate;
       break;
     }
   }
@@ -564,6 +776,79 @@ const mitk::PropertyList *mitk::SceneIO::GetFailedProperties()
   return m_FailedProperties;
 }
 
+const mitk::DataStorage::SetOfObjects *mitk::SceneIO::GetReusedNodes() const
+{
+  return m_ReusedNodes.GetPointer();
+}
+
+bool mitk::SceneIO::IsSavedSceneFile(const std::string &filename) const
+{
+  if (m_SavedSceneFilename.empty() || filename != m_SavedSceneFilename)
+    return false;
+
+  try
+  {
+    Poco::File sceneFile(filename);
+    return sceneFile.exists() && sceneFile.getLastModified() == m_SavedSceneTimestamp &&
+           sceneFile.getSize() == m_SavedSceneSize;
+  }
+  catch (...)
+  {
+    return false;
+  }
+}
+
+void mitk::SceneIO::UpdateSceneFile(const std::string &filename, const std::set<std::string> &reusedFiles) const
+{
+  std::map<std::string, std::string> writtenFiles;
+  CollectFiles(Poco::Path(m_WorkingDirectory), "", writtenFiles);
+
+  try
+  {
+    Poco::Zip::ZipManipulator manipulator(filename, false);
+    const auto &archive = manipulator.originalArchive();
+
+    for (const auto &reusedFile : reusedFiles)
+    {
+      if (archive.findHeader(reusedFile) == archive.headerEnd())
+        mitkThrow() << "Entry '" << reusedFile << "' is missing.";
+
+      if (writtenFiles.count(reusedFile) != 0)
+        mitkThrow() << "Entry '" << reusedFile << "' is written again.";
+    }
+
+    // reused entries are kept (copied without recompression), all others are replaced or removed
+    for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+    {
+      const auto &zipPath = iter->first;
+
+      if (reusedFiles.count(zipPath) != 0)
+        continue;
+
+      auto writtenIter = writtenFiles.find(zipPath);
+
+      if (writtenIter != writtenFiles.end())
+      {
+        manipulator.replaceFile(zipPath, writtenIter->second);
+        writtenFiles.erase(writtenIter);
+      }
+      else
+      {
+        manipulator.deleteFile(zipPath);
+      }
+    }
+
+    for (const auto &writtenFile : writtenFiles)
+      manipulator.addFile(writtenFile.first, writtenFile.second, GetCompressionMethod(writtenFile.first, m_CompressionEnabled));
+
+    manipulator.commit();
+  }
+  catch (const Poco::Exception &e)
+  {
+    mitkThrow() << e.displayText();
+  }
+}
+
 void mitk::SceneIO::OnUnzipError(const void * /*pSender*/,
                                  std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info)
 {
@@ -22,7 +22,9 @@ found in the LICENSE file.
 #include <tinyxml2.h>
 
 #include <mitkFileSystem.h>
+#include <functional>
 #include <map>
+#include <set>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -77,6 +79,16 @@ namespace
       geometry->SetStepDuration(value);
   }
 
+  /** Forwards the files read by IOUtil::LoadConcurrently() to the scene reader.*/
+  struct LoadedCallback : public mitk::IOUtil::LoadedFunctorBase
+  {
+    explicit LoadedCallback(std::function<void(mitk::IOUtil::LoadInfo &)> callback) : m_Callback(callback) {}
+    void operator()(mitk::IOUtil::LoadInfo &loadInfo) override { m_Callback(loadInfo); }
+
+  private:
+    std::function<void(mitk::IOUtil::LoadInfo &)> m_Callback;
+  };
+
   mitk::PropertyList::Pointer DeserializeProperties(const tinyxml2::XMLElement *propertiesElement, const fs::path& basePath)
   {
     if (propertiesElement == nullptr)
@@ -112,81 +124,40 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
   //        - if serializer could be created, use it to read the file into a BaseData object
   //        - if successful, call the new node's SetData(..)
 
-  // create a node for the tag "data" and test if node was created
-  typedef std::vector<mitk::DataNode::Pointer> DataNodeVector;
-  DataNodeVector DataNodes;
-  unsigned int listSize = 0;
+  // collect all <node> elements once, they are visited several times below
+  std::vector<const tinyxml2::XMLElement *> nodeElements;
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    ++listSize;
+    nodeElements.push_back(element);
   }
 
-  ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
+  const auto numberOfNodes = static_cast<unsigned int>(nodeElements.size());
+  ProgressBar::GetInstance()->AddStepsToDo(numberOfNodes * 2);
 
-  // Deserialize base data properties before reading the actual data to be
-  // able to provide them as read-only meta data to the data reader.
-  std::map<std::string, PropertyList::Pointer> baseDataPropertyLists;
+  // Everything but the data is prepared first: the nodes, their parents and their properties.
+  // This determines the order in which the nodes are added to the data storage, so that each
+  // node can be added as soon as its data is read.
+  std::vector<const tinyxml2::XMLElement *> dataElements(numberOfNodes, nullptr);
+  std::vector<PropertyList::Pointer> baseDataPropertyLists(numberOfNodes);
+  std::vector<NodePropertyListsType> nodePropertyLists(numberOfNodes);
+  std::map<DataNode *, std::size_t> elementIndexForNode;
 
-  for (auto *nodeElement = document.FirstChildElement("node"); nodeElement != nullptr;
-       nodeElement = nodeElement->NextSiblingElement("node"))
+  for (std::size_t i = 0; i < numberOfNodes; ++i)
   {
-    const auto *uid = nodeElement->Attribute("UID");
-
-    if (uid == nullptr)
-      continue;
+    const auto *element = nodeElements[i];
 
-    auto *dataElement = nodeElement->FirstChildElement("data");
+    // Deserialize base data properties before reading the actual data to be
+    // able to provide them as read-only meta data to the data reader.
+    dataElements[i] = element->FirstChildElement("data");
 
-    if (dataElement != nullptr)
-    {
-      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
-
-      if (properties.IsNotNull())
-        baseDataPropertyLists[uid] = properties;
-    }
-  }
-
-  for (auto *element = document.FirstChildElement("node"); element != nullptr;
-       element = element->NextSiblingElement("node"))
-  {
-    mitk::PropertyList* properties = nullptr;
-    const auto *uid = element->Attribute("UID");
-
-    if (uid != nullptr)
-    {
-      auto iter = baseDataPropertyLists.find(uid);
-
-      if (iter != baseDataPropertyLists.end())
-        properties = iter->second;
-    }
+    if (dataElements[i] != nullptr && element->Attribute("UID") != nullptr)
+      baseDataPropertyLists[i] = DeserializeProperties(dataElements[i]->FirstChildElement("properties"), workingDirectory);
 
-    const auto *dataElement = element->FirstChildElement("data");
-    auto dataNode = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
-
-    if (dataNode.IsNull())
-      continue;
-
-    auto* baseData = dataNode->GetData();
-
-    if (baseData != nullptr && properties != nullptr)
-    {
-      baseData->SetPropertyList(properties);
-      ApplyProportionalTimeGeometryProperties(baseData);
-    }
-
-    DataNodes.push_back(dataNode);
-
-    ProgressBar::GetInstance()->Progress();
-  }
-
-  // iterate all nodes
-  // first level nodes should be <node> elements
-  auto nit = DataNodes.begin();
-  for (auto *element = document.FirstChildElement("node"); element != nullptr || nit != DataNodes.end();
-       element = element->NextSiblingElement("node"), ++nit)
-  {
-    mitk::DataNode::Pointer node = *nit;
+    // in case there is no <data> element or it cannot be read, the node stays empty
+    // (for appending a propertylist later)
+    mitk::DataNode::Pointer node = DataNode::New();
+    elementIndexForNode[node] = i;
 
     //   1. check child nodes
     const char *uida = element->Attribute("UID");
@@ -208,12 +179,9 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     //        - instantiate the appropriate PropertyListDeSerializer
     //        - use them to construct PropertyList objects
     //        - add these properties to the node (if necessary, use renderwindow name)
-    bool success = DecorateNodeWithProperties(node, element, workingDirectory);
-    if (!success)
-    {
-      MITK_ERROR << "Could not load properties for node.";
-      error = true;
-    }
+    //      The properties are applied again after the data was assigned (see SetNodeData()).
+    nodePropertyLists[i] = this->DeserializeNodeProperties(element, workingDirectory, error);
+    this->DecorateNodeWithProperties(node, nodePropertyLists[i]);
 
     // remember node for later adding to DataStorage
     m_OrderedNodePairs.push_back(std::make_pair(node, std::list<std::string>()));
@@ -256,122 +224,179 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     }
   }
 
-  // repeat the following loop ...
-  //   ... for all created nodes
-  unsigned int lastMapSize(0);
-  while (lastMapSize !=
-         m_OrderedNodePairs
-           .size()) // this is to prevent infinite loops; each iteration must at least add one node to DataStorage
+  // Each node is inserted as soon as all of its parents are inserted. Among all nodes
+  // that are ready, the one of the lowest (layer ordered) position is inserted first.
+  std::vector<OrderedNodesList::iterator> orderedNodes;
+  std::map<DataNode *, std::size_t> positionForNode;
+
+  for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end(); ++nodesIter)
   {
-    lastMapSize = m_OrderedNodePairs.size();
+    positionForNode[nodesIter->first.GetPointer()] = orderedNodes.size();
+    orderedNodes.push_back(nodesIter);
+  }
+
+  std::vector<std::size_t> numberOfMissingParents(orderedNodes.size(), 0);
+  std::vector<std::vector<std::size_t>> childPositions(orderedNodes.size());
 
-    // iterate (layer) ordered nodes backwards
-    // we insert the highest layers first
-    for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();
-         ++nodesIter)
+  for (std::size_t position = 0; position < orderedNodes.size(); ++position)
+  {
+    for (const auto &parentUID : orderedNodes[position]->second)
     {
-      bool addThisNode(true);
+      childPositions[positionForNode[m_NodeForID[parentUID]]].push_back(position);
+      ++numberOfMissingParents[position];
+    }
+  }
 
-      // if any parent node is not yet in DataStorage, skip node for now and check later
-      for (auto parentsIter = nodesIter->second.begin();
-           parentsIter != nodesIter->second.end();
-           ++parentsIter)
-      {
-        if (!storage->Exists(m_NodeForID[*parentsIter]))
-        {
-          addThisNode = false;
-          break;
-        }
-      }
+  std::set<std::size_t> readyPositions;
+  for (std::size_t position = 0; position < orderedNodes.size(); ++position)
+  {
+    if (numberOfMissingParents[position] == 0)
+      readyPositions.insert(position);
+  }
 
-      if (addThisNode)
-      {
-        DataStorage::SetOfObjects::Pointer parents = DataStorage::SetOfObjects::New();
-        for (auto parentsIter = nodesIter->second.begin();
-             parentsIter != nodesIter->second.end();
-             ++parentsIter)
-        {
-          parents->push_back(m_NodeForID[*parentsIter]);
-        }
+  std::vector<OrderedNodesList::iterator> insertionOrder;
 
-        // if all parents are found in datastorage (or are unknown), add node to DataStorage
-        storage->Add(nodesIter->first, parents);
+  while (!readyPositions.empty())
+  {
+    const auto position = *readyPositions.begin();
+    readyPositions.erase(readyPositions.begin());
 
-        // remove this node from m_OrderedNodePairs
-        m_OrderedNodePairs.erase(nodesIter);
+    insertionOrder.push_back(orderedNodes[position]);
 
-        // break this for loop because iterators are probably invalid
-        break;
-      }
+    for (const auto childPosition : childPositions[position])
+    {
+      if (--numberOfMissingParents[childPosition] == 0)
+        readyPositions.insert(childPosition);
     }
   }
 
-  // All nodes that are still in m_OrderedNodePairs at this point are not part of a proper directed graph structure.
+  // All other nodes are not part of a proper directed graph structure.
   // We'll add such nodes without any parent information.
-  for (auto nodesIter = m_OrderedNodePairs.begin(); nodesIter != m_OrderedNodePairs.end();
-       ++nodesIter)
+  for (std::size_t position = 0; position < orderedNodes.size(); ++position)
   {
-    storage->Add(nodesIter->first);
-    MITK_WARN << "Encountered node that is not part of a directed graph structure. Will be added to DataStorage "
-                 "without parents.";
-    error = true;
+    if (numberOfMissingParents[position] != 0)
+    {
+      orderedNodes[position]->second.clear();
+      insertionOrder.push_back(orderedNodes[position]);
+      MITK_WARN << "Encountered node that is not part of a directed graph structure. Will be added to DataStorage "
+                   "without parents.";
+      error = true;
+    }
   }
 
-  return !error;
-}
-
-mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
-                                                                     const PropertyList *properties,
-                                                                     const std::string &workingDirectory,
-                                                                     bool &error)
-{
-  DataNode::Pointer node;
+  // one load info for each data element with a file, in the order of insertion
+  std::vector<IOUtil::LoadInfo> loadInfos;
+  std::vector<std::size_t> loadInfoIndices(insertionOrder.size(), insertionOrder.size());
 
-  if (dataElement)
+  for (std::size_t position = 0; position < insertionOrder.size(); ++position)
   {
-    const char *filename = dataElement->Attribute("file");
+    const auto i = elementIndexForNode[insertionOrder[position]->first];
+    if (dataElements[i] == nullptr)
+      continue;
+
+    const char *filename = dataElements[i]->Attribute("file");
     if (filename && strlen(filename) != 0)
     {
-      try
-      {
-        auto baseData = IOUtil::Load(workingDirectory + Poco::Path::separator() + filename, properties);
-
-        node = DataNode::New();
-        node->SetData(baseData);
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Error during attempt to read '" << filename << "'. Exception says: " << e.what();
-        error = true;
-      }
-
-      if (node.IsNull())
-      {
-        MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
-        error = true;
-      }
+      loadInfoIndices[position] = loadInfos.size();
+      loadInfos.emplace_back(workingDirectory + Poco::Path::separator() + filename);
+      loadInfos.back().m_Properties = baseDataPropertyLists[i];
     }
     else
     {
       MITK_ERROR << "File attribute of data tag is empty!";
       error = true;
     }
+  }
+
+  // Nodes are added in insertion order on the calling thread, each one as soon as the files of
+  // all load infos up to its own were read. The remaining files are read meanwhile.
+  std::size_t numberOfSettledLoadInfos = 0;
+  std::size_t nextPosition = 0;
 
-    const char* dataUID = dataElement->Attribute("UID");
-    if (!error && dataUID != nullptr)
+  auto addSettledNodes = [&]()
+  {
+    for (; nextPosition < insertionOrder.size(); ++nextPosition)
     {
-      UIDManipulator manip(node->GetData());
-      manip.SetUID(dataUID);
+      const auto loadInfoIndex = loadInfoIndices[nextPosition];
+      if (loadInfoIndex != insertionOrder.size() && loadInfoIndex >= numberOfSettledLoadInfos)
+        break;
+
+      auto nodesIter = insertionOrder[nextPosition];
+      DataNode *node = nodesIter->first;
+      const auto i = elementIndexForNode[node];
+
+      if (loadInfoIndex != insertionOrder.size())
+      {
+        if (this->SetNodeData(node, dataElements[i], loadInfos[loadInfoIndex].m_Output, baseDataPropertyLists[i]))
+        {
+          this->DecorateNodeWithProperties(node, nodePropertyLists[i]);
+        }
+        else
+        {
+          MITK_ERROR << "Error during attempt to read '" << dataElements[i]->Attribute("file") << "'.";
+          error = true;
+        }
+      }
+
+      DataStorage::SetOfObjects::Pointer parents = DataStorage::SetOfObjects::New();
+      for (const auto &parentUID : nodesIter->second)
+      {
+        parents->push_back(m_NodeForID[parentUID]);
+      }
+
+      storage->Add(node, parents);
+      ProgressBar::GetInstance()->Progress();
+
+      // remove this node from m_OrderedNodePairs
+      m_OrderedNodePairs.erase(nodesIter);
     }
+  };
+
+  // errors are already reported by IOUtil, failed files have no output
+  if (!loadInfos.empty())
+  {
+    LoadedCallback loadedCallback([&](IOUtil::LoadInfo &loadInfo)
+    {
+      // load infos are reported in order, skipped ones before it could not be read
+      numberOfSettledLoadInfos = static_cast<std::size_t>(&loadInfo - loadInfos.data()) + 1;
+      addSettledNodes();
+    });
+
+    IOUtil::LoadConcurrently(loadInfos, nullptr, 0, &loadedCallback);
   }
 
-  // in case there was no <data> element we create a new empty node (for appending a propertylist later)
-  if (node.IsNull())
+  numberOfSettledLoadInfos = loadInfos.size();
+  addSettledNodes();
+
+  return !error;
+}
+
+bool mitk::SceneReaderV1::SetNodeData(DataNode *node,
+                                      const tinyxml2::XMLElement *dataElement,
+                                      const std::vector<BaseData::Pointer> &output,
+                                      PropertyList *baseDataProperties)
+{
+  if (output.empty() || output.front().IsNull())
+    return false;
+
+  node->SetData(output.front());
+
+  auto *baseData = node->GetData();
+
+  const char* dataUID = dataElement->Attribute("UID");
+  if (dataUID != nullptr)
+  {
+    UIDManipulator manip(baseData);
+    manip.SetUID(dataUID);
+  }
+
+  if (baseDataProperties != nullptr)
   {
-    node = DataNode::New();
+    baseData->SetPropertyList(baseDataProperties);
+    ApplyProportionalTimeGeometryProperties(baseData);
   }
 
-  return node;
+  return true;
 }
 
 void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, PropertyList &propertyList)
@@ -423,13 +448,11 @@ void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, Pr
   propertyList.ConcatenatePropertyList(propertiesToKeep);
 }
 
-bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
-                                                     const tinyxml2::XMLElement *nodeElement,
-                                                     const std::string &workingDirectory)
+mitk::SceneReaderV1::NodePropertyListsType mitk::SceneReaderV1::DeserializeNodeProperties(
+  const tinyxml2::XMLElement *nodeElement, const std::string &workingDirectory, bool &error)
 {
-  assert(node);
   assert(nodeElement);
-  bool error(false);
+  NodePropertyListsType propertyLists;
 
   for (auto *properties = nodeElement->FirstChildElement("properties"); properties != nullptr;
        properties = properties->NextSiblingElement("properties"))
@@ -440,21 +463,22 @@ bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
     const char *renderwindowa(properties->Attribute("renderwindow"));
     std::string renderwindow(renderwindowa ? renderwindowa : "");
 
-    PropertyList::Pointer propertyList =
-      node->GetPropertyList(renderwindow); // DataNode implementation always returns a propertylist
-    ClearNodePropertyListWithExceptions(*node, *propertyList);
-
     // use deserializer to construct new properties
     PropertyListDeserializer::Pointer deserializer = PropertyListDeserializer::New();
 
     deserializer->SetFilename(workingDirectory + Poco::Path::separator() + propertiesfile);
     bool success = deserializer->Deserialize();
-    error |= !success;
     PropertyList::Pointer readProperties = deserializer->GetOutput();
 
+    if (!success)
+    {
+      MITK_ERROR << "Could not load properties for node.";
+      error = true;
+    }
+
     if (readProperties.IsNotNull())
     {
-      propertyList->ConcatenatePropertyList(readProperties, true); // true = replace
+      propertyLists.emplace_back(renderwindow, readProperties);
     }
     else
     {
@@ -464,5 +488,19 @@ bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
     }
   }
 
-  return !error;
+  return propertyLists;
+}
+
+void mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node, const NodePropertyListsType &propertyLists)
+{
+  assert(node);
+
+  for (const auto &[renderwindow, readProperties] : propertyLists)
+  {
+    PropertyList::Pointer propertyList =
+      node->GetPropertyList(renderwindow); // DataNode implementation always returns a propertylist
+    ClearNodePropertyListWithExceptions(*node, *propertyList);
+
+    propertyList->ConcatenatePropertyList(readProperties, true); // true = replace
+  }
 }
@@ -35,18 +35,32 @@ namespace mitk
                              DataStorage *storage) override;
 
   protected:
+    typedef std::vector<std::pair<std::string, PropertyList::Pointer>> NodePropertyListsType;
+
+    /**
+      \brief assigns the data read for a \<data\> element to the node
+
+      The data files of all elements are read at once, independent files concurrently
+      (see IOUtil::LoadConcurrently()). LoadScene() calls this method and adds the node to
+      the data storage as soon as the files of the node and of all nodes inserted before were read.
+      Returns false if nothing was read; the node stays without data then (for appending a property list later).
+    */
+    bool SetNodeData(DataNode *node,
+                     const tinyxml2::XMLElement *dataElement,
+                     const std::vector<BaseData::Pointer> &output,
+                     PropertyList *baseDataProperties);
+
     /**
-      \brief tries to create one DataNode from a given XML \<node\> element
+      \brief reads all the properties of a node from the XML document (render window name and property list)
     */
-    DataNode::Pointer LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
-                                              const PropertyList *properties,
-                                              const std::string &workingDirectory,
-                                              bool &error);
+    NodePropertyListsType DeserializeNodeProperties(const tinyxml2::XMLElement *nodeElement,
+                                                    const std::string &workingDirectory,
+                                                    bool &error);
 
     /**
-      \brief reads all the properties from the XML document and recreates them in node
+      \brief recreates the deserialized properties in node
     */
-    bool DecorateNodeWithProperties(DataNode *node, const tinyxml2::XMLElement *nodeElement, const std::string &workingDirectory);
+    void DecorateNodeWithProperties(DataNode *node, const NodePropertyListsType &propertyLists);
 
     /**
       \brief Clear a default property list and handle some exceptions.
@@ -18,6 +18,7 @@ MITK_REGISTER_SERIALIZER(SurfaceSerializer)
 
 mitk::SurfaceSerializer::SurfaceSerializer()
 {
+  this->SetThreadSafe(true);
 }
 
 mitk::SurfaceSerializer::~SurfaceSerializer()
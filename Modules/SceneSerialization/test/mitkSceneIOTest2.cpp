@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
 
+#include <algorithm>
+
 /**
   \brief Test cases for SceneIO.
 
@@ -78,6 +80,7 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_IncrementalSaving);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +128,65 @@ public:
     }
   }
 
+  void Test_IncrementalSaving()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    mitk::SceneIOTestScenarioProvider::ScenarioList scenarios = m_TestCaseProvider.GetAllScenarios();
+    for (const auto& scenario : scenarios)
+    {
+      if (!scenario.serializable)
+        continue;
+
+      MITK_TEST_OUTPUT(<< "\n===== Test_IncrementalSaving, scenario '" << scenario.key << "' =====");
+
+      std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+      mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+      writer->IncrementalSavingOn();
+      writer->CompressionEnabledOff();
+      mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+
+      auto nodes = originalStorage->GetAll();
+      auto countNodesWithDataOtherThan = [&nodes](const mitk::BaseData *excludedData) {
+        return std::count_if(nodes->begin(), nodes->end(), [excludedData](const mitk::DataNode::Pointer &node) {
+          return nullptr != node->GetData() && excludedData != node->GetData();
+        });
+      };
+
+      // the first save writes all data, the second one reuses all of it
+      CPPUNIT_ASSERT(writer->SaveScene(nodes, originalStorage, archiveFilename));
+      CPPUNIT_ASSERT_EQUAL(std::size_t(0), std::size_t(writer->GetReusedNodes()->size()));
+
+      CPPUNIT_ASSERT(writer->SaveScene(nodes, originalStorage, archiveFilename));
+      CPPUNIT_ASSERT_EQUAL(std::size_t(countNodesWithDataOtherThan(nullptr)),
+                           std::size_t(writer->GetReusedNodes()->size()));
+
+      // the third save rewrites the modified data only
+      mitk::BaseData *modifiedData = nodes->empty() ? nullptr : nodes->front()->GetData();
+      if (nullptr != modifiedData)
+        modifiedData->Modified();
+
+      CPPUNIT_ASSERT(writer->SaveScene(nodes, originalStorage, archiveFilename));
+      CPPUNIT_ASSERT_EQUAL(std::size_t(countNodesWithDataOtherThan(modifiedData)),
+                           std::size_t(writer->GetReusedNodes()->size()));
+
+      for (const auto &reusedNode : *writer->GetReusedNodes())
+        CPPUNIT_ASSERT_MESSAGE("Modified data was reused", modifiedData != reusedNode->GetData());
+
+      mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+      mitk::DataStorage::Pointer restoredStorage;
+      CPPUNIT_ASSERT_NO_THROW(restoredStorage = reader->LoadScene(archiveFilename));
+      CPPUNIT_ASSERT_MESSAGE(
+        std::string("Comparing incrementally saved test scenario '") + scenario.key + "'",
+        mitk::DataStorageCompare(originalStorage,
+                                 restoredStorage,
+                                 mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+                                   mitk::DataStorageCompare::CMP_Properties,
+                                 scenario.comparisonPrecision)
+          .CompareVerbose());
+    }
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -53,15 +53,31 @@ namespace mitk
       */
     virtual std::string Serialize();
 
+    /**
+      \brief Indicates if Serialize() may run concurrently with serializers of other data.
+
+      mitk::SceneIO runs thread-safe serializers on several threads, all others one after
+      another on the calling thread. The default is \c false, see SetThreadSafe().
+      */
+    bool IsThreadSafe() const;
+
   protected:
     BaseDataSerializer();
     ~BaseDataSerializer() override;
 
     std::string GetUniqueFilenameInWorkingDirectory();
 
+    /** Derived serializers whose Serialize() (including the used file writers) was verified
+      to run concurrently declare this in their constructor. The scene is saved with the "C"
+      locale, so writers that only switch to this locale do not change it.*/
+    void SetThreadSafe(bool threadSafe);
+
     std::string m_FilenameHint;
     std::string m_WorkingDirectory;
     BaseData::ConstPointer m_Data;
+
+  private:
+    bool m_ThreadSafe;
   };
 
 } // namespace
@@ -14,7 +14,9 @@ found in the LICENSE file.
 #include "mitkStandardFileLocations.h"
 #include <itksys/SystemTools.hxx>
 
-mitk::BaseDataSerializer::BaseDataSerializer() : m_FilenameHint("unnamed"), m_WorkingDirectory("")
+#include <atomic>
+
+mitk::BaseDataSerializer::BaseDataSerializer() : m_FilenameHint("unnamed"), m_WorkingDirectory(""), m_ThreadSafe(false)
 {
 }
 
@@ -30,10 +32,20 @@ std::string mitk::BaseDataSerializer::Serialize()
   return "";
 }
 
+bool mitk::BaseDataSerializer::IsThreadSafe() const
+{
+  return m_ThreadSafe;
+}
+
+void mitk::BaseDataSerializer::SetThreadSafe(bool threadSafe)
+{
+  m_ThreadSafe = threadSafe;
+}
+
 std::string mitk::BaseDataSerializer::GetUniqueFilenameInWorkingDirectory()
 {
-  // tmpname
-  static unsigned long count = 0;
+  // tmpname, serializers may run concurrently
+  static std::atomic<unsigned long> count(0);
   unsigned long n = count++;
   std::ostringstream name;
   for (int i = 0; i < 6; ++i)
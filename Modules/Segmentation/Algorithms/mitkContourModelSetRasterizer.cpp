@@ -0,0 +1,220 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkContourModelSetRasterizer.h"
+
+#include <mitkContourModelUtils.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace
+{
+  /** The two in-plane axes of a slice orthogonal to sliceDimension, the lower one first.*/
+  std::array<unsigned int, 2> GetInPlaneAxes(unsigned int sliceDimension)
+  {
+    return { { sliceDimension == 0 ? 1u : 0u, sliceDimension == 2 ? 1u : 2u } };
+  }
+}
+
+void mitk::ContourModelSetRasterizer::Initialize(const BaseGeometry* geometry, const ContourModelSet* contourSet)
+{
+  if (nullptr == geometry)
+    mitkThrow() << "Cannot initialize ContourModelSetRasterizer. Passed geometry is nullptr.";
+
+  if (nullptr == contourSet)
+    mitkThrow() << "Cannot initialize ContourModelSetRasterizer. Passed contour set is nullptr.";
+
+  m_Slices.clear();
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    m_LargestPossibleRegion.SetIndex(dim, 0);
+    m_LargestPossibleRegion.SetSize(dim, static_cast<itk::SizeValueType>(std::round(geometry->GetExtent(dim))));
+  }
+
+  std::map<std::pair<unsigned int, itk::IndexValueType>, std::size_t> sliceIDs;
+
+  // ContourModelSet offers no const iteration
+  auto nonConstContourSet = const_cast<ContourModelSet*>(contourSet);
+
+  for (auto it = nonConstContourSet->Begin(); it != nonConstContourSet->End(); ++it)
+  {
+    const ContourModel* contour = it->GetPointer();
+
+    if (nullptr == contour || contour->IsEmptyTimeStep(0))
+      continue;
+
+    std::vector<Point3D> indexPoints;
+    indexPoints.reserve(contour->GetNumberOfVertices(0));
+
+    Point3D minIndex;
+    Point3D maxIndex;
+    minIndex.Fill(std::numeric_limits<ScalarType>::max());
+    maxIndex.Fill(std::numeric_limits<ScalarType>::lowest());
+
+    for (auto vertexIt = contour->Begin(0); vertexIt != contour->End(0); ++vertexIt)
+    {
+      Point3D indexPoint;
+      geometry->WorldToIndex((*vertexIt)->Coordinates, indexPoint);
+      indexPoints.push_back(indexPoint);
+
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        minIndex[dim] = std::min(minIndex[dim], indexPoint[dim]);
+        maxIndex[dim] = std::max(maxIndex[dim], indexPoint[dim]);
+      }
+    }
+
+    // the slice dimension is the axis along which the contour does not extend
+    unsigned int sliceDimension = 0;
+    for (unsigned int dim = 1; dim < 3; ++dim)
+    {
+      if (maxIndex[dim] - minIndex[dim] < maxIndex[sliceDimension] - minIndex[sliceDimension])
+        sliceDimension = dim;
+    }
+
+    if (maxIndex[sliceDimension] - minIndex[sliceDimension] >= 0.5)
+      mitkThrow() << "Cannot detect correct slice number! Only axial, sagittal and coronal oriented contours are supported!";
+
+    const auto sliceIndex = static_cast<itk::IndexValueType>(std::round(0.5 * (minIndex[sliceDimension] + maxIndex[sliceDimension])));
+
+    if (sliceIndex < 0 || sliceIndex >= static_cast<itk::IndexValueType>(m_LargestPossibleRegion.GetSize(sliceDimension)))
+    {
+      MITK_WARN << "Ignoring contour outside of the image (slice " << sliceIndex << " in dimension " << sliceDimension << ").";
+      continue;
+    }
+
+    auto [sliceIter, inserted] = sliceIDs.emplace(std::make_pair(sliceDimension, sliceIndex), m_Slices.size());
+    if (inserted)
+    {
+      SliceContours slice;
+      slice.SliceDimension = sliceDimension;
+      slice.SliceIndex = sliceIndex;
+      m_Slices.push_back(slice);
+    }
+
+    const auto axes = GetInPlaneAxes(sliceDimension);
+    PolygonType polygon;
+    polygon.reserve(indexPoints.size());
+
+    for (const auto& indexPoint : indexPoints)
+      polygon.push_back({ { indexPoint[axes[0]], indexPoint[axes[1]] } });
+
+    m_Slices[sliceIter->second].Polygons.push_back(std::move(polygon));
+  }
+
+  this->Modified();
+}
+
+mitk::ContourModelSetRasterizer::RegionType mitk::ContourModelSetRasterizer::GetLargestPossibleRegion() const
+{
+  return m_LargestPossibleRegion;
+}
+
+std::size_t mitk::ContourModelSetRasterizer::GetNumberOfSlices() const
+{
+  return m_Slices.size();
+}
+
+void mitk::ContourModelSetRasterizer::RasterizeRegion(const RegionType& region, const SliceMaskCallbackType& callback) const
+{
+  // Slices of different orientations can overlap, so only slices of one orientation are processed concurrently.
+  for (unsigned int sliceDimension = 0; sliceDimension < 3; ++sliceDimension)
+  {
+    std::vector<const SliceContours*> relevantSlices;
+
+    for (const auto& slice : m_Slices)
+    {
+      if (slice.SliceDimension == sliceDimension
+        && slice.SliceIndex >= region.GetIndex(sliceDimension)
+        && slice.SliceIndex < region.GetIndex(sliceDimension) + static_cast<itk::IndexValueType>(region.GetSize(sliceDimension)))
+      {
+        relevantSlices.push_back(&slice);
+      }
+    }
+
+    if (relevantSlices.empty())
+      continue;
+
+    auto rasterize = [&](itk::SizeValueType i)
+    {
+      auto mask = this->RasterizeSlice(*(relevantSlices[i]), region);
+
+      if (!mask.Inside.empty())
+        callback(mask);
+    };
+
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(0, relevantSlices.size(), rasterize, nullptr);
+  }
+}
+
+mitk::ContourModelSetRasterizer::SliceMask mitk::ContourModelSetRasterizer::RasterizeSlice(const SliceContours& slice, const RegionType& region) const
+{
+  const auto axes = GetInPlaneAxes(slice.SliceDimension);
+
+  SliceMask mask;
+  mask.SliceDimension = slice.SliceDimension;
+  mask.Region = region;
+  mask.Region.SetIndex(slice.SliceDimension, slice.SliceIndex);
+  mask.Region.SetSize(slice.SliceDimension, 1);
+
+  // The mask only covers the in-plane extent of the region; contours are shifted accordingly.
+  unsigned int dimensions[3] = { static_cast<unsigned int>(region.GetSize(axes[0])), static_cast<unsigned int>(region.GetSize(axes[1])), 1 };
+  const auto numberOfPixels = static_cast<std::size_t>(dimensions[0]) * dimensions[1];
+
+  if (0 == numberOfPixels)
+    return mask;
+
+  auto maskImage = Image::New();
+  maskImage->Initialize(MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+  {
+    ImageWriteAccessor accessor(maskImage);
+    std::memset(accessor.GetData(), 0, numberOfPixels);
+  }
+
+  for (const auto& polygon : slice.Polygons)
+  {
+    auto contour = ContourModel::New();
+
+    for (const auto& point : polygon)
+    {
+      Point3D shiftedPoint;
+      shiftedPoint[0] = point[0] - region.GetIndex(axes[0]);
+      shiftedPoint[1] = point[1] - region.GetIndex(axes[1]);
+      shiftedPoint[2] = 0.0;
+      contour->AddVertex(shiftedPoint);
+    }
+
+    contour->Close();
+    ContourModelUtils::FillContourInSlice2(contour, 0, maskImage, 1);
+  }
+
+  ImageReadAccessor accessor(maskImage);
+  auto data = static_cast<const unsigned char*>(accessor.GetData());
+
+  if (std::none_of(data, data + numberOfPixels, [](unsigned char value) { return 0 != value; }))
+    return mask;
+
+  mask.Inside.assign(data, data + numberOfPixels);
+  return mask;
+}
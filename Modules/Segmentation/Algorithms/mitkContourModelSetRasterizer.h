@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkContourModelSetRasterizer_h
+#define mitkContourModelSetRasterizer_h
+
+#include <MitkSegmentationExports.h>
+
+#include <mitkBaseGeometry.h>
+#include <mitkContourModelSet.h>
+
+#include <itkImageRegion.h>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /** @brief Rasterizes the contours of a mitk::ContourModelSet into arbitrary regions of an image grid.
+  *
+  * Initialize() assigns every contour to the axis-aligned slice of the image grid it lies in and keeps
+  * the contours in index coordinates of that slice. Afterwards any region of the grid (e.g. one slab)
+  * can be filled without the rest of the volume being present. All slices of one orientation that
+  * intersect the region are rasterized in parallel.
+  *
+  * Contours that lie in the same slice are united. Only contours that are parallel to one of the
+  * image axes are supported.
+  */
+  class MITKSEGMENTATION_EXPORT ContourModelSetRasterizer : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(ContourModelSetRasterizer, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using RegionType = itk::ImageRegion<3>;
+
+    /** Rasterized part of one slice. Region has the size 1 in SliceDimension; the voxels of Inside
+    * are stored in the order of Region (lower axis running fastest).*/
+    struct SliceMask
+    {
+      unsigned int SliceDimension = 2;
+      RegionType Region;
+      std::vector<unsigned char> Inside;
+    };
+
+    /** Callback that is called for every rasterized slice. It is called concurrently for different
+    * slices of the same orientation, which never overlap.*/
+    using SliceMaskCallbackType = std::function<void(const SliceMask&)>;
+
+    /** @brief Assigns the contours (time step 0) of contourSet to the slices of the image grid defined by geometry.
+    * Contours whose slice lies outside of the grid are ignored.
+    * @pre geometry and contourSet must not be nullptr.
+    * @remark Throws an exception if a contour is not parallel to one of the image axes.*/
+    void Initialize(const BaseGeometry* geometry, const ContourModelSet* contourSet);
+
+    /** Size of the image grid passed to Initialize().*/
+    RegionType GetLargestPossibleRegion() const;
+
+    /** Number of slices that contain at least one contour.*/
+    std::size_t GetNumberOfSlices() const;
+
+    /** @brief Rasterizes the contours within region and passes the result slice by slice to callback.
+    * Slices without any filled voxel within region are not passed.*/
+    void RasterizeRegion(const RegionType& region, const SliceMaskCallbackType& callback) const;
+
+    /** @brief Sets all voxels of region that are inside of a contour to value.
+    * @param buffer Voxels of bufferRegion (x running fastest).
+    * @param bufferRegion Region of the image grid that is covered by buffer.
+    * @param value Value that is written into the voxels inside of contours.*/
+    template <typename TPixel>
+    void FillRegion(TPixel* buffer, const RegionType& bufferRegion, TPixel value) const
+    {
+      this->RasterizeRegion(bufferRegion, [&](const SliceMask& mask)
+      {
+        const auto& maskRegion = mask.Region;
+        auto inside = mask.Inside.data();
+
+        for (itk::SizeValueType z = 0; z < maskRegion.GetSize(2); ++z)
+        {
+          for (itk::SizeValueType y = 0; y < maskRegion.GetSize(1); ++y)
+          {
+            auto bufferRow = buffer + bufferRegion.ComputeOffset({ { maskRegion.GetIndex(0), maskRegion.GetIndex(1) + static_cast<itk::IndexValueType>(y), maskRegion.GetIndex(2) + static_cast<itk::IndexValueType>(z) } });
+
+            for (itk::SizeValueType x = 0; x < maskRegion.GetSize(0); ++x, ++inside)
+            {
+              if (0 != *inside)
+                bufferRow[x] = value;
+            }
+          }
+        }
+      });
+    }
+
+  protected:
+    ContourModelSetRasterizer() = default;
+    ~ContourModelSetRasterizer() override = default;
+
+    using PolygonType = std::vector<std::array<double, 2>>;
+
+    /** All contours of one slice, in index coordinates of the two in-plane axes.*/
+    struct SliceContours
+    {
+      unsigned int SliceDimension = 2;
+      itk::IndexValueType SliceIndex = 0;
+      std::vector<PolygonType> Polygons;
+    };
+
+    SliceMask RasterizeSlice(const SliceContours& slice, const RegionType& region) const;
+
+    RegionType m_LargestPossibleRegion;
+    std::vector<SliceContours> m_Slices;
+  };
+}
+
+#endif
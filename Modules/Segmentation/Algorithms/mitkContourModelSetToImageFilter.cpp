@@ -13,13 +13,12 @@ found in the LICENSE file.
 #include "mitkContourModelSetToImageFilter.h"
 
 #include <mitkContourModelSet.h>
-#include <mitkContourModelUtils.h>
-#include <mitkExtractSliceFilter.h>
+#include <mitkContourModelSetRasterizer.h>
 #include <mitkImageWriteAccessor.h>
+#include <mitkPixelTypeMultiplex.h>
 #include <mitkProgressBar.h>
 #include <mitkTimeHelper.h>
 #include <mitkLabel.h>
-#include <mitkVtkImageOverwrite.h>
 
 mitk::ContourModelSetToImageFilter::ContourModelSetToImageFilter()
   : m_MakeOutputBinary(true),
@@ -141,10 +140,26 @@ const mitk::Image *mitk::ContourModelSetToImageFilter::GetImage(void)
   return m_ReferenceImage;
 }
 
+namespace
+{
+  template <typename TPixel>
+  void FillContoursIntoVolume(const mitk::PixelType&, mitk::Image* image, mitk::TimeStepType timeStep,
+    const mitk::ContourModelSetRasterizer* rasterizer, int paintingPixelValue)
+  {
+    mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(timeStep));
+    rasterizer->FillRegion(static_cast<TPixel*>(accessor.GetData()), rasterizer->GetLargestPossibleRegion(), static_cast<TPixel>(paintingPixelValue));
+  }
+}
+
 void mitk::ContourModelSetToImageFilter::GenerateData()
 {
   auto *contourSet = const_cast<mitk::ContourModelSet *>(this->GetInput());
 
+  if (nullptr == contourSet || contourSet->GetContourModelList()->size() == 0)
+  {
+    mitkThrow() << "No contours specified!";
+  }
+
   // Initializing progressbar
   unsigned int num_contours = contourSet->GetContourModelList()->size();
   mitk::ProgressBar::GetInstance()->AddStepsToDo(num_contours);
@@ -159,115 +174,16 @@ void mitk::ContourModelSetToImageFilter::GenerateData()
     mitkThrow() << "Error creating output for specified image!";
   }
 
-  if (!contourSet || contourSet->GetContourModelList()->size() == 0)
-  {
-    mitkThrow() << "No contours specified!";
-  }
-
-  mitk::BaseGeometry *outputImageGeo = outputImage->GetGeometry(m_TimeStep);
-
-  // Create mitkVtkImageOverwrite which is needed to write the slice back into the volume
-  vtkSmartPointer<mitkVtkImageOverwrite> reslice = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-  // Create ExtractSliceFilter for extracting the corresponding slices from the volume
-  mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslice);
-  extractor->SetInput(outputImage);
-  extractor->SetTimeStep(m_TimeStep);
-  extractor->SetResliceTransformByGeometry(outputImageGeo);
-
-  // Fill each contour of the contourmodelset into the image
-  auto it = contourSet->Begin();
-  auto end = contourSet->End();
-  while (it != end)
-  {
-    mitk::ContourModel *contour = it->GetPointer();
-
-    // 1. Create slice geometry using the contour points
-    mitk::PlaneGeometry::Pointer plane = mitk::PlaneGeometry::New();
-    mitk::Point3D point3D, tempPoint;
-    mitk::Vector3D normal;
-
-    mitk::Image::Pointer slice;
-
-    int sliceIndex;
-    bool isFrontside = true;
-    bool isRotated = false;
+  // Group the contours by slice and fill all slices directly into the output volume
+  auto rasterizer = mitk::ContourModelSetRasterizer::New();
+  rasterizer->Initialize(outputImage->GetGeometry(m_TimeStep), contourSet);
 
-    // Determine plane orientation
-    point3D = contour->GetVertexAt(0)->Coordinates;
-    tempPoint = contour->GetVertexAt(contour->GetNumberOfVertices() * 0.25)->Coordinates;
-    mitk::Vector3D vec = point3D - tempPoint;
-    vec.Normalize();
-    outputImageGeo->WorldToIndex(point3D, point3D);
+  mitkPixelTypeMultiplex4(FillContoursIntoVolume, outputImage->GetPixelType(), outputImage, m_TimeStep, rasterizer, m_PaintingPixelValue);
 
-    mitk::AnatomicalPlane orientation;
-    if (mitk::Equal(vec[0], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Sagittal;
-      sliceIndex = point3D[0];
-    }
-    else if (mitk::Equal(vec[1], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Coronal;
-      sliceIndex = point3D[1];
-    }
-    else if (mitk::Equal(vec[2], 0))
-    {
-      orientation = mitk::AnatomicalPlane::Axial;
-      sliceIndex = point3D[2];
-    }
-    else
-    {
-      // TODO Maybe rotate geometry to extract slice?
-      MITK_ERROR
-        << "Cannot detect correct slice number! Only axial, sagittal and coronal oriented contours are supported!";
-      return;
-    }
-
-    // Initialize plane using the detected orientation
-    plane->InitializeStandardPlane(outputImageGeo, orientation, sliceIndex, isFrontside, isRotated);
-    point3D = plane->GetOrigin();
-    normal = plane->GetNormal();
-    normal.Normalize();
-    point3D += normal * 0.5; // pixelspacing is 1, so half the spacing is 0.5
-    plane->SetOrigin(point3D);
-
-    // 2. Extract slice at the given position
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(false);
-    reslice->SetOverwriteMode(false);
-
-    extractor->Modified();
-    extractor->Update();
-
-    slice = extractor->GetOutput();
-    slice->DisconnectPipeline();
-
-    // 3. Fill contour into slice
-    mitk::ContourModel::Pointer projectedContour =
-      mitk::ContourModelUtils::ProjectContourTo2DSlice(slice, contour);
-    mitk::ContourModelUtils::FillContourInSlice(projectedContour, 0, slice, m_PaintingPixelValue);
-
-    // 4. Write slice back into image volume
-    reslice->SetInputSlice(slice->GetVtkImageData());
-
-    // set overwrite mode to true to write back to the image volume
-    reslice->SetOverwriteMode(true);
-    reslice->Modified();
-
-    extractor->Modified();
-    extractor->Update();
-
-    reslice->SetInputSlice(nullptr);
-
-    // Progress
-    mitk::ProgressBar::GetInstance()->Progress();
-
-    ++it;
-  }
+  // Progress
+  mitk::ProgressBar::GetInstance()->Progress(num_contours);
 
   outputImage->Modified();
-  outputImage->GetVtkImageData()->Modified();
 }
 
 void mitk::ContourModelSetToImageFilter::InitializeOutputEmpty()
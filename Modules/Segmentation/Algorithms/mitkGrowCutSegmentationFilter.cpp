@@ -18,11 +18,22 @@ found in the LICENSE file.
 #include "mitkImageCast.h"
 #include "mitkGrowCutSegmentationFilter.h"
 
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkImageRegionIterator.h>
+#include <itkProgressAccumulator.h>
+#include <itkRegionOfInterestImageFilter.h>
+
+#include <algorithm>
+
 template <typename TPixel, unsigned int VImageDimension>
 void AccessItkGrowCutFilter(const itk::Image<TPixel, VImageDimension> *inputImage,
                             const itk::Image<mitk::Label::PixelType, VImageDimension> *seedImage,
+                            const itk::ImageRegion<VImageDimension> &region,
                             const double distancePenalty,
-                            mitk::Image::Pointer output)
+                            itk::ProcessObject *miniPipelineFilter,
+                            typename itk::Image<mitk::Label::PixelType, VImageDimension>::Pointer &result,
+                            itk::ImageRegion<VImageDimension> &resultRegion)
 {
   using ImageType = itk::Image<TPixel, VImageDimension>;
   using LabelType = itk::Image<mitk::Label::PixelType, VImageDimension>;
@@ -30,31 +41,173 @@ void AccessItkGrowCutFilter(const itk::Image<TPixel, VImageDimension> *inputImag
   using FGCType = itk::FastGrowCut<ImageType, LabelType>;
   typename FGCType::Pointer fgcFilter = FGCType::New();
 
-  fgcFilter->SetInput(inputImage);
-  fgcFilter->SetSeedImage(seedImage);
+  const bool useRegion = region != inputImage->GetLargestPossibleRegion();
+
+  if (useRegion)
+  {
+    // only the region around the seeds is segmented
+    using InputROIFilterType = itk::RegionOfInterestImageFilter<ImageType, ImageType>;
+    auto inputROIFilter = InputROIFilterType::New();
+    inputROIFilter->SetInput(inputImage);
+    inputROIFilter->SetRegionOfInterest(region);
+
+    using SeedROIFilterType = itk::RegionOfInterestImageFilter<LabelType, LabelType>;
+    auto seedROIFilter = SeedROIFilterType::New();
+    seedROIFilter->SetInput(seedImage);
+    seedROIFilter->SetRegionOfInterest(region);
+
+    fgcFilter->SetInput(inputROIFilter->GetOutput());
+    fgcFilter->SetSeedImage(seedROIFilter->GetOutput());
+  }
+  else
+  {
+    fgcFilter->SetInput(inputImage);
+    fgcFilter->SetSeedImage(seedImage);
+  }
+
   fgcFilter->SetDistancePenalty(distancePenalty);
 
+  // forwards progress to observers of the mitk filter and passes abort requests to the growcut
+  auto progress = itk::ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(miniPipelineFilter);
+  progress->RegisterInternalFilter(fgcFilter, 1.0f);
+
   try
   {
     fgcFilter->Update();
   }
+  catch (const itk::ProcessAborted &)
+  {
+    throw;
+  }
   catch (...)
   {
     mitkThrow() << "An error occurred while using the itkFastGrowCut filter Update()-Method.";
   }
 
-  mitk::CastToMitkImage<LabelType>(fgcFilter->GetOutput(), output);
-  return;
+  if (!useRegion)
+  {
+    result = fgcFilter->GetOutput();
+    result->DisconnectPipeline();
+    resultRegion = region;
+    return;
+  }
+
+  // paste the result of the region into an unlabeled image of the full input size. The result image of the
+  // previous computation is reused, only the region written by that computation has to be reset.
+  if (result.IsNull() || result->GetLargestPossibleRegion() != inputImage->GetLargestPossibleRegion())
+  {
+    result = LabelType::New();
+    result->CopyInformation(inputImage);
+    result->SetRegions(inputImage->GetLargestPossibleRegion());
+    result->Allocate();
+    result->FillBuffer(mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+  }
+  else
+  {
+    result->CopyInformation(inputImage);
+
+    itk::ImageRegionIterator<LabelType> resetIter(result, resultRegion);
+    for (; !resetIter.IsAtEnd(); ++resetIter)
+    {
+      resetIter.Set(mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+    }
+  }
+
+  auto regionResult = fgcFilter->GetOutput();
+  itk::ImageRegionConstIterator<LabelType> sourceIter(regionResult, regionResult->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<LabelType> targetIter(result, region);
+
+  for (; !sourceIter.IsAtEnd(); ++sourceIter, ++targetIter)
+  {
+    targetIter.Set(sourceIter.Get());
+  }
+
+  resultRegion = region;
 }
 
 namespace mitk
 {
-  GrowCutSegmentationFilter::GrowCutSegmentationFilter() : m_DistancePenalty(0)
+  GrowCutSegmentationFilter::GrowCutSegmentationFilter()
+    : m_DistancePenalty(0), m_SeedRegionMargin(20), m_UseSeedRegion(false)
   {
   }
 
   GrowCutSegmentationFilter::~GrowCutSegmentationFilter() {}
 
+  void GrowCutSegmentationFilter::ResetSession()
+  {
+    m_SessionInput = nullptr;
+    m_SessionInputMTime = 0;
+    m_SessionSeedImage = nullptr;
+    m_SessionSeedMTime = 0;
+    m_SessionResult = nullptr;
+    m_SessionResultRegion = SeedImageType::RegionType();
+  }
+
+  GrowCutSegmentationFilter::SeedImageType::RegionType GrowCutSegmentationFilter::ComputeSeedRegion() const
+  {
+    const auto largestRegion = m_itkSeedImage->GetLargestPossibleRegion();
+
+    if (!m_UseSeedRegion)
+      return largestRegion;
+
+    SeedImageType::IndexType minIndex = largestRegion.GetUpperIndex();
+    SeedImageType::IndexType maxIndex = largestRegion.GetIndex();
+    bool foundSeed = false;
+
+    if (m_SeedBoundingRegion.GetNumberOfPixels() > 0)
+    {
+      // the caller keeps track of the seeds, no need to scan the seed image
+      minIndex = m_SeedBoundingRegion.GetIndex();
+      maxIndex = m_SeedBoundingRegion.GetUpperIndex();
+      foundSeed = true;
+    }
+    else
+    {
+      itk::ImageRegionConstIteratorWithIndex<SeedImageType> iter(m_itkSeedImage, largestRegion);
+      for (; !iter.IsAtEnd(); ++iter)
+      {
+        if (MultiLabelSegmentation::UNLABELED_VALUE == iter.Get())
+          continue;
+
+        const auto& index = iter.GetIndex();
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          minIndex[dim] = std::min(minIndex[dim], index[dim]);
+          maxIndex[dim] = std::max(maxIndex[dim], index[dim]);
+        }
+        foundSeed = true;
+      }
+    }
+
+    if (!foundSeed)
+      return largestRegion;
+
+    const auto margin = static_cast<itk::IndexValueType>(m_SeedRegionMargin);
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minIndex[dim] = std::max(minIndex[dim] - margin, largestRegion.GetIndex(dim));
+      maxIndex[dim] = std::min(maxIndex[dim] + margin, largestRegion.GetUpperIndex()[dim]);
+    }
+
+    SeedImageType::RegionType region;
+    region.SetIndex(minIndex);
+    region.SetUpperIndex(maxIndex);
+    return region;
+  }
+
+  bool GrowCutSegmentationFilter::IsSessionUpToDate(const Image* input) const
+  {
+    if (m_SessionResult.IsNull() || input != m_SessionInput || input->GetMTime() != m_SessionInputMTime ||
+        m_DistancePenalty != m_SessionDistancePenalty || m_UseSeedRegion != m_SessionUsedSeedRegion ||
+        m_SeedRegionMargin != m_SessionSeedRegionMargin || m_SeedBoundingRegion != m_SessionSeedBoundingRegion)
+      return false;
+
+    return m_itkSeedImage.GetPointer() == m_SessionSeedImage.GetPointer() &&
+           m_itkSeedImage->GetMTime() == m_SessionSeedMTime;
+  }
+
   void GrowCutSegmentationFilter::GenerateData()
   {
     if (nullptr == m_itkSeedImage)
@@ -64,11 +217,31 @@ namespace mitk
 
     mitk::Image::ConstPointer mitkInputImage = GetInput();
 
-    AccessFixedDimensionByItk_n(mitkInputImage,
-                                AccessItkGrowCutFilter,
-                                3,
-                                (m_itkSeedImage.GetPointer(),
-                                 m_DistancePenalty,
-                                 this->GetOutput()));
+    if (!this->IsSessionUpToDate(mitkInputImage))
+    {
+      const auto region = this->ComputeSeedRegion();
+
+      AccessFixedDimensionByItk_n(mitkInputImage,
+                                  AccessItkGrowCutFilter,
+                                  3,
+                                  (m_itkSeedImage.GetPointer(),
+                                   region,
+                                   m_DistancePenalty,
+                                   this,
+                                   m_SessionResult,
+                                   m_SessionResultRegion));
+
+      m_SessionSeedImage = m_itkSeedImage;
+      m_SessionSeedMTime = m_itkSeedImage->GetMTime();
+      m_SessionSeedBoundingRegion = m_SeedBoundingRegion;
+      m_SessionInput = mitkInputImage;
+      m_SessionInputMTime = mitkInputImage->GetMTime();
+      m_SessionDistancePenalty = m_DistancePenalty;
+      m_SessionUsedSeedRegion = m_UseSeedRegion;
+      m_SessionSeedRegionMargin = m_SeedRegionMargin;
+    }
+
+    mitk::Image::Pointer output = this->GetOutput();
+    mitk::CastToMitkImage(m_SessionResult, output);
   }
 } // namespace mitk
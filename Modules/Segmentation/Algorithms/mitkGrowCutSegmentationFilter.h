@@ -28,6 +28,16 @@ namespace mitk
     given seedimage.
     Internally, itk::FastGrowCut is used.
 
+    Optionally (see SetUseSeedRegion()) the segmentation is restricted to the bounding box of all seeds,
+    dilated by SeedRegionMargin voxels. Voxels outside of this region stay unlabeled, so the restriction
+    only suits structures that do not extend further than the margin beyond the seeds. Callers that keep
+    track of the seeds can pass their bounding box (see SetSeedBoundingRegion()) to avoid a scan of the seed image.
+
+    The filter can be kept alive over several updates of an interactive session (e.g. by mitk::GrowCutTool).
+    It remembers input, seed image (identity and modification time) and settings of the last computation and
+    reuses its result if the next update is triggered with identical settings. The result image is also reused
+    by the next computation; only the region written before is reset. Call ResetSession() to drop the cached state.
+
     $Author: Jan Sahrhage
   */
   class MITKSEGMENTATION_EXPORT GrowCutSegmentationFilter : public ImageToImageFilter
@@ -37,18 +47,69 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
-    void SetSeedImage(itk::Image<mitk::Label::PixelType, 3>::Pointer itkSeedImage) { m_itkSeedImage = itkSeedImage; }
+    using SeedImageType = itk::Image<mitk::Label::PixelType, 3>;
+
+    void SetSeedImage(SeedImageType::Pointer itkSeedImage)
+    {
+      m_itkSeedImage = itkSeedImage;
+      this->Modified();
+    }
+
+    itkSetMacro(DistancePenalty, double);
+    itkGetConstMacro(DistancePenalty, double);
+
+    /** Number of voxels the bounding box of the seeds is dilated by in each direction to get the
+    region the growcut is computed in. Default is 20.*/
+    itkSetMacro(SeedRegionMargin, unsigned int);
+    itkGetConstMacro(SeedRegionMargin, unsigned int);
 
-    void SetDistancePenalty(double distancePenalty) { m_DistancePenalty = distancePenalty; }
+    /** If set to true, the growcut is only computed in the bounding box of the seeds dilated by the
+    seed region margin. Otherwise the growcut is computed on the whole input image. Default is false.*/
+    itkSetMacro(UseSeedRegion, bool);
+    itkGetConstMacro(UseSeedRegion, bool);
+    itkBooleanMacro(UseSeedRegion);
+
+    /** Bounding box (index coordinates) of all seeds, if it is known by the caller (e.g. from
+    MultiLabelSegmentation::GetLabelBoundingRegion()). If the region is empty (default), the bounding box
+    is determined by scanning the seed image.*/
+    itkSetMacro(SeedBoundingRegion, SeedImageType::RegionType);
+    itkGetConstReferenceMacro(SeedBoundingRegion, SeedImageType::RegionType);
+
+    /** Drops the cached state of the last computation.*/
+    void ResetSession();
 
   protected:
     GrowCutSegmentationFilter();
     ~GrowCutSegmentationFilter() override;
     void GenerateData() override;
 
+    /** Returns the bounding box of all seeds dilated by the seed region margin and cropped to the image.
+    The seed image is only scanned if no seed bounding region was set.
+    If no seeds exist, the largest possible region of the seed image is returned.*/
+    SeedImageType::RegionType ComputeSeedRegion() const;
+
+    /** Checks if input, seed image and settings are identical to the last computation.*/
+    bool IsSessionUpToDate(const Image* input) const;
+
   private:
-    itk::Image<mitk::Label::PixelType, 3>::Pointer m_itkSeedImage = nullptr;
+    SeedImageType::Pointer m_itkSeedImage = nullptr;
     double m_DistancePenalty;
+    unsigned int m_SeedRegionMargin;
+    bool m_UseSeedRegion;
+    SeedImageType::RegionType m_SeedBoundingRegion;
+
+    // state of the last computation
+    const Image* m_SessionInput = nullptr;
+    itk::ModifiedTimeType m_SessionInputMTime = 0;
+    double m_SessionDistancePenalty = 0.0;
+    bool m_SessionUsedSeedRegion = false;
+    unsigned int m_SessionSeedRegionMargin = 0;
+    SeedImageType::ConstPointer m_SessionSeedImage;
+    itk::ModifiedTimeType m_SessionSeedMTime = 0;
+    SeedImageType::RegionType m_SessionSeedBoundingRegion;
+    SeedImageType::Pointer m_SessionResult;
+    /** region of m_SessionResult that was written by the last computation*/
+    SeedImageType::RegionType m_SessionResultRegion;
 
   }; // class
 
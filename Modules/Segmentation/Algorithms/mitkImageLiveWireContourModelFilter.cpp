@@ -18,7 +18,13 @@ found in the LICENSE file.
 
 #include "mitkIOUtil.h"
 
+#include <algorithm>
+#include <limits>
+
+const unsigned int mitk::ImageLiveWireContourModelFilter::MinimalSearchWindowMargin = 16;
+
 mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
+  : m_UseIncrementalSearch(true), m_SearchTreeIsValid(false), m_SearchUsesDynamicCostMap(false)
 {
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
   this->SetNumberOfRequiredInputs(1);
@@ -58,6 +64,7 @@ void mitk::ImageLiveWireContourModelFilter::SetInput(unsigned int idx,
     this->Modified();
 
     AccessFixedDimensionByItk(input, ItkPreProcessImage, 2);
+    this->ResetSearchTree();
   }
 }
 
@@ -139,11 +146,13 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
 {
   m_CostFunction->ClearRepulsivePoints();
+  this->ResetSearchTree();
 }
 
 void mitk::ImageLiveWireContourModelFilter::AddRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->AddRepulsivePoint(idx);
+  this->ResetSearchTree();
 }
 
 void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
@@ -157,6 +166,7 @@ void mitk::ImageLiveWireContourModelFilter::DumpMaskImage()
 void mitk::ImageLiveWireContourModelFilter::RemoveRepulsivePoint(const itk::Index<2> &idx)
 {
   m_CostFunction->RemoveRepulsivePoint(idx);
+  this->ResetSearchTree();
 }
 
 void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPathType &points)
@@ -168,6 +178,8 @@ void mitk::ImageLiveWireContourModelFilter::SetRepulsivePoints(const ShortestPat
   {
     m_CostFunction->AddRepulsivePoint((*iter));
   }
+
+  this->ResetSearchTree();
 }
 
 void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
@@ -195,29 +207,34 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   region.SetSize(size);
   region.SetIndex(startRegion);
 
-  // inputImage->SetRequestedRegion(region);
-
   // extracts features from image and calculates costs
-  // m_CostFunction->SetImage(m_InternalImage);
   m_CostFunction->SetStartIndex(startPoint);
   m_CostFunction->SetEndIndex(endPoint);
   m_CostFunction->SetRequestedRegion(region);
   m_CostFunction->SetUseCostMap(m_UseDynamicCostMap);
 
-  // calculate shortest path between start and end point
-  m_ShortestPathFilter->SetFullNeighborsMode(true);
-  // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
-  m_ShortestPathFilter->SetMakeOutputImage(false);
+  ShortestPathType shortestPath;
+
+  if (m_UseIncrementalSearch && m_ShortestPathFilter->GetUseCostFunction())
+  {
+    // the feature images are only computed once per input image
+    m_CostFunction->Initialize();
+    shortestPath = this->ComputeIncrementalShortestPath(startPoint, endPoint);
+  }
+  else
+  {
+    // calculate shortest path between start and end point
+    m_ShortestPathFilter->SetFullNeighborsMode(true);
+    m_ShortestPathFilter->SetMakeOutputImage(false);
 
-  // m_ShortestPathFilter->SetCalcAllDistances(true);
-  m_ShortestPathFilter->SetStartIndex(startPoint);
-  m_ShortestPathFilter->SetEndIndex(endPoint);
+    m_ShortestPathFilter->SetStartIndex(startPoint);
+    m_ShortestPathFilter->SetEndIndex(endPoint);
 
-  m_ShortestPathFilter->Update();
+    m_ShortestPathFilter->Update();
 
-  // construct contour from path image
-  // get the shortest path as vector
-  ShortestPathType shortestPath = m_ShortestPathFilter->GetVectorPath();
+    // get the shortest path as vector
+    shortestPath = m_ShortestPathFilter->GetVectorPath();
+  }
 
   // fill the output contour with control points from the path
   OutputType::Pointer output = dynamic_cast<OutputType *>(this->MakeOutput(0).GetPointer());
@@ -246,6 +263,181 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   }
 }
 
+void mitk::ImageLiveWireContourModelFilter::ResetSearchTree()
+{
+  m_SearchTreeIsValid = false;
+  m_SearchDistances.clear();
+  m_SearchPredecessors.clear();
+  m_SearchSettled.clear();
+  m_SearchFrontier = SearchQueueType();
+  m_DeferredSearchNodes.clear();
+}
+
+void mitk::ImageLiveWireContourModelFilter::GrowSearchWindow(const InternalImageType::IndexType &startPoint,
+                                                             const InternalImageType::IndexType &endPoint)
+{
+  const auto imageRegion = m_InternalImage->GetLargestPossibleRegion();
+
+  // the margin grows with the distance of the points, so longer paths get more room for detours
+  const auto extent = std::max(std::abs(startPoint[0] - endPoint[0]), std::abs(startPoint[1] - endPoint[1]));
+  const auto margin = std::max<itk::IndexValueType>(MinimalSearchWindowMargin, extent / 2);
+
+  InternalImageType::IndexType lower, upper;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    lower[dim] = std::min(startPoint[dim], endPoint[dim]) - margin;
+    upper[dim] = std::max(startPoint[dim], endPoint[dim]) + margin;
+
+    if (m_SearchWindow.GetNumberOfPixels() > 0)
+    {
+      lower[dim] = std::min(lower[dim], m_SearchWindow.GetIndex(dim));
+      upper[dim] = std::max(upper[dim], m_SearchWindow.GetUpperIndex()[dim]);
+    }
+
+    lower[dim] = std::max(lower[dim], imageRegion.GetIndex(dim));
+    upper[dim] = std::min(upper[dim], imageRegion.GetUpperIndex()[dim]);
+  }
+
+  InternalImageType::RegionType window;
+  window.SetIndex(lower);
+  window.SetUpperIndex(upper);
+
+  if (window == m_SearchWindow)
+    return;
+
+  // Nodes settled so far only have the shortest distance within the old window. Paths through the new part
+  // of the window may be shorter, thus all settled nodes are reopened. Their distances remain valid upper
+  // bounds, so resuming the search from them still yields the shortest paths within the grown window.
+  if (m_SearchWindow.GetNumberOfPixels() > 0)
+  {
+    const auto oldLower = m_SearchWindow.GetIndex();
+    const auto oldUpper = m_SearchWindow.GetUpperIndex();
+
+    InternalImageType::IndexType index;
+    for (index[1] = oldLower[1]; index[1] <= oldUpper[1]; ++index[1])
+    {
+      for (index[0] = oldLower[0]; index[0] <= oldUpper[0]; ++index[0])
+      {
+        const auto node = m_InternalImage->ComputeOffset(index);
+
+        if (m_SearchSettled[node])
+        {
+          m_SearchSettled[node] = false;
+          m_SearchFrontier.emplace(m_SearchDistances[node], node);
+        }
+      }
+    }
+  }
+
+  m_SearchWindow = window;
+
+  // resume the search at all frontier nodes that are covered by the grown window
+  auto deferredEnd = std::partition(m_DeferredSearchNodes.begin(), m_DeferredSearchNodes.end(),
+    [this](SearchNodeType node) { return !m_SearchWindow.IsInside(m_InternalImage->ComputeIndex(node)); });
+
+  for (auto iter = deferredEnd; iter != m_DeferredSearchNodes.end(); ++iter)
+  {
+    if (!m_SearchSettled[*iter])
+      m_SearchFrontier.emplace(m_SearchDistances[*iter], *iter);
+  }
+
+  m_DeferredSearchNodes.erase(deferredEnd, m_DeferredSearchNodes.end());
+}
+
+mitk::ImageLiveWireContourModelFilter::ShortestPathType mitk::ImageLiveWireContourModelFilter::ComputeIncrementalShortestPath(
+  const InternalImageType::IndexType &startPoint, const InternalImageType::IndexType &endPoint)
+{
+  const auto imageRegion = m_InternalImage->GetLargestPossibleRegion();
+  const auto numberOfNodes = static_cast<std::size_t>(imageRegion.GetNumberOfPixels());
+
+  if (!m_SearchTreeIsValid || startPoint != m_SearchSeed || m_UseDynamicCostMap != m_SearchUsesDynamicCostMap ||
+      numberOfNodes != m_SearchDistances.size())
+  {
+    this->ResetSearchTree();
+
+    m_SearchDistances.assign(numberOfNodes, std::numeric_limits<double>::max());
+    m_SearchPredecessors.assign(numberOfNodes, -1);
+    m_SearchSettled.assign(numberOfNodes, false);
+
+    const auto seedNode = m_InternalImage->ComputeOffset(startPoint);
+    m_SearchDistances[seedNode] = 0.0;
+    m_SearchFrontier.emplace(0.0, seedNode);
+
+    m_SearchWindow = InternalImageType::RegionType();
+    m_SearchSeed = startPoint;
+    m_SearchUsesDynamicCostMap = m_UseDynamicCostMap;
+    m_SearchTreeIsValid = true;
+  }
+
+  this->GrowSearchWindow(startPoint, endPoint);
+
+  const auto endNode = m_InternalImage->ComputeOffset(endPoint);
+
+  // Dijkstra search that stops as soon as the end point is settled. Settled nodes keep their optimal distance
+  // within the search window, thus the next update only has to continue with the remaining frontier as long
+  // as the window does not grow.
+  while (!m_SearchSettled[endNode] && !m_SearchFrontier.empty())
+  {
+    const auto [distance, node] = m_SearchFrontier.top();
+    m_SearchFrontier.pop();
+
+    if (m_SearchSettled[node] || distance > m_SearchDistances[node])
+      continue; // outdated queue entry
+
+    const auto index = m_InternalImage->ComputeIndex(node);
+
+    if (!m_SearchWindow.IsInside(index))
+    {
+      m_DeferredSearchNodes.push_back(node);
+      continue;
+    }
+
+    m_SearchSettled[node] = true;
+
+    InternalImageType::IndexType neighbor;
+    for (itk::IndexValueType dy = -1; dy <= 1; ++dy)
+    {
+      for (itk::IndexValueType dx = -1; dx <= 1; ++dx)
+      {
+        if (0 == dx && 0 == dy)
+          continue;
+
+        neighbor[0] = index[0] + dx;
+        neighbor[1] = index[1] + dy;
+
+        if (!imageRegion.IsInside(neighbor))
+          continue;
+
+        const auto neighborNode = m_InternalImage->ComputeOffset(neighbor);
+
+        if (m_SearchSettled[neighborNode])
+          continue;
+
+        const double newDistance = distance + m_CostFunction->GetCost(index, neighbor);
+
+        if (newDistance < m_SearchDistances[neighborNode])
+        {
+          m_SearchDistances[neighborNode] = newDistance;
+          m_SearchPredecessors[neighborNode] = node;
+          m_SearchFrontier.emplace(newDistance, neighborNode);
+        }
+      }
+    }
+  }
+
+  ShortestPathType shortestPath;
+
+  if (!m_SearchSettled[endNode])
+    return shortestPath;
+
+  for (auto node = endNode; -1 != node; node = m_SearchPredecessors[node])
+    shortestPath.push_back(m_InternalImage->ComputeIndex(node));
+
+  std::reverse(shortestPath.begin(), shortestPath.end());
+
+  return shortestPath;
+}
+
 bool mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMap(mitk::ContourModel *path)
 {
   mitk::Image::ConstPointer input = dynamic_cast<const mitk::Image *>(this->GetInput());
@@ -441,4 +633,6 @@ void mitk::ImageLiveWireContourModelFilter::CreateDynamicCostMapByITK(
 
   this->m_CostFunction->SetDynamicCostMap(histogram);
   this->m_CostFunction->SetCostMapMaximum(max);
+
+  this->ResetSearchTree();
 }
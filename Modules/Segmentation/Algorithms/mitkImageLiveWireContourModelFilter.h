@@ -25,6 +25,10 @@ found in the LICENSE file.
 #include <itkShortestPathCostFunctionLiveWire.h>
 #include <itkShortestPathImageFilter.h>
 
+#include <functional>
+#include <queue>
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -39,6 +43,12 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   By default the shortest path is computed incrementally (see SetUseIncrementalSearch()): the filter keeps the
+   shortest path tree of a Dijkstra search anchored at the start point. As long as the start point, the input and
+   the costs do not change, moving the end point only expands the not yet settled frontier of that tree instead
+   of searching the whole slice again. The search is restricted to a window around start and end point that is
+   grown on demand.
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -76,6 +86,20 @@ namespace mitk
     itkSetMacro(UseDynamicCostMap, bool);
     itkGetMacro(UseDynamicCostMap, bool);
 
+    /** \brief Reuse the shortest path tree of previous updates if only the end point changed (default: true).
+    If disabled, every update runs a complete itk::ShortestPathImageFilter search over the whole slice.
+    \note The incremental search finds the optimal path within its search window. The window contains start and
+    end point with a margin of at least MinimalSearchWindowMargin pixels, thus paths that would leave it are not
+    considered.
+    */
+    itkSetMacro(UseIncrementalSearch, bool);
+    itkGetMacro(UseIncrementalSearch, bool);
+    itkBooleanMacro(UseIncrementalSearch);
+
+    /** \brief Minimal number of pixels the search window of the incremental search extends beyond the
+    bounding box of start and end point.*/
+    static const unsigned int MinimalSearchWindowMargin;
+
     /** \brief Clear all repulsive points used in the cost function
     */
     void ClearRepulsivePoints();
@@ -121,6 +145,20 @@ namespace mitk
 
     void UpdateLiveWire();
 
+    /** \brief Computes the shortest path from startPoint to endPoint by expanding the cached shortest path tree.
+    The tree is rebuilt if it was reset or if the start point or the cost settings changed.
+    \return Path from start to end point or an empty path if the end point could not be reached.*/
+    ShortestPathType ComputeIncrementalShortestPath(const InternalImageType::IndexType &startPoint,
+                                                    const InternalImageType::IndexType &endPoint);
+
+    /** \brief Grows the search window so that it contains start and end point (plus margin). If the window
+    changes, the search is resumed at all deferred nodes inside the new window and all settled nodes are
+    reopened, because their distances may decrease via paths through the added part of the window.*/
+    void GrowSearchWindow(const InternalImageType::IndexType &startPoint, const InternalImageType::IndexType &endPoint);
+
+    /** \brief Discards the cached shortest path tree, e.g. because the input or the costs changed.*/
+    void ResetSearchTree();
+
     /** \brief start point in worldcoordinates*/
     mitk::Point3D m_StartPoint;
 
@@ -152,6 +190,27 @@ namespace mitk
                                    mitk::ContourModel *path = nullptr);
 
     InternalImageType::Pointer m_InternalImage;
+
+    /** \brief Flag to reuse the shortest path tree between updates*/
+    bool m_UseIncrementalSearch;
+
+    using SearchNodeType = itk::OffsetValueType;
+    using SearchQueueEntryType = std::pair<double, SearchNodeType>;
+    using SearchQueueType = std::priority_queue<SearchQueueEntryType,
+                                                std::vector<SearchQueueEntryType>,
+                                                std::greater<SearchQueueEntryType>>;
+
+    /** \brief State of the incremental search. Nodes are pixel offsets in the buffer of m_InternalImage.*/
+    bool m_SearchTreeIsValid;
+    bool m_SearchUsesDynamicCostMap;
+    InternalImageType::IndexType m_SearchSeed;
+    InternalImageType::RegionType m_SearchWindow;
+    std::vector<double> m_SearchDistances;
+    std::vector<SearchNodeType> m_SearchPredecessors;
+    std::vector<bool> m_SearchSettled;
+    SearchQueueType m_SearchFrontier;
+    /** \brief Frontier nodes that were reached but lie outside of the current search window.*/
+    std::vector<SearchNodeType> m_DeferredSearchNodes;
   };
 }
 
@@ -18,6 +18,9 @@ found in the LICENSE file.
 #include <mitkLabelSetImageConverter.h>
 #include <vtkPolyDataNormals.h>
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef MITK_USE_OpenMP
 #include <omp.h>
 #endif
@@ -108,6 +111,20 @@ namespace mitk
       int numLabels = static_cast<int>(labels.size());
       m_SurfaceNodes.reserve(numLabels);
 
+      // Single 3D volumes are processed per label only within the bounding region of the label. The region is grown
+      // by the extent of the median and gaussian kernels, so that the result equals the one of the whole volume.
+      const bool cropLabels = 3 == labelSetImage->GetDimension() && 1 == labelSetImage->GetTimeSteps();
+      const auto spacing = labelSetImage->GetGeometry()->GetSpacing();
+      const auto minSpacing = std::min({ spacing[0], spacing[1], spacing[2] });
+      const auto cropPadding = medianKernelSize + static_cast<unsigned int>(std::ceil(3.0 * gaussianSD / minSpacing)) + 1;
+
+      if (cropLabels)
+      {
+        // determine the label regions up front instead of concurrently in the loop below
+        for (const auto& label : labels)
+          labelSetImage->GetLabelBoundingRegion(label->GetValue());
+      }
+
 #ifdef MITK_USE_OpenMP
       omp_lock_t lock;
       omp_init_lock(&lock);
@@ -116,7 +133,9 @@ namespace mitk
       #pragma omp parallel for
       for (int i = 0; i < numLabels; ++i)
       {
-        auto labelImage = CreateLabelMask(labelSetImage, labels[i]->GetValue());
+        auto labelImage = cropLabels
+          ? CreateCroppedLabelMask(labelSetImage, labels[i]->GetValue(), cropPadding)
+          : CreateLabelMask(labelSetImage, labels[i]->GetValue());
 
         if (labelImage.IsNull())
           continue;
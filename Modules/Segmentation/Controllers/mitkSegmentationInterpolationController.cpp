@@ -17,11 +17,20 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageHelper.h>
+#include <mitkSegChangeOperationApplier.h>
+#include <mitkVtkImageOverwrite.h>
 //#include <mitkPlaneGeometry.h>
 
 #include <itkCommand.h>
 #include <itkImage.h>
 #include <itkImageSliceConstIteratorWithIndex.h>
+#include <itkMultiThreaderBase.h>
+
+#include <vtkSmartPointer.h>
+
+#include <cstring>
 
 #include <thread>
 
@@ -60,7 +69,9 @@ mitk::SegmentationInterpolationController::SegmentationInterpolationController()
   : m_SegmentationModifiedObserverTag(std::make_pair(0UL, false)),
     m_BlockModified(false),
     m_2DInterpolationActivated(false),
-    m_EnableSliceImageCache(false)
+    m_EnableSliceImageCache(false),
+    m_AbortInterpolation(false),
+    m_LabelValue(MultiLabelSegmentation::UNLABELED_VALUE)
 {
 }
 
@@ -95,9 +106,24 @@ mitk::SegmentationInterpolationController::~SegmentationInterpolationController(
 
 void mitk::SegmentationInterpolationController::OnImageModified(const itk::EventObject &)
 {
-  if (!m_BlockModified && m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
+  if (!m_BlockModified)
   {
-    SetSegmentationVolume(m_Segmentation);
+    this->UpdateAfterModification();
+  }
+}
+
+void mitk::SegmentationInterpolationController::UpdateAfterModification()
+{
+  if (m_Segmentation.IsNotNull() && m_2DInterpolationActivated)
+  {
+    if (m_OccupancyIndex.IsNotNull())
+    {
+      this->UpdateSliceCountsFromOccupancyIndex();
+    }
+    else
+    {
+      SetSegmentationVolume(m_Segmentation);
+    }
   }
 }
 
@@ -107,6 +133,49 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 }
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
+{
+  m_OccupancyIndex = nullptr;
+  m_LabelValue = MultiLabelSegmentation::UNLABELED_VALUE;
+
+  if (!this->InitializeSegmentationVolume(segmentation))
+    return;
+
+  // for all timesteps
+  // scan whole image
+  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
+  {
+    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
+    timeSelector->SetInput(m_Segmentation);
+    timeSelector->SetTimeNr(timeStep);
+    timeSelector->UpdateLargestPossibleRegion();
+    Image::Pointer segmentation3D = timeSelector->GetOutput();
+    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
+  }
+
+  Modified();
+}
+
+void mitk::SegmentationInterpolationController::SetSegmentationVolume(const MultiLabelSegmentation *segmentation,
+                                                                      MultiLabelSegmentation::LabelValueType labelValue)
+{
+  if (nullptr == segmentation || !segmentation->ExistLabel(labelValue))
+  {
+    this->SetSegmentationVolume(nullptr);
+    return;
+  }
+
+  const auto groupIndex = segmentation->GetGroupIndexOfLabel(labelValue);
+
+  m_OccupancyIndex = segmentation->GetLabelOccupancyIndex(groupIndex);
+  m_LabelValue = labelValue;
+
+  if (!this->InitializeSegmentationVolume(segmentation->GetGroupImage(groupIndex)))
+    return;
+
+  this->UpdateSliceCountsFromOccupancyIndex();
+}
+
+bool mitk::SegmentationInterpolationController::InitializeSegmentationVolume(const Image *segmentation)
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
@@ -127,8 +196,9 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   if (nullptr == segmentation || !segmentation->IsInitialized())
   {
     m_Segmentation = nullptr;
+    m_OccupancyIndex = nullptr;
     this->InvokeEvent(itk::AbortEvent());
-    return;
+    return false;
   }
 
   if (segmentation->GetDimension() > 4 || segmentation->GetDimension() < 3)
@@ -157,17 +227,19 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   s_InterpolatorForImage.insert(std::make_pair(m_Segmentation, this));
 
-  // for all timesteps
-  // scan whole image
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
-  {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
-    timeSelector->SetTimeNr(timeStep);
-    timeSelector->UpdateLargestPossibleRegion();
-    Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
-  }
+  return true;
+}
+
+void mitk::SegmentationInterpolationController::UpdateSliceCountsFromOccupancyIndex()
+{
+  if (m_OccupancyIndex.IsNull() || m_Segmentation.IsNull())
+    return;
+
+  if (!m_OccupancyIndex->IsUpToDate(m_Segmentation))
+    m_OccupancyIndex->Initialize(m_Segmentation);
+
+  for (unsigned int timeStep = 0; timeStep < m_SegmentationCountInSlice.size(); ++timeStep)
+    m_SegmentationCountInSlice[timeStep] = m_OccupancyIndex->GetSliceCounts(m_LabelValue, timeStep);
 
   Modified();
 }
@@ -572,13 +644,26 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(con
   extractor->SetWorldGeometry(planeGeometry);
   extractor->Update();
 
+  Image::Pointer slice = extractor->GetOutput();
+
+  if (m_OccupancyIndex.IsNotNull())
+  {
+    // Reduce the slice of the group image to a binary slice of the label
+    ImageWriteAccessor accessor(slice);
+    auto *pixels = static_cast<MultiLabelSegmentation::LabelValueType *>(accessor.GetData());
+    const std::size_t numberOfPixels = static_cast<std::size_t>(slice->GetDimension(0)) * slice->GetDimension(1);
+
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+      pixels[i] = m_LabelValue == pixels[i] ? 1 : 0;
+  }
+
   if (cache && m_EnableSliceImageCache)
   {
     std::lock_guard<std::mutex> lock(m_SliceImageCacheMutex);
-    m_SliceImageCache[key] = extractor->GetOutput();
+    m_SliceImageCache[key] = slice;
   }
 
-  return extractor->GetOutput();
+  return slice;
 }
 
 void mitk::SegmentationInterpolationController::EnableSliceImageCache()
@@ -591,3 +676,197 @@ void mitk::SegmentationInterpolationController::DisableSliceImageCache()
   m_EnableSliceImageCache = false;
   m_SliceImageCache.clear();
 }
+
+unsigned int mitk::SegmentationInterpolationController::InterpolateAllSlices(unsigned int sliceDimension,
+                                                                           const PlaneGeometry *referencePlane,
+                                                                           unsigned int timeStep,
+                                                                           Image *resultVolume,
+                                                                           const SliceProgressCallbackType &progressCallback)
+{
+  if (m_Segmentation.IsNull() || nullptr == referencePlane || nullptr == resultVolume)
+    return 0;
+
+  if (timeStep >= m_SegmentationCountInSlice.size() || sliceDimension > 2)
+    return 0;
+
+  const auto numSlices = static_cast<unsigned int>(m_SegmentationCountInSlice[timeStep][sliceDimension].size());
+  const auto slicedGeometry = m_Segmentation->GetSlicedGeometry(timeStep);
+
+  // Reuse interpolation algorithm instance for each slice to cache boundary calculations
+  auto algorithm = ShapeBasedInterpolationAlgorithm::New();
+
+  std::atomic_uint totalChangedSlices(0);
+  std::mutex writeBackMutex;
+
+  auto interpolate = [&](itk::SizeValueType sliceIndex)
+  {
+    if (!m_AbortInterpolation)
+    {
+      auto clonedPlaneGeometry = referencePlane->Clone();
+      auto origin = clonedPlaneGeometry->GetOrigin();
+      slicedGeometry->WorldToIndex(origin, origin);
+      origin[sliceDimension] = sliceIndex;
+      slicedGeometry->IndexToWorld(origin, origin);
+      clonedPlaneGeometry->SetOrigin(origin);
+
+      auto interpolation = this->Interpolate(sliceDimension, sliceIndex, clonedPlaneGeometry, timeStep, algorithm);
+
+      if (interpolation.IsNotNull() && !m_AbortInterpolation)
+      {
+        // Setting up the reslicing pipeline which allows us to write the interpolation results back into the volume
+        auto reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+        reslicer->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
+        reslicer->SetOverwriteMode(true);
+        reslicer->Modified();
+
+        auto sliceWriter = ExtractSliceFilter::New(reslicer);
+        sliceWriter->SetInput(resultVolume);
+        sliceWriter->SetTimeStep(0);
+        sliceWriter->SetWorldGeometry(clonedPlaneGeometry);
+        sliceWriter->SetVtkOutputRequest(true);
+        sliceWriter->SetResliceTransformByGeometry(resultVolume->GetTimeGeometry()->GetGeometryForTimeStep(0));
+        sliceWriter->Modified();
+
+        {
+          std::lock_guard<std::mutex> lock(writeBackMutex);
+          sliceWriter->Update();
+        }
+
+        ++totalChangedSlices;
+      }
+    }
+
+    if (progressCallback)
+      progressCallback();
+  };
+
+  this->EnableSliceImageCache();
+
+  try
+  {
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(0, numSlices, interpolate, nullptr);
+  }
+  catch (...)
+  {
+    this->DisableSliceImageCache();
+    throw;
+  }
+
+  this->DisableSliceImageCache();
+
+  return totalChangedSlices;
+}
+
+unsigned int mitk::SegmentationInterpolationController::AcceptAllInterpolations(MultiLabelSegmentation *segmentation,
+                                                                              MultiLabelSegmentation::LabelValueType labelValue,
+                                                                              unsigned int sliceDimension,
+                                                                              const PlaneGeometry *referencePlane,
+                                                                              TimeStepType timeStep,
+                                                                              const SliceProgressCallbackType &progressCallback)
+{
+  if (nullptr == segmentation || nullptr == referencePlane)
+    return 0;
+
+  if (!segmentation->ExistLabel(labelValue))
+    mitkThrow() << "Cannot accept all interpolations. Label does not exist. Invalid label value: " << labelValue;
+
+  if (timeStep >= segmentation->GetTimeSteps())
+    mitkThrow() << "Cannot accept all interpolations. Invalid time step: " << timeStep;
+
+  this->SetSegmentationVolume(segmentation, labelValue);
+
+  const auto interpolationVolume = this->CreateInterpolationVolume(timeStep);
+
+  const auto totalChangedSlices =
+    this->InterpolateAllSlices(sliceDimension, referencePlane, timeStep, interpolationVolume, progressCallback);
+
+  if (0 == totalChangedSlices || m_AbortInterpolation)
+    return 0;
+
+  this->ApplyInterpolatedSlices(segmentation, labelValue, interpolationVolume, timeStep);
+
+  return totalChangedSlices;
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::InterpolateAllSlicesOfLabel(unsigned int sliceDimension,
+                                                                                          const PlaneGeometry *referencePlane,
+                                                                                          TimeStepType timeStep,
+                                                                                          const SliceProgressCallbackType &progressCallback)
+{
+  if (m_OccupancyIndex.IsNull() || nullptr == referencePlane || timeStep >= m_SegmentationCountInSlice.size())
+    return nullptr;
+
+  const auto interpolationVolume = this->CreateInterpolationVolume(timeStep);
+
+  const auto totalChangedSlices =
+    this->InterpolateAllSlices(sliceDimension, referencePlane, timeStep, interpolationVolume, progressCallback);
+
+  if (0 == totalChangedSlices || m_AbortInterpolation)
+    return nullptr;
+
+  return interpolationVolume;
+}
+
+void mitk::SegmentationInterpolationController::ApplyInterpolatedSlices(MultiLabelSegmentation *segmentation,
+                                                                      MultiLabelSegmentation::LabelValueType labelValue,
+                                                                      const Image *interpolationVolume,
+                                                                      TimeStepType timeStep)
+{
+  if (nullptr == segmentation || nullptr == interpolationVolume)
+    return;
+
+  if (!segmentation->ExistLabel(labelValue))
+    mitkThrow() << "Cannot apply interpolated slices. Label does not exist. Invalid label value: " << labelValue;
+
+  if (timeStep >= segmentation->GetTimeSteps())
+    mitkThrow() << "Cannot apply interpolated slices. Invalid time step: " << timeStep;
+
+  const auto groupIndex = segmentation->GetGroupIndexOfLabel(labelValue);
+  const auto groupImage = segmentation->GetGroupImage(groupIndex);
+
+  SegGroupModifyUndoRedoHelper undoHelper(segmentation, { groupIndex }, false, timeStep, true, false, true);
+
+  TransferLabelContentAtTimeStep(interpolationVolume,
+                                 groupImage,
+                                 segmentation->GetConstLabelsByValue(segmentation->GetLabelValuesByGroup(groupIndex)),
+                                 timeStep,
+                                 0,
+                                 0,
+                                 false,
+                                 { {1, labelValue} },
+                                 MultiLabelSegmentation::MergeStyle::Merge,
+                                 MultiLabelSegmentation::OverwriteStyle::RegardLocks);
+
+  const auto labelName = LabelSetImageHelper::CreateDisplayLabelName(segmentation, segmentation->GetLabel(labelValue));
+  undoHelper.RegisterUndoRedoOperationEvent("3D-interpolation - " + labelName);
+}
+
+mitk::Image::Pointer mitk::SegmentationInterpolationController::CreateInterpolationVolume(TimeStepType timeStep) const
+{
+  // Empty volume receiving all interpolated slices before they are transferred in one go
+  auto interpolationVolume = Image::New();
+  interpolationVolume->Initialize(SelectImageByTimeStep(m_Segmentation.GetPointer(), timeStep));
+
+  ImageWriteAccessor accessor(interpolationVolume);
+  const auto &pixelType = interpolationVolume->GetPixelType();
+  std::memset(accessor.GetData(), 0, pixelType.GetSize() * interpolationVolume->GetDimension(0) *
+    interpolationVolume->GetDimension(1) * interpolationVolume->GetDimension(2));
+
+  return interpolationVolume;
+}
+
+void mitk::SegmentationInterpolationController::AbortInterpolation()
+{
+  m_AbortInterpolation = true;
+}
+
+void mitk::SegmentationInterpolationController::ResetAbortInterpolation()
+{
+  m_AbortInterpolation = false;
+}
+
+bool mitk::SegmentationInterpolationController::IsInterpolationAborted() const
+{
+  return m_AbortInterpolation;
+}
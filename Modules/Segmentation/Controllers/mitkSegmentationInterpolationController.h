@@ -15,12 +15,15 @@ found in the LICENSE file.
 
 #include "mitkCommon.h"
 #include "mitkImage.h"
+#include <mitkLabelSetImage.h>
 #include <MitkSegmentationExports.h>
 #include <mitkShapeBasedInterpolationAlgorithm.h>
 
 #include <itkImage.h>
 #include <itkObjectFactory.h>
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <utility>
@@ -99,6 +102,21 @@ namespace mitk
     */
     void SetSegmentationVolume(const Image *segmentation);
 
+    /**
+      \brief Initialize with a label of a multi-label segmentation.
+
+      Instead of scanning a binary mask of the label, the slice occupancy is taken from the label occupancy index of
+      the label's group (see MultiLabelSegmentation::GetLabelOccupancyIndex()). The index covers all labels of the
+      group, so switching between labels does not rescan the volume as long as the group image is unchanged.
+      Slices are extracted from the group image and reduced to the label on the fly.
+
+      In this mode, difference images passed to SetChangedSlice() and SetChangedVolume() refer to the label only
+      (1: pixel became part of the label, -1: pixel was removed from the label). The occupancy index itself has to be
+      kept up to date by the client that modifies the group image (see mitk::SegTool2D::WriteSliceToVolume()), which
+      then notifies the controller via UpdateAfterModification().
+    */
+    void SetSegmentationVolume(const MultiLabelSegmentation *segmentation, MultiLabelSegmentation::LabelValueType labelValue);
+
     /**
       \brief Update after changing a single slice.
 
@@ -117,6 +135,15 @@ namespace mitk
                          unsigned int timeStep);
     void SetChangedVolume(const Image *sliceDiff, unsigned int timeStep);
 
+    /**
+      \brief Update after the segmentation was modified while reactions to its Modified() events were blocked.
+
+      If the controller was initialized with a label of a multi-label segmentation and the modifying client kept the
+      occupancy index of the group up to date (see LabelOccupancyIndex::UpdateSlice()), the slice counts are only
+      copied from the index. Otherwise the segmentation is scanned again.
+    */
+    void UpdateAfterModification();
+
     /**
       \brief Generates an interpolated image for the given slice.
 
@@ -136,6 +163,108 @@ namespace mitk
                                unsigned int timeStep,
                                mitk::ShapeBasedInterpolationAlgorithm::Pointer algorithm = nullptr);
 
+    /**
+      \brief Callback that is called once for every processed slice of InterpolateAllSlices().
+
+      It is called from worker threads, so it must be thread-safe.
+    */
+    using SliceProgressCallbackType = std::function<void()>;
+
+    /**
+      \brief Generates interpolations for all slices of one direction.
+
+      The slices are distributed across the ITK thread pool. Each interpolation is written into \a resultVolume as
+      soon as it is computed. Writing the results back is serialized, so \a resultVolume does not have to be
+      thread-safe. Already written slices remain in \a resultVolume if the interpolation is aborted via
+      AbortInterpolation().
+
+      \param sliceDimension Number of the dimension which is constant for all pixels of the meant slices.
+
+      \param referencePlane Plane geometry of any slice in the direction specified by sliceDimension. It is cloned and
+             shifted for each slice.
+
+      \param timeStep Which time step to use
+
+      \param resultVolume 3D image with the geometry of the segmentation at timeStep. Pixels of interpolated slices
+             are set to 1, all other pixels are left untouched.
+
+      \param progressCallback Optional callback that is called once per processed slice.
+
+      \return Number of interpolated slices.
+    */
+    unsigned int InterpolateAllSlices(unsigned int sliceDimension,
+                                      const PlaneGeometry *referencePlane,
+                                      unsigned int timeStep,
+                                      Image *resultVolume,
+                                      const SliceProgressCallbackType &progressCallback = nullptr);
+
+    /**
+      \brief Generates interpolations for all slices of one direction and transfers them to a label.
+
+      The controller is (re-)initialized with the mask of \a labelValue, all slices are interpolated in parallel
+      (see InterpolateAllSlices()) and the results are merged into the group image of the label with respect to
+      label locks. All changes are registered as a single undo operation.
+
+      \return Number of interpolated slices. Nothing is changed if 0 is returned, e.g. because the interpolation
+              was aborted.
+
+      \sa InterpolateAllSlicesOfLabel(), ApplyInterpolatedSlices()
+    */
+    unsigned int AcceptAllInterpolations(MultiLabelSegmentation *segmentation,
+                                         MultiLabelSegmentation::LabelValueType labelValue,
+                                         unsigned int sliceDimension,
+                                         const PlaneGeometry *referencePlane,
+                                         TimeStepType timeStep,
+                                         const SliceProgressCallbackType &progressCallback = nullptr);
+
+    /**
+      \brief First step of AcceptAllInterpolations(), which does not modify the segmentation.
+
+      Interpolates all slices of one direction of the label the controller was initialized with (see
+      SetSegmentationVolume(const MultiLabelSegmentation*, MultiLabelSegmentation::LabelValueType)). It can be run in a
+      background thread as long as the segmentation is not modified meanwhile, e.g. to keep the UI responsive for an
+      AbortInterpolation() request.
+
+      \return Volume with the geometry of the group image at \a timeStep. Pixels of interpolated slices are set to 1.
+              nullptr is returned if no slice was interpolated or the interpolation was aborted.
+    */
+    Image::Pointer InterpolateAllSlicesOfLabel(unsigned int sliceDimension,
+                                               const PlaneGeometry *referencePlane,
+                                               TimeStepType timeStep,
+                                               const SliceProgressCallbackType &progressCallback = nullptr);
+
+    /**
+      \brief Second step of AcceptAllInterpolations().
+
+      Merges a volume returned by InterpolateAllSlicesOfLabel() into the group image of the label with respect to
+      label locks. All changes are registered as a single undo operation.
+    */
+    void ApplyInterpolatedSlices(MultiLabelSegmentation *segmentation,
+                                 MultiLabelSegmentation::LabelValueType labelValue,
+                                 const Image *interpolationVolume,
+                                 TimeStepType timeStep);
+
+    /**
+      \brief Cooperatively cancel a running InterpolateAllSlices() or AcceptAllInterpolations().
+
+      Slices that are currently interpolated are finished, no further slices are started. May be called from any
+      thread. The request stays active until ResetAbortInterpolation() is called, so an abort requested before a
+      call of InterpolateAllSlices() or AcceptAllInterpolations() is not lost.
+    */
+    void AbortInterpolation();
+
+    /**
+      \brief Withdraw a previous AbortInterpolation() request.
+
+      Call this at the start of a user action that interpolates slices, not from the interpolating code itself.
+    */
+    void ResetAbortInterpolation();
+
+    /**
+      \brief Indicates if an AbortInterpolation() request is active.
+    */
+    bool IsInterpolationAborted() const;
+
     void OnImageModified(const itk::EventObject &);
 
     /**
@@ -200,6 +329,15 @@ namespace mitk
 
     void PrintStatus();
 
+    /// (re-)registers the segmentation image and resets m_SegmentationCountInSlice; returns false if it is invalid
+    bool InitializeSegmentationVolume(const Image *segmentation);
+
+    /// copies the slice counts of m_LabelValue from the occupancy index (rebuilding the index if it is outdated)
+    void UpdateSliceCountsFromOccupancyIndex();
+
+    /// creates an empty (all 0) volume with the geometry of the segmentation at timeStep
+    Image::Pointer CreateInterpolationVolume(TimeStepType timeStep) const;
+
     /**
      * Extract a slice and optionally use a caching mechanism if enabled.
     */
@@ -226,6 +364,12 @@ namespace mitk
     bool m_EnableSliceImageCache;
     std::map<std::pair<unsigned int, unsigned int>, Image::Pointer> m_SliceImageCache;
     std::mutex m_SliceImageCacheMutex;
+
+    std::atomic_bool m_AbortInterpolation;
+
+    /// only set if initialized with a label of a multi-label segmentation; m_Segmentation is the group image then
+    LabelOccupancyIndex::Pointer m_OccupancyIndex;
+    MultiLabelSegmentation::LabelValueType m_LabelValue;
   };
 
 } // namespace
@@ -25,6 +25,7 @@ mitk::BinaryThresholdBaseTool::BinaryThresholdBaseTool()
     m_LowerThreshold(1),
     m_UpperThreshold(1)
 {
+  this->SetAsynchronousPreviewUpdateSupported(true);
 }
 
 mitk::BinaryThresholdBaseTool::~BinaryThresholdBaseTool()
@@ -98,6 +99,20 @@ void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
   }
 }
 
+void mitk::BinaryThresholdBaseTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_PreviewLowerThreshold = m_LowerThreshold;
+  m_PreviewUpperThreshold = m_UpperThreshold;
+
+  if (nullptr != this->GetPreviewSegmentation())
+  {
+    m_PreviewLabelValue = this->GetActiveLabelValueOfPreview();
+    this->SetSelectedLabels({ m_PreviewLabelValue });
+  }
+}
+
 void mitk::BinaryThresholdBaseTool::DoUpdatePreview(const Image* inputAtTimeStep, const Image* /*oldSegAtTimeStep*/, MultiLabelSegmentation* previewImage, TimeStepType timeStep)
 {
   if (nullptr != inputAtTimeStep && nullptr != previewImage)
@@ -115,13 +130,12 @@ void mitk::BinaryThresholdBaseTool::ITKThresholding(const itk::Image<TPixel, VIm
   typedef itk::Image<Tool::DefaultSegmentationDataType, VImageDimension> SegmentationType;
   typedef itk::BinaryThresholdImageFilter<ImageType, SegmentationType> ThresholdFilterType;
 
-  const auto activeValue = this->GetActiveLabelValueOfPreview();
-  this->SetSelectedLabels({activeValue});
+  const auto activeValue = m_PreviewLabelValue;
 
   typename ThresholdFilterType::Pointer filter = ThresholdFilterType::New();
   filter->SetInput(inputImage);
-  filter->SetLowerThreshold(m_LowerThreshold);
-  filter->SetUpperThreshold(m_UpperThreshold);
+  filter->SetLowerThreshold(m_PreviewLowerThreshold);
+  filter->SetUpperThreshold(m_PreviewUpperThreshold);
   filter->SetInsideValue(activeValue);
   filter->SetOutsideValue(0);
   filter->Update();
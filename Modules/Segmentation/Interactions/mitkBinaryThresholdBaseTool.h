@@ -54,6 +54,7 @@ namespace mitk
     itkGetMacro(SensibleMaximumThreshold, ScalarType);
 
     void InitiateToolByInput() override;
+    void UpdatePrepare() override;
     void DoUpdatePreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, MultiLabelSegmentation* previewImage, TimeStepType timeStep) override;
 
     template <typename TPixel, unsigned int VImageDimension>
@@ -67,6 +68,12 @@ namespace mitk
     ScalarType m_LowerThreshold;
     ScalarType m_UpperThreshold;
 
+    /** State used by DoUpdatePreview(). It is captured by UpdatePrepare(), so that the thresholds
+      can be changed while a preview is computed asynchronously.*/
+    ScalarType m_PreviewLowerThreshold = 1;
+    ScalarType m_PreviewUpperThreshold = 1;
+    MultiLabelSegmentation::LabelValueType m_PreviewLabelValue = 1;
+
     /** Indicates if the tool should behave like a single threshold tool (true)
       or like a upper/lower threshold tool (false)*/
     bool m_LockedUpperThreshold = false;
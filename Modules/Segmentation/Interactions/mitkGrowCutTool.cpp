@@ -16,7 +16,6 @@ found in the LICENSE file.
 #include "mitkTool.h"
 #include <mitkLabelSetImage.h>
 #include <mitkLabelSetImageHelper.h>
-#include "mitkGrowCutSegmentationFilter.h"
 
 // us
 #include <usGetModuleContext.h>
@@ -27,6 +26,8 @@ found in the LICENSE file.
 // ITK
 #include <itkImage.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   MITK_TOOL_MACRO(MITKSEGMENTATION_EXPORT, GrowCutTool, "GrowCutTool");
@@ -36,6 +37,11 @@ mitk::GrowCutTool::GrowCutTool() : SegWithPreviewTool(true, "PressMoveReleaseAnd
 {
   this->ResetsToEmptyPreviewOn();
   this->UseSpecialPreviewColorOff();
+
+  m_GrowCutFilter = GrowCutSegmentationFilter::New();
+  m_GrowCutFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
+
+  this->SetAsynchronousPreviewUpdateSupported(true);
 }
 
 mitk::GrowCutTool::~GrowCutTool() {}
@@ -67,6 +73,10 @@ void mitk::GrowCutTool::Activated()
 void mitk::GrowCutTool::Deactivated()
 {
   Superclass::Deactivated();
+
+  m_GrowCutFilter->ResetSession();
+  m_SeedImage = nullptr;
+  m_SeedSourceImage = nullptr;
 }
 
 bool mitk::GrowCutTool::SeedImageIsValid()
@@ -94,6 +104,54 @@ bool mitk::GrowCutTool::SeedImageIsValid()
   return false;
 }
 
+void mitk::GrowCutTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  // set here and not in DoUpdatePreview, because the penalty may change while the preview is computed asynchronously
+  m_GrowCutFilter->SetDistancePenalty(m_DistancePenalty);
+}
+
+namespace
+{
+  /** Returns the bounding box of all labels of the active group at the given time step. It is taken from
+  the label occupancy index of the segmentation, which is kept up to date while the seeds are drawn.
+  So the seed image does not have to be scanned by the filter.*/
+  mitk::GrowCutSegmentationFilter::SeedImageType::RegionType GetSeedBoundingRegion(const mitk::MultiLabelSegmentation* segmentation, mitk::TimeStepType timeStep)
+  {
+    mitk::GrowCutSegmentationFilter::SeedImageType::RegionType seedRegion;
+
+    if (nullptr == segmentation || timeStep >= segmentation->GetTimeSteps())
+      return seedRegion;
+
+    for (const auto labelValue : segmentation->GetLabelValuesByGroup(segmentation->GetActiveLayer()))
+    {
+      const auto labelRegion = segmentation->GetLabelBoundingRegion(labelValue, timeStep);
+
+      if (0 == labelRegion.GetNumberOfPixels())
+        continue;
+
+      if (0 == seedRegion.GetNumberOfPixels())
+      {
+        seedRegion = labelRegion;
+        continue;
+      }
+
+      auto lower = seedRegion.GetIndex();
+      auto upper = seedRegion.GetUpperIndex();
+      for (unsigned int dim = 0; dim < 3; ++dim)
+      {
+        lower[dim] = std::min(lower[dim], labelRegion.GetIndex(dim));
+        upper[dim] = std::max(upper[dim], labelRegion.GetUpperIndex()[dim]);
+      }
+      seedRegion.SetIndex(lower);
+      seedRegion.SetUpperIndex(upper);
+    }
+
+    return seedRegion;
+  }
+}
+
 void mitk::GrowCutTool::DoUpdatePreview(const Image *inputAtTimeStep,
                                         const Image * oldSegAtTimeStep,
                                         MultiLabelSegmentation *previewImage,
@@ -102,31 +160,44 @@ void mitk::GrowCutTool::DoUpdatePreview(const Image *inputAtTimeStep,
   if (nullptr != inputAtTimeStep &&
       nullptr != previewImage)
   {
-      mitk::GrowCutSegmentationFilter::Pointer growCutFilter = mitk::GrowCutSegmentationFilter::New();
-
       if (nullptr == this->GetToolManager()->GetWorkingData(0))
       {
         return;
       }
 
-      SeedImageType::Pointer seedImage = SeedImageType::New();
-      CastToItkImage(oldSegAtTimeStep, seedImage);
+      // The seed image is only recreated if the segmentation changed. An unchanged seed image lets the
+      // filter reuse its last result without comparing the seeds.
+      if (m_SeedImage.IsNull() || oldSegAtTimeStep != m_SeedSourceImage.GetPointer() || oldSegAtTimeStep->GetMTime() != m_SeedSourceMTime)
+      {
+        m_SeedImage = SeedImageType::New();
+        CastToItkImage(oldSegAtTimeStep, m_SeedImage);
+        m_SeedSourceImage = oldSegAtTimeStep;
+        m_SeedSourceMTime = oldSegAtTimeStep->GetMTime();
+      }
 
-      growCutFilter->SetSeedImage(seedImage);
-      growCutFilter->SetDistancePenalty(m_DistancePenalty);
-      growCutFilter->SetInput(inputAtTimeStep);
-      growCutFilter->AddObserver(itk::ProgressEvent(), m_ProgressCommand);
+      m_GrowCutFilter->SetSeedImage(m_SeedImage);
+      m_GrowCutFilter->SetInput(inputAtTimeStep);
+
+      // determined here and not in UpdatePrepare, because this may run asynchronously and off the GUI thread
+      if (m_GrowCutFilter->GetUseSeedRegion())
+      {
+        m_GrowCutFilter->SetSeedBoundingRegion(GetSeedBoundingRegion(this->GetTargetSegmentation(), timeStep));
+      }
 
       try
       {
-        growCutFilter->Update();
+        m_GrowCutFilter->Update();
+      }
+      catch (const itk::ProcessAborted&)
+      {
+        throw;
       }
       catch (...)
       {
         mitkThrow() << "itkGrowCutFilter error";
       }
 
-      auto growCutResultImage = growCutFilter->GetOutput();
+      auto growCutResultImage = m_GrowCutFilter->GetOutput();
 
       previewImage->UpdateGroupImage(previewImage->GetActiveLayer(), growCutResultImage, timeStep);
   }
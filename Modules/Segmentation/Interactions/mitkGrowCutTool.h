@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkGrowCutTool_h
 
 #include "mitkSegWithPreviewTool.h"
+#include "mitkGrowCutSegmentationFilter.h"
 #include <MitkSegmentationExports.h>
 
 namespace us
@@ -49,12 +50,22 @@ namespace mitk
     GrowCutTool(); // purposely hidden
     ~GrowCutTool() override;
 
+    void UpdatePrepare() override;
+
     void DoUpdatePreview(const Image *inputAtTimeStep,
                          const Image *oldSegAtTimeStep,
                          MultiLabelSegmentation *previewImage,
                          TimeStepType timeStep) override;
 
     double m_DistancePenalty = 0.0;
+
+    /** The filter is kept over all preview updates of an activation, so that it can reuse its results.*/
+    GrowCutSegmentationFilter::Pointer m_GrowCutFilter;
+
+    /** Seed image of the last preview update and the segmentation image it was created from.*/
+    SeedImageType::Pointer m_SeedImage;
+    Image::ConstPointer m_SeedSourceImage;
+    itk::ModifiedTimeType m_SeedSourceMTime = 0;
   };
 
 } // namespace mitk
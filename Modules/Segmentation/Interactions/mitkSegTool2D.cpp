@@ -34,9 +34,11 @@ found in the LICENSE file.
 #include "mitkImageTimeSelector.h"
 #include "mitkImageToContourFilter.h"
 #include "mitkSurfaceInterpolationController.h"
+#include "mitkSegmentationInterpolationController.h"
 
 // includes for resling and overwriting
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkVtkImageOverwrite.h>
 #include <vtkImageData.h>
 #include <vtkSmartPointer.h>
@@ -58,6 +60,75 @@ found in the LICENSE file.
 
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
 
+namespace
+{
+  /** Returns the smallest region (index coordinates of the group image) that contains all voxels that differ
+  * between the original and the modified content of a slab (see MultiLabelSegmentation::GetGroupSlab()).*/
+  mitk::LabelOccupancyIndex::RegionType DetermineModifiedSlabRegion(const mitk::Image* slab, const mitk::Label::PixelType* originalData,
+    const mitk::Label::PixelType* modifiedData, unsigned int sliceDimension, unsigned int sliceIndex)
+  {
+    const unsigned int axisU = sliceDimension == 0 ? 1 : 0;
+    const unsigned int axisV = sliceDimension == 2 ? 1 : 2;
+    const auto sizeU = axisU < slab->GetDimension() ? slab->GetDimension(axisU) : 1;
+    const auto sizeV = axisV < slab->GetDimension() ? slab->GetDimension(axisV) : 1;
+
+    itk::IndexValueType minU = sizeU, maxU = -1, minV = sizeV, maxV = -1;
+    for (unsigned int v = 0; v < sizeV; ++v)
+    {
+      const auto offset = static_cast<std::size_t>(v) * sizeU;
+      for (unsigned int u = 0; u < sizeU; ++u)
+      {
+        if (originalData[offset + u] != modifiedData[offset + u])
+        {
+          minU = std::min<itk::IndexValueType>(minU, u);
+          maxU = std::max<itk::IndexValueType>(maxU, u);
+          minV = std::min<itk::IndexValueType>(minV, v);
+          maxV = std::max<itk::IndexValueType>(maxV, v);
+        }
+      }
+    }
+
+    mitk::LabelOccupancyIndex::RegionType region;
+    if (maxU < 0)
+      return region;
+
+    region.SetIndex(sliceDimension, sliceIndex);
+    region.SetSize(sliceDimension, 1);
+    region.SetIndex(axisU, minU);
+    region.SetSize(axisU, maxU - minU + 1);
+    region.SetIndex(axisV, minV);
+    region.SetSize(axisV, maxV - minV + 1);
+    return region;
+  }
+
+  /** Blocks the reaction of the slice interpolation controller of an image (if there is one) to Modified()
+  * events of the image for the lifetime of the blocker (see SegmentationInterpolationController::BlockModified()).*/
+  class InterpolationModifiedBlocker
+  {
+  public:
+    explicit InterpolationModifiedBlocker(const mitk::Image* image)
+      : m_Controller(mitk::SegmentationInterpolationController::InterpolatorForImage(image))
+    {
+      if (m_Controller.IsNotNull())
+        m_Controller->BlockModified(true);
+    }
+
+    ~InterpolationModifiedBlocker()
+    {
+      if (m_Controller.IsNotNull())
+        m_Controller->BlockModified(false);
+    }
+
+    mitk::SegmentationInterpolationController* GetController() const
+    {
+      return m_Controller;
+    }
+
+  private:
+    mitk::SegmentationInterpolationController::Pointer m_Controller;
+  };
+}
+
 mitk::SegTool2D::SliceInformation::SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep) :
   slice(aSlice), plane(aPlane), timestep(aTimestep)
 {
@@ -625,10 +696,32 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
       UndoStackItem::IncCurrGroupEventId();
     }
 
+    // An up-to-date occupancy index of the group is updated slice-wise instead of rescanning the group image
+    // later on. This is only possible for slices that are aligned with the image axes. For those slices also
+    // the modified region is reported to the segmentation, so that e.g. label surfaces can be updated locally.
+    auto occupancyIndex = segmentation->GetLabelOccupancyIndex(groupIndex, false);
+
+    // The interpolation controller of the group would rebuild the index on every write. It is blocked and
+    // takes the slice counts from the updated index afterwards.
+    InterpolationModifiedBlocker interpolationBlocker(groupImage);
+
     for (const auto& sliceInfo : sliceList)
     {
       if (nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
       {
+        unsigned int sliceDimension = 0;
+        unsigned int sliceIndex = 0;
+        Image::Pointer originalSlab;
+
+        if (LabelSetImageHelper::DetermineAxisAlignedSlice(groupImage->GetGeometry(sliceInfo.timestep), sliceInfo.plane, sliceDimension, sliceIndex))
+        {
+          originalSlab = segmentation->GetGroupSlab(groupIndex, sliceDimension, sliceIndex, sliceInfo.timestep);
+        }
+        else
+        {
+          occupancyIndex = nullptr;
+        }
+
         SegSliceOperation* undoOperation = nullptr;
 
         if (allowUndo)
@@ -641,8 +734,31 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
           /*============= END undo/redo feature block ========================*/
         }
 
+        const auto mTimeBeforeModification = groupImage->GetMTime();
+        const auto indexMTimeBeforeModification = nullptr != occupancyIndex ? occupancyIndex->GetMTime() : 0;
         SegTool2D::WriteSliceToVolume(groupImage, sliceInfo);
 
+        if (originalSlab.IsNotNull())
+        {
+          auto modifiedSlab = segmentation->GetGroupSlab(groupIndex, sliceDimension, sliceIndex, sliceInfo.timestep);
+          ImageReadAccessor originalAccess(originalSlab);
+          ImageReadAccessor modifiedAccess(modifiedSlab);
+          const auto originalData = static_cast<const Label::PixelType*>(originalAccess.GetData());
+          const auto modifiedData = static_cast<const Label::PixelType*>(modifiedAccess.GetData());
+
+          if (nullptr != occupancyIndex)
+          {
+            // An observer of the group image may already have rebuilt the index in reaction to the write.
+            // The slice delta must only be applied to an index that still reflects the state before the write.
+            if (occupancyIndex->GetMTime() == indexMTimeBeforeModification)
+              occupancyIndex->UpdateSlice(sliceDimension, sliceIndex, sliceInfo.timestep, originalData, modifiedData);
+            occupancyIndex->MarkUpToDate(groupImage);
+          }
+
+          segmentation->ReportModifiedGroupRegion(groupIndex, sliceInfo.timestep,
+            DetermineModifiedSlabRegion(originalSlab, originalData, modifiedData, sliceDimension, sliceIndex), mTimeBeforeModification);
+        }
+
         if (allowUndo)
         {
           /*============= BEGIN undo/redo feature block ========================*/
@@ -661,6 +777,12 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
         }
       }
     }
+
+    if (nullptr != interpolationBlocker.GetController())
+    {
+      interpolationBlocker.GetController()->BlockModified(false);
+      interpolationBlocker.GetController()->UpdateAfterModification();
+    }
   }
 
   SegTool2D::UpdateSurfaceInterpolation(sliceList, groupImage, false, activeLabelValue);
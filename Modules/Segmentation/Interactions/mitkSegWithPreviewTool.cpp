@@ -32,18 +32,26 @@ found in the LICENSE file.
 
 #include <mitkSegChangeOperationApplier.h>
 
+namespace
+{
+  constexpr int PREVIEW_PROGRESS_STEPS = 200;
+}
+
 mitk::SegWithPreviewTool::SegWithPreviewTool(bool lazyDynamicPreviews): Tool("dummy"), m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
   m_ProgressCommand = ToolCommand::New();
+  m_ProgressCommand->PendingProgressAvailable += MessageDelegate<SegWithPreviewTool>(this, &SegWithPreviewTool::OnPendingProgressAvailable);
 }
 
 mitk::SegWithPreviewTool::SegWithPreviewTool(bool lazyDynamicPreviews, const char* interactorType, const us::Module* interactorModule) : Tool(interactorType, interactorModule), m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
   m_ProgressCommand = ToolCommand::New();
+  m_ProgressCommand->PendingProgressAvailable += MessageDelegate<SegWithPreviewTool>(this, &SegWithPreviewTool::OnPendingProgressAvailable);
 }
 
 mitk::SegWithPreviewTool::~SegWithPreviewTool()
 {
+  this->CancelAsynchronousPreviewUpdate();
 }
 
 void mitk::SegWithPreviewTool::SetMergeStyle(MultiLabelSegmentation::MergeStyle mergeStyle)
@@ -134,6 +142,8 @@ void mitk::SegWithPreviewTool::Activated()
 
 void mitk::SegWithPreviewTool::Deactivated()
 {
+  this->CancelAsynchronousPreviewUpdate();
+
   this->GetToolManager()->RoiDataChanged -=
     MessageDelegate<SegWithPreviewTool>(this, &SegWithPreviewTool::OnRoiDataChanged);
 
@@ -167,12 +177,19 @@ void mitk::SegWithPreviewTool::Deactivated()
 
 void mitk::SegWithPreviewTool::ConfirmSegmentation()
 {
+  // a running or requested asynchronous update has to be done before the preview can be confirmed
+  const bool droppedAsynchronousUpdate = this->CancelAsynchronousPreviewUpdate();
+
   bool labelChanged = this->EnsureUpToDateUserDefinedActiveLabel();
   if ((m_LazyDynamicPreviews && m_CreateAllTimeSteps) || labelChanged)
   { // The tool should create all time steps but is currently in lazy mode,
     // thus ensure that a preview for all time steps is available.
     this->UpdatePreview(true);
   }
+  else if (droppedAsynchronousUpdate)
+  {
+    this->UpdatePreviewSynchronously(false);
+  }
 
   CreateResultSegmentationFromPreview();
 
@@ -256,6 +273,8 @@ void mitk::SegWithPreviewTool::ResetPreviewContent()
 
 void mitk::SegWithPreviewTool::ResetPreviewNode()
 {
+  this->CancelAsynchronousPreviewUpdate();
+
   if (m_IsUpdating)
   {
     mitkThrow() << "Used tool is implemented incorrectly. ResetPreviewNode is called while preview update is ongoing. Check implementation!";
@@ -581,10 +600,84 @@ bool mitk::SegWithPreviewTool::EnsureUpToDateUserDefinedActiveLabel()
 }
 
 void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
+{
+  if (m_AsynchronousPreviewUpdate && !ignoreLazyPreviewSetting)
+  {
+    if (m_AsynchronousPreviewUpdateFuture.valid())
+    { // the running computation is superseded; it is cancelled and the latest request is computed afterwards
+      m_PendingAsynchronousPreviewUpdate = true;
+      m_ProgressCommand->SetStopProcessing(true);
+    }
+    else
+    {
+      this->StartAsynchronousPreviewUpdate();
+    }
+    return;
+  }
+
+  this->CancelAsynchronousPreviewUpdate();
+  this->UpdatePreviewSynchronously(ignoreLazyPreviewSetting);
+}
+
+void mitk::SegWithPreviewTool::ComputePreview(const Image* inputImage,
+                                              const Image* workingImage,
+                                              MultiLabelSegmentation* previewImage,
+                                              TimePointType timePoint,
+                                              bool allTimeSteps)
+{
+  if (previewImage->GetTimeSteps() > 1 && allTimeSteps)
+  {
+    for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
+    {
+      if (m_ProgressCommand->GetStopProcessing())
+        return;
+
+      Image::ConstPointer feedBackImage;
+      Image::ConstPointer currentSegImage;
+
+      auto previewTimePoint = previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
+      auto inputTimeStep = inputImage->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
+
+      if (nullptr != this->GetWorkingPlaneGeometry())
+      { //only extract a specific slice defined by the working plane as feedback referenceImage.
+        feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImage(this->GetWorkingPlaneGeometry(), inputImage, inputTimeStep);
+        currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, previewTimePoint);
+      }
+      else
+      { //work on the whole feedback referenceImage
+        feedBackImage = this->GetImageByTimeStep(inputImage, inputTimeStep);
+        currentSegImage = this->GetImageByTimePoint(workingImage, previewTimePoint);
+      }
+
+      this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
+    }
+  }
+  else
+  {
+    Image::ConstPointer feedBackImage;
+    Image::ConstPointer currentSegImage;
+
+    if (nullptr != this->GetWorkingPlaneGeometry())
+    {
+      feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), inputImage, timePoint);
+      currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, timePoint);
+    }
+    else
+    {
+      feedBackImage = this->GetImageByTimePoint(inputImage, timePoint);
+      currentSegImage = this->GetImageByTimePoint(workingImage, timePoint);
+    }
+
+    auto timeStep = previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint);
+
+    this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
+  }
+}
+
+void mitk::SegWithPreviewTool::UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting)
 {
   const auto inputImage = this->GetSegmentationInput();
   auto previewImage = this->GetPreviewSegmentation();
-  int progress_steps = 200;
   this->EnsureUpToDateUserDefinedActiveLabel();
 
   const auto workingSegmentation = this->GetTargetSegmentation();
@@ -601,52 +694,10 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
   {
     if (nullptr != inputImage && nullptr != previewImage)
     {
-      m_ProgressCommand->AddStepsToDo(progress_steps);
-
-      if (previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews))
-      {
-        for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
-        {
-          Image::ConstPointer feedBackImage;
-          Image::ConstPointer currentSegImage;
-
-          auto previewTimePoint = previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
-          auto inputTimeStep = inputImage->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
-
-          if (nullptr != this->GetWorkingPlaneGeometry())
-          { //only extract a specific slice defined by the working plane as feedback referenceImage.
-            feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImage(this->GetWorkingPlaneGeometry(), inputImage, inputTimeStep);
-            currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, previewTimePoint);
-          }
-          else
-          { //work on the whole feedback referenceImage
-            feedBackImage = this->GetImageByTimeStep(inputImage, inputTimeStep);
-            currentSegImage = this->GetImageByTimePoint(workingImage, previewTimePoint);
-          }
-
-          this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
-        }
-      }
-      else
-      {
-        Image::ConstPointer feedBackImage;
-        Image::ConstPointer currentSegImage;
-
-        if (nullptr != this->GetWorkingPlaneGeometry())
-        {
-          feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), inputImage, timePoint);
-          currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, timePoint);
-        }
-        else
-        {
-          feedBackImage = this->GetImageByTimePoint(inputImage, timePoint);
-          currentSegImage = this->GetImageByTimePoint(workingImage, timePoint);
-        }
+      m_ProgressCommand->AddStepsToDo(PREVIEW_PROGRESS_STEPS);
 
-        auto timeStep = previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint);
+      this->ComputePreview(inputImage, workingImage, previewImage, timePoint, ignoreLazyPreviewSetting || !m_LazyDynamicPreviews);
 
-        this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
-      }
       RenderingManager::GetInstance()->RequestUpdateAll();
       if (!previewImage->GetAllLabelValues().empty())
       { // check if labels exits for the preview
@@ -658,14 +709,14 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
   {
     MITK_ERROR << "Exception caught: " << excep.GetDescription();
 
-    m_ProgressCommand->SetProgress(progress_steps);
+    m_ProgressCommand->SetProgress(PREVIEW_PROGRESS_STEPS);
 
     std::string msg = excep.GetDescription();
     ErrorMessage.Send(msg);
   }
   catch (...)
   {
-    m_ProgressCommand->SetProgress(progress_steps);
+    m_ProgressCommand->SetProgress(PREVIEW_PROGRESS_STEPS);
     m_IsUpdating = false;
     CurrentlyBusy.Send(false);
     throw;
@@ -673,11 +724,155 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
 
   this->UpdateCleanUp();
   m_LastTimePointOfUpdate = timePoint;
-  m_ProgressCommand->SetProgress(progress_steps);
+  m_ProgressCommand->SetProgress(PREVIEW_PROGRESS_STEPS);
   m_IsUpdating = false;
   CurrentlyBusy.Send(false);
 }
 
+void mitk::SegWithPreviewTool::SetAsynchronousPreviewUpdate(bool asynchronous)
+{
+  const bool newValue = asynchronous && m_AsynchronousPreviewUpdateSupported;
+
+  if (newValue == m_AsynchronousPreviewUpdate)
+    return;
+
+  if (!newValue)
+  {
+    this->CancelAsynchronousPreviewUpdate();
+  }
+
+  m_AsynchronousPreviewUpdate = newValue;
+}
+
+void mitk::SegWithPreviewTool::StartAsynchronousPreviewUpdate()
+{
+  m_PendingAsynchronousPreviewUpdate = false;
+
+  Image::ConstPointer inputImage = this->GetSegmentationInput();
+  auto previewImage = this->GetPreviewSegmentation();
+
+  if (inputImage.IsNull() || nullptr == previewImage)
+    return;
+
+  this->EnsureUpToDateUserDefinedActiveLabel();
+
+  const auto workingSegmentation = this->GetTargetSegmentation();
+  Image::ConstPointer workingImage = workingSegmentation->GetGroupImage(workingSegmentation->GetActiveLayer());
+
+  m_IsUpdating = true;
+  this->UpdatePrepare();
+
+  // The worker writes into a copy of the preview. The visible preview is replaced as a whole
+  // by FinalizeAsynchronousPreviewUpdate(), so rendering never sees a partially computed preview.
+  m_PreviewBuffer = previewImage->Clone();
+  m_AsynchronousPreviewTimePoint = RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
+  m_AsynchronousPreviewResultIsValid = false;
+  m_ProgressCommand->SetStopProcessing(false);
+  m_ProgressCommand->AddStepsToDo(PREVIEW_PROGRESS_STEPS);
+
+  MultiLabelSegmentation::Pointer previewBuffer = m_PreviewBuffer;
+  const auto timePoint = m_AsynchronousPreviewTimePoint;
+  const bool allTimeSteps = !m_LazyDynamicPreviews;
+
+  m_AsynchronousPreviewUpdateFuture = std::async(std::launch::async,
+    [this, inputImage, workingImage, previewBuffer, timePoint, allTimeSteps]()
+    {
+      std::string errorMessage;
+
+      try
+      {
+        this->ComputePreview(inputImage, workingImage, previewBuffer, timePoint, allTimeSteps);
+        m_AsynchronousPreviewResultIsValid = !m_ProgressCommand->GetStopProcessing();
+      }
+      catch (const itk::ExceptionObject& excep)
+      {
+        // exceptions of cancelled computations (e.g. itk::ProcessAborted) are expected
+        if (!m_ProgressCommand->GetStopProcessing())
+        {
+          MITK_ERROR << "Exception caught: " << excep.GetDescription();
+          errorMessage = excep.GetDescription();
+        }
+      }
+      catch (const std::exception& excep)
+      {
+        MITK_ERROR << "Exception caught: " << excep.what();
+        errorMessage = excep.what();
+      }
+      catch (...)
+      {
+        MITK_ERROR << "Unknown exception caught while computing the preview.";
+        errorMessage = "Unknown error while computing the preview.";
+      }
+
+      this->AsynchronousPreviewUpdateFinished.Send();
+      return errorMessage;
+    });
+}
+
+void mitk::SegWithPreviewTool::FinalizeAsynchronousPreviewUpdate()
+{
+  if (!m_AsynchronousPreviewUpdateFuture.valid())
+    return;
+
+  const std::string errorMessage = m_AsynchronousPreviewUpdateFuture.get();
+  m_ProgressCommand->ReportPendingProgress();
+  m_ProgressCommand->SetProgress(PREVIEW_PROGRESS_STEPS);
+
+  if (m_AsynchronousPreviewResultIsValid && m_PreviewSegmentationNode.IsNotNull())
+  {
+    m_PreviewSegmentationNode->SetData(m_PreviewBuffer);
+    m_IsPreviewGenerated = !m_PreviewBuffer->GetAllLabelValues().empty();
+    m_LastTimePointOfUpdate = m_AsynchronousPreviewTimePoint;
+    RenderingManager::GetInstance()->RequestUpdateAll();
+  }
+
+  m_PreviewBuffer = nullptr;
+  this->UpdateCleanUp();
+  m_IsUpdating = false;
+
+  if (!errorMessage.empty())
+  {
+    ErrorMessage.Send(errorMessage);
+  }
+
+  if (m_PendingAsynchronousPreviewUpdate)
+  {
+    this->StartAsynchronousPreviewUpdate();
+  }
+}
+
+void mitk::SegWithPreviewTool::OnPendingProgressAvailable()
+{
+  this->AsynchronousPreviewProgress.Send();
+}
+
+void mitk::SegWithPreviewTool::ReportAsynchronousPreviewProgress()
+{
+  m_ProgressCommand->ReportPendingProgress();
+}
+
+bool mitk::SegWithPreviewTool::CancelAsynchronousPreviewUpdate()
+{
+  bool dropped = m_PendingAsynchronousPreviewUpdate;
+  m_PendingAsynchronousPreviewUpdate = false;
+
+  if (m_AsynchronousPreviewUpdateFuture.valid())
+  {
+    m_ProgressCommand->SetStopProcessing(true);
+    m_AsynchronousPreviewUpdateFuture.get();
+    m_ProgressCommand->SetStopProcessing(false);
+    m_ProgressCommand->ReportPendingProgress();
+    m_ProgressCommand->SetProgress(PREVIEW_PROGRESS_STEPS);
+
+    m_PreviewBuffer = nullptr;
+    this->UpdateCleanUp();
+    m_IsUpdating = false;
+    dropped = true;
+  }
+
+  return dropped;
+}
+
 bool mitk::SegWithPreviewTool::IsUpdating() const
 {
   return m_IsUpdating;
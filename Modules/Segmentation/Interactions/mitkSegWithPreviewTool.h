@@ -19,6 +19,9 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include <MitkSegmentationExports.h>
 
+#include <atomic>
+#include <future>
+
 namespace mitk
 {
   /**
@@ -31,6 +34,12 @@ namespace mitk
   This class also takes care to properly transfer a confirmed preview into the segmentation
   result.
 
+  Derived classes with a thread safe DoUpdatePreview() can support asynchronous preview
+  updates (see SetAsynchronousPreviewUpdate()). Then the preview is computed by a background
+  worker into a second preview buffer, which replaces the visible preview as a whole once the
+  computation is finished. Requests that are made while the worker is busy cancel the running
+  computation (via m_ProgressCommand) and are coalesced, so that only the latest request is computed.
+
   \ingroup ToolManagerEtAl
   \sa mitk::Tool
   \sa QmitkInteractiveSegmentation
@@ -123,6 +132,37 @@ namespace mitk
     /** Indicate if currently UpdatePreview is triggered (true) or not (false).*/
     bool IsUpdating() const;
 
+    /** Indicates if the tool is able to compute its preview asynchronously.*/
+    itkGetConstMacro(AsynchronousPreviewUpdateSupported, bool);
+
+    /** If enabled (and supported by the tool), UpdatePreview() does not block but requests
+     * the computation of the preview in a background thread. The computed preview is only shown after
+     * FinalizeAsynchronousPreviewUpdate() was called. As this has to happen in the thread that owns the
+     * preview (normally the GUI thread), users that enable asynchronous updates have to observe
+     * AsynchronousPreviewUpdateFinished and call FinalizeAsynchronousPreviewUpdate() from their thread.
+     * UpdatePreview(true) and ConfirmSegmentation() always work synchronously.
+     * Disabling the mode cancels a running computation.*/
+    void SetAsynchronousPreviewUpdate(bool asynchronous);
+    itkGetConstMacro(AsynchronousPreviewUpdate, bool);
+
+    /** Sent by the background worker (thus not in the GUI thread) as soon as an asynchronous
+     * preview computation is finished or was cancelled.*/
+    Message<> AsynchronousPreviewUpdateFinished;
+
+    /** Makes the result of a finished asynchronous preview computation visible and starts the
+     * computation of a pending request, if there is any. Does nothing if no computation is running.
+     * Must be called in the thread that owns the preview (see SetAsynchronousPreviewUpdate()).*/
+    void FinalizeAsynchronousPreviewUpdate();
+
+    /** Sent by the background worker (thus not in the GUI thread) if the computation reported progress.
+     * Users that enable asynchronous updates have to call ReportAsynchronousPreviewProgress() from the thread
+     * that owns the preview, as the progress bar must not be updated by the worker.*/
+    Message<> AsynchronousPreviewProgress;
+
+    /** Passes the progress reported by the background worker to the progress bar.
+     * Must be called in the thread that owns the preview (see AsynchronousPreviewProgress).*/
+    void ReportAsynchronousPreviewProgress();
+
     /**
    * @brief Gets the name of the currently selected segmentation node
    * @return the name of the segmentation node or an empty string if
@@ -248,7 +288,31 @@ namespace mitk
 
     bool ConfirmBeforeDeactivation() override;
 
+    /** Derived classes call this (normally in their constructor) to indicate that their DoUpdatePreview(),
+     * UpdatePrepare() and UpdateCleanUp() are suited for asynchronous preview updates. This is the case if
+     * DoUpdatePreview() does not access the GUI, the data storage or any member that is changed while
+     * the preview is computed. State needed by DoUpdatePreview() can be captured in UpdatePrepare(),
+     * which is always called in the thread that requested the update.*/
+    itkSetMacro(AsynchronousPreviewUpdateSupported, bool);
+
   private:
+    /** Computes the preview in the calling thread (see UpdatePreview()).*/
+    void UpdatePreviewSynchronously(bool ignoreLazyPreviewSetting);
+
+    /** Generates the preview content for the passed time point (or all time steps) into previewImage.*/
+    void ComputePreview(const Image* inputImage, const Image* workingImage, MultiLabelSegmentation* previewImage,
+                        TimePointType timePoint, bool allTimeSteps);
+
+    /** Starts the background worker for the current state of the tool.*/
+    void StartAsynchronousPreviewUpdate();
+
+    /** Cancels the running asynchronous computation and all pending requests and waits for the worker.
+     * @return Indicates if there was a computation or a request that has been dropped.*/
+    bool CancelAsynchronousPreviewUpdate();
+
+    /** Announces progress of the background worker (see AsynchronousPreviewProgress).*/
+    void OnPendingProgressAvailable();
+
     void TransferSegmentationsAtTimeStep(const MultiLabelSegmentation* sourceSeg, MultiLabelSegmentation* destinationSeg, const TimeStepType timeStep, const LabelMappingType& labelMapping);
 
     void CreateResultSegmentationFromPreview();
@@ -333,6 +397,17 @@ namespace mitk
      * Call RequestDeactivationConfirmationOn() in the tool class to avail this feature.
      */
     bool m_RequestDeactivationConfirmation = false;
+
+    bool m_AsynchronousPreviewUpdateSupported = false;
+    bool m_AsynchronousPreviewUpdate = false;
+    /** Indicates that UpdatePreview() was called while the background worker was busy.*/
+    bool m_PendingAsynchronousPreviewUpdate = false;
+    /** Result of the background worker: an error message or an empty string if the computation succeeded.*/
+    std::future<std::string> m_AsynchronousPreviewUpdateFuture;
+    std::atomic_bool m_AsynchronousPreviewResultIsValid{false};
+    /** Second buffer of the preview the background worker writes into.*/
+    MultiLabelSegmentation::Pointer m_PreviewBuffer;
+    TimePointType m_AsynchronousPreviewTimePoint = 0.;
   };
 
 } // namespace
@@ -13,12 +13,25 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include "mitkProgressBar.h"
 
-mitk::ToolCommand::ToolCommand() : m_ProgressValue(0), m_StopProcessing(false)
+#include <itkProcessObject.h>
+
+mitk::ToolCommand::ToolCommand()
+  : m_ProgressValue(0), m_OwnerThreadId(std::this_thread::get_id()), m_PendingProgressSteps(0), m_StopProcessing(false)
 {
 }
 
-void mitk::ToolCommand::Execute(itk::Object *, const itk::EventObject &event)
+void mitk::ToolCommand::Execute(itk::Object *caller, const itk::EventObject &event)
 {
+  if (m_StopProcessing)
+  {
+    auto processObject = dynamic_cast<itk::ProcessObject *>(caller);
+    if (nullptr != processObject)
+    {
+      processObject->SetAbortGenerateData(true);
+    }
+    return;
+  }
+
   if (typeid(event) == typeid(itk::IterationEvent))
   {
     // MITK_INFO << "IterationEvent";
@@ -59,7 +72,7 @@ void mitk::ToolCommand::Execute(itk::Object *, const itk::EventObject &event)
     // MITK_INFO << "FunctionAndGradientEvaluationIterationEvent";
   }
 
-  mitk::ProgressBar::GetInstance()->Progress();
+  this->ReportProgress(1);
 }
 
 void mitk::ToolCommand::Execute(const itk::Object * /*caller*/, const itk::EventObject & /*event*/)
@@ -73,7 +86,32 @@ void mitk::ToolCommand::AddStepsToDo(int steps)
 
 void mitk::ToolCommand::SetProgress(int steps)
 {
-  mitk::ProgressBar::GetInstance()->Progress(steps);
+  this->ReportProgress(steps);
+}
+
+void mitk::ToolCommand::ReportProgress(int steps)
+{
+  if (std::this_thread::get_id() == m_OwnerThreadId)
+  {
+    mitk::ProgressBar::GetInstance()->Progress(steps);
+    return;
+  }
+
+  // the progress bar is a GUI element, progress of other threads is passed on by ReportPendingProgress()
+  if (0 == m_PendingProgressSteps.fetch_add(steps))
+  {
+    PendingProgressAvailable.Send();
+  }
+}
+
+void mitk::ToolCommand::ReportPendingProgress()
+{
+  const auto steps = m_PendingProgressSteps.exchange(0);
+
+  if (steps > 0)
+  {
+    mitk::ProgressBar::GetInstance()->Progress(steps);
+  }
 }
 
 double mitk::ToolCommand::GetCurrentProgressValue()
@@ -85,3 +123,8 @@ void mitk::ToolCommand::SetStopProcessing(bool value)
 {
   m_StopProcessing = value;
 }
+
+bool mitk::ToolCommand::GetStopProcessing() const
+{
+  return m_StopProcessing;
+}
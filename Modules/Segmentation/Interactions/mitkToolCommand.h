@@ -15,13 +15,22 @@ found in the LICENSE file.
 
 #include "itkCommand.h"
 #include "mitkCommon.h"
+#include "mitkMessage.h"
 #include <MitkSegmentationExports.h>
 
+#include <atomic>
+#include <thread>
+
 namespace mitk
 {
   /**
   * \brief A command to get tool process feedback.
   *
+  * Progress is forwarded to the ProgressBar only in the thread that created the command (normally the GUI thread).
+  * Progress reported by other threads (e.g. by filters running in a background worker) is accumulated and
+  * announced via PendingProgressAvailable; it is forwarded as soon as ReportPendingProgress() is called in the
+  * thread that created the command.
+  *
   * \sa ProgressBar
   *
   */
@@ -65,17 +74,40 @@ namespace mitk
     double GetCurrentProgressValue();
 
     /**
-    * \brief Sets the stop processing flag, which is used to call ...
-    *
+    * \brief Sets the stop processing flag. While it is set, every observed itk::ProcessObject
+    * that reports an event is asked to abort (see itk::ProcessObject::SetAbortGenerateData()).
+    * The flag may be set from any thread.
     */
     void SetStopProcessing(bool value);
 
+    /**
+    * \brief Returns the stop processing flag.
+    *
+    */
+    bool GetStopProcessing() const;
+
+    /**
+    * \brief Forwards the progress reported by other threads to the progress bar.
+    * Must be called in the thread that created the command.
+    */
+    void ReportPendingProgress();
+
+    /**
+    * \brief Sent in the reporting thread, if progress of another thread than the one that created the command
+    * is pending and no earlier notification is still unanswered by ReportPendingProgress().
+    */
+    Message<> PendingProgressAvailable;
+
   protected:
     ToolCommand();
 
   private:
+    void ReportProgress(int steps);
+
     double m_ProgressValue;
-    bool m_StopProcessing;
+    std::thread::id m_OwnerThreadId;
+    std::atomic_int m_PendingProgressSteps;
+    std::atomic_bool m_StopProcessing;
   };
 
 } // namespace mitk
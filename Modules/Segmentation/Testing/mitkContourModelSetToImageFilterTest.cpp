@@ -11,16 +11,20 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkContourModelSet.h>
+#include <mitkContourModelSetRasterizer.h>
 #include <mitkContourModelSetToImageFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <algorithm>
+
 class mitkContourModelSetToImageFilterTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkContourModelSetToImageFilterTestSuite);
   MITK_TEST(TestFillContourSetIntoImage);
+  MITK_TEST(TestRasterizeSlabs);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -51,6 +55,39 @@ public:
 
     MITK_ASSERT_EQUAL(refImage, filledImage, "Error filling contours into image");
   }
+
+  void TestRasterizeSlabs()
+  {
+    mitk::Image::Pointer refImage = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("ContourModel-Data/RefImage.nrrd"));
+    auto readerOutput = mitk::IOUtil::Load(GetTestDataFilePath("ContourModel-Data/Contours.cnt_set"));
+    mitk::ContourModelSet::Pointer cnt_set = dynamic_cast<mitk::ContourModelSet *>(readerOutput.at(0).GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("Failed to load contours", cnt_set.IsNotNull());
+
+    auto rasterizer = mitk::ContourModelSetRasterizer::New();
+    rasterizer->Initialize(refImage->GetGeometry(), cnt_set);
+    CPPUNIT_ASSERT(rasterizer->GetNumberOfSlices() > 0);
+
+    const auto region = rasterizer->GetLargestPossibleRegion();
+    std::vector<unsigned char> volume(region.GetNumberOfPixels(), 0);
+    rasterizer->FillRegion(volume.data(), region, static_cast<unsigned char>(1));
+
+    // filling the image slab by slab must give the same result as filling it at once
+    std::vector<unsigned char> slabs(region.GetNumberOfPixels(), 0);
+    const itk::SizeValueType slabSize = 3;
+    for (itk::IndexValueType z = 0; z < static_cast<itk::IndexValueType>(region.GetSize(2)); z += slabSize)
+    {
+      auto slabRegion = region;
+      slabRegion.SetIndex(2, z);
+      slabRegion.SetSize(2, std::min(slabSize, region.GetSize(2) - static_cast<itk::SizeValueType>(z)));
+
+      std::vector<unsigned char> slab(slabRegion.GetNumberOfPixels(), 0);
+      rasterizer->FillRegion(slab.data(), slabRegion, static_cast<unsigned char>(1));
+      std::copy(slab.begin(), slab.end(), slabs.begin() + region.ComputeOffset(slabRegion.GetIndex()));
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Slab-wise rasterization differs from rasterizing the whole volume", volume == slabs);
+    CPPUNIT_ASSERT(std::any_of(volume.begin(), volume.end(), [](unsigned char value) { return 0 != value; }));
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkContourModelSetToImageFilter)
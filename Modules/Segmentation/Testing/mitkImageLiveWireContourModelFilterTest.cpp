@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageLiveWireContourModelFilter.h>
+#include <mitkImage.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+class mitkImageLiveWireContourModelFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageLiveWireContourModelFilterTestSuite);
+  MITK_TEST(TestIncrementalSearchAfterGrowingWindow);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::ContourModel::Pointer ComputeLiveWire(mitk::ImageLiveWireContourModelFilter *filter, const mitk::Point3D &endPoint)
+  {
+    filter->SetEndPoint(endPoint);
+    filter->Update();
+
+    return filter->GetOutput()->Clone();
+  }
+
+public:
+  void setUp() override
+  {
+    const unsigned int dimensions[] = { 100, 100 };
+
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<float>(), 2, dimensions);
+
+    // deterministic noise, so that shortest paths are unique
+    mitk::ImageWriteAccessor accessor(m_Image);
+    auto *pixels = static_cast<float *>(accessor.GetData());
+    unsigned int state = 4711;
+    for (unsigned int i = 0; i < dimensions[0] * dimensions[1]; ++i)
+    {
+      state = state * 1664525u + 1013904223u;
+      pixels[i] = static_cast<float>(state >> 16) / 65536.0f * 255.0f;
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void TestIncrementalSearchAfterGrowingWindow()
+  {
+    mitk::Point3D startPoint;
+    mitk::FillVector3D(startPoint, 20, 50, 0);
+    mitk::Point3D nearEndPoint;
+    mitk::FillVector3D(nearEndPoint, 25, 50, 0);
+    mitk::Point3D farEndPoint;
+    mitk::FillVector3D(farEndPoint, 80, 50, 0);
+
+    // the search window of the incremental filter grows from the near to the far end point
+    auto incrementalFilter = mitk::ImageLiveWireContourModelFilter::New();
+    incrementalFilter->SetInput(m_Image);
+    incrementalFilter->SetStartPoint(startPoint);
+    this->ComputeLiveWire(incrementalFilter, nearEndPoint);
+    auto incrementalContour = this->ComputeLiveWire(incrementalFilter, farEndPoint);
+
+    // a fresh filter searches the far end point directly (same search window, no reused tree)
+    auto freshFilter = mitk::ImageLiveWireContourModelFilter::New();
+    freshFilter->SetInput(m_Image);
+    freshFilter->SetStartPoint(startPoint);
+    auto freshContour = this->ComputeLiveWire(freshFilter, farEndPoint);
+
+    CPPUNIT_ASSERT(freshContour->GetNumberOfVertices() > 0);
+    CPPUNIT_ASSERT_EQUAL(freshContour->GetNumberOfVertices(), incrementalContour->GetNumberOfVertices());
+
+    for (int i = 0; i < freshContour->GetNumberOfVertices(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Incremental search deviates from the search without reused tree",
+        mitk::Equal(freshContour->GetVertexAt(i)->Coordinates, incrementalContour->GetVertexAt(i)->Coordinates));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageLiveWireContourModelFilter)
@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
 #include <mitkSegmentationInterpolationController.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
@@ -31,63 +32,58 @@ class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Coronal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_Axial_TestAllSlicesInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(Equal_Sagittal_TestAllSlicesInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(AcceptAllInterpolations_Axial_AddsInterpolatedSlice);
+  MITK_TEST(AcceptAllInterpolations_Aborted_LeavesSegmentationUnchanged);
   CPPUNIT_TEST_SUITE_END();
 
 private:
-  // The tests all do the same, only in different directions
-  void testRoutine(mitk::AnatomicalPlane viewDirection)
+  int GetSliceDimension(mitk::AnatomicalPlane viewDirection)
   {
-    int dim;
     switch (viewDirection)
     {
       case (mitk::AnatomicalPlane::Axial):
-        dim = 2;
-        break;
+        return 2;
       case (mitk::AnatomicalPlane::Coronal):
-        dim = 1;
-        break;
+        return 1;
       case (mitk::AnatomicalPlane::Sagittal):
-        dim = 0;
-        break;
+        return 0;
       default: // mitk::AnatomicalPlane::Original
-        dim = -1;
-        break;
+        return -1;
     }
+  }
 
-    /* Fill segmentation
-     *
-     * 1st slice: 3x3 square segmentation
-     * 2nd slice: empty
-     * 3rd slice: 1x1 square segmentation in corner
-     * -> 2nd slice should become 2x2 square in corner
-     *
-     * put accessor in scope
-     */
-
+  /* Fill segmentation
+   *
+   * 1st slice: 3x3 square segmentation
+   * 2nd slice: empty
+   * 3rd slice: 1x1 square segmentation in corner
+   * -> 2nd slice should become 2x2 square in corner
+   */
+  void FillSegmentation(int dim)
+  {
     itk::Index<3> currentPoint;
-    {
-      mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+    mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
 
-      // Fill 3x3 slice
-      currentPoint[dim] = m_CenterPoint[dim] - 1;
-      for (int i = -1; i <= 1; ++i)
+    // Fill 3x3 slice
+    currentPoint[dim] = m_CenterPoint[dim] - 1;
+    for (int i = -1; i <= 1; ++i)
+    {
+      for (int j = -1; j <= 1; ++j)
       {
-        for (int j = -1; j <= 1; ++j)
-        {
-          currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
-          currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
-          writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
-        }
+        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
+        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+        writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
       }
-      // Now i=j=1, set point two slices up
-      currentPoint[dim] = m_CenterPoint[dim] + 1;
-      writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
     }
+    // Now i=j=1, set point two slices up
+    currentPoint[dim] = m_CenterPoint[dim] + 1;
+    writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+  }
 
-    //        mitk::IOUtil::Save(m_SegmentationImage, "SOME PATH");
-
-    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
-
+  mitk::PlaneGeometry::ConstPointer GetCenterPlane(mitk::AnatomicalPlane viewDirection)
+  {
     // This could be easier...
     mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
     navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
@@ -95,32 +91,58 @@ private:
     mitk::Point3D pointMM;
     m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
     navigationController->SelectSliceByPoint(pointMM);
-    auto plane = navigationController->GetCurrentPlaneGeometry();
-    mitk::Image::Pointer interpolationResult =
-      m_InterpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0);
-
-    //        mitk::IOUtil::Save(interpolationResult, "SOME PATH");
-
-    // Write result into segmentation image
-    vtkSmartPointer<mitkVtkImageOverwrite> reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-    reslicer->SetInputSlice(
-      interpolationResult->GetSliceData()->GetVtkImageAccessor(interpolationResult)->GetVtkImageData());
-    reslicer->SetOverwriteMode(true);
-    reslicer->Modified();
-    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslicer);
-    extractor->SetInput(m_SegmentationImage);
-    extractor->SetTimeStep(0);
-    extractor->SetWorldGeometry(plane);
-    extractor->SetVtkOutputRequest(true);
-    extractor->SetResliceTransformByGeometry(m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-    extractor->Modified();
-    extractor->Update();
+    return navigationController->GetCurrentPlaneGeometry();
+  }
+
+  // The tests all do the same, only in different directions
+  void testRoutine(mitk::AnatomicalPlane viewDirection, bool interpolateAllSlices = false)
+  {
+    const int dim = this->GetSliceDimension(viewDirection);
+
+    this->FillSegmentation(dim);
 
     //        mitk::IOUtil::Save(m_SegmentationImage, "SOME PATH");
 
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    auto plane = this->GetCenterPlane(viewDirection);
+    mitk::Image::Pointer resultImage = m_SegmentationImage;
+
+    if (interpolateAllSlices)
+    {
+      // Interpolate into a copy since the controller reads the segmentation concurrently
+      resultImage = m_SegmentationImage->Clone();
+      auto numberOfInterpolatedSlices = m_InterpolationController->InterpolateAllSlices(dim, plane, 0, resultImage);
+      CPPUNIT_ASSERT_EQUAL(1u, numberOfInterpolatedSlices);
+    }
+    else
+    {
+      mitk::Image::Pointer interpolationResult =
+        m_InterpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0);
+
+      //        mitk::IOUtil::Save(interpolationResult, "SOME PATH");
+
+      // Write result into segmentation image
+      vtkSmartPointer<mitkVtkImageOverwrite> reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+      reslicer->SetInputSlice(
+        interpolationResult->GetSliceData()->GetVtkImageAccessor(interpolationResult)->GetVtkImageData());
+      reslicer->SetOverwriteMode(true);
+      reslicer->Modified();
+      mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslicer);
+      extractor->SetInput(m_SegmentationImage);
+      extractor->SetTimeStep(0);
+      extractor->SetWorldGeometry(plane);
+      extractor->SetVtkOutputRequest(true);
+      extractor->SetResliceTransformByGeometry(m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+      extractor->Modified();
+      extractor->Update();
+    }
+
+    //        mitk::IOUtil::Save(resultImage, "SOME PATH");
+
     // Check a 4x4 square, the center of which needs to be filled
-    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(m_SegmentationImage);
-    currentPoint = m_CenterPoint;
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(resultImage);
+    auto currentPoint = m_CenterPoint;
 
     for (int i = -1; i <= 2; ++i)
     {
@@ -155,6 +177,7 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Failed to load image for test: [Pic3D.nrrd]", m_ReferenceImage.IsNotNull());
 
     m_InterpolationController = mitk::SegmentationInterpolationController::GetInstance();
+    m_InterpolationController->ResetAbortInterpolation();
 
     // Create empty segmentation
     // Surely there must be a better way to get an image with all zeros?
@@ -176,6 +199,7 @@ public:
 
   void tearDown() override
   {
+    m_InterpolationController->ResetAbortInterpolation();
     m_ReferenceImage = nullptr;
     m_SegmentationImage = nullptr;
     m_CenterPoint = {{0, 0, 0}};
@@ -198,6 +222,56 @@ public:
     mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void Equal_Axial_TestAllSlicesInterpolationAndReferenceInterpolation_ReturnsTrue()
+  {
+    mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Axial;
+    testRoutine(viewDirection, true);
+  }
+
+  void Equal_Sagittal_TestAllSlicesInterpolationAndReferenceInterpolation_ReturnsTrue()
+  {
+    mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Sagittal;
+    testRoutine(viewDirection, true);
+  }
+
+  void AcceptAllInterpolations_Axial_AddsInterpolatedSlice()
+  {
+    this->FillSegmentation(2);
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->InitializeByLabeledImage(m_SegmentationImage);
+    const auto labelValue = segmentation->GetAllLabelValues().front();
+    const auto voxelCount = segmentation->GetLabelVoxelCount(labelValue);
+
+    auto numberOfInterpolatedSlices = m_InterpolationController->AcceptAllInterpolations(
+      segmentation, labelValue, 2, this->GetCenterPlane(mitk::AnatomicalPlane::Axial), 0);
+
+    CPPUNIT_ASSERT_EQUAL(1u, numberOfInterpolatedSlices);
+    CPPUNIT_ASSERT_EQUAL(voxelCount + 4, segmentation->GetLabelVoxelCount(labelValue));
+  }
+
+  void AcceptAllInterpolations_Aborted_LeavesSegmentationUnchanged()
+  {
+    this->FillSegmentation(2);
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->InitializeByLabeledImage(m_SegmentationImage);
+    const auto labelValue = segmentation->GetAllLabelValues().front();
+    const auto voxelCount = segmentation->GetLabelVoxelCount(labelValue);
+    const auto groupImageMTime = segmentation->GetGroupImage(0)->GetMTime();
+
+    // the abort is requested while the slices are interpolated, slices in progress are still finished
+    auto numberOfInterpolatedSlices = m_InterpolationController->AcceptAllInterpolations(
+      segmentation, labelValue, 2, this->GetCenterPlane(mitk::AnatomicalPlane::Axial), 0,
+      [this]() { m_InterpolationController->AbortInterpolation(); });
+
+    CPPUNIT_ASSERT_EQUAL(0u, numberOfInterpolatedSlices);
+    CPPUNIT_ASSERT_EQUAL(voxelCount, segmentation->GetLabelVoxelCount(labelValue));
+    CPPUNIT_ASSERT_EQUAL(groupImageMTime, segmentation->GetGroupImage(0)->GetMTime());
+
+    m_InterpolationController->SetSegmentationVolume(segmentation, labelValue);
+    CPPUNIT_ASSERT_MESSAGE("Interpolation must not start while an abort is requested.",
+      m_InterpolationController->InterpolateAllSlicesOfLabel(2, this->GetCenterPlane(mitk::AnatomicalPlane::Axial), 0).IsNull());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
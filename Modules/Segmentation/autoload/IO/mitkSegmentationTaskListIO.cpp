@@ -151,6 +151,7 @@ namespace mitk
 mitk::SegmentationTaskListIO::SegmentationTaskListIO()
   : AbstractFileIO(SegmentationTaskList::GetStaticNameOfClass(), MitkSegmentationIOMimeTypes::SEGMENTATIONTASKLIST_MIMETYPE(), "MITK Segmentation Task List")
 {
+  this->SetReaderThreadSafe(true);
   this->RegisterService();
 }
 
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <mitkCommandLineParser.h>
 #include <mitkContourModelSet.h>
+#include <mitkContourModelSetRasterizer.h>
 #include <mitkContourModelSetToImageFilter.h>
 #include <mitkDataStorage.h>
 #include <mitkImageReadAccessor.h>
@@ -25,6 +26,11 @@ found in the LICENSE file.
 
 #include <mitkFileSystem.h>
 
+#include <itkImageFileWriter.h>
+#include <itkImageSource.h>
+
+#include <algorithm>
+
 enum class OutputFormat
 {
   Binary,
@@ -44,6 +50,101 @@ void InitializeCommandLineParser(mitkCommandLineParser& parser)
   parser.addArgument("reference", "r", mitkCommandLineParser::Image, "Reference image:", "Input reference image", us::Any(), false, false, false, mitkCommandLineParser::Input);
   parser.addArgument("output", "o", mitkCommandLineParser::Image, "Output file:", "Output image", us::Any(), false, false, false, mitkCommandLineParser::Output);
   parser.addArgument("format", "f", mitkCommandLineParser::String, "Output format:", "Output format (binary, label, or multilabel)", std::string("binary"));
+  parser.addArgument("slab", "s", mitkCommandLineParser::Int, "Slab size:", "Write binary output in slabs of the given number of slices instead of creating the whole image in memory (requires an output format that supports streamed writing, e.g. .nii or .mha)", 0);
+}
+
+/** ITK image source that rasterizes contours only within the requested region. In conjunction with
+ * a streaming writer the whole image never has to be held in memory.
+ */
+class ContourRasterImageSource : public itk::ImageSource<itk::Image<unsigned char, 3>>
+{
+public:
+  using Self = ContourRasterImageSource;
+  using Superclass = itk::ImageSource<itk::Image<unsigned char, 3>>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ContourRasterImageSource, ImageSource);
+
+  void SetGeometry(const mitk::BaseGeometry* geometry)
+  {
+    m_Geometry = geometry;
+    this->Modified();
+  }
+
+  void SetRasterizer(const mitk::ContourModelSetRasterizer* rasterizer)
+  {
+    m_Rasterizer = rasterizer;
+    this->Modified();
+  }
+
+protected:
+  ContourRasterImageSource() = default;
+  ~ContourRasterImageSource() override = default;
+
+  void GenerateOutputInformation() override
+  {
+    auto output = this->GetOutput();
+
+    OutputImageType::SpacingType spacing;
+    OutputImageType::PointType origin;
+    OutputImageType::DirectionType direction;
+
+    const auto& matrix = m_Geometry->GetIndexToWorldTransform()->GetMatrix();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      spacing[i] = m_Geometry->GetSpacing()[i];
+      origin[i] = m_Geometry->GetOrigin()[i];
+    }
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+        direction[i][j] = matrix[i][j] / spacing[j];
+    }
+
+    output->SetLargestPossibleRegion(m_Rasterizer->GetLargestPossibleRegion());
+    output->SetSpacing(spacing);
+    output->SetOrigin(origin);
+    output->SetDirection(direction);
+  }
+
+  void GenerateData() override
+  {
+    auto output = this->GetOutput();
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+    output->FillBuffer(0);
+
+    m_Rasterizer->FillRegion(output->GetBufferPointer(), output->GetBufferedRegion(), static_cast<unsigned char>(1));
+  }
+
+private:
+  mitk::BaseGeometry::ConstPointer m_Geometry;
+  mitk::ContourModelSetRasterizer::ConstPointer m_Rasterizer;
+};
+
+/** Writes a binary mask of the contour set slab by slab.*/
+void StreamBinaryImage(const mitk::Image* referenceImage, const mitk::ContourModelSet* contourSet, const fs::path& outputPath, unsigned int slabSize)
+{
+  auto geometry = referenceImage->GetGeometry();
+
+  auto rasterizer = mitk::ContourModelSetRasterizer::New();
+  rasterizer->Initialize(geometry, contourSet);
+
+  auto source = ContourRasterImageSource::New();
+  source->SetGeometry(geometry);
+  source->SetRasterizer(rasterizer);
+
+  const auto numberOfSlices = static_cast<unsigned int>(rasterizer->GetLargestPossibleRegion().GetSize(2));
+
+  auto writer = itk::ImageFileWriter<itk::Image<unsigned char, 3>>::New();
+  writer->SetInput(source->GetOutput());
+  writer->SetFileName(outputPath.string());
+  writer->SetNumberOfStreamDivisions(std::max(1u, (numberOfSlices + slabSize - 1) / slabSize));
+  writer->Update();
 }
 
 std::string GetSafeName(const mitk::IPropertyProvider* propertyProvider)
@@ -180,6 +281,15 @@ int main(int argc, char* argv[])
     auto referenceFilename = us::any_cast<std::string>(args["reference"]);
     auto outputFilename = us::any_cast<std::string>(args["output"]);
     auto format = ParseOutputFormat(args);
+    auto slabSize = args.end() != args.find("slab")
+      ? static_cast<unsigned int>(std::max(0, us::any_cast<int>(args["slab"])))
+      : 0u;
+
+    if (slabSize > 0 && format != OutputFormat::Binary)
+    {
+      MITK_WARN << "Slab-wise writing is only supported for binary output. Ignoring slab size.";
+      slabSize = 0;
+    }
 
     auto referenceImage = mitk::IOUtil::Load<mitk::Image>(referenceFilename);
     auto inputs = FilterValidInputs(mitk::IOUtil::Load(inputFilename));
@@ -209,6 +319,12 @@ int main(int argc, char* argv[])
         outputPath.replace_filename(outputPath.stem().string() + '_' + name + outputPath.extension().string());
       }
 
+      if (slabSize > 0)
+      {
+        StreamBinaryImage(referenceImage, input, outputPath, slabSize);
+        continue;
+      }
+
       // Do the actual conversion from a contour set to an image with a background pixel value of 0.
       // - For "binary" output, use pixel value 1 and unsigned char as pixel type.
       // - For "label" output, use pixel value 1 and our label pixel type.
@@ -4,6 +4,7 @@ set(H_FILES
 
 set(CPP_FILES
   Algorithms/mitkCalculateSegmentationVolume.cpp
+  Algorithms/mitkContourModelSetRasterizer.cpp
   Algorithms/mitkContourModelSetToImageFilter.cpp
   Algorithms/mitkContourSetToPointSetFilter.cpp
   Algorithms/mitkContourUtils.cpp
@@ -35,7 +35,7 @@ QmitkSegWithPreviewToolGUIBase::~QmitkSegWithPreviewToolGUIBase()
 {
   if (m_Tool.IsNotNull())
   {
-    m_Tool->CurrentlyBusy -= mitk::MessageDelegate1<QmitkSegWithPreviewToolGUIBase, bool>(this, &QmitkSegWithPreviewToolGUIBase::BusyStateChanged);
+    this->DisconnectOldTool(m_Tool);
   }
 }
 
@@ -119,6 +119,12 @@ void QmitkSegWithPreviewToolGUIBase::OnAcceptPreview()
 void QmitkSegWithPreviewToolGUIBase::DisconnectOldTool(mitk::SegWithPreviewTool* oldTool)
 {
   oldTool->CurrentlyBusy -= mitk::MessageDelegate1<QmitkSegWithPreviewToolGUIBase, bool>(this, &QmitkSegWithPreviewToolGUIBase::BusyStateChanged);
+
+  oldTool->SetAsynchronousPreviewUpdate(false);
+  oldTool->AsynchronousPreviewUpdateFinished -=
+    mitk::MessageDelegate<QmitkSegWithPreviewToolGUIBase>(this, &QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewUpdateFinished);
+  oldTool->AsynchronousPreviewProgress -=
+    mitk::MessageDelegate<QmitkSegWithPreviewToolGUIBase>(this, &QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewProgress);
 }
 
 void QmitkSegWithPreviewToolGUIBase::ConnectNewTool(mitk::SegWithPreviewTool* newTool)
@@ -126,6 +132,13 @@ void QmitkSegWithPreviewToolGUIBase::ConnectNewTool(mitk::SegWithPreviewTool* ne
   newTool->CurrentlyBusy +=
     mitk::MessageDelegate1<QmitkSegWithPreviewToolGUIBase, bool>(this, &QmitkSegWithPreviewToolGUIBase::BusyStateChanged);
 
+  // the GUI keeps responsive while tools that support it compute their preview
+  newTool->AsynchronousPreviewUpdateFinished +=
+    mitk::MessageDelegate<QmitkSegWithPreviewToolGUIBase>(this, &QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewUpdateFinished);
+  newTool->AsynchronousPreviewProgress +=
+    mitk::MessageDelegate<QmitkSegWithPreviewToolGUIBase>(this, &QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewProgress);
+  newTool->SetAsynchronousPreviewUpdate(true);
+
   m_CheckProcessAll->setVisible(
     !m_Mode2D &&
     m_EnableProcessingOfAllTimeSteps &&
@@ -152,6 +165,28 @@ void QmitkSegWithPreviewToolGUIBase::BusyStateChanged(bool isBusy)
   this->EnableWidgets(!isBusy);
  }
 
+void QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewUpdateFinished()
+{
+  QMetaObject::invokeMethod(this, [this]()
+  {
+    if (m_Tool.IsNotNull())
+    {
+      m_Tool->FinalizeAsynchronousPreviewUpdate();
+    }
+  }, Qt::QueuedConnection);
+}
+
+void QmitkSegWithPreviewToolGUIBase::OnAsynchronousPreviewProgress()
+{
+  QMetaObject::invokeMethod(this, [this]()
+  {
+    if (m_Tool.IsNotNull())
+    {
+      m_Tool->ReportAsynchronousPreviewProgress();
+    }
+  }, Qt::QueuedConnection);
+}
+
 void QmitkSegWithPreviewToolGUIBase::EnableWidgets(bool enabled)
 {
   if (nullptr != m_MainLayout)
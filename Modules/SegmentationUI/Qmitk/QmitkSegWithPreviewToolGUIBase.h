@@ -66,6 +66,14 @@ protected:
 
   void BusyStateChanged(bool isBusy) override;
 
+  /** Called by the tool from its background worker if an asynchronous preview update is finished.
+   Queues the finalization of the update into the GUI thread.*/
+  void OnAsynchronousPreviewUpdateFinished();
+
+  /** Called by the tool from its background worker if the computation reported progress.
+   Queues the update of the progress bar into the GUI thread.*/
+  void OnAsynchronousPreviewProgress();
+
   using EnableConfirmSegBtnFunctionType = std::function<bool(bool)>;
   EnableConfirmSegBtnFunctionType m_EnableConfirmSegBtnFnc;
 
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "QmitkSlicesInterpolator.h"
 #include "QmitkRenderWindow.h"
 #include "QmitkRenderWindowWidget.h"
+#include <QmitkRun.h>
 
 #include "mitkColorProperty.h"
 #include "mitkCoreObjectFactory.h"
@@ -68,8 +69,6 @@ found in the LICENSE file.
 #include <vtkPolyData.h>
 
 #include <array>
-#include <atomic>
-#include <thread>
 #include <vector>
 
 namespace
@@ -818,14 +817,11 @@ void QmitkSlicesInterpolator::OnAcceptInterpolationClicked()
 
 void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationController *slicer)
 {
-  /*
-   * What exactly is done here:
-   * 1. We create an empty diff image for the current segmentation
-   * 2. All interpolated slices are written into the diff image
-   * 3. Then the diffimage is applied to the original segmentation
-   */
   if (m_Segmentation)
   {
+    // a new user action, withdraw aborts of previous ones
+    m_Interpolator->ResetAbortInterpolation();
+
     if (!m_Segmentation->ExistLabel(m_CurrentActiveLabelValue))
     {
       MITK_ERROR << "AcceptAllInterpolations triggered with no valid label selected. Currently selected invalid label: " << m_CurrentActiveLabelValue;
@@ -839,36 +835,9 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
       return;
     }
 
-    mitk::Image::Pointer activeLabelImage;
-    try
-    {
-      activeLabelImage = mitk::CreateLabelMask(m_Segmentation, m_CurrentActiveLabelValue);
-    }
-    catch (const std::exception& e)
-    {
-      MITK_ERROR << e.what() << " | NO LABELSETIMAGE IN WORKING NODE\n";
-    }
-    m_Interpolator->SetSegmentationVolume(activeLabelImage);
-
     const auto relevantGroupImage = m_Segmentation->GetGroupImage(m_Segmentation->GetGroupIndexOfLabel(m_CurrentActiveLabelValue));
     const auto segmentation3D = mitk::SelectImageByTimePoint(relevantGroupImage, m_TimePoint);
 
-    // Create an empty diff image for the undo operation
-    auto diffImage = mitk::Image::New();
-    diffImage->Initialize(segmentation3D);
-
-    // Create scope for ImageWriteAccessor so that the accessor is destroyed right after use
-    {
-      mitk::ImageWriteAccessor accessor(diffImage);
-
-      // Set all pixels to zero
-      auto pixelType = mitk::MakeScalarPixelType<mitk::Tool::DefaultSegmentationDataType>();
-
-      memset(accessor.GetData(), 0, pixelType.GetSize() * diffImage->GetDimension(0) * diffImage->GetDimension(1) * diffImage->GetDimension(2));
-    }
-
-    // Since we need to shift the plane it must be clone so that the original plane isn't altered
-    auto slicedGeometry = m_Segmentation->GetSlicedGeometry();
     auto planeGeometry = slicer->GetCurrentPlaneGeometry()->Clone();
     int sliceDimension = -1;
     int sliceIndex = -1;
@@ -884,99 +853,32 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     const auto numSlices = m_Segmentation->GetDimensions()[sliceDimension];
     mitk::ProgressBar::GetInstance()->AddStepsToDo(numSlices);
 
-    std::atomic_uint totalChangedSlices;
-
-    // Reuse interpolation algorithm instance for each slice to cache boundary calculations
-    auto algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
-
-    // Distribute slice interpolations to multiple threads
-    const auto numThreads = std::min(std::thread::hardware_concurrency(), numSlices);
-    std::vector<std::vector<unsigned int>> sliceIndices(numThreads);
-
-    for (std::remove_const_t<decltype(numSlices)> sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
-      sliceIndices[sliceIndex % numThreads].push_back(sliceIndex);
-
-    std::vector<std::thread> threads;
-    threads.reserve(numThreads);
-
-    auto timeStep = m_Segmentation->GetTimeGeometry()->TimePointToTimeStep(m_TimePoint);
+    const auto timeStep = m_Segmentation->GetTimeGeometry()->TimePointToTimeStep(m_TimePoint);
 
-    // This lambda will be executed by the threads
-    auto interpolate = [=, &interpolator = m_Interpolator, &totalChangedSlices](unsigned int threadIndex)
-    {
-      auto clonedPlaneGeometry = planeGeometry->Clone();
-      auto origin = clonedPlaneGeometry->GetOrigin();
-
-      //  Go through the sliced indices
-      for (auto sliceIndex : sliceIndices[threadIndex])
-      {
-        slicedGeometry->WorldToIndex(origin, origin);
-        origin[sliceDimension] = sliceIndex;
-        slicedGeometry->IndexToWorld(origin, origin);
-        clonedPlaneGeometry->SetOrigin(origin);
-
-        auto interpolation = interpolator->Interpolate(sliceDimension, sliceIndex, clonedPlaneGeometry, timeStep, algorithm);
-
-        if (interpolation.IsNotNull())
-        {
-          // Setting up the reslicing pipeline which allows us to write the interpolation results back into the image volume
-          auto reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-          // Set overwrite mode to true to write back to the image volume
-          reslicer->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-          reslicer->SetOverwriteMode(true);
-          reslicer->Modified();
-
-          auto diffSliceWriter = mitk::ExtractSliceFilter::New(reslicer);
-
-          diffSliceWriter->SetInput(diffImage);
-          diffSliceWriter->SetTimeStep(0);
-          diffSliceWriter->SetWorldGeometry(clonedPlaneGeometry);
-          diffSliceWriter->SetVtkOutputRequest(true);
-          diffSliceWriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-          diffSliceWriter->Modified();
-          diffSliceWriter->Update();
-
-          ++totalChangedSlices;
-        }
-
-        mitk::ProgressBar::GetInstance()->Progress();
-      }
-    };
-    m_Interpolator->EnableSliceImageCache();
-
-    //  Do the interpolation here.
-    for (size_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
+    try
     {
-      interpolate(threadIndex);
+      // Slices are interpolated in parallel by the controller in the background, so the user can cancel the
+      // interpolation. The segmentation is only modified afterwards, as a single undo step.
+      m_Interpolator->SetSegmentationVolume(m_Segmentation, m_CurrentActiveLabelValue);
+
+      mitk::Image::Pointer interpolationVolume;
+      const bool completed = QmitkRunCancelableAsyncBlocking("Interpolation", "Interpolating all slices...",
+        [&]() {
+          interpolationVolume = m_Interpolator->InterpolateAllSlicesOfLabel(sliceDimension,
+                                                                            planeGeometry,
+                                                                            timeStep,
+                                                                            [] { mitk::ProgressBar::GetInstance()->Progress(); });
+        },
+        [this]() { m_Interpolator->AbortInterpolation(); });
+
+      if (completed && interpolationVolume.IsNotNull())
+        m_Interpolator->ApplyInterpolatedSlices(m_Segmentation, m_CurrentActiveLabelValue, interpolationVolume, timeStep);
     }
-
-    m_Interpolator->DisableSliceImageCache();
-
-    if (totalChangedSlices > 0)
+    catch (const std::exception& e)
     {
-      const auto activeLabel = m_Segmentation->GetActiveLabel();
-      auto newDestinationLabel = activeLabel->GetValue();
-      auto activeLabelName = mitk::LabelSetImageHelper::CreateDisplayLabelName(m_Segmentation, activeLabel);
-
-      mitk::SegGroupModifyUndoRedoHelper undoHelper(m_Segmentation, { m_Segmentation->GetActiveLayer() }, false, timeStep, true, false, true);
-
-      TransferLabelContentAtTimeStep(
-        diffImage,
-        m_Segmentation->GetGroupImage(m_Segmentation->GetActiveLayer()),
-        m_Segmentation->GetConstLabelsByValue(m_Segmentation->GetLabelValuesByGroup(m_Segmentation->GetActiveLayer())),
-        timeStep,
-        0,
-        0,
-        false,
-        { {1, newDestinationLabel} },
-        mitk::MultiLabelSegmentation::MergeStyle::Merge,
-        mitk::MultiLabelSegmentation::OverwriteStyle::RegardLocks);
-
-      std::string name = "3D-interpolation - " + activeLabelName;
-
-      undoHelper.RegisterUndoRedoOperationEvent(name);
+      MITK_ERROR << "Error while accepting all interpolations: " << e.what();
     }
+
     m_FeedbackNode->SetData(nullptr);
   }
 
@@ -1237,8 +1139,7 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
       const auto* activeLabel = labelSetImage->GetActiveLabel();
       if (nullptr != activeLabel)
       {
-        auto activeLabelImage = mitk::CreateLabelMask(labelSetImage, activeLabel->GetValue());
-        m_Interpolator->SetSegmentationVolume(activeLabelImage);
+        m_Interpolator->SetSegmentationVolume(labelSetImage, activeLabel->GetValue());
       }
     }
   }
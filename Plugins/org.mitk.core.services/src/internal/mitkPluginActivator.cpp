@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkPluginActivator.h"
 
+#include <mitkLog.h>
 #include <mitkLogBackend.h>
 
 #include <QString>
@@ -86,6 +87,11 @@ void org_mitk_core_services_Activator::start(ctkPluginContext* context)
   mitk::VtkLoggingAdapter::Initialize();
   mitk::ItkLoggingAdapter::Initialize();
 
+  // keep file I/O of the log backends off the threads that emit messages, if requested on the command line
+  // (see mitk::BaseApplication::ARG_ASYNCHRONOUS_LOGGING)
+  if (context->getProperty("MITK.asynchronousLogging").toBool())
+    mitk::EnableAsynchronousLogging();
+
   //initialize data storage service
   dataStorageService.reset(new DataStorageService());
   context->registerService<mitk::IDataStorageService>(dataStorageService.data());
@@ -118,6 +124,7 @@ void org_mitk_core_services_Activator::stop(ctkPluginContext* /*context*/)
   mapMitkIdToAdapter.clear();
 
   //clean up logging
+  mitk::DisableAsynchronousLogging();
   mitk::LogBackend::Unregister();
 
   dataStorageService.reset();
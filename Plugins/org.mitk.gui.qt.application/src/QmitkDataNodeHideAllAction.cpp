@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <QmitkDataNodeHideAllAction.h>
 
 // mitk core
+#include <mitkBatchUpdateScope.h>
 #include <mitkRenderingManager.h>
 
 #include <QWidget>
@@ -70,6 +71,9 @@ void QmitkDataNodeHideAllAction::OnActionTriggered(bool /*checked*/)
 {
   mitk::BaseRenderer::Pointer baseRenderer = GetBaseRenderer();
 
+  // notify listeners and render windows only once for all nodes
+  mitk::BatchUpdateScope batchUpdate(m_DataStorage.Lock());
+
   auto selectedNodes = GetSelectedNodes();
   HideAllAction::Run(selectedNodes, baseRenderer);
 }
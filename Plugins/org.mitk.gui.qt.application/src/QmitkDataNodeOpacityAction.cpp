@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include <QmitkDataNodeOpacityAction.h>
 
+#include <mitkBatchUpdateScope.h>
 #include <mitkRenderingManager.h>
 
 #include <QHBoxLayout>
@@ -84,6 +85,9 @@ void QmitkDataNodeOpacityAction::OnOpacityChanged(int value)
 {
   float opacity = value * 0.01f;
 
+  // notify listeners and render windows only once for all nodes
+  mitk::BatchUpdateScope batchUpdate(m_DataStorage.Lock());
+
   for (auto node : this->GetSelectedOpacityNodes())
     node->SetOpacity(opacity);
 
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <QmitkDataNodeShowSelectedNodesAction.h>
 
 // mitk core
+#include <mitkBatchUpdateScope.h>
 #include <mitkRenderingManager.h>
 
 #include <QWidget>
@@ -47,6 +48,9 @@ void QmitkDataNodeShowSelectedNodesAction::OnActionTriggered(bool /*checked*/)
     return;
   }
 
+  // notify listeners and render windows only once for all nodes
+  mitk::BatchUpdateScope batchUpdate(dataStorage);
+
   mitk::BaseRenderer::Pointer baseRenderer = GetBaseRenderer();
 
   auto selectedNodes = GetSelectedNodes();
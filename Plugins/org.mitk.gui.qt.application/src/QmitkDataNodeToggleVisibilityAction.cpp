@@ -14,6 +14,7 @@ found in the LICENSE file.
 #include <QmitkDataNodeGlobalReinitAction.h>
 
 // mitk core
+#include <mitkBatchUpdateScope.h>
 #include <mitkRenderingManager.h>
 
 #include <mitkCoreServices.h>
@@ -27,14 +28,19 @@ namespace ToggleVisibilityAction
 {
   void Run(berry::IWorkbenchPartSite::Pointer workbenchPartSite, mitk::DataStorage::Pointer dataStorage, const QList<mitk::DataNode::Pointer>& selectedNodes /*= QList<mitk::DataNode::Pointer>()*/, mitk::BaseRenderer* baseRenderer /*= nullptr*/)
   {
-    bool isVisible;
-    for (auto& node : selectedNodes)
     {
-      if (node.IsNotNull())
+      // notify listeners only once for all nodes
+      mitk::BatchUpdateScope batchUpdate(dataStorage);
+
+      bool isVisible;
+      for (auto& node : selectedNodes)
       {
-        isVisible = false;
-        node->GetBoolProperty("visible", isVisible, baseRenderer);
-        node->SetVisibility(!isVisible, baseRenderer);
+        if (node.IsNotNull())
+        {
+          isVisible = false;
+          node->GetBoolProperty("visible", isVisible, baseRenderer);
+          node->SetVisibility(!isVisible, baseRenderer);
+        }
       }
     }
 
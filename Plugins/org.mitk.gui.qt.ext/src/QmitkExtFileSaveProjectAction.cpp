@@ -64,6 +64,15 @@ void QmitkExtFileSaveProjectAction::Run()
      */
     static QString m_LastPath;
 
+    /**
+     * @brief kept across saves to update the last saved file incrementally
+     */
+    static mitk::SceneIO::Pointer m_SceneIO = []() {
+      auto sceneIO = mitk::SceneIO::New();
+      sceneIO->IncrementalSavingOn();
+      return sceneIO;
+    }();
+
     mitk::IDataStorageReference::Pointer dsRef;
 
     {
@@ -106,7 +115,7 @@ void QmitkExtFileSaveProjectAction::Run()
     if ( fileName.right(5) != ".mitk" )
       fileName += ".mitk";
 
-    mitk::SceneIO::Pointer sceneIO = mitk::SceneIO::New();
+    mitk::SceneIO::Pointer sceneIO = m_SceneIO;
 
     mitk::ProgressBar::GetInstance()->AddStepsToDo(2);
 
@@ -75,6 +75,8 @@ bool QmitkSegmentationPreferencePage::PerformOk()
   prefs->PutFloat("opacity factor", opacityFactor);
 
   prefs->PutBool("selection mode", m_Ui->selectionModeCheckBox->isChecked());
+  prefs->PutBool("compress idle groups", m_Ui->compressIdleGroupsCheckBox->isChecked());
+  prefs->PutInt("3D rendering mode", m_Ui->rendering3DComboBox->currentIndex());
   prefs->Put("label set preset", m_Ui->labelSetPresetLineEdit->text().toStdString());
   prefs->PutBool("default label naming", m_Ui->defaultNameRadioButton->isChecked());
   prefs->Put("label suggestions", m_Ui->suggestionsLineEdit->text().toStdString());
@@ -109,6 +111,8 @@ void QmitkSegmentationPreferencePage::Update()
   m_Ui->opacityFactorSlider->setValue(opacityFactor);
 
   m_Ui->selectionModeCheckBox->setChecked(prefs->GetBool("selection mode", false));
+  m_Ui->compressIdleGroupsCheckBox->setChecked(prefs->GetBool("compress idle groups", false));
+  m_Ui->rendering3DComboBox->setCurrentIndex(prefs->GetInt("3D rendering mode", 0));
 
   auto labelSetPreset = mitk::BaseApplication::instance().config().getString(mitk::BaseApplication::ARG_SEGMENTATION_LABELSET_PRESET.toStdString(), "");
   bool isOverriddenByCmdLineArg = !labelSetPreset.empty();
@@ -90,6 +90,8 @@ QmitkSegmentationView::QmitkSegmentationView()
   , m_WorkingNode(nullptr)
   , m_DrawOutline(true)
   , m_SelectionMode(false)
+  , m_CompressIdleGroups(false)
+  , m_3DRenderingMode(0)
   , m_MouseCursorSet(false)
   , m_DefaultLabelNaming(true)
   , m_SelectionChangeIsAlreadyBeingHandled(false)
@@ -235,6 +237,16 @@ void QmitkSegmentationView::OnAnySelectionChanged()
       m_WorkingDataObserverTags.erase(m_WorkingNode);
     }
 
+    // The previous segmentation is not edited anymore, so its idle groups can be compressed
+    if (m_CompressIdleGroups && m_WorkingNode.IsNotNull())
+    {
+      auto previousSegmentation = dynamic_cast<mitk::MultiLabelSegmentation*>(m_WorkingNode->GetData());
+      if (nullptr != previousSegmentation)
+      {
+        previousSegmentation->CompressIdleGroups();
+      }
+    }
+
     // Set new working node
     m_WorkingNode = selectedWorkingNode;
     m_ToolManager->SetWorkingData(m_WorkingNode);
@@ -503,6 +515,10 @@ void QmitkSegmentationView::OnCurrentLabelSelectionChanged(QmitkMultiLabelManage
     mitk::RenderingManager::GetInstance()->RequestUpdateAll();
   }
   m_Controls->slicesInterpolator->SetActiveLabelValue(labelValue);
+
+  // only the group of the active label is edited, all other groups are kept compressed
+  if (m_CompressIdleGroups)
+    segmentation->CompressIdleGroups();
 }
 
 void QmitkSegmentationView::OnGoToLabel(mitk::MultiLabelSegmentation::LabelValueType /*label*/, const mitk::Point3D& pos)
@@ -759,6 +775,8 @@ void QmitkSegmentationView::OnPreferencesChanged(const mitk::IPreferences* prefs
 
   m_DrawOutline = prefs->GetBool("draw outline", true);
   m_SelectionMode = prefs->GetBool("selection mode", false);
+  m_CompressIdleGroups = prefs->GetBool("compress idle groups", false);
+  m_3DRenderingMode = prefs->GetInt("3D rendering mode", 0);
 
   m_LabelSetPresetPreference = QString::fromStdString(prefs->Get("label set preset", ""));
 
@@ -844,6 +862,10 @@ void QmitkSegmentationView::ApplyDisplayOptions(mitk::DataNode* node)
   // the outline property can be set in the segmentation preference page
   node->SetProperty("labelset.contour.active", mitk::BoolProperty::New(m_DrawOutline));
 
+  // the 3D rendering mode can be set in the segmentation preference page
+  node->SetProperty("multilabel.3D.combined", mitk::BoolProperty::New(1 == m_3DRenderingMode));
+  node->SetProperty("multilabel.3D.surface", mitk::BoolProperty::New(2 == m_3DRenderingMode));
+
   // force render window update to show outline
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
 }
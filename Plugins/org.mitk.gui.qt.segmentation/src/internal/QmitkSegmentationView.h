@@ -161,6 +161,9 @@ private:
 
   bool m_DrawOutline;
   bool m_SelectionMode;
+  bool m_CompressIdleGroups;
+  /** 0: one volume per group, 1: combined volume of all groups, 2: label surfaces (see mitk::MultiLabelSegmentationVtkMapper3D)*/
+  int m_3DRenderingMode;
   bool m_MouseCursorSet;
 
   QString m_LabelSetPresetPreference;